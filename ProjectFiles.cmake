@@ -4,7 +4,26 @@
 
 # Set project source files.
 set(SRC
+  "${SRC_PATH}/batchRunner.cpp"
+  "${SRC_PATH}/binaryEncoding.cpp"
+  "${SRC_PATH}/capi.cpp"
+  "${SRC_PATH}/checkpoint.cpp"
+  "${SRC_PATH}/clohessyWiltshire.cpp"
+  "${SRC_PATH}/configLoader.cpp"
+  "${SRC_PATH}/guidanceKernel.cpp"
+  "${SRC_PATH}/instrumentation.cpp"
+  "${SRC_PATH}/monteCarlo.cpp"
+  "${SRC_PATH}/multiChaserSimulator.cpp"
+  "${SRC_PATH}/outputSampler.cpp"
+  "${SRC_PATH}/outputSink.cpp"
+  "${SRC_PATH}/parameterSweep.cpp"
+  "${SRC_PATH}/propagator.cpp"
+  "${SRC_PATH}/simulator.cpp"
+  "${SRC_PATH}/threadPool.cpp"
+  "${SRC_PATH}/thrustPolicy.cpp"
+  "${SRC_PATH}/timeGrid.cpp"
   "${SRC_PATH}/userInput.cpp"
+  "${SRC_PATH}/workQueue.cpp"
 )
 
 # Set project main file.
@@ -12,9 +31,38 @@ set(MAIN_SRC
   "${SRC_PATH}/main.cpp"
 )
 
+# Set batch runner main file.
+set(BATCH_MAIN_SRC
+  "${SRC_PATH}/batchMain.cpp"
+)
+
 # Set project test source files.
 set(TEST_SRC
   "${TEST_SRC_PATH}/testRvdsim.cpp"
+  "${TEST_SRC_PATH}/testBatchRunner.cpp"
+  "${TEST_SRC_PATH}/testCApi.cpp"
+  "${TEST_SRC_PATH}/testCheckpoint.cpp"
+  "${TEST_SRC_PATH}/testClohessyWiltshire.cpp"
+  "${TEST_SRC_PATH}/testConfigLoader.cpp"
+  "${TEST_SRC_PATH}/testGuidanceKernel.cpp"
+  "${TEST_SRC_PATH}/testInstrumentation.cpp"
+  "${TEST_SRC_PATH}/testMonteCarlo.cpp"
+  "${TEST_SRC_PATH}/testMultiChaserSimulator.cpp"
+  "${TEST_SRC_PATH}/testOutputSampler.cpp"
+  "${TEST_SRC_PATH}/testOutputSink.cpp"
+  "${TEST_SRC_PATH}/testParameterSweep.cpp"
+  "${TEST_SRC_PATH}/testPropagator.cpp"
+  "${TEST_SRC_PATH}/testSimulator.cpp"
+  "${TEST_SRC_PATH}/testThreadPool.cpp"
+  "${TEST_SRC_PATH}/testThrustPolicy.cpp"
+  "${TEST_SRC_PATH}/testTimeGrid.cpp"
+  "${TEST_SRC_PATH}/testUnconstrainedGuidance.cpp"
   "${TEST_SRC_PATH}/testUserInput.cpp"
   "${TEST_SRC_PATH}/testTypedefs.cpp"
+  "${TEST_SRC_PATH}/testWorkQueue.cpp"
+)
+
+# Set project benchmark source files.
+set(BENCHMARK_SRC
+  "${BENCHMARK_SRC_PATH}/benchmarkRvdsim.cpp"
 )
@@ -0,0 +1,684 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <rapidjson/document.h>
+
+#include "rvdsim/clohessyWiltshire.hpp"
+#include "rvdsim/configLoader.hpp"
+#include "rvdsim/guidanceKernel.hpp"
+#include "rvdsim/multiChaserSimulator.hpp"
+#include "rvdsim/outputSink.hpp"
+#include "rvdsim/parameterSweep.hpp"
+#include "rvdsim/propagator.hpp"
+#include "rvdsim/simulator.hpp"
+#include "rvdsim/thrustPolicy.hpp"
+#include "rvdsim/typedefs.hpp"
+#include "rvdsim/userInput.hpp"
+
+namespace
+{
+
+//! Result of a single benchmark.
+struct BenchmarkResult
+{
+public:
+
+    //! Name of benchmark.
+    std::string name;
+
+    //! Problem size, i.e., number of items processed per repetition [-].
+    std::size_t problemSize;
+
+    //! Unit of items processed.
+    std::string unit;
+
+    //! Number of timed repetitions [-].
+    std::size_t numberOfRepetitions;
+
+    //! Minimum wall-clock time over all repetitions [s].
+    double minimumTime;
+
+    //! Median wall-clock time over all repetitions [s].
+    double medianTime;
+
+protected:
+private:
+};
+
+//! Time given function.
+/*!
+ * Executes given function once as warm-up, followed by the given number of timed repetitions.
+ *
+ * @tparam    Function            Type of function to time
+ * @param[in] name                Name of benchmark
+ * @param[in] problemSize         Number of items processed per repetition
+ * @param[in] unit                Unit of items processed
+ * @param[in] numberOfRepetitions Number of timed repetitions
+ * @param[in] function            Function to time
+ * @return                        Benchmark result
+ */
+template< typename Function >
+BenchmarkResult timeFunction( const std::string& name,
+                              const std::size_t problemSize,
+                              const std::string& unit,
+                              const std::size_t numberOfRepetitions,
+                              Function function )
+{
+    function( );
+
+    std::vector< double > times( numberOfRepetitions );
+    for ( std::size_t i = 0; i < numberOfRepetitions; ++i )
+    {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now( );
+        function( );
+        times[ i ] = std::chrono::duration< double >(
+            std::chrono::steady_clock::now( ) - start ).count( );
+    }
+    std::sort( times.begin( ), times.end( ) );
+
+    BenchmarkResult result;
+    result.name = name;
+    result.problemSize = problemSize;
+    result.unit = unit;
+    result.numberOfRepetitions = numberOfRepetitions;
+    result.minimumTime = times.front( );
+    result.medianTime = times[ numberOfRepetitions / 2 ];
+
+    std::cerr << name << " [" << problemSize << " " << unit << "]: " << result.medianTime << " s"
+              << std::endl;
+
+    return result;
+}
+
+//! Create user input for benchmarks.
+/*!
+ * @param[in] thrustMode      Thrust mode
+ * @param[in] numberOfPulses  Number of thruster pulses simulated
+ * @param[in] thrustMaximum   Thrust maximum [N] (default: 0.5)
+ * @return                    User input
+ */
+rvdsim::UserInput createBenchmarkInput( const rvdsim::ThrustMode thrustMode,
+                                        const std::size_t numberOfPulses,
+                                        const rvdsim::Real thrustMaximum = 0.5 )
+{
+    const rvdsim::Vector6 chaserInitialState = { { -100.0, -1000.0, 10.0, 0.0, 0.1, 0.0 } };
+
+    return rvdsim::UserInput( 0.0,
+                              static_cast< rvdsim::Real >( numberOfPulses ),
+                              3.986004418e14,
+                              6778.0e3,
+                              chaserInitialState,
+                              thrustMode,
+                              thrustMaximum,
+                              1.0,
+                              100.0,
+                              1.0,
+                              ".",
+                              "chaser_state_history.csv",
+                              "chaser_thrust_history.csv" );
+}
+
+//! Get name of thrust mode.
+std::string getThrustModeName( const rvdsim::ThrustMode thrustMode )
+{
+    switch ( thrustMode )
+    {
+        case rvdsim::off:
+            return "off";
+
+        case rvdsim::throttle:
+            return "throttle";
+
+        case rvdsim::onOff:
+            return "on_off";
+    }
+
+    return "unknown";
+}
+
+//! Benchmark guidance loop, in steps per second, for each thrust mode.
+void benchmarkGuidanceLoop( const std::vector< std::size_t >& problemSizes,
+                            std::vector< BenchmarkResult >& results )
+{
+    const rvdsim::ThrustMode thrustModes[ ] = { rvdsim::off, rvdsim::throttle, rvdsim::onOff };
+
+    for ( std::size_t i = 0; i < 3; ++i )
+    {
+        for ( std::size_t j = 0; j < problemSizes.size( ); ++j )
+        {
+            const rvdsim::UserInput input
+                = createBenchmarkInput( thrustModes[ i ], problemSizes[ j ] );
+            rvdsim::Simulator simulator( input, false );
+            results.push_back(
+                timeFunction( "guidance_loop_" + getThrustModeName( thrustModes[ i ] ),
+                              problemSizes[ j ],
+                              "steps",
+                              5,
+                              [ &simulator ]( ) { simulator.execute( ); } ) );
+        }
+    }
+
+    // Unconstrained thruster, which applies the precomputed closed-loop transitions.
+    for ( std::size_t j = 0; j < problemSizes.size( ); ++j )
+    {
+        const rvdsim::UserInput input
+            = createBenchmarkInput( rvdsim::throttle, problemSizes[ j ], 0.0 );
+        rvdsim::Simulator simulator( input, false );
+        results.push_back( timeFunction( "guidance_loop_unconstrained",
+                                         problemSizes[ j ],
+                                         "steps",
+                                         5,
+                                         [ &simulator ]( ) { simulator.execute( ); } ) );
+    }
+}
+
+//! Benchmark multi-chaser guidance loop, in chaser-steps per second, for given numbers of chasers.
+void benchmarkMultiChaserLoop( const std::vector< std::size_t >& problemSizes,
+                               std::vector< BenchmarkResult >& results )
+{
+    const std::size_t numberOfPulses = 100;
+    const rvdsim::UserInput input = createBenchmarkInput( rvdsim::throttle, numberOfPulses );
+
+    for ( std::size_t j = 0; j < problemSizes.size( ); ++j )
+    {
+        std::vector< rvdsim::ChaserSettings > chasers;
+        for ( std::size_t i = 0; i < problemSizes[ j ]; ++i )
+        {
+            rvdsim::Vector6 initialState = input.chaserInitialState;
+            initialState[ 0 ] += static_cast< rvdsim::Real >( i % 100 );
+            chasers.push_back(
+                rvdsim::ChaserSettings( initialState, rvdsim::throttle, 0.5, 100.0 ) );
+        }
+
+        rvdsim::MultiChaserSimulator simulator( input, chasers );
+        results.push_back( timeFunction( "multi_chaser_loop",
+                                         problemSizes[ j ] * numberOfPulses,
+                                         "chaser_steps",
+                                         5,
+                                         [ &simulator ]( ) { simulator.execute( ); } ) );
+    }
+}
+
+//! Benchmark Clohessy-Wiltshire propagation latency, for single states and batches of states.
+void benchmarkClohessyWiltshirePropagation( const std::vector< std::size_t >& problemSizes,
+                                            std::vector< BenchmarkResult >& results )
+{
+    const rvdsim::Real meanMotion = 1.1e-3;
+    const rvdsim::ClohessyWiltshireStateTransition transition
+        = rvdsim::computeClohessyWiltshireStateTransition( meanMotion, 1.0 );
+    const rvdsim::Vector3 thrustAcceleration = { { 1.0e-4, -2.0e-4, 5.0e-5 } };
+
+    for ( std::size_t j = 0; j < problemSizes.size( ); ++j )
+    {
+        const std::size_t numberOfStates = problemSizes[ j ];
+
+        rvdsim::Vector6 state = { { -100.0, -1000.0, 10.0, 0.0, 0.1, 0.0 } };
+        results.push_back(
+            timeFunction( "cw_propagation_single",
+                          numberOfStates,
+                          "states",
+                          5,
+                          [ &transition, &thrustAcceleration, &state, numberOfStates ]( )
+        {
+            for ( std::size_t i = 0; i < numberOfStates; ++i )
+            {
+                rvdsim::propagateClohessyWiltshire( transition, state, thrustAcceleration, state );
+            }
+        } ) );
+
+        // Keep propagated state observable, such that loop cannot be optimised away.
+        if ( !( state[ 0 ] == state[ 0 ] ) )
+        {
+            std::cerr << "WARNING: Propagated state is not finite!" << std::endl;
+        }
+
+        rvdsim::StateBatch initialStates( numberOfStates );
+        rvdsim::AccelerationBatch thrustAccelerations( numberOfStates );
+        for ( std::size_t i = 0; i < numberOfStates; ++i )
+        {
+            initialStates.setVector( i, state );
+            thrustAccelerations.setVector( i, thrustAcceleration );
+        }
+        rvdsim::StateBatch finalStates( numberOfStates );
+        results.push_back(
+            timeFunction( "cw_propagation_batch_" + rvdsim::getBatchInstructionSet( ),
+                          numberOfStates,
+                          "states",
+                          5,
+                          [ &transition, &initialStates, &thrustAccelerations, &finalStates ]( )
+        {
+            rvdsim::propagateClohessyWiltshireBatch(
+                transition, initialStates, thrustAccelerations, finalStates );
+        } ) );
+    }
+}
+
+//! Benchmark thrust policy applied to batch of commanded thrust accelerations.
+/*!
+ * @tparam        ThrustPolicy Thrust policy
+ * @param[in]     name         Name of benchmark
+ * @param[in]     problemSizes Numbers of thrust accelerations
+ * @param[in,out] results      Benchmark results
+ */
+template< typename ThrustPolicy >
+void benchmarkThrustPolicy( const std::string& name,
+                            const std::vector< std::size_t >& problemSizes,
+                            std::vector< BenchmarkResult >& results )
+{
+    const rvdsim::Real thrustAccelerationMaximum = 1.0e-3;
+
+    for ( std::size_t j = 0; j < problemSizes.size( ); ++j )
+    {
+        const std::size_t numberOfAccelerations = problemSizes[ j ];
+
+        // Commanded thrust accelerations that span the switching threshold and the maximum.
+        std::vector< rvdsim::Vector3 > commandedAccelerations( numberOfAccelerations );
+        for ( std::size_t i = 0; i < numberOfAccelerations; ++i )
+        {
+            const rvdsim::Real magnitude
+                = 2.0e-3 * static_cast< rvdsim::Real >( i ) / numberOfAccelerations;
+            const rvdsim::Vector3 acceleration
+                = { { 0.6 * magnitude, -0.8 * magnitude, 0.0 } };
+            commandedAccelerations[ i ] = acceleration;
+        }
+
+        std::vector< rvdsim::Vector3 > thrustAccelerations( numberOfAccelerations );
+        std::size_t numberOfSaturations = 0;
+        results.push_back(
+            timeFunction( "thrust_policy_" + name,
+                          numberOfAccelerations,
+                          "accelerations",
+                          5,
+                          [ &commandedAccelerations, &thrustAccelerations, &numberOfSaturations,
+                            thrustAccelerationMaximum ]( )
+        {
+            for ( std::size_t i = 0; i < commandedAccelerations.size( ); ++i )
+            {
+                thrustAccelerations[ i ] = commandedAccelerations[ i ];
+                numberOfSaturations += rvdsim::applyThrustPolicy< ThrustPolicy >(
+                    thrustAccelerationMaximum, thrustAccelerations[ i ] );
+            }
+        } ) );
+
+        // Keep results observable, such that loop cannot be optimised away.
+        if ( !( thrustAccelerations.back( )[ 0 ] == thrustAccelerations.back( )[ 0 ] ) )
+        {
+            std::cerr << "WARNING: Thrust acceleration is not finite!" << std::endl;
+        }
+    }
+}
+
+//! Benchmark thrust policies.
+void benchmarkThrustPolicies( const std::vector< std::size_t >& problemSizes,
+                              std::vector< BenchmarkResult >& results )
+{
+    benchmarkThrustPolicy< rvdsim::UnconstrainedThrustPolicy >(
+        "unconstrained", problemSizes, results );
+    benchmarkThrustPolicy< rvdsim::ThrottleThrustPolicy >( "throttle", problemSizes, results );
+    benchmarkThrustPolicy< rvdsim::OnOffThrustPolicy >( "on_off", problemSizes, results );
+}
+
+//! Benchmark fused guidance kernel, for single chasers and batches of chasers.
+void benchmarkGuidanceKernel( const std::vector< std::size_t >& problemSizes,
+                              std::vector< BenchmarkResult >& results )
+{
+    const rvdsim::Real meanMotion = 1.1e-3;
+    const rvdsim::Real timeToGo = 1000.0;
+    const rvdsim::Real thrustAccelerationMaximum = 1.0e-3;
+    const rvdsim::ClohessyWiltshireStateTransition timeToGoTransition
+        = rvdsim::computeClohessyWiltshireStateTransition( meanMotion, timeToGo );
+
+    for ( std::size_t j = 0; j < problemSizes.size( ); ++j )
+    {
+        const std::size_t numberOfChasers = problemSizes[ j ];
+
+        // Chaser states spread along-track, such that the thruster is throttled for part of them.
+        rvdsim::StateBatch states( numberOfChasers );
+        for ( std::size_t i = 0; i < numberOfChasers; ++i )
+        {
+            const rvdsim::Vector6 state
+                = { { -100.0, -10.0 * static_cast< rvdsim::Real >( i ), 10.0, 0.0, 0.1, 0.0 } };
+            states.setVector( i, state );
+        }
+
+        rvdsim::Vector3 zeroEffortMiss;
+        rvdsim::Vector3 zeroEffortVelocity;
+        rvdsim::Vector3 thrustAcceleration;
+        rvdsim::Real totalNorm = 0.0;
+        results.push_back(
+            timeFunction( "guidance_kernel_single",
+                          numberOfChasers,
+                          "chasers",
+                          5,
+                          [ &states, &timeToGoTransition, &zeroEffortMiss, &zeroEffortVelocity,
+                            &thrustAcceleration, &totalNorm, timeToGo, thrustAccelerationMaximum,
+                            numberOfChasers ]( )
+        {
+            rvdsim::Vector6 state;
+            bool isSaturated = false;
+            for ( std::size_t i = 0; i < numberOfChasers; ++i )
+            {
+                states.getVector( i, state );
+                totalNorm += rvdsim::evaluateGuidanceKernel< rvdsim::ThrottleThrustPolicy >(
+                    timeToGoTransition, timeToGo, state, thrustAccelerationMaximum,
+                    zeroEffortMiss, zeroEffortVelocity, thrustAcceleration, isSaturated );
+            }
+        } ) );
+
+        // Keep results observable, such that loop cannot be optimised away.
+        if ( !( totalNorm == totalNorm ) )
+        {
+            std::cerr << "WARNING: Thrust acceleration is not finite!" << std::endl;
+        }
+
+        const std::vector< rvdsim::ThrustPolicyType > thrustPolicies(
+            numberOfChasers, rvdsim::throttleThrustPolicy );
+        const std::vector< rvdsim::Real > thrustAccelerationMaxima(
+            numberOfChasers, thrustAccelerationMaximum );
+        rvdsim::AccelerationBatch thrustAccelerations( numberOfChasers );
+        std::vector< rvdsim::Real > thrustAccelerationNorms( numberOfChasers );
+        std::vector< unsigned char > isSaturated( numberOfChasers );
+        results.push_back(
+            timeFunction( "guidance_kernel_batch",
+                          numberOfChasers,
+                          "chasers",
+                          5,
+                          [ &timeToGoTransition, &states, &thrustPolicies,
+                            &thrustAccelerationMaxima, &thrustAccelerations,
+                            &thrustAccelerationNorms, &isSaturated, timeToGo ]( )
+        {
+            rvdsim::evaluateGuidanceKernelBatch( timeToGoTransition,
+                                                 timeToGo,
+                                                 states,
+                                                 thrustPolicies,
+                                                 thrustAccelerationMaxima,
+                                                 thrustAccelerations,
+                                                 thrustAccelerationNorms,
+                                                 isSaturated );
+        } ) );
+    }
+}
+
+//! Benchmark propagation cost per thruster pulse, for each propagator.
+void benchmarkPropagators( const std::vector< std::size_t >& problemSizes,
+                           std::vector< BenchmarkResult >& results )
+{
+    const rvdsim::Real gravitationalParameter = 3.986004418e14;
+    const rvdsim::Real semiMajorAxis = 6778.0e3;
+    const rvdsim::Vector3 thrustAcceleration = { { 1.0e-4, -2.0e-4, 5.0e-5 } };
+
+    std::vector< std::string > names;
+    std::vector< std::shared_ptr< rvdsim::Propagator > > propagators;
+    names.push_back( "propagator_clohessy_wiltshire" );
+    propagators.push_back( std::make_shared< rvdsim::ClohessyWiltshirePropagator >(
+        std::sqrt( gravitationalParameter / ( semiMajorAxis * semiMajorAxis * semiMajorAxis ) ),
+        1.0 ) );
+    names.push_back( "propagator_yamanaka_ankersen" );
+    propagators.push_back( std::make_shared< rvdsim::YamanakaAnkersenPropagator >(
+        gravitationalParameter, semiMajorAxis, 0.01, 0.0 ) );
+    names.push_back( "propagator_j2_nonlinear_rk4" );
+    propagators.push_back( std::make_shared< rvdsim::J2NonlinearPropagator >(
+        gravitationalParameter,
+        semiMajorAxis,
+        rvdsim::PropagatorSettings( rvdsim::j2NonlinearPropagator, 0.01, 0.9, 0.0,
+                                    rvdsim::rungeKutta4Integrator ) ) );
+    names.push_back( "propagator_j2_nonlinear_dormand_prince" );
+    propagators.push_back( std::make_shared< rvdsim::J2NonlinearPropagator >(
+        gravitationalParameter,
+        semiMajorAxis,
+        rvdsim::PropagatorSettings( rvdsim::j2NonlinearPropagator, 0.01, 0.9, 0.0,
+                                    rvdsim::dormandPrince45Integrator ) ) );
+
+    for ( std::size_t i = 0; i < propagators.size( ); ++i )
+    {
+        rvdsim::Propagator& propagator = *propagators[ i ];
+        for ( std::size_t j = 0; j < problemSizes.size( ); ++j )
+        {
+            const std::size_t numberOfPulses = problemSizes[ j ];
+            rvdsim::Vector6 state;
+            results.push_back(
+                timeFunction( names[ i ],
+                              numberOfPulses,
+                              "pulses",
+                              5,
+                              [ &propagator, &thrustAcceleration, &state, numberOfPulses ]( )
+            {
+                const rvdsim::Vector6 initialState = { { -100.0, -1000.0, 10.0, 0.0, 0.1, 0.0 } };
+                state = initialState;
+                propagator.reset( );
+                for ( std::size_t k = 0; k < numberOfPulses; ++k )
+                {
+                    propagator.propagate( 1.0, state, thrustAcceleration, state );
+                }
+            } ) );
+
+            // Keep propagated state observable, such that loop cannot be optimised away.
+            if ( !( state[ 0 ] == state[ 0 ] ) )
+            {
+                std::cerr << "WARNING: Propagated state is not finite!" << std::endl;
+            }
+        }
+    }
+}
+
+//! Benchmark output writing throughput, in rows per second, for each output format.
+void benchmarkOutputWriting( const std::vector< std::size_t >& problemSizes,
+                             const std::string& outputDirectory,
+                             std::vector< BenchmarkResult >& results )
+{
+    const char* columnNames[ ] = { "t", "x", "y", "z", "xdot", "ydot", "zdot" };
+    const std::vector< std::string > names( columnNames, columnNames + 7 );
+    const rvdsim::OutputFormat outputFormats[ ] = { rvdsim::csvOutput, rvdsim::binaryOutput };
+    const std::string formatNames[ ] = { "csv", "binary" };
+
+    for ( std::size_t i = 0; i < 2; ++i )
+    {
+        const std::string filePath = outputDirectory + "/benchmark_output." + formatNames[ i ];
+        const rvdsim::OutputFormat outputFormat = outputFormats[ i ];
+
+        for ( std::size_t j = 0; j < problemSizes.size( ); ++j )
+        {
+            const std::size_t numberOfRows = problemSizes[ j ];
+            results.push_back(
+                timeFunction( "output_" + formatNames[ i ],
+                              numberOfRows,
+                              "rows",
+                              5,
+                              [ &filePath, &names, outputFormat, numberOfRows ]( )
+            {
+                std::unique_ptr< rvdsim::OutputSink > sink
+                    = rvdsim::createOutputSink( outputFormat, filePath, names );
+                rvdsim::Real row[ 7 ] = { 0.0, -100.0, -1000.0, 10.0, 0.0, 0.1, 0.0 };
+                for ( std::size_t k = 0; k < numberOfRows; ++k )
+                {
+                    row[ 0 ] = static_cast< rvdsim::Real >( k );
+                    row[ 2 ] += 0.1;
+                    sink->writeRow( row );
+                }
+                sink->close( );
+            } ) );
+        }
+
+        std::remove( filePath.c_str( ) );
+    }
+}
+
+//! Benchmark JSON load time, for sweep configurations with given numbers of swept values.
+void benchmarkJsonLoad( const std::vector< std::size_t >& problemSizes,
+                        const std::string& outputDirectory,
+                        std::vector< BenchmarkResult >& results )
+{
+    const std::string filePath = outputDirectory + "/benchmark_config.json";
+
+    for ( std::size_t j = 0; j < problemSizes.size( ); ++j )
+    {
+        // Write configuration file with swept thrust maximum values and a comment per value.
+        {
+            std::ofstream configFile( filePath.c_str( ) );
+            configFile << "{\n"
+                       << "    \"propagation_settings\" : [0.0, 1000.0],\n"
+                       << "    \"earth_gravitational_parameter\" : 3.986004418e14,\n"
+                       << "    \"target_semi_major_axis\" : 6778.0e3,\n"
+                       << "    \"chaser_initial_state\" : [-100.0, -1000.0, 10.0, 0.0, 0.1, 0.0],\n"
+                       << "    \"chaser_thrust_settings\" : [\"throttle\", 0.5, 1.0],\n"
+                       << "    \"chaser_wet_mass\" : 100.0,\n"
+                       << "    \"arrival_distance_tolerance\" : 1.0,\n"
+                       << "    \"sweep\" :\n"
+                       << "    {\n"
+                       << "        \"thrust_maximum\" :\n"
+                       << "        [\n";
+            for ( std::size_t i = 0; i < problemSizes[ j ]; ++i )
+            {
+                configFile << "            // Swept value " << i << "\n"
+                           << "            " << 0.01 * ( i + 1 )
+                           << ( i + 1 < problemSizes[ j ] ? ",\n" : "\n" );
+            }
+            configFile << "        ],\n"
+                       << "        \"results_filename\" : \"sweep_results.csv\"\n"
+                       << "    },\n"
+                       << "    \"output_directory\" : \".\",\n"
+                       << "    \"chaser_state_history_filename\" : \"state.csv\",\n"
+                       << "    \"chaser_thrust_history_filename\" : \"thrust.csv\"\n"
+                       << "}\n";
+        }
+
+        // Load configuration the same way as the main application, discarding console output.
+        results.push_back(
+            timeFunction( "json_load",
+                          problemSizes[ j ],
+                          "sweep_values",
+                          5,
+                          [ &filePath ]( )
+        {
+            std::ostringstream discardedOutput;
+            std::streambuf* consoleBuffer = std::cout.rdbuf( discardedOutput.rdbuf( ) );
+
+            const rvdsim::ConfigCollection configs = rvdsim::loadConfigs( filePath );
+            const rapidjson::Document& config = configs.getDocument( 0 );
+            const rvdsim::UserInput input = rvdsim::checkInput( config );
+            rvdsim::checkSweepInput( config, input );
+
+            std::cout.rdbuf( consoleBuffer );
+        } ) );
+    }
+
+    std::remove( filePath.c_str( ) );
+}
+
+//! Write benchmark results as JSON.
+/*!
+ * Writes benchmark results as a JSON document, such that results of different builds can be
+ * compared using python/compare_benchmarks.py.
+ *
+ * @param[in] stream  Output stream
+ * @param[in] results Benchmark results
+ */
+void writeBenchmarkResults( std::ostream& stream, const std::vector< BenchmarkResult >& results )
+{
+    stream.precision( 9 );
+    stream << "{" << std::endl;
+    stream << "  \"batch_instruction_set\": \"" << rvdsim::getBatchInstructionSet( ) << "\","
+           << std::endl;
+    stream << "  \"benchmarks\": [" << std::endl;
+    for ( std::size_t i = 0; i < results.size( ); ++i )
+    {
+        const BenchmarkResult& result = results[ i ];
+        stream << "    { \"name\": \"" << result.name << "\""
+               << ", \"problem_size\": " << result.problemSize
+               << ", \"unit\": \"" << result.unit << "\""
+               << ", \"repetitions\": " << result.numberOfRepetitions
+               << ", \"minimum_time\": " << result.minimumTime
+               << ", \"median_time\": " << result.medianTime
+               << ", \"throughput\": " << result.problemSize / result.medianTime << " }"
+               << ( i + 1 < results.size( ) ? "," : "" ) << std::endl;
+    }
+    stream << "  ]" << std::endl;
+    stream << "}" << std::endl;
+}
+
+} // namespace
+
+//! Execute benchmark suite.
+/*!
+ * Executes benchmark suite and writes results as JSON to the file given as first argument, or to
+ * standard output if no argument is given. Progress is written to standard error. The optional
+ * "--quick" argument reduces the problem sizes, e.g., for smoke tests.
+ */
+int main( const int numberOfInputs, const char* inputArguments[ ] )
+{
+    std::string resultsPath;
+    bool isQuick = false;
+    for ( int i = 1; i < numberOfInputs; ++i )
+    {
+        const std::string argument = inputArguments[ i ];
+        if ( argument == "--quick" )
+        {
+            isQuick = true;
+        }
+        else
+        {
+            resultsPath = argument;
+        }
+    }
+
+    std::vector< std::size_t > stepSizes;
+    stepSizes.push_back( 1000 );
+    stepSizes.push_back( 10000 );
+    std::vector< std::size_t > chaserSizes;
+    chaserSizes.push_back( 10 );
+    chaserSizes.push_back( 1000 );
+    std::vector< std::size_t > stateSizes;
+    stateSizes.push_back( 64 );
+    stateSizes.push_back( 4096 );
+    std::vector< std::size_t > rowSizes;
+    rowSizes.push_back( 10000 );
+    std::vector< std::size_t > sweepSizes;
+    sweepSizes.push_back( 10 );
+    sweepSizes.push_back( 1000 );
+    if ( !isQuick )
+    {
+        stepSizes.push_back( 100000 );
+        chaserSizes.push_back( 10000 );
+        stateSizes.push_back( 262144 );
+        rowSizes.push_back( 1000000 );
+        sweepSizes.push_back( 100000 );
+    }
+
+    std::vector< BenchmarkResult > results;
+    benchmarkGuidanceLoop( stepSizes, results );
+    benchmarkMultiChaserLoop( chaserSizes, results );
+    benchmarkClohessyWiltshirePropagation( stateSizes, results );
+    benchmarkThrustPolicies( stateSizes, results );
+    benchmarkGuidanceKernel( stateSizes, results );
+    benchmarkPropagators( stepSizes, results );
+    benchmarkOutputWriting( rowSizes, ".", results );
+    benchmarkJsonLoad( sweepSizes, ".", results );
+
+    if ( resultsPath.empty( ) )
+    {
+        writeBenchmarkResults( std::cout, results );
+    }
+    else
+    {
+        std::ofstream resultsFile( resultsPath.c_str( ) );
+        writeBenchmarkResults( resultsFile, results );
+    }
+
+    return EXIT_SUCCESS;
+}
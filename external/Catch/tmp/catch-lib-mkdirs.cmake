@@ -0,0 +1,22 @@
+# Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+# file Copyright.txt or https://cmake.org/licensing for details.
+
+cmake_minimum_required(VERSION 3.5)
+
+file(MAKE_DIRECTORY
+  "/root/repo/external/Catch/src/catch-lib"
+  "/root/repo/external/Catch/src/catch-lib-build"
+  "/root/repo/external/Catch"
+  "/root/repo/external/Catch/tmp"
+  "/root/repo/external/Catch/src/catch-lib-stamp"
+  "/root/repo/external/Catch/src"
+  "/root/repo/external/Catch/src/catch-lib-stamp"
+)
+
+set(configSubDirs )
+foreach(subDir IN LISTS configSubDirs)
+    file(MAKE_DIRECTORY "/root/repo/external/Catch/src/catch-lib-stamp/${subDir}")
+endforeach()
+if(cfgdir)
+  file(MAKE_DIRECTORY "/root/repo/external/Catch/src/catch-lib-stamp${cfgdir}") # cfgdir has leading slash
+endif()
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef RVDSIM_BATCH_RUNNER_HPP
+#define RVDSIM_BATCH_RUNNER_HPP
+
+#include <cstddef>
+#include <istream>
+#include <string>
+#include <vector>
+
+#include "rvdsim/outputSink.hpp"
+
+namespace rvdsim
+{
+
+//! Batch settings.
+/*!
+ * Settings for the execution of a batch of scenarios.
+ */
+struct BatchSettings
+{
+public:
+
+    //! Construct batch settings.
+    /*!
+     * @param[in] aNumberOfThreads     Number of threads used to execute scenarios (default: 0,
+     *                                 i.e., number of hardware threads)
+     * @param[in] aMaximumNumberOfScenariosInMemory
+     *                                 Maximum number of scenarios that are held in memory at the
+     *                                 same time (default: 1024)
+     */
+    BatchSettings( const std::size_t aNumberOfThreads = 0,
+                   const std::size_t aMaximumNumberOfScenariosInMemory = 1024 )
+        : numberOfThreads( aNumberOfThreads ),
+          maximumNumberOfScenariosInMemory( aMaximumNumberOfScenariosInMemory )
+    { }
+
+    //! Number of threads used to execute scenarios (0: number of hardware threads).
+    const std::size_t numberOfThreads;
+
+    //! Maximum number of scenarios that are held in memory at the same time.
+    const std::size_t maximumNumberOfScenariosInMemory;
+
+protected:
+private:
+};
+
+//! Get column names of batch results.
+/*!
+ * Returns the column names of the batch results: the scenario index, followed by the simulation
+ * summary (final distance, target reached, total delta-V, thruster throttled to maximum,
+ * saturation time, termination time, propellant mass).
+ *
+ * @return Column names of batch results
+ */
+std::vector< std::string > getBatchResultColumnNames( );
+
+//! Execute batch of scenarios.
+/*!
+ * Executes all scenarios in a JSON-lines manifest, in which each line contains the user input of a
+ * single scenario, with the same keys as the JSON input file of the main application. Empty lines
+ * and lines starting with "//" are skipped. The scenarios are executed as single simulations
+ * without storing or writing histories, and the summary of each scenario is written to the result
+ * sink, with the index of the scenario in the manifest in the first column.
+ *
+ * The manifest is read in chunks of at most the maximum number of scenarios in memory, which are
+ * executed in parallel using a thread pool, such that memory use is bounded irrespective of the
+ * size of the manifest. The results are written in the order of the manifest. The scenarios in a
+ * chunk are parsed and checked before any of them is executed. If a scenario cannot be parsed
+ * (std::runtime_error) or its input is invalid (std::invalid_argument), an error is thrown with the
+ * line number in the manifest; results of the preceding chunks have then been written already.
+ *
+ * @sa BatchSettings, getBatchResultColumnNames
+ * @param[in]  manifest     Stream containing JSON-lines manifest
+ * @param[in]  manifestName Name of manifest, used to report errors
+ * @param[in]  settings     Batch settings
+ * @param[out] resultSink   Sink to which results are written
+ * @return                  Number of scenarios executed
+ */
+std::size_t executeBatch( std::istream&        manifest,
+                          const std::string&   manifestName,
+                          const BatchSettings& settings,
+                          OutputSink&          resultSink );
+
+} // namespace rvdsim
+
+#endif // RVDSIM_BATCH_RUNNER_HPP
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef RVDSIM_BINARY_ENCODING_HPP
+#define RVDSIM_BINARY_ENCODING_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace rvdsim
+{
+
+//! Append unsigned integer to buffer in little-endian byte order.
+/*!
+ * @param[in]     value         Unsigned integer
+ * @param[in]     numberOfBytes Number of bytes to append
+ * @param[in,out] buffer        Buffer
+ */
+void appendLittleEndian( const std::uint64_t value,
+                         const std::size_t numberOfBytes,
+                         std::vector< char >& buffer );
+
+//! Append double to buffer as little-endian IEEE-754 double.
+/*!
+ * @param[in]     value  Value
+ * @param[in,out] buffer Buffer
+ */
+void appendLittleEndian( const double value, std::vector< char >& buffer );
+
+//! Reader of little-endian values from binary file contents.
+/*!
+ * Reads values written with appendLittleEndian( ) in sequence. If the contents end before a value
+ * is complete, or if values remain once all are expected to be read, an error is thrown
+ * (std::runtime_error) stating that the file is truncated or corrupt.
+ */
+class LittleEndianReader
+{
+public:
+
+    //! Construct reader.
+    /*!
+     * @param[in] someContents     Contents of binary file
+     * @param[in] aFileDescription Description of file, used in error messages (e.g.,
+     *                             "Checkpoint file")
+     * @param[in] aFilePath        Path to binary file, used in error messages
+     */
+    LittleEndianReader( const std::vector< char >& someContents,
+                        const std::string& aFileDescription,
+                        const std::string& aFilePath )
+        : contents( someContents ),
+          fileDescription( aFileDescription ),
+          filePath( aFilePath ),
+          position( 0 )
+    { }
+
+    //! Read unsigned integer stored with given number of bytes.
+    std::uint64_t readUnsignedInteger( const std::size_t numberOfBytes );
+
+    //! Read double.
+    double readDouble( );
+
+    //! Read flag.
+    bool readFlag( ) { return readUnsignedInteger( 1 ) != 0; }
+
+    //! Check that all contents have been read.
+    void checkEnd( ) const;
+
+protected:
+private:
+
+    //! Check that given number of bytes remains to be read.
+    void checkRemainingSize( const std::size_t numberOfBytes ) const;
+
+    //! Report invalid file.
+    void reportInvalidFile( ) const;
+
+    //! Contents of binary file.
+    const std::vector< char >& contents;
+
+    //! Description of file.
+    const std::string fileDescription;
+
+    //! Path to binary file.
+    const std::string filePath;
+
+    //! Position of next value to be read [bytes].
+    std::size_t position;
+};
+
+} // namespace rvdsim
+
+#endif // RVDSIM_BINARY_ENCODING_HPP
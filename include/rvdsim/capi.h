@@ -0,0 +1,277 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef RVDSIM_CAPI_H
+#define RVDSIM_CAPI_H
+
+/*!
+ * C API of the simulation engine.
+ *
+ * The C API allows the simulator to be embedded in other applications and called in-process from
+ * other languages (e.g., through the ctypes bindings in python/rvdsim_api.py), without writing
+ * configuration files or reading output files. Settings and initial states are passed as plain
+ * structs and arrays of doubles; the state and thrust histories are exposed as pointers to the
+ * contiguous columns stored by the simulator, such that they can be accessed without copying.
+ *
+ * All functions report errors through a status code instead of exceptions, and validate their
+ * arguments before they are passed to the simulator. The API is stable across releases with the
+ * same API version (see rvdsimGetApiVersion): new fields are only appended to the settings struct,
+ * which should always be initialised using rvdsimInitialiseSettings.
+ *
+ * A simulator handle must not be used concurrently from multiple threads; different handles can
+ * be used concurrently.
+ */
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//! Version of C API, incremented when the API changes in a backwards-incompatible way.
+#define RVDSIM_API_VERSION 1
+
+//! Status codes returned by C API.
+typedef enum
+{
+    RVDSIM_SUCCESS = 0,
+    RVDSIM_ERROR_NULL_POINTER = 1,
+    RVDSIM_ERROR_INVALID_SETTINGS = 2,
+    RVDSIM_ERROR_INVALID_ARGUMENT = 3,
+    RVDSIM_ERROR_OUT_OF_MEMORY = 4,
+    RVDSIM_ERROR_INTERNAL = 5
+} RvdsimStatus;
+
+//! Thrust modes (see rvdsim::ThrustMode).
+typedef enum
+{
+    RVDSIM_THRUST_OFF = 0,
+    RVDSIM_THRUST_THROTTLE = 1,
+    RVDSIM_THRUST_ON_OFF = 2
+} RvdsimThrustMode;
+
+//! Relative dynamics models (see rvdsim::PropagatorType).
+typedef enum
+{
+    RVDSIM_PROPAGATOR_CLOHESSY_WILTSHIRE = 0,
+    RVDSIM_PROPAGATOR_YAMANAKA_ANKERSEN = 1,
+    RVDSIM_PROPAGATOR_J2_NONLINEAR = 2
+} RvdsimPropagator;
+
+//! Simulation settings (see rvdsim::UserInput).
+typedef struct
+{
+    //! Simulation start time [s].
+    double startTime;
+
+    //! Simulation end time [s].
+    double endTime;
+
+    //! Earth gravitational parameter [m^3 s^-2].
+    double earthGravitationalParameter;
+
+    //! Target semi-major axis [m]; for the J2-perturbed model, the perigee of the target orbit
+    //! should lie above the Earth's equatorial radius.
+    double targetSemiMajorAxis;
+
+    //! Thrust mode (RvdsimThrustMode).
+    int thrustMode;
+
+    //! Maximum thrust [N]; zero if thrust is unconstrained in throttle mode.
+    double thrustMaximum;
+
+    //! Thruster pulse frequency [Hz].
+    double thrustFrequency;
+
+    //! Chaser wet mass [kg].
+    double chaserWetMass;
+
+    //! Chaser specific impulse [s]; zero if chaser mass is constant.
+    double chaserSpecificImpulse;
+
+    //! Arrival distance tolerance [m].
+    double arrivalDistanceTolerance;
+
+    //! Relative dynamics model (RvdsimPropagator).
+    int propagator;
+
+    //! Target eccentricity [-].
+    double targetEccentricity;
+
+    //! Target inclination [rad].
+    double targetInclination;
+
+    //! Target true anomaly at start time [rad].
+    double targetInitialTrueAnomaly;
+
+    //! Flag indicating if state and thrust histories are stored (non-zero) or not (zero).
+    int isHistoryStored;
+} RvdsimSettings;
+
+//! Summary of simulation (see rvdsim::SimulationSummary).
+typedef struct
+{
+    //! Final distance between chaser and target [m].
+    double finalDistanceToTarget;
+
+    //! Total delta-V applied by thruster [m/s].
+    double totalDeltaV;
+
+    //! Total propellant mass consumed by thruster [kg].
+    double propellantMass;
+
+    //! Total time during which thruster was throttled to its maximum [s].
+    double throttleSaturationTime;
+
+    //! Epoch at which simulation ended [s].
+    double terminationTime;
+
+    //! Flag indicating if final distance is within arrival distance tolerance.
+    int isTargetReached;
+
+    //! Flag indicating if thruster was throttled to its maximum.
+    int isThrottleMax;
+
+    //! Flag indicating if simulation was terminated before end time.
+    int isTerminatedEarly;
+} RvdsimSummary;
+
+//! Opaque handle of simulator.
+typedef struct RvdsimSimulator RvdsimSimulator;
+
+//! Get version of C API.
+/*!
+ * @return Version of C API (RVDSIM_API_VERSION of the library)
+ */
+int rvdsimGetApiVersion( void );
+
+//! Get description of status code.
+/*!
+ * @param[in] status Status code
+ * @return           Null-terminated description of status code
+ */
+const char* rvdsimGetStatusMessage( int status );
+
+//! Initialise simulation settings.
+/*!
+ * Initialises settings to representative values, which can then be modified field by field: a
+ * target in a circular orbit with a semi-major axis of 7000 km around the Earth, a 100 kg chaser
+ * of constant mass with a throttled 1 N thruster at 1 Hz, an arrival distance tolerance of 1 m and
+ * the Clohessy-Wiltshire propagator, simulated for 1000 s with histories stored.
+ *
+ * @param[out] settings Settings to initialise
+ * @return              Status code
+ */
+int rvdsimInitialiseSettings( RvdsimSettings* settings );
+
+//! Create simulator.
+/*!
+ * Creates simulator for given settings, pre-computing all quantities that remain constant
+ * throughout the simulation, such that the simulator can be executed many times from different
+ * initial states. Settings are checked using the same rules as for JSON input (see
+ * rvdsim::checkUserInput); invalid settings are reported as RVDSIM_ERROR_INVALID_SETTINGS.
+ *
+ * @param[in]  settings  Simulation settings
+ * @param[out] simulator Handle of created simulator; must be destroyed using
+ *                       rvdsimDestroySimulator
+ * @return               Status code
+ */
+int rvdsimCreateSimulator( const RvdsimSettings* settings, RvdsimSimulator** simulator );
+
+//! Destroy simulator.
+/*!
+ * @param[in] simulator Handle of simulator to destroy (null pointer is ignored)
+ */
+void rvdsimDestroySimulator( RvdsimSimulator* simulator );
+
+//! Execute simulation.
+/*!
+ * Executes simulation from given chaser initial state. Histories and summary from previous
+ * executions are replaced, such that pointers to history columns are invalidated.
+ *
+ * @param[in] simulator          Handle of simulator
+ * @param[in] chaserInitialState Chaser initial state (x, y, z, xdot, ydot, zdot) [m; m/s]
+ * @return                       Status code
+ */
+int rvdsimExecuteSimulation( RvdsimSimulator* simulator, const double chaserInitialState[ 6 ] );
+
+//! Get summary of last simulation executed.
+/*!
+ * @param[in]  simulator Handle of simulator
+ * @param[out] summary   Summary of simulation
+ * @return               Status code
+ */
+int rvdsimGetSummary( const RvdsimSimulator* simulator, RvdsimSummary* summary );
+
+//! Get number of entries in chaser state history.
+/*!
+ * @param[in] simulator Handle of simulator
+ * @return              Number of entries; zero if histories are not stored
+ */
+size_t rvdsimGetNumberOfStates( const RvdsimSimulator* simulator );
+
+//! Get column of chaser state history.
+/*!
+ * Gets pointer to contiguous column of chaser state history, with columns (t, x, y, z, xdot,
+ * ydot, zdot). The pointer remains valid until the simulator is executed again or destroyed.
+ *
+ * @param[in] simulator   Handle of simulator
+ * @param[in] columnIndex Index of column (0 for epochs, 1-6 for state components)
+ * @return                Pointer to column; null pointer if column index is invalid or history is
+ *                        empty
+ */
+const double* rvdsimGetStateHistoryColumn( const RvdsimSimulator* simulator,
+                                           const size_t columnIndex );
+
+//! Get number of entries in chaser thrust history.
+/*!
+ * @param[in] simulator Handle of simulator
+ * @return              Number of entries; zero if histories are not stored
+ */
+size_t rvdsimGetNumberOfThrusts( const RvdsimSimulator* simulator );
+
+//! Get column of chaser thrust history.
+/*!
+ * Gets pointer to contiguous column of chaser thrust history, with columns (t, Tx, Ty, Tz). The
+ * pointer remains valid until the simulator is executed again or destroyed.
+ *
+ * @param[in] simulator   Handle of simulator
+ * @param[in] columnIndex Index of column (0 for epochs, 1-3 for thrust components)
+ * @return                Pointer to column; null pointer if column index is invalid or history is
+ *                        empty
+ */
+const double* rvdsimGetThrustHistoryColumn( const RvdsimSimulator* simulator,
+                                            const size_t columnIndex );
+
+//! Execute batch of simulations.
+/*!
+ * Executes simulations with the same settings from a batch of chaser initial states on a thread
+ * pool and writes the summary of each simulation. Histories are not stored, irrespective of the
+ * settings. Simulations are distributed over the threads in chunks, and each chunk reuses a single
+ * simulator. The summaries are identical to executing the simulations one by one.
+ *
+ * @param[in]  settings             Simulation settings
+ * @param[in]  numberOfSimulations  Number of simulations
+ * @param[in]  chaserInitialStates  Chaser initial states, stored row-major as
+ *                                  numberOfSimulations x 6 array [m; m/s]
+ * @param[out] summaries            Summaries of simulations (numberOfSimulations entries)
+ * @param[in]  numberOfThreads      Number of threads (0 sets the number of threads equal to the
+ *                                  number of hardware threads available; 1 executes simulations
+ *                                  on calling thread)
+ * @return                          Status code
+ */
+int rvdsimExecuteBatch( const RvdsimSettings* settings,
+                        const size_t numberOfSimulations,
+                        const double* chaserInitialStates,
+                        RvdsimSummary* summaries,
+                        const size_t numberOfThreads );
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // RVDSIM_CAPI_H
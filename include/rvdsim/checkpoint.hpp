@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef RVDSIM_CHECKPOINT_HPP
+#define RVDSIM_CHECKPOINT_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "rvdsim/outputSampler.hpp"
+#include "rvdsim/outputSink.hpp"
+#include "rvdsim/typedefs.hpp"
+#include "rvdsim/userInput.hpp"
+
+namespace rvdsim
+{
+
+//! Simulator checkpoint.
+/*!
+ * Complete state of a simulation in between two thruster pulses, from which the simulation can be
+ * resumed such that it continues bit-for-bit identically to an uninterrupted simulation. Besides
+ * the state of the chaser and the accumulated totals, the checkpoint contains the internal states
+ * of the propagator and the output sampler, and the positions of the output sinks, such that rows
+ * written after the checkpoint are discarded when the output files are resumed. The simulation
+ * settings are not part of the checkpoint: a simulation must be resumed with the same user input;
+ * the settings that determine the trajectory (start time, end time, thruster pulse length, thrust
+ * mode and maximum, chaser wet mass, target semi-major axis and propagator) are stored to detect
+ * mismatches.
+ *
+ * @sa Simulator::resume, writeCheckpoint, readCheckpoint
+ */
+struct SimulatorCheckpoint
+{
+public:
+
+    //! Simulation start time [s].
+    Real startTime;
+
+    //! Simulation end time [s].
+    Real endTime;
+
+    //! Length of thruster pulse [s].
+    Real thrustPulseTime;
+
+    //! Thrust mode.
+    ThrustMode thrustMode;
+
+    //! Maximum thrust [N].
+    Real thrustMaximum;
+
+    //! Chaser wet mass [kg].
+    Real chaserWetMass;
+
+    //! Target semi-major axis [m].
+    Real targetSemiMajorAxis;
+
+    //! Type of propagator.
+    PropagatorType propagatorType;
+
+    //! Index of next thruster pulse.
+    std::uint64_t stepIndex;
+
+    //! Current epoch [s] (informational, since epoch is derived from step index on resume).
+    Real currentTime;
+
+    //! Current Time-To-Go (TTG) [s] (informational, since TTG is derived from step index).
+    Real timeToGo;
+
+    //! Current chaser state [m; m/s].
+    Vector6 currentState;
+
+    //! Current chaser mass [kg].
+    Real chaserMass;
+
+    //! Flag indicating if thruster was throttled to its maximum.
+    bool isThrottleMax;
+
+    //! Total delta-V applied by thruster [m/s].
+    Real totalDeltaV;
+
+    //! Total propellant mass consumed by thruster [kg].
+    Real propellantMass;
+
+    //! Total time during which thruster was throttled to its maximum [s].
+    Real throttleSaturationTime;
+
+    //! State of output sampler.
+    OutputSamplerState outputSamplerState;
+
+    //! Internal state of propagator.
+    std::vector< Real > propagatorState;
+
+    //! Position of state output sink (zero if not used).
+    OutputSinkPosition stateSinkPosition;
+
+    //! Position of thrust output sink (zero if not used).
+    OutputSinkPosition thrustSinkPosition;
+
+    //! Position of trajectory output sink (zero if not used).
+    OutputSinkPosition trajectorySinkPosition;
+
+protected:
+private:
+};
+
+//! Write checkpoint to file.
+/*!
+ * Writes checkpoint to a binary file, with all values stored in little-endian byte order, after a
+ * magic number (checkpointMagic) and the file format version. The checkpoint is first written to
+ * a temporary file, which then replaces the given file, such that an existing checkpoint is not
+ * lost if the application is interrupted while writing. An error is thrown (std::runtime_error) if
+ * the checkpoint cannot be written.
+ *
+ * @param[in] filePath   Path to checkpoint file
+ * @param[in] checkpoint Simulator checkpoint
+ */
+void writeCheckpoint( const std::string& filePath, const SimulatorCheckpoint& checkpoint );
+
+//! Read checkpoint from file.
+/*!
+ * Reads checkpoint written by writeCheckpoint. An error is thrown (std::runtime_error) if the file
+ * cannot be read or is not a valid checkpoint file.
+ *
+ * @param[in] filePath Path to checkpoint file
+ * @return             Simulator checkpoint
+ */
+SimulatorCheckpoint readCheckpoint( const std::string& filePath );
+
+//! Check if checkpoint file exists.
+/*!
+ * @param[in] filePath Path to checkpoint file
+ * @return             True if checkpoint file exists and can be opened
+ */
+bool isCheckpointAvailable( const std::string& filePath );
+
+//! Magic number at start of checkpoint files.
+const char checkpointMagic[ ] = "RVDSIMC1";
+
+//! Version of checkpoint file format.
+const std::uint32_t checkpointVersion = 3;
+
+} // namespace rvdsim
+
+#endif // RVDSIM_CHECKPOINT_HPP
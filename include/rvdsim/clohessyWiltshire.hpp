@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef RVDSIM_CLOHESSY_WILTSHIRE_HPP
+#define RVDSIM_CLOHESSY_WILTSHIRE_HPP
+
+#include <cstddef>
+#include <string>
+
+#include "rvdsim/timeGrid.hpp"
+#include "rvdsim/typedefs.hpp"
+
+namespace rvdsim
+{
+
+//! Clohessy-Wiltshire state transition.
+/*!
+ * Linear map that propagates a relative state over a fixed propagation time under a constant
+ * acceleration, according to the closed-form Clohessy-Wiltshire solution for a circular target
+ * orbit:
+ *
+ *  x(t) = stateTransitionMatrix * x(0) + inputMatrix * a
+ *
+ * The state is expressed in the Hill frame, with x radial, y along-track and z cross-track (see
+ * Fehse (2003)). Since the transition only depends on the mean motion and the propagation time,
+ * it can be computed once and applied to any number of states.
+ */
+struct ClohessyWiltshireStateTransition
+{
+public:
+
+    //! State transition matrix [-, s; s^-1, -].
+    Matrix66 stateTransitionMatrix;
+
+    //! Input matrix for constant acceleration [s^2; s].
+    Matrix63 inputMatrix;
+
+protected:
+private:
+};
+
+//! Compute Clohessy-Wiltshire state transition.
+/*!
+ * Computes state transition and input matrices of the closed-form Clohessy-Wiltshire solution for
+ * given mean motion and propagation time. The trigonometric terms are evaluated once and shared by
+ * all matrix entries.
+ *
+ * @sa ClohessyWiltshireStateTransition
+ * @param[in] meanMotion      Mean motion of target's orbit [rad/s]
+ * @param[in] propagationTime Propagation time [s]
+ * @return                    Clohessy-Wiltshire state transition
+ */
+ClohessyWiltshireStateTransition computeClohessyWiltshireStateTransition(
+    const Real meanMotion, const Real propagationTime );
+
+//! Get Clohessy-Wiltshire state transition from cache.
+/*!
+ * Returns Clohessy-Wiltshire state transition for given mean motion and propagation time from a
+ * small, process-wide cache, which is shared by all simulations (e.g., repeated runs or Monte Carlo
+ * samples with the same target orbit and thrust frequency). If the transition is not yet present
+ * in the cache, it is computed using computeClohessyWiltshireStateTransition( ) and added to the
+ * cache, replacing the oldest entry if the cache is full. This function is thread-safe.
+ *
+ * @sa computeClohessyWiltshireStateTransition
+ * @param[in] meanMotion      Mean motion of target's orbit [rad/s]
+ * @param[in] propagationTime Propagation time [s]
+ * @return                    Clohessy-Wiltshire state transition
+ */
+ClohessyWiltshireStateTransition getClohessyWiltshireStateTransition(
+    const Real meanMotion, const Real propagationTime );
+
+//! Clohessy-Wiltshire state transition over Time-To-Go, updated incrementally.
+/*!
+ * Maintains the Clohessy-Wiltshire state transition over the Time-To-Go (TTG) at the thruster
+ * pulses of a time grid, as used to predict the ballistic trajectory in the guidance law. Since the
+ * TTG decreases by one pulse length from one pulse to the next, the sine and cosine of half the
+ * TTG angle n t are updated using the angle-subtraction formulas with the fixed sine and cosine of
+ * half the pulse angle, such that no trigonometric functions are evaluated for each pulse. The
+ * terms sin( n t ), cos( n t ) and 1 - cos( n t ) of the transition follow from the half-angle
+ * terms without cancellation, while the terms that are linear in n t are computed from the TTG.
+ *
+ * The rounding errors of the updates accumulate linearly with the number of updates. To bound the
+ * error, the half-angle terms are re-synchronised with their direct computation at every pulse
+ * whose index is a multiple of the synchronisation interval, which is derived from the tolerance
+ * on the absolute error of the trigonometric terms (excluding the rounding error of the angle n t
+ * itself, of the order of n t times the machine epsilon, which equally affects the direct
+ * computation). Since the synchronisation pulses are fixed, the transition at a pulse is a function
+ * of the index of the pulse only, irrespective of the order in which pulses are requested: if the
+ * pulse does not follow the previous pulse (e.g., after a coast arc is skipped or a simulation is
+ * resumed), the terms are re-synchronised at the last synchronisation pulse and updated up to the
+ * requested pulse.
+ *
+ * @sa computeClohessyWiltshireStateTransition, TimeGrid, PropagatorSettings
+ */
+class ClohessyWiltshireTimeToGoTransition
+{
+public:
+
+    //! Construct Clohessy-Wiltshire state transition over Time-To-Go.
+    /*!
+     * @param[in] aMeanMotion Mean motion of target's orbit [rad/s]
+     * @param[in] aTimeGrid   Time grid of thruster pulses
+     * @param[in] aTolerance  Tolerance on absolute error of trigonometric terms with respect to
+     *                        direct computation [-]; if zero, the half-angle terms are computed
+     *                        directly for each pulse
+     */
+    ClohessyWiltshireTimeToGoTransition( const Real aMeanMotion,
+                                         const TimeGrid& aTimeGrid,
+                                         const Real aTolerance );
+
+    //! Update state transition to thruster pulse.
+    /*!
+     * @param[in] stepIndex Index of thruster pulse
+     * @return              Clohessy-Wiltshire state transition over Time-To-Go at thruster pulse,
+     *                      which remains valid until the next update
+     */
+    const ClohessyWiltshireStateTransition& update( const std::size_t stepIndex );
+
+    //! Get synchronisation interval.
+    /*!
+     * @return Number of thruster pulses between synchronisations with direct computation
+     */
+    std::size_t getSynchronisationInterval( ) const { return synchronisationInterval; }
+
+protected:
+private:
+
+    //! Mean motion of target's orbit [rad/s].
+    const Real meanMotion;
+
+    //! Time grid of thruster pulses.
+    const TimeGrid timeGrid;
+
+    //! Number of thruster pulses between synchronisations with direct computation.
+    const std::size_t synchronisationInterval;
+
+    //! Sine of half the angle swept by the target during a thruster pulse [-].
+    const Real pulseHalfAngleSine;
+
+    //! Cosine of half the angle swept by the target during a thruster pulse [-].
+    const Real pulseHalfAngleCosine;
+
+    //! Flag indicating if half-angle terms have been computed for any thruster pulse.
+    bool isInitialised;
+
+    //! Index of thruster pulse of current half-angle terms.
+    std::size_t currentStepIndex;
+
+    //! Sine of half the angle swept by the target during the Time-To-Go [-].
+    Real halfAngleSine;
+
+    //! Cosine of half the angle swept by the target during the Time-To-Go [-].
+    Real halfAngleCosine;
+
+    //! State transition over Time-To-Go at current thruster pulse.
+    ClohessyWiltshireStateTransition transition;
+};
+
+//! Propagate state using Clohessy-Wiltshire state transition.
+/*!
+ * Propagates state under constant acceleration using a pre-computed Clohessy-Wiltshire state
+ * transition. Only the entries that are non-zero for the Clohessy-Wiltshire solution are used,
+ * such that the in-plane and out-of-plane motion are propagated separately. The final state may
+ * refer to the same object as the initial state.
+ *
+ * @param[in]  transition   Clohessy-Wiltshire state transition
+ * @param[in]  initialState Initial state [m; m/s]
+ * @param[in]  acceleration Constant acceleration [m/s^2]
+ * @param[out] finalState   Final state [m; m/s]
+ */
+inline void propagateClohessyWiltshire( const ClohessyWiltshireStateTransition& transition,
+                                        const Vector6& initialState,
+                                        const Vector3& acceleration,
+                                        Vector6& finalState )
+{
+    const Matrix66& phi = transition.stateTransitionMatrix;
+    const Matrix63& gamma = transition.inputMatrix;
+
+    const Real x = initialState[ 0 ];
+    const Real y = initialState[ 1 ];
+    const Real z = initialState[ 2 ];
+    const Real xDot = initialState[ 3 ];
+    const Real yDot = initialState[ 4 ];
+    const Real zDot = initialState[ 5 ];
+
+    finalState[ 0 ] = phi[ 0 ][ 0 ] * x + phi[ 0 ][ 3 ] * xDot + phi[ 0 ][ 4 ] * yDot
+                      + gamma[ 0 ][ 0 ] * acceleration[ 0 ] + gamma[ 0 ][ 1 ] * acceleration[ 1 ];
+    finalState[ 1 ] = phi[ 1 ][ 0 ] * x + y + phi[ 1 ][ 3 ] * xDot + phi[ 1 ][ 4 ] * yDot
+                      + gamma[ 1 ][ 0 ] * acceleration[ 0 ] + gamma[ 1 ][ 1 ] * acceleration[ 1 ];
+    finalState[ 2 ] = phi[ 2 ][ 2 ] * z + phi[ 2 ][ 5 ] * zDot
+                      + gamma[ 2 ][ 2 ] * acceleration[ 2 ];
+    finalState[ 3 ] = phi[ 3 ][ 0 ] * x + phi[ 3 ][ 3 ] * xDot + phi[ 3 ][ 4 ] * yDot
+                      + gamma[ 3 ][ 0 ] * acceleration[ 0 ] + gamma[ 3 ][ 1 ] * acceleration[ 1 ];
+    finalState[ 4 ] = phi[ 4 ][ 0 ] * x + phi[ 4 ][ 3 ] * xDot + phi[ 4 ][ 4 ] * yDot
+                      + gamma[ 4 ][ 0 ] * acceleration[ 0 ] + gamma[ 4 ][ 1 ] * acceleration[ 1 ];
+    finalState[ 5 ] = phi[ 5 ][ 2 ] * z + phi[ 5 ][ 5 ] * zDot
+                      + gamma[ 5 ][ 2 ] * acceleration[ 2 ];
+}
+
+//! Propagate batch of states using Clohessy-Wiltshire state transition.
+/*!
+ * Propagates a batch of states, each under its own constant acceleration, using a pre-computed
+ * Clohessy-Wiltshire state transition that is shared by all states in the batch (common mean
+ * motion and propagation time). The batch is processed with AVX-512 or AVX2 instructions if the
+ * library is compiled with support for these instruction sets (see getBatchInstructionSet( )),
+ * and with a scalar loop otherwise. The final states may refer to the same batch as the initial
+ * states.
+ *
+ * @param[in]  transition    Clohessy-Wiltshire state transition
+ * @param[in]  initialStates Batch of initial states [m; m/s]
+ * @param[in]  accelerations Batch of constant accelerations [m/s^2]
+ * @param[out] finalStates   Batch of final states [m; m/s], resized to size of initial states
+ */
+void propagateClohessyWiltshireBatch( const ClohessyWiltshireStateTransition& transition,
+                                      const StateBatch& initialStates,
+                                      const AccelerationBatch& accelerations,
+                                      StateBatch& finalStates );
+
+//! Propagate batch of states using Clohessy-Wiltshire state transition with scalar loop.
+/*!
+ * Scalar reference implementation of propagateClohessyWiltshireBatch( ), which is used for the
+ * remainder of a batch that does not fill a complete SIMD register.
+ *
+ * @sa propagateClohessyWiltshireBatch
+ * @param[in]  transition    Clohessy-Wiltshire state transition
+ * @param[in]  initialStates Batch of initial states [m; m/s]
+ * @param[in]  accelerations Batch of constant accelerations [m/s^2]
+ * @param[out] finalStates   Batch of final states [m; m/s], resized to size of initial states
+ */
+void propagateClohessyWiltshireBatchScalar( const ClohessyWiltshireStateTransition& transition,
+                                            const StateBatch& initialStates,
+                                            const AccelerationBatch& accelerations,
+                                            StateBatch& finalStates );
+
+//! Get instruction set used for batch propagation.
+/*!
+ * @return Name of instruction set used for batch propagation ("avx512", "avx2" or "scalar")
+ */
+std::string getBatchInstructionSet( );
+
+} // namespace rvdsim
+
+#endif // RVDSIM_CLOHESSY_WILTSHIRE_HPP
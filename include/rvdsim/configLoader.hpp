@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef RVDSIM_CONFIG_LOADER_HPP
+#define RVDSIM_CONFIG_LOADER_HPP
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <rapidjson/document.h>
+
+namespace rvdsim
+{
+
+//! Parse flags used for JSON configuration files.
+/*!
+ * Configuration files are parsed in situ, allowing comments (both single-line and multi-line) and
+ * trailing commas in objects and arrays.
+ */
+const unsigned int configParseFlags = rapidjson::kParseInsituFlag
+                                      | rapidjson::kParseCommentsFlag
+                                      | rapidjson::kParseTrailingCommasFlag;
+
+//! Read contents of file.
+/*!
+ * Reads the complete contents of a file in a single read operation. The contents are terminated by
+ * a null character, such that they can be parsed in situ.
+ *
+ * @param[in] filePath Path to file
+ * @return            Null-terminated file contents
+ */
+std::vector< char > readFileContents( const std::string& filePath );
+
+//! List names of entries in directory.
+/*!
+ * Lists the names of all entries (files and subdirectories) in a directory, in the order in which
+ * they are returned by the file system. If the directory cannot be opened, an error is thrown.
+ *
+ * @param[in] directoryPath Path to directory
+ * @return                  Names of entries in directory
+ */
+std::vector< std::string > listDirectoryEntries( const std::string& directoryPath );
+
+//! Collection of configurations.
+/*!
+ * Collection of JSON configurations, e.g., the scenarios of a batch of simulations. The
+ * configurations are parsed in situ, i.e., the strings in the documents point into the buffers
+ * that hold the file contents, which are therefore owned by the collection. This avoids copying
+ * the file contents and the strings in the documents.
+ *
+ * @sa loadConfigs
+ */
+class ConfigCollection
+{
+public:
+
+    //! Construct empty collection of configurations.
+    ConfigCollection( ) : buffers( ), documents( ), names( ) { }
+
+    //! Add configurations from JSON file.
+    /*!
+     * Adds the configuration in a JSON file. The file is read in a single read operation and
+     * parsed in situ.
+     *
+     * @param[in] filePath Path to JSON file
+     */
+    void addFile( const std::string& filePath );
+
+    //! Add configurations from JSON-lines file.
+    /*!
+     * Adds the configurations in a JSON-lines file, in which each line contains a complete JSON
+     * document. Empty lines and lines starting with "//" are skipped. The file is read in a single
+     * read operation and each line is parsed in situ.
+     *
+     * @param[in] filePath Path to JSON-lines file
+     */
+    void addJsonLinesFile( const std::string& filePath );
+
+    //! Add configuration from single line of JSON-lines input.
+    /*!
+     * Adds the configuration in a single line of JSON-lines input, e.g., read from a stream. The
+     * line is copied to a buffer owned by the collection and parsed in situ. Empty lines and lines
+     * starting with "//" are skipped.
+     *
+     * @param[in] line Line containing complete JSON document
+     * @param[in] name Name of configuration
+     * @return         True if configuration was added, false if line was skipped
+     */
+    bool addJsonLine( const std::string& line, const std::string& name );
+
+    //! Get number of configurations.
+    /*!
+     * @return Number of configurations in collection
+     */
+    std::size_t size( ) const { return documents.size( ); }
+
+    //! Get configuration.
+    /*!
+     * @param[in] configIndex Index of configuration
+     * @return                JSON document containing configuration
+     */
+    const rapidjson::Document& getDocument( const std::size_t configIndex ) const
+    {
+        return *documents[ configIndex ];
+    }
+
+    //! Get name of configuration.
+    /*!
+     * Returns the name of a configuration, given by the file path, followed by the line number
+     * for configurations read from JSON-lines files.
+     *
+     * @param[in] configIndex Index of configuration
+     * @return                Name of configuration
+     */
+    const std::string& getName( const std::size_t configIndex ) const
+    {
+        return names[ configIndex ];
+    }
+
+protected:
+
+private:
+
+    //! Parse configuration in situ and add it to collection.
+    void parseDocument( char* json, const std::string& name );
+
+    //! Buffers containing file contents, into which the documents point.
+    std::vector< std::unique_ptr< std::vector< char > > > buffers;
+
+    //! Documents containing configurations.
+    std::vector< std::unique_ptr< rapidjson::Document > > documents;
+
+    //! Names of configurations.
+    std::vector< std::string > names;
+};
+
+//! Load configurations.
+/*!
+ * Loads all configurations at the given path, which is either a JSON file, a JSON-lines file
+ * (extension ".jsonl") or a directory. For a directory, all JSON and JSON-lines files in the
+ * directory are loaded in alphabetical order. If a configuration cannot be parsed, an error is
+ * thrown (std::runtime_error) with the name of the configuration, a description of the problem and
+ * the offset at which it was found.
+ *
+ * @sa ConfigCollection
+ * @param[in] path Path to JSON file, JSON-lines file or directory
+ * @return         Collection of configurations
+ */
+ConfigCollection loadConfigs( const std::string& path );
+
+} // namespace rvdsim
+
+#endif // RVDSIM_CONFIG_LOADER_HPP
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef RVDSIM_GUIDANCE_KERNEL_HPP
+#define RVDSIM_GUIDANCE_KERNEL_HPP
+
+#include <cmath>
+#include <vector>
+
+#include "rvdsim/clohessyWiltshire.hpp"
+#include "rvdsim/thrustPolicy.hpp"
+#include "rvdsim/typedefs.hpp"
+
+namespace rvdsim
+{
+
+//! Evaluate guidance kernel for ballistic end state.
+/*!
+ * Evaluates the optimal ZEM/ZEV guidance law, a = 6 ZEM / tgo^2 - 2 ZEV / tgo, where the
+ * Zero-Effort-Miss (ZEM) and Zero-Effort-Velocity (ZEV) are the negative of the end position and
+ * velocity of the ballistic trajectory, and constrains the commanded thrust acceleration to the
+ * thruster capability according to the given thrust policy. The ZEM/ZEV, the thrust acceleration,
+ * its norm and the clamp are computed in a single pass over fixed-size vectors, replacing the
+ * composition of control::computeOptimalGuidanceLaw( ), sml::norm( ) and applyThrustPolicy( ).
+ *
+ * @tparam     ThrustPolicy              Thrust policy
+ * @param[in]  zeroThrustEndState        End state of ballistic trajectory [m; m/s]
+ * @param[in]  timeToGo                  Time-To-Go [s]
+ * @param[in]  thrustAccelerationMaximum Maximum thrust acceleration [m/s^2]
+ * @param[out] zeroEffortMiss            Zero-Effort-Miss [m]
+ * @param[out] zeroEffortVelocity        Zero-Effort-Velocity [m/s]
+ * @param[out] thrustAcceleration        Thrust acceleration applied [m/s^2]
+ * @param[out] isSaturated               Flag indicating if thruster is throttled to its maximum
+ * @return                               Norm of thrust acceleration applied [m/s^2]
+ */
+template< typename ThrustPolicy >
+inline Real evaluateGuidanceKernel( const Vector6& zeroThrustEndState,
+                                    const Real timeToGo,
+                                    const Real thrustAccelerationMaximum,
+                                    Vector3& zeroEffortMiss,
+                                    Vector3& zeroEffortVelocity,
+                                    Vector3& thrustAcceleration,
+                                    bool& isSaturated )
+{
+    const Real positionGain = 6.0 / ( timeToGo * timeToGo );
+    const Real velocityGain = 2.0 / timeToGo;
+
+    Real thrustAccelerationNormSquared = 0.0;
+    for ( int i = 0; i < 3; ++i )
+    {
+        zeroEffortMiss[ i ] = -zeroThrustEndState[ i ];
+        zeroEffortVelocity[ i ] = -zeroThrustEndState[ i + 3 ];
+        thrustAcceleration[ i ]
+            = positionGain * zeroEffortMiss[ i ] - velocityGain * zeroEffortVelocity[ i ];
+        thrustAccelerationNormSquared += thrustAcceleration[ i ] * thrustAcceleration[ i ];
+    }
+
+    const Real thrustAccelerationNorm = std::sqrt( thrustAccelerationNormSquared );
+    const Real scaleFactor = ThrustPolicy::computeScaleFactor(
+        thrustAccelerationNorm, thrustAccelerationMaximum, isSaturated );
+    for ( int i = 0; i < 3; ++i )
+    {
+        thrustAcceleration[ i ] *= scaleFactor;
+    }
+
+    return scaleFactor * thrustAccelerationNorm;
+}
+
+//! Evaluate guidance kernel for Clohessy-Wiltshire dynamics.
+/*!
+ * Evaluates the guidance kernel, computing the end state of the ballistic trajectory from the
+ * Clohessy-Wiltshire state transition over the Time-To-Go in the same pass. Only the non-zero
+ * entries of the state transition matrix are used; the input matrix is not needed, since no thrust
+ * is applied along the ballistic trajectory.
+ *
+ * @sa evaluateGuidanceKernel
+ * @tparam     ThrustPolicy              Thrust policy
+ * @param[in]  timeToGoTransition        Clohessy-Wiltshire state transition over Time-To-Go
+ * @param[in]  timeToGo                  Time-To-Go [s]
+ * @param[in]  state                     Current state [m; m/s]
+ * @param[in]  thrustAccelerationMaximum Maximum thrust acceleration [m/s^2]
+ * @param[out] zeroEffortMiss            Zero-Effort-Miss [m]
+ * @param[out] zeroEffortVelocity        Zero-Effort-Velocity [m/s]
+ * @param[out] thrustAcceleration        Thrust acceleration applied [m/s^2]
+ * @param[out] isSaturated               Flag indicating if thruster is throttled to its maximum
+ * @return                               Norm of thrust acceleration applied [m/s^2]
+ */
+template< typename ThrustPolicy >
+inline Real evaluateGuidanceKernel( const ClohessyWiltshireStateTransition& timeToGoTransition,
+                                    const Real timeToGo,
+                                    const Vector6& state,
+                                    const Real thrustAccelerationMaximum,
+                                    Vector3& zeroEffortMiss,
+                                    Vector3& zeroEffortVelocity,
+                                    Vector3& thrustAcceleration,
+                                    bool& isSaturated )
+{
+    const Matrix66& phi = timeToGoTransition.stateTransitionMatrix;
+    const Real x = state[ 0 ];
+    const Real y = state[ 1 ];
+    const Real z = state[ 2 ];
+    const Real xDot = state[ 3 ];
+    const Real yDot = state[ 4 ];
+    const Real zDot = state[ 5 ];
+
+    Vector6 zeroThrustEndState;
+    zeroThrustEndState[ 0 ] = phi[ 0 ][ 0 ] * x + phi[ 0 ][ 3 ] * xDot + phi[ 0 ][ 4 ] * yDot;
+    zeroThrustEndState[ 1 ] = phi[ 1 ][ 0 ] * x + y + phi[ 1 ][ 3 ] * xDot + phi[ 1 ][ 4 ] * yDot;
+    zeroThrustEndState[ 2 ] = phi[ 2 ][ 2 ] * z + phi[ 2 ][ 5 ] * zDot;
+    zeroThrustEndState[ 3 ] = phi[ 3 ][ 0 ] * x + phi[ 3 ][ 3 ] * xDot + phi[ 3 ][ 4 ] * yDot;
+    zeroThrustEndState[ 4 ] = phi[ 4 ][ 0 ] * x + phi[ 4 ][ 3 ] * xDot + phi[ 4 ][ 4 ] * yDot;
+    zeroThrustEndState[ 5 ] = phi[ 5 ][ 2 ] * z + phi[ 5 ][ 5 ] * zDot;
+
+    return evaluateGuidanceKernel< ThrustPolicy >( zeroThrustEndState,
+                                                   timeToGo,
+                                                   thrustAccelerationMaximum,
+                                                   zeroEffortMiss,
+                                                   zeroEffortVelocity,
+                                                   thrustAcceleration,
+                                                   isSaturated );
+}
+
+//! Evaluate guidance kernel for batch of chasers with Clohessy-Wiltshire dynamics.
+/*!
+ * Evaluates the guidance kernel for a batch of chasers that share the Time-To-Go (and therefore
+ * the state transition), each with its own thrust policy and maximum thrust acceleration. The
+ * ballistic end state, ZEM/ZEV, thrust acceleration, its norm and the clamp are computed in a
+ * single pass over the columns of the batch, without intermediate batches. Consecutive chasers
+ * with the same thrust policy are processed by a loop specialised for the policy, which uses
+ * AVX2/AVX-512 instructions if the library is compiled for an instruction set that supports them
+ * (see getBatchInstructionSet( )), and a scalar loop otherwise.
+ *
+ * @sa evaluateGuidanceKernel
+ * @param[in]  timeToGoTransition        Clohessy-Wiltshire state transition over Time-To-Go
+ * @param[in]  timeToGo                  Time-To-Go [s]
+ * @param[in]  states                    Batch of current states [m; m/s]
+ * @param[in]  thrustPolicies            Thrust policy of each chaser
+ * @param[in]  thrustAccelerationMaxima  Maximum thrust acceleration of each chaser [m/s^2]
+ * @param[out] thrustAccelerations       Batch of thrust accelerations applied [m/s^2], resized to
+ *                                       size of batch of states
+ * @param[out] thrustAccelerationNorms   Norm of thrust acceleration applied to each chaser
+ *                                       [m/s^2], resized to size of batch of states
+ * @param[out] isSaturated               Flags (non-zero) indicating if thruster of each chaser is
+ *                                       throttled to its maximum, resized to size of batch of
+ *                                       states
+ */
+void evaluateGuidanceKernelBatch( const ClohessyWiltshireStateTransition& timeToGoTransition,
+                                  const Real timeToGo,
+                                  const StateBatch& states,
+                                  const std::vector< ThrustPolicyType >& thrustPolicies,
+                                  const std::vector< Real >& thrustAccelerationMaxima,
+                                  AccelerationBatch& thrustAccelerations,
+                                  std::vector< Real >& thrustAccelerationNorms,
+                                  std::vector< unsigned char >& isSaturated );
+
+} // namespace rvdsim
+
+#endif // RVDSIM_GUIDANCE_KERNEL_HPP
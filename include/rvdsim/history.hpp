@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef RVDSIM_HISTORY_HPP
+#define RVDSIM_HISTORY_HPP
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace rvdsim
+{
+
+//! Time history of fixed-size vectors.
+/*!
+ * Container for a time history of vectors of fixed dimension, stored as a structure-of-arrays: the
+ * epochs and each of the vector components are stored in separate, contiguous columns. Entries
+ * are stored in the order in which they are added, which is expected to be chronological.
+ *
+ * The storage required for a known number of entries can be reserved up front, such that adding
+ * entries does not trigger any allocations.
+ *
+ * @tparam Real      Floating-point type
+ * @tparam Dimension Dimension of vectors stored in history
+ */
+template< typename Real, std::size_t Dimension >
+class History
+{
+public:
+
+    //! Define type of columns used to store epochs and vector components.
+    typedef std::vector< Real > Column;
+
+    //! Reserve storage.
+    /*!
+     * Reserves storage for given number of entries in all columns.
+     *
+     * @param[in] numberOfEntries Number of entries to reserve storage for
+     */
+    void reserve( const std::size_t numberOfEntries )
+    {
+        epochs.reserve( numberOfEntries );
+        for ( std::size_t i = 0; i < Dimension; ++i )
+        {
+            columns[ i ].reserve( numberOfEntries );
+        }
+    }
+
+    //! Add entry to end of history.
+    /*!
+     * Adds epoch and vector to end of history.
+     *
+     * @tparam    Vector Vector type, which must provide element access via operator[]
+     * @param[in] epoch  Epoch of entry
+     * @param[in] vector Vector of length Dimension
+     */
+    template< typename Vector >
+    void push_back( const Real epoch, const Vector& vector )
+    {
+        epochs.push_back( epoch );
+        for ( std::size_t i = 0; i < Dimension; ++i )
+        {
+            columns[ i ].push_back( vector[ i ] );
+        }
+    }
+
+    //! Clear history.
+    /*!
+     * Removes all entries from history. Reserved storage is retained.
+     */
+    void clear( )
+    {
+        epochs.clear( );
+        for ( std::size_t i = 0; i < Dimension; ++i )
+        {
+            columns[ i ].clear( );
+        }
+    }
+
+    //! Get number of entries in history.
+    /*!
+     * @return Number of entries
+     */
+    std::size_t size( ) const { return epochs.size( ); }
+
+    //! Check if history is empty.
+    /*!
+     * @return True if history contains no entries
+     */
+    bool empty( ) const { return epochs.empty( ); }
+
+    //! Get epoch of entry.
+    /*!
+     * @param[in] entryIndex Index of entry
+     * @return               Epoch of entry
+     */
+    Real getEpoch( const std::size_t entryIndex ) const { return epochs[ entryIndex ]; }
+
+    //! Get vector component of entry.
+    /*!
+     * @param[in] entryIndex     Index of entry
+     * @param[in] componentIndex Index of vector component
+     * @return                   Vector component of entry
+     */
+    Real operator( )( const std::size_t entryIndex, const std::size_t componentIndex ) const
+    {
+        return columns[ componentIndex ][ entryIndex ];
+    }
+
+    //! Get column of epochs.
+    /*!
+     * @return Contiguous column containing epochs of all entries
+     */
+    const Column& getEpochs( ) const { return epochs; }
+
+    //! Get column of vector component.
+    /*!
+     * @param[in] componentIndex Index of vector component
+     * @return                   Contiguous column containing vector component of all entries
+     */
+    const Column& getColumn( const std::size_t componentIndex ) const
+    {
+        return columns[ componentIndex ];
+    }
+
+protected:
+
+private:
+
+    //! Column of epochs.
+    Column epochs;
+
+    //! Columns of vector components.
+    std::array< Column, Dimension > columns;
+};
+
+} // namespace rvdsim
+
+#endif // RVDSIM_HISTORY_HPP
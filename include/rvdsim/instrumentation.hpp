@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef RVDSIM_INSTRUMENTATION_HPP
+#define RVDSIM_INSTRUMENTATION_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+namespace rvdsim
+{
+
+//! Phases of the application that are timed by the instrumentation layer.
+enum InstrumentationPhase
+{
+    jsonParsePhase,
+    inputCheckPhase,
+    simulationPhase,
+    guidancePhase,
+    propagationPhase,
+    outputPhase,
+    numberOfInstrumentationPhases
+};
+
+//! Events that are counted by the instrumentation layer.
+enum InstrumentationCounter
+{
+    propagationCounter,
+    guidanceCallCounter,
+    throttleSaturationCounter,
+    bytesWrittenCounter,
+    numberOfInstrumentationCounters
+};
+
+//! Snapshot of instrumentation metrics, accumulated over all threads.
+struct InstrumentationSnapshot
+{
+public:
+
+    //! Cumulative time spent in each phase [ns].
+    std::uint64_t phaseTimes[ numberOfInstrumentationPhases ];
+
+    //! Number of times each phase was entered [-].
+    std::uint64_t phaseCalls[ numberOfInstrumentationPhases ];
+
+    //! Value of each counter [-].
+    std::uint64_t counters[ numberOfInstrumentationCounters ];
+
+protected:
+private:
+};
+
+//! Check if instrumentation is enabled.
+/*!
+ * Instrumentation is enabled at compile time by defining RVDSIM_ENABLE_INSTRUMENTATION (CMake
+ * option BUILD_WITH_INSTRUMENTATION). If it is disabled, the instrumentation macros expand to
+ * nothing, so that the hot paths of the simulator carry no overhead.
+ *
+ * @return True if instrumentation is enabled
+ */
+inline bool isInstrumentationEnabled( )
+{
+#ifdef RVDSIM_ENABLE_INSTRUMENTATION
+    return true;
+#else
+    return false;
+#endif
+}
+
+//! Get name of instrumentation phase.
+/*!
+ * @param[in] phase Instrumentation phase
+ * @return          Name of phase
+ */
+std::string getInstrumentationPhaseName( const InstrumentationPhase phase );
+
+//! Get name of instrumentation counter.
+/*!
+ * @param[in] counter Instrumentation counter
+ * @return            Name of counter
+ */
+std::string getInstrumentationCounterName( const InstrumentationCounter counter );
+
+//! Add time spent in phase.
+/*!
+ * Adds time spent in phase to the metrics of the calling thread. Metrics are kept per thread, so
+ * that threads executing simulations in parallel do not contend.
+ *
+ * @param[in] phase       Instrumentation phase
+ * @param[in] nanoseconds Time spent in phase [ns]
+ */
+void addInstrumentationPhaseTime( const InstrumentationPhase phase,
+                                  const std::uint64_t nanoseconds );
+
+//! Increment instrumentation counter.
+/*!
+ * @param[in] counter Instrumentation counter
+ * @param[in] amount  Amount to add to counter
+ */
+void incrementInstrumentationCounter( const InstrumentationCounter counter,
+                                      const std::uint64_t amount );
+
+//! Get snapshot of instrumentation metrics.
+/*!
+ * Gets snapshot of instrumentation metrics, accumulated over all threads, including threads that
+ * have exited. Phase times of threads executing in parallel add up, i.e., phase times are
+ * cumulative thread times, not wall-clock times.
+ *
+ * @return Snapshot of instrumentation metrics
+ */
+InstrumentationSnapshot getInstrumentationSnapshot( );
+
+//! Reset instrumentation metrics.
+/*!
+ * Resets metrics of all threads to zero. Should not be called while simulations are executing.
+ */
+void resetInstrumentation( );
+
+//! Write instrumentation report.
+/*!
+ * Writes a human-readable summary of the instrumentation metrics, with the total and mean time
+ * per phase and the value of each counter.
+ *
+ * @param[in] stream Output stream
+ */
+void writeInstrumentationReport( std::ostream& stream );
+
+//! Write instrumentation metrics to JSON file.
+/*!
+ * @param[in] filePath Path to output file
+ */
+void writeInstrumentationMetrics( const std::string& filePath );
+
+//! Scoped timer.
+/*!
+ * Timer that adds the time between its construction and destruction to the given phase. Use the
+ * RVDSIM_SCOPED_TIMER macro instead of constructing a scoped timer directly, so that the timer is
+ * removed if instrumentation is disabled.
+ */
+class ScopedTimer
+{
+public:
+
+    //! Construct scoped timer and start timing.
+    /*!
+     * @param[in] aPhase Instrumentation phase
+     */
+    explicit ScopedTimer( const InstrumentationPhase aPhase )
+        : phase( aPhase ),
+          startTime( std::chrono::steady_clock::now( ) )
+    { }
+
+    //! Destruct scoped timer and add elapsed time to phase.
+    ~ScopedTimer( )
+    {
+        addInstrumentationPhaseTime(
+            phase,
+            static_cast< std::uint64_t >( std::chrono::duration_cast< std::chrono::nanoseconds >(
+                std::chrono::steady_clock::now( ) - startTime ).count( ) ) );
+    }
+
+protected:
+
+private:
+
+    //! Disable copy-constructor.
+    ScopedTimer( const ScopedTimer& );
+
+    //! Disable copy-assignment operator.
+    ScopedTimer& operator=( const ScopedTimer& );
+
+    //! Instrumentation phase.
+    const InstrumentationPhase phase;
+
+    //! Start time of timer.
+    const std::chrono::steady_clock::time_point startTime;
+};
+
+} // namespace rvdsim
+
+#define RVDSIM_INSTRUMENTATION_CONCATENATE_IMPLEMENTATION( a, b ) a##b
+#define RVDSIM_INSTRUMENTATION_CONCATENATE( a, b ) \
+    RVDSIM_INSTRUMENTATION_CONCATENATE_IMPLEMENTATION( a, b )
+
+#ifdef RVDSIM_ENABLE_INSTRUMENTATION
+
+//! Time enclosing scope and add elapsed time to given phase.
+#define RVDSIM_SCOPED_TIMER( phase ) \
+    const ::rvdsim::ScopedTimer \
+        RVDSIM_INSTRUMENTATION_CONCATENATE( rvdsimScopedTimer, __LINE__ )( phase )
+
+//! Add given amount to instrumentation counter.
+#define RVDSIM_INCREMENT_COUNTER( counter, amount ) \
+    ::rvdsim::incrementInstrumentationCounter( counter, amount )
+
+#else
+
+#define RVDSIM_SCOPED_TIMER( phase )
+#define RVDSIM_INCREMENT_COUNTER( counter, amount ) static_cast< void >( 0 )
+
+#endif // RVDSIM_ENABLE_INSTRUMENTATION
+
+#endif // RVDSIM_INSTRUMENTATION_HPP
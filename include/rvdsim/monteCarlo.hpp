@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef RVDSIM_MONTE_CARLO_HPP
+#define RVDSIM_MONTE_CARLO_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <rapidjson/document.h>
+
+#include "rvdsim/simulator.hpp"
+#include "rvdsim/typedefs.hpp"
+#include "rvdsim/userInput.hpp"
+
+namespace rvdsim
+{
+
+//! Dispersion distribution.
+/*!
+ * Definition of distributions used to disperse input parameters:
+ *  - noDispersion      : parameter is not dispersed
+ *  - normalDispersion  : offset is drawn from a normal distribution, defined by its mean and
+ *                        standard deviation
+ *  - uniformDispersion : offset is drawn from a uniform distribution, defined by its lower and
+ *                        upper bounds
+ */
+enum DispersionDistribution
+{
+    noDispersion,
+    normalDispersion,
+    uniformDispersion
+};
+
+//! Dispersion of a single input parameter.
+/*!
+ * Dispersion of an input parameter, expressed as an offset that is added to the nominal value of
+ * the parameter.
+ */
+struct Dispersion
+{
+public:
+
+    //! Define default constructor.
+    Dispersion( const DispersionDistribution aDistribution = noDispersion,
+                const Real aFirstParameter = 0.0,
+                const Real aSecondParameter = 0.0 )
+        : distribution( aDistribution ),
+          firstParameter( aFirstParameter ),
+          secondParameter( aSecondParameter )
+    { }
+
+    //! Distribution of offset.
+    DispersionDistribution distribution;
+
+    //! Mean (normal distribution) or lower bound (uniform distribution) of offset.
+    Real firstParameter;
+
+    //! Standard deviation (normal distribution) or upper bound (uniform distribution) of offset.
+    Real secondParameter;
+
+protected:
+private:
+};
+
+//! Define container for dispersions of chaser initial state components.
+typedef std::array< Dispersion, 6 > StateDispersion;
+
+//! Dispersion settings provided by user for Monte Carlo analysis.
+struct DispersionSettings
+{
+public:
+
+    //! Define default constructor.
+    DispersionSettings( const std::size_t       aNumberOfSamples,
+                        const std::uint64_t     aSeed,
+                        const std::size_t       aNumberOfThreads,
+                        const StateDispersion&  aChaserInitialStateDispersion,
+                        const Dispersion&       aChaserWetMassDispersion,
+                        const Dispersion&       aThrustMaximumDispersion,
+                        const Dispersion&       aTargetSemiMajorAxisDispersion,
+                        const std::string&      aSummaryFilename )
+        : numberOfSamples( aNumberOfSamples ),
+          seed( aSeed ),
+          numberOfThreads( aNumberOfThreads ),
+          chaserInitialStateDispersion( aChaserInitialStateDispersion ),
+          chaserWetMassDispersion( aChaserWetMassDispersion ),
+          thrustMaximumDispersion( aThrustMaximumDispersion ),
+          targetSemiMajorAxisDispersion( aTargetSemiMajorAxisDispersion ),
+          summaryFilename( aSummaryFilename )
+    { }
+
+    //! Number of Monte Carlo samples [-].
+    const std::size_t numberOfSamples;
+
+    //! Seed for random number generation [-].
+    const std::uint64_t seed;
+
+    //! Number of threads used to execute samples [-] (0: number of hardware threads).
+    const std::size_t numberOfThreads;
+
+    //! Dispersion of chaser initial state [m; m/s].
+    const StateDispersion chaserInitialStateDispersion;
+
+    //! Dispersion of chaser wet mass [kg].
+    const Dispersion chaserWetMassDispersion;
+
+    //! Dispersion of chaser thrust maximum [N].
+    const Dispersion thrustMaximumDispersion;
+
+    //! Dispersion of target semi-major axis [m].
+    const Dispersion targetSemiMajorAxisDispersion;
+
+    //! Monte Carlo summary filename [-].
+    const std::string summaryFilename;
+
+protected:
+private:
+};
+
+//! Check dispersion settings.
+/*!
+ * Checks that the dispersion settings for a Monte Carlo analysis, given by the "dispersion" object
+ * in the JSON input, are valid. If not, an error is thrown (std::invalid_argument) with a short
+ * description of the problem. Parameters for which no dispersion is specified are not dispersed.
+ *
+ * The chaser wet mass and target semi-major axis should remain positive when dispersed, and the
+ * thrust maximum should remain positive if it is positive in the nominal input (a thrust maximum
+ * of zero selects an unconstrained thruster) and non-negative otherwise. An error is thrown if
+ * the lower bound of a uniform dispersion or the mean of a normal dispersion violates this. The
+ * tails of normal dispersions are truncated by redrawing (see computeDispersedInput).
+ *
+ * @sa DispersionSettings, hasDispersionInput
+ * @param[in] config       User-defined configuration options (extracted from JSON input file)
+ * @param[in] nominalInput User input containing nominal simulation settings
+ * @param[in] outputStream Stream to which valid inputs are reported (default: std::cout)
+ * @return                 Struct containing all valid dispersion settings
+ */
+DispersionSettings checkDispersionInput( const rapidjson::Document& config,
+                                         const UserInput& nominalInput,
+                                         std::ostream& outputStream = std::cout );
+
+//! Check if dispersion settings are provided.
+/*!
+ * Checks if the JSON input contains a "dispersion" object, which switches the application to Monte
+ * Carlo mode.
+ *
+ * @param[in] config User-defined configuration options (extracted from JSON input file)
+ * @return           True if dispersion settings are provided
+ */
+bool hasDispersionInput( const rapidjson::Document& config );
+
+//! Compute dispersed user input.
+/*!
+ * Computes user input for a given Monte Carlo sample by adding random offsets to the nominal
+ * input parameters. The random numbers for each sample are generated by a generator that is
+ * seeded from the user-defined seed and the sample index, such that the dispersed input for a
+ * sample only depends on the seed and the sample index, and not on the order in which samples are
+ * executed.
+ *
+ * Offsets that yield an invalid chaser wet mass, thrust maximum or target semi-major axis (see
+ * checkDispersionInput) are redrawn, after the offsets of all parameters have been drawn, such
+ * that the distributions are truncated to the valid ranges of the parameters. If the mean or lower
+ * bound of a dispersion yields an invalid value, an error is thrown (std::invalid_argument).
+ *
+ * @param[in] nominalInput User input containing nominal simulation settings
+ * @param[in] settings     Dispersion settings
+ * @param[in] sampleIndex  Index of Monte Carlo sample
+ * @return                 Dispersed user input
+ */
+UserInput computeDispersedInput( const UserInput&          nominalInput,
+                                 const DispersionSettings& settings,
+                                 const std::size_t         sampleIndex );
+
+//! Compute dispersed user input and check if any offset was redrawn.
+/*!
+ * @sa computeDispersedInput
+ * @param[in]  nominalInput User input containing nominal simulation settings
+ * @param[in]  settings     Dispersion settings
+ * @param[in]  sampleIndex  Index of Monte Carlo sample
+ * @param[out] isRedrawn    Flag indicating if any offset was redrawn
+ * @return                  Dispersed user input
+ */
+UserInput computeDispersedInput( const UserInput&          nominalInput,
+                                 const DispersionSettings& settings,
+                                 const std::size_t         sampleIndex,
+                                 bool&                     isRedrawn );
+
+//! Execute range of Monte Carlo samples.
+/*!
+ * Executes simulations for a contiguous range of Monte Carlo samples in parallel on a
+ * work-stealing thread pool. Since the dispersed input of a sample only depends on the seed and
+ * the sample index, the summaries are identical to those of the same samples in a complete Monte
+ * Carlo analysis, such that an analysis can be split into ranges that are executed separately,
+ * e.g., by the workers of a work queue. The dispersions are checked before any sample is executed
+ * (see computeDispersedInput), such that invalid dispersions throw an error on the calling thread.
+ *
+ * @sa executeMonteCarloAnalysis
+ * @param[in] nominalInput     User input containing nominal simulation settings
+ * @param[in] settings         Dispersion settings
+ * @param[in] firstSampleIndex Index of first Monte Carlo sample in range
+ * @param[in] numberOfSamples  Number of Monte Carlo samples in range
+ * @return                     Simulation summaries, ordered by sample index
+ */
+std::vector< SimulationSummary > executeMonteCarloSamples( const UserInput&          nominalInput,
+                                                           const DispersionSettings& settings,
+                                                           const std::size_t firstSampleIndex,
+                                                           const std::size_t numberOfSamples );
+
+//! Execute Monte Carlo analysis.
+/*!
+ * Executes simulations for all Monte Carlo samples in parallel on a work-stealing thread pool.
+ * The results are reproducible for a given seed, independent of the number of threads used.
+ *
+ * @param[in] nominalInput User input containing nominal simulation settings
+ * @param[in] settings     Dispersion settings
+ * @return                 Simulation summaries, ordered by sample index
+ */
+std::vector< SimulationSummary > executeMonteCarloAnalysis( const UserInput&          nominalInput,
+                                                            const DispersionSettings& settings );
+
+//! Write Monte Carlo summary to file.
+/*!
+ * Writes simulation summaries of all Monte Carlo samples to a CSV file, with one row per sample.
+ *
+ * @param[in] filePath  Path to output file
+ * @param[in] summaries Simulation summaries, ordered by sample index
+ */
+void writeMonteCarloSummary( const std::string&                      filePath,
+                             const std::vector< SimulationSummary >& summaries );
+
+} // namespace rvdsim
+
+#endif // RVDSIM_MONTE_CARLO_HPP
@@ -0,0 +1,282 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef RVDSIM_MULTI_CHASER_SIMULATOR_HPP
+#define RVDSIM_MULTI_CHASER_SIMULATOR_HPP
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <rapidjson/document.h>
+
+#include "rvdsim/clohessyWiltshire.hpp"
+#include "rvdsim/outputSampler.hpp"
+#include "rvdsim/outputSink.hpp"
+#include "rvdsim/simulator.hpp"
+#include "rvdsim/thrustPolicy.hpp"
+#include "rvdsim/timeGrid.hpp"
+#include "rvdsim/typedefs.hpp"
+#include "rvdsim/userInput.hpp"
+
+namespace rvdsim
+{
+
+//! Settings of a single chaser in a multi-chaser simulation.
+struct ChaserSettings
+{
+public:
+
+    //! Define default constructor.
+    ChaserSettings( const Vector6&    anInitialState,
+                    const ThrustMode  aThrustMode,
+                    const Real        aThrustMaximum,
+                    const Real        aWetMass )
+        : initialState( anInitialState ),
+          thrustMode( aThrustMode ),
+          thrustMaximum( aThrustMaximum ),
+          wetMass( aWetMass )
+    { }
+
+    //! Chaser initial state [m; m/s].
+    const Vector6 initialState;
+
+    //! Chaser thrust mode.
+    const ThrustMode thrustMode;
+
+    //! Chaser thrust maximum [N].
+    const Real thrustMaximum;
+
+    //! Chaser wet mass [kg].
+    const Real wetMass;
+
+protected:
+private:
+};
+
+//! Multi-chaser settings provided by user.
+struct MultiChaserSettings
+{
+public:
+
+    //! Define default constructor.
+    MultiChaserSettings( const std::vector< ChaserSettings >& someChasers,
+                         const std::string&                   aSummaryFilename )
+        : chasers( someChasers ),
+          summaryFilename( aSummaryFilename )
+    { }
+
+    //! Settings of all chasers.
+    const std::vector< ChaserSettings > chasers;
+
+    //! Multi-chaser summary filename [-].
+    const std::string summaryFilename;
+
+protected:
+private:
+};
+
+//! Check multi-chaser settings.
+/*!
+ * Checks that the settings for a multi-chaser simulation, given by the "multi_chaser" object in
+ * the JSON input, are valid. If not, an error is thrown (std::invalid_argument) with a short
+ * description of the problem. The nominal input should not select settings that are not supported
+ * by multi-chaser simulations (see MultiChaserSimulator). Each entry of the "chasers" array is an
+ * object with the optional keys "initial_state", "thrust_settings" (thrust mode and maximum) and
+ * "wet_mass"; keys that are not given are set to the nominal value in the user input.
+ *
+ * @sa MultiChaserSettings, hasMultiChaserInput
+ * @param[in] config       User-defined configuration options (extracted from JSON input file)
+ * @param[in] nominalInput User input containing nominal simulation settings
+ * @param[in] outputStream Stream to which valid inputs are reported (default: std::cout)
+ * @return                 Struct containing all valid multi-chaser settings
+ */
+MultiChaserSettings checkMultiChaserInput( const rapidjson::Document& config,
+                                           const UserInput& nominalInput,
+                                           std::ostream& outputStream = std::cout );
+
+//! Check if multi-chaser settings are provided.
+/*!
+ * Checks if the JSON input contains a "multi_chaser" object, which switches the application to
+ * multi-chaser mode.
+ *
+ * @param[in] config User-defined configuration options (extracted from JSON input file)
+ * @return           True if multi-chaser settings are provided
+ */
+bool hasMultiChaserInput( const rapidjson::Document& config );
+
+//! Multi-chaser rendezvous simulator.
+/*!
+ * Simulation engine that propagates the motion of many chasers with respect to a shared target
+ * under ZEM/ZEV feedback guidance, in a single time loop. Each chaser has its own initial state,
+ * thrust mode, thrust maximum and mass, whilst the time span, target orbit and thrust frequency
+ * are shared.
+ *
+ * The chaser states are stored as a structure-of-arrays batch. Since all chasers share the
+ * Time-To-Go, the ballistic end states used by the guidance law are obtained for the complete
+ * batch using a single Clohessy-Wiltshire state transition per thruster pulse, which is updated
+ * incrementally from the previous pulse (see ClohessyWiltshireTimeToGoTransition), after which the
+ * guidance law and the thruster constraints are evaluated column-wise and the batch is propagated
+ * over the thruster pulse using the (SIMD) batch propagation kernel. The outcome for each chaser
+ * matches that of the single-chaser Simulator with the same settings to within round-off. Since
+ * the batch kernels are specific to the Clohessy-Wiltshire model, other propagators are not
+ * supported. Output is sampled using the sampling mode of the user input only: event-triggered
+ * samples, adaptive scheduling and checkpointing are not supported either. An error is thrown
+ * (std::invalid_argument) upon construction if any of these is selected in the user input.
+ *
+ * @sa Simulator, ChaserSettings
+ */
+class MultiChaserSimulator
+{
+public:
+
+    //! Construct multi-chaser simulator.
+    /*!
+     * @param[in] anInput     User input containing shared simulation settings
+     * @param[in] someChasers Settings of all chasers
+     */
+    MultiChaserSimulator( const UserInput& anInput,
+                          const std::vector< ChaserSettings >& someChasers );
+
+    //! Execute simulation.
+    /*!
+     * Executes simulation of all chasers, starting from their initial states.
+     */
+    void execute( );
+
+    //! Set output sinks.
+    /*!
+     * Sets sinks to which the chaser states and thrusts are streamed while the simulation is
+     * executed, with one row per chaser per epoch and columns (t, chaser, x, y, z, xdot, ydot,
+     * zdot) and (t, chaser, Tx, Ty, Tz) respectively. The epochs that are streamed are selected
+     * according to the sampling mode in the user input; sampling events are not supported, since
+     * they differ per chaser. The first and final epochs are always streamed. The sinks are not
+     * owned by the simulator; a null pointer disables streaming.
+     *
+     * @param[in] aStateSink  Sink for chaser states (default: none)
+     * @param[in] aThrustSink Sink for chaser thrusts (default: none)
+     */
+    void setOutputSinks( OutputSink* aStateSink = 0, OutputSink* aThrustSink = 0 );
+
+    //! Get number of chasers.
+    /*!
+     * @return Number of chasers
+     */
+    std::size_t getNumberOfChasers( ) const { return chasers.size( ); }
+
+    //! Get chaser final states.
+    /*!
+     * @return Batch of chaser states at the end of the last execution [m; m/s]
+     */
+    const StateBatch& getChaserFinalStates( ) const { return currentStates; }
+
+    //! Get summaries of simulation.
+    /*!
+     * @return Summary of the last execution for each chaser
+     */
+    std::vector< SimulationSummary > getSummaries( ) const;
+
+protected:
+
+private:
+
+    //! Compute thrust accelerations of all chasers using ZEM/ZEV feedback law.
+    /*!
+     * @param[in] stepIndex Index of current thruster pulse
+     */
+    void computeThrustAccelerations( const std::size_t stepIndex );
+
+    //! Write current states and thrusts to output sinks.
+    void writeOutputRows( const bool isThrustWritten );
+
+    //! User input containing shared simulation settings.
+    const UserInput input;
+
+    //! Settings of all chasers.
+    const std::vector< ChaserSettings > chasers;
+
+    //! Chaser thrust pulse time [s].
+    const Real thrustPulseTime;
+
+    //! Time grid of thruster pulses.
+    const TimeGrid timeGrid;
+
+    //! Exhaust velocity of thrusters [m/s]; zero if chaser masses are constant.
+    const Real exhaustVelocity;
+
+    //! Target mean motion [rad/s].
+    const Real targetMeanMotion;
+
+    //! Clohessy-Wiltshire state transition over a single thrust pulse.
+    const ClohessyWiltshireStateTransition pulseStateTransition;
+
+    //! Clohessy-Wiltshire state transition over Time-To-Go, shared by all chasers.
+    ClohessyWiltshireTimeToGoTransition timeToGoTransition;
+
+    //! Thrust policy of each chaser, which does not change as the chaser mass is depleted.
+    std::vector< ThrustPolicyType > thrustPolicies;
+
+    //! Maximum thrust acceleration of each chaser at its current mass [m/s^2].
+    std::vector< Real > thrustAccelerationMaxima;
+
+    //! Current chaser epoch, derived from index of current thruster pulse [s].
+    Real currentTime;
+
+    //! Current Time-To-Go (TTG), derived from index of current thruster pulse [s].
+    Real timeToGo;
+
+    //! Current chaser states [m; m/s].
+    StateBatch currentStates;
+
+    //! Current thrust accelerations [m/s^2].
+    AccelerationBatch thrustAccelerations;
+
+    //! Norm of current thrust acceleration of each chaser [m/s^2].
+    std::vector< Real > thrustAccelerationNorms;
+
+    //! Flags (non-zero) indicating if thruster of each chaser is throttled to its maximum during
+    //! current thruster pulse.
+    std::vector< unsigned char > isThrottleSaturated;
+
+    //! Total delta-V applied by thruster of each chaser [m/s].
+    std::vector< Real > totalDeltaV;
+
+    //! Current mass of each chaser [kg].
+    std::vector< Real > chaserMasses;
+
+    //! Total propellant mass consumed by thruster of each chaser [kg].
+    std::vector< Real > propellantMass;
+
+    //! Time during which thruster of each chaser was throttled to its maximum [s].
+    std::vector< Real > throttleSaturationTime;
+
+    //! Flags indicating if thruster of each chaser was throttled to its maximum.
+    std::vector< bool > isThrottleMax;
+
+    //! Sink to which chaser states are streamed (not owned).
+    OutputSink* stateSink;
+
+    //! Sink to which chaser thrusts are streamed (not owned).
+    OutputSink* thrustSink;
+
+    //! Sampler that selects epochs streamed to output sinks.
+    OutputSampler outputSampler;
+};
+
+//! Write multi-chaser summary to file.
+/*!
+ * Writes summary of all chasers to a CSV file, with one row per chaser.
+ *
+ * @param[in] filePath  Path to output file
+ * @param[in] summaries Summaries of all chasers
+ */
+void writeMultiChaserSummary( const std::string&                      filePath,
+                              const std::vector< SimulationSummary >& summaries );
+
+} // namespace rvdsim
+
+#endif // RVDSIM_MULTI_CHASER_SIMULATOR_HPP
@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef RVDSIM_OUTPUT_SAMPLER_HPP
+#define RVDSIM_OUTPUT_SAMPLER_HPP
+
+#include <cstddef>
+
+#include "rvdsim/typedefs.hpp"
+
+namespace rvdsim
+{
+
+//! Output sampling mode.
+/*!
+ * Definition of output sampling modes, which determine the epochs for which output rows are
+ * written:
+ *  - everyStep     : every thruster pulse is written
+ *  - everyNthStep  : every N-th thruster pulse is written
+ *  - fixedInterval : the first thruster pulse at or after each multiple of a fixed output interval
+ *                    (measured from the start time) is written
+ */
+enum SamplingMode
+{
+    everyStep,
+    everyNthStep,
+    fixedInterval
+};
+
+//! Output sampling settings.
+/*!
+ * Settings that determine which epochs are written to the output. Independent of the sampling
+ * mode, rows can also be triggered by events, and the first and final epochs are always written.
+ *
+ * @sa OutputSampler
+ */
+struct OutputSamplingSettings
+{
+public:
+
+    //! Construct output sampling settings.
+    /*!
+     * The default settings write every thruster pulse.
+     *
+     * @param[in] aSamplingMode                  Output sampling mode (default: every step)
+     * @param[in] aStepInterval                  Number of steps between output rows for
+     *                                           every-N-th-step mode (default: 1)
+     * @param[in] aTimeInterval                  Output interval for fixed-interval mode [s]
+     *                                           (default: 0)
+     * @param[in] isThrustSwitchEventEnabledFlag Flag indicating if thrust on/off transitions
+     *                                           trigger output (default: false)
+     * @param[in] isThrottleSaturationEventEnabledFlag
+     *                                           Flag indicating if transitions into and out of
+     *                                           throttle saturation trigger output
+     *                                           (default: false)
+     * @param[in] isArrivalEventEnabledFlag      Flag indicating if crossings of the arrival
+     *                                           distance tolerance trigger output (default: false)
+     */
+    OutputSamplingSettings( const SamplingMode  aSamplingMode = everyStep,
+                            const std::size_t   aStepInterval = 1,
+                            const Real          aTimeInterval = 0.0,
+                            const bool          isThrustSwitchEventEnabledFlag = false,
+                            const bool          isThrottleSaturationEventEnabledFlag = false,
+                            const bool          isArrivalEventEnabledFlag = false )
+        : samplingMode( aSamplingMode ),
+          stepInterval( aStepInterval ),
+          timeInterval( aTimeInterval ),
+          isThrustSwitchEventEnabled( isThrustSwitchEventEnabledFlag ),
+          isThrottleSaturationEventEnabled( isThrottleSaturationEventEnabledFlag ),
+          isArrivalEventEnabled( isArrivalEventEnabledFlag )
+    { }
+
+    //! Output sampling mode.
+    const SamplingMode samplingMode;
+
+    //! Number of steps between output rows for every-N-th-step mode.
+    const std::size_t stepInterval;
+
+    //! Output interval for fixed-interval mode [s].
+    const Real timeInterval;
+
+    //! Flag indicating if thrust on/off transitions trigger output.
+    const bool isThrustSwitchEventEnabled;
+
+    //! Flag indicating if transitions into and out of throttle saturation trigger output.
+    const bool isThrottleSaturationEventEnabled;
+
+    //! Flag indicating if crossings of the arrival distance tolerance trigger output.
+    const bool isArrivalEventEnabled;
+
+protected:
+private:
+};
+
+//! Output sampler state.
+/*!
+ * State of an output sampler in between epochs, e.g., recorded in a checkpoint such that sampling
+ * continues identically once the simulation is resumed.
+ *
+ * @sa OutputSampler
+ */
+struct OutputSamplerState
+{
+public:
+
+    //! Index of next output interval for fixed-interval mode.
+    std::size_t nextIntervalIndex;
+
+    //! Flag indicating if first epoch has been processed.
+    bool isStarted;
+
+    //! Flag indicating if thrust was non-zero during previous pulse.
+    bool wasThrustOn;
+
+    //! Flag indicating if thrust was throttled during previous pulse.
+    bool wasThrottleSaturated;
+
+    //! Flag indicating if chaser was within arrival distance tolerance at previous epoch.
+    bool wasWithinArrivalTolerance;
+
+protected:
+private:
+};
+
+//! Output sampler.
+/*!
+ * Decides, epoch by epoch, whether output rows are written, according to the output sampling
+ * settings. The sampler keeps track of the previous event conditions, so that it can detect
+ * transitions; it must be reset at the start of each simulation.
+ *
+ * @sa OutputSamplingSettings
+ */
+class OutputSampler
+{
+public:
+
+    //! Construct output sampler.
+    /*!
+     * @param[in] someSettings Output sampling settings
+     * @param[in] aStartTime   Simulation start time [s]
+     */
+    OutputSampler( const OutputSamplingSettings& someSettings, const Real aStartTime );
+
+    //! Reset sampler to start of simulation.
+    void reset( );
+
+    //! Check if epoch is sampled.
+    /*!
+     * Checks if output rows should be written for the given epoch. This function must be called
+     * exactly once for each epoch in the simulation, in order. The first epoch is always sampled.
+     *
+     * @param[in] stepIndex                Index of step (thruster pulse) starting at epoch
+     * @param[in] time                     Epoch [s]
+     * @param[in] isThrustOn               Flag indicating if thrust is non-zero during pulse
+     * @param[in] isThrottleSaturated      Flag indicating if thrust is throttled during pulse
+     * @param[in] isWithinArrivalTolerance Flag indicating if chaser is within arrival distance
+     *                                     tolerance at epoch
+     * @return                             True if output rows should be written for epoch
+     */
+    bool isSampled( const std::size_t stepIndex,
+                    const Real time,
+                    const bool isThrustOn,
+                    const bool isThrottleSaturated,
+                    const bool isWithinArrivalTolerance );
+
+    //! Get state of sampler.
+    /*!
+     * @return State of sampler
+     */
+    OutputSamplerState getState( ) const;
+
+    //! Set state of sampler.
+    /*!
+     * @param[in] state State of sampler, as obtained from getState( )
+     */
+    void setState( const OutputSamplerState& state );
+
+protected:
+
+private:
+
+    //! Output sampling settings.
+    const OutputSamplingSettings settings;
+
+    //! Simulation start time [s].
+    const Real startTime;
+
+    //! Index of next output interval for fixed-interval mode.
+    std::size_t nextIntervalIndex;
+
+    //! Flag indicating if first epoch has been processed.
+    bool isStarted;
+
+    //! Flag indicating if thrust was non-zero during previous pulse.
+    bool wasThrustOn;
+
+    //! Flag indicating if thrust was throttled during previous pulse.
+    bool wasThrottleSaturated;
+
+    //! Flag indicating if chaser was within arrival distance tolerance at previous epoch.
+    bool wasWithinArrivalTolerance;
+};
+
+} // namespace rvdsim
+
+#endif // RVDSIM_OUTPUT_SAMPLER_HPP
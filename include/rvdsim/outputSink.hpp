@@ -0,0 +1,282 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef RVDSIM_OUTPUT_SINK_HPP
+#define RVDSIM_OUTPUT_SINK_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rvdsim/typedefs.hpp"
+
+namespace rvdsim
+{
+
+//! Output file format.
+/*!
+ * Definition of output file formats:
+ *  - csvOutput    : comma-separated text file with a header line containing the column names
+ *  - binaryOutput : binary file with a fixed header containing the column names, followed by the
+ *                   rows stored as little-endian doubles (see BinaryOutputSink)
+ */
+enum OutputFormat
+{
+    csvOutput,
+    binaryOutput
+};
+
+//! Position of output sink in its file.
+/*!
+ * Position up to which an output sink has written its rows to file, e.g., recorded in a checkpoint
+ * such that the sink can be reopened at that position once the simulation is resumed.
+ *
+ * @sa OutputSink::synchronize
+ */
+struct OutputSinkPosition
+{
+public:
+
+    //! Size of file up to and including the last row written [bytes].
+    std::uint64_t fileOffset;
+
+    //! Number of rows written.
+    std::uint64_t numberOfRows;
+
+protected:
+private:
+};
+
+//! Output sink.
+/*!
+ * Interface for sinks that write tabular output (e.g., state and thrust histories) row by row,
+ * while it is generated. Each row contains one value per column. Sinks buffer the rows internally
+ * and write them to file in large blocks, such that memory use is constant, irrespective of the
+ * number of rows written.
+ */
+class OutputSink
+{
+public:
+
+    //! Construct output sink.
+    /*!
+     * @param[in] someColumnNames Names of columns in output
+     */
+    explicit OutputSink( const std::vector< std::string >& someColumnNames );
+
+    //! Destruct output sink.
+    virtual ~OutputSink( ) { }
+
+    //! Write row.
+    /*!
+     * @param[in] row Pointer to row, containing one value per column
+     */
+    virtual void writeRow( const Real* row ) = 0;
+
+    //! Close sink.
+    /*!
+     * Flushes all buffered rows to file and closes file. No rows can be written after the sink is
+     * closed. Closing a sink that is already closed has no effect.
+     */
+    virtual void close( ) = 0;
+
+    //! Synchronise sink with file.
+    /*!
+     * Writes all buffered rows to file and flushes the file, such that all rows written so far are
+     * stored on disk, and returns the position of the sink in the file. Rows can still be written
+     * afterwards. Sinks that do not write to file only report the number of rows written.
+     *
+     * @return Position of sink in file
+     */
+    virtual OutputSinkPosition synchronize( )
+    {
+        OutputSinkPosition position;
+        position.fileOffset = 0;
+        position.numberOfRows = numberOfRows;
+        return position;
+    }
+
+    //! Get names of columns.
+    /*!
+     * @return Names of columns in output
+     */
+    const std::vector< std::string >& getColumnNames( ) const { return columnNames; }
+
+    //! Get number of rows written.
+    /*!
+     * @return Number of rows written to sink
+     */
+    std::size_t getNumberOfRows( ) const { return numberOfRows; }
+
+protected:
+
+    //! Names of columns.
+    const std::vector< std::string > columnNames;
+
+    //! Number of rows written.
+    std::size_t numberOfRows;
+
+private:
+};
+
+//! CSV output sink.
+/*!
+ * Output sink that writes rows to a comma-separated text file. The first line contains the column
+ * names. Values are formatted with the given number of significant digits (default matches the
+ * default precision of std::ostream).
+ */
+class CsvOutputSink : public OutputSink
+{
+public:
+
+    //! Construct CSV output sink.
+    /*!
+     * Opens file and writes header line. An error is thrown if the file cannot be opened. If a
+     * resume position is given, the existing file is truncated to that position instead and rows
+     * are appended from there on.
+     *
+     * @param[in] aFilePath       Path to output file
+     * @param[in] someColumnNames Names of columns in output
+     * @param[in] aPrecision      Number of significant digits of values (default: 6)
+     * @param[in] aBufferSize     Size of output buffer [bytes] (default: 1 MiB)
+     * @param[in] aResumePosition Position at which existing file is resumed (default: none)
+     */
+    CsvOutputSink( const std::string& aFilePath,
+                   const std::vector< std::string >& someColumnNames,
+                   const int aPrecision = 6,
+                   const std::size_t aBufferSize = 1 << 20,
+                   const OutputSinkPosition* aResumePosition = 0 );
+
+    //! Destruct CSV output sink, closing file if still open.
+    ~CsvOutputSink( );
+
+    //! Write row.
+    void writeRow( const Real* row );
+
+    //! Close sink.
+    void close( );
+
+    //! Synchronise sink with file.
+    OutputSinkPosition synchronize( );
+
+protected:
+
+private:
+
+    //! Flush buffer to file.
+    void flush( );
+
+    //! Output file.
+    std::ofstream file;
+
+    //! Number of significant digits of values.
+    const int precision;
+
+    //! Size of output buffer [bytes].
+    const std::size_t bufferSize;
+
+    //! Output buffer.
+    std::string buffer;
+};
+
+//! Binary output sink.
+/*!
+ * Output sink that writes rows to a compact binary file. The file consists of a fixed header,
+ * followed by the rows, each stored as one 8-byte little-endian IEEE-754 double per column:
+ *
+ *  offset  size  content
+ *  0       8     magic "RVDSIMB1"
+ *  8       4     format version (uint32, currently 1)
+ *  12      4     number of columns (uint32)
+ *  16      8     number of rows (uint64, written when sink is closed)
+ *  24      8     offset of first row in bytes (uint64)
+ *  32      ...   column names, each terminated by '\0'
+ *
+ * The header is zero-padded to a multiple of 64 bytes, such that the rows are aligned and can be
+ * loaded directly, e.g., as a memory-mapped array with shape (rows, columns).
+ */
+class BinaryOutputSink : public OutputSink
+{
+public:
+
+    //! Construct binary output sink.
+    /*!
+     * Opens file and writes header. An error is thrown if the file cannot be opened. If a resume
+     * position is given, the existing file is truncated to that position instead and rows are
+     * appended from there on; the number of rows in the header is updated when the sink is
+     * closed.
+     *
+     * @param[in] aFilePath       Path to output file
+     * @param[in] someColumnNames Names of columns in output
+     * @param[in] aBufferSize     Size of output buffer [bytes] (default: 1 MiB)
+     * @param[in] aResumePosition Position at which existing file is resumed (default: none)
+     */
+    BinaryOutputSink( const std::string& aFilePath,
+                      const std::vector< std::string >& someColumnNames,
+                      const std::size_t aBufferSize = 1 << 20,
+                      const OutputSinkPosition* aResumePosition = 0 );
+
+    //! Destruct binary output sink, closing file if still open.
+    ~BinaryOutputSink( );
+
+    //! Write row.
+    void writeRow( const Real* row );
+
+    //! Close sink.
+    void close( );
+
+    //! Synchronise sink with file.
+    OutputSinkPosition synchronize( );
+
+protected:
+
+private:
+
+    //! Flush buffer to file.
+    void flush( );
+
+    //! Output file.
+    std::ofstream file;
+
+    //! Size of output buffer [bytes].
+    const std::size_t bufferSize;
+
+    //! Output buffer.
+    std::vector< char > buffer;
+};
+
+//! Magic number at start of binary output files.
+const char binaryOutputMagic[ ] = "RVDSIMB1";
+
+//! Version of binary output file format.
+const std::uint32_t binaryOutputVersion = 1;
+
+//! Alignment of data section in binary output files [bytes].
+const std::size_t binaryOutputAlignment = 64;
+
+//! Create output sink.
+/*!
+ * Creates output sink for given output format. If a resume position is given, the sink continues
+ * writing to the existing file from that position (see OutputSink::synchronize).
+ *
+ * @sa OutputFormat, CsvOutputSink, BinaryOutputSink
+ * @param[in] outputFormat   Output file format
+ * @param[in] filePath       Path to output file
+ * @param[in] columnNames    Names of columns in output
+ * @param[in] resumePosition Position at which existing file is resumed (default: none)
+ * @return                   Output sink
+ */
+std::unique_ptr< OutputSink > createOutputSink( const OutputFormat outputFormat,
+                                                const std::string& filePath,
+                                                const std::vector< std::string >& columnNames,
+                                                const OutputSinkPosition* resumePosition = 0 );
+
+} // namespace rvdsim
+
+#endif // RVDSIM_OUTPUT_SINK_HPP
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef RVDSIM_PARAMETER_SWEEP_HPP
+#define RVDSIM_PARAMETER_SWEEP_HPP
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <rapidjson/document.h>
+
+#include "rvdsim/simulator.hpp"
+#include "rvdsim/typedefs.hpp"
+#include "rvdsim/userInput.hpp"
+
+namespace rvdsim
+{
+
+//! Sweep settings provided by user for parameter sweep over thruster settings.
+/*!
+ * Settings for a parameter sweep, in which the simulation is executed for each point on the grid
+ * spanned by the given values of the chaser thrust maximum and thrust frequency. All other
+ * parameters are taken from the nominal user input.
+ */
+struct SweepSettings
+{
+public:
+
+    //! Define default constructor.
+    SweepSettings( const std::vector< Real >&  someThrustMaximumValues,
+                   const std::vector< Real >&  someThrustFrequencyValues,
+                   const std::size_t           aNumberOfThreads,
+                   const TerminationSettings&  someTerminationSettings,
+                   const std::string&          aResultsFilename )
+        : thrustMaximumValues( someThrustMaximumValues ),
+          thrustFrequencyValues( someThrustFrequencyValues ),
+          numberOfThreads( aNumberOfThreads ),
+          terminationSettings( someTerminationSettings ),
+          resultsFilename( aResultsFilename )
+    { }
+
+    //! Get number of grid points.
+    /*!
+     * @return Number of grid points [-]
+     */
+    std::size_t getNumberOfGridPoints( ) const
+    {
+        return thrustMaximumValues.size( ) * thrustFrequencyValues.size( );
+    }
+
+    //! Values of chaser thrust maximum [N].
+    const std::vector< Real > thrustMaximumValues;
+
+    //! Values of chaser thrust frequency [Hz].
+    const std::vector< Real > thrustFrequencyValues;
+
+    //! Number of threads used to execute grid points [-] (0: number of hardware threads).
+    const std::size_t numberOfThreads;
+
+    //! Early termination settings applied to each grid point.
+    const TerminationSettings terminationSettings;
+
+    //! Sweep results filename [-].
+    const std::string resultsFilename;
+
+protected:
+private:
+};
+
+//! Result of a single grid point in a parameter sweep.
+struct SweepResult
+{
+public:
+
+    //! Index of grid point [-].
+    std::size_t gridPointIndex;
+
+    //! Chaser thrust maximum [N].
+    Real thrustMaximum;
+
+    //! Chaser thrust frequency [Hz].
+    Real thrustFrequency;
+
+    //! Summary of simulation.
+    SimulationSummary summary;
+
+protected:
+private:
+};
+
+//! Check sweep settings.
+/*!
+ * Checks that the settings for a parameter sweep, given by the "sweep" object in the JSON input,
+ * are valid. If not, an error is thrown with a short description of the problem. The values of
+ * each swept parameter are given either as an array of values, or as an object
+ * {"from", "to", "points"} describing evenly spaced values. Parameters that are not swept are set
+ * to their nominal value. If the nominal thrust mode is on-off, the swept thrust maxima should
+ * be positive, since on-off mode requires a maximum thrust level.
+ *
+ * @sa SweepSettings, hasSweepInput
+ * @param[in] config       User-defined configuration options (extracted from JSON input file)
+ * @param[in] nominalInput User input containing nominal simulation settings
+ * @param[in] outputStream Stream to which valid inputs are reported (default: std::cout)
+ * @return                 Struct containing all valid sweep settings
+ */
+SweepSettings checkSweepInput( const rapidjson::Document& config,
+                               const UserInput& nominalInput,
+                               std::ostream& outputStream = std::cout );
+
+//! Check if sweep settings are provided.
+/*!
+ * Checks if the JSON input contains a "sweep" object, which switches the application to parameter
+ * sweep mode.
+ *
+ * @param[in] config User-defined configuration options (extracted from JSON input file)
+ * @return           True if sweep settings are provided
+ */
+bool hasSweepInput( const rapidjson::Document& config );
+
+//! Compute user input for grid point.
+/*!
+ * Computes user input for a given grid point by replacing the nominal thruster settings. Grid
+ * points are ordered with the thrust frequency varying fastest.
+ *
+ * @param[in] nominalInput   User input containing nominal simulation settings
+ * @param[in] settings       Sweep settings
+ * @param[in] gridPointIndex Index of grid point
+ * @return                   User input for grid point
+ */
+UserInput computeGridPointInput( const UserInput&     nominalInput,
+                                 const SweepSettings& settings,
+                                 const std::size_t    gridPointIndex );
+
+//! Execute parameter sweep.
+/*!
+ * Executes simulations for all grid points in parallel on a work-stealing thread pool, applying
+ * the early termination settings to each simulation. Grid points that share the thrust frequency
+ * share the pre-computed state transition over a thruster pulse.
+ *
+ * @param[in] nominalInput User input containing nominal simulation settings
+ * @param[in] settings     Sweep settings
+ * @return                 Results, ordered by grid point index
+ */
+std::vector< SweepResult > executeParameterSweep( const UserInput&     nominalInput,
+                                                  const SweepSettings& settings );
+
+//! Write parameter sweep results to file.
+/*!
+ * Writes results of all grid points to a CSV file, with one row per grid point.
+ *
+ * @param[in] filePath Path to output file
+ * @param[in] results  Results, ordered by grid point index
+ */
+void writeParameterSweepResults( const std::string&                filePath,
+                                 const std::vector< SweepResult >& results );
+
+} // namespace rvdsim
+
+#endif // RVDSIM_PARAMETER_SWEEP_HPP
@@ -0,0 +1,408 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef RVDSIM_PROPAGATOR_HPP
+#define RVDSIM_PROPAGATOR_HPP
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "rvdsim/clohessyWiltshire.hpp"
+#include "rvdsim/typedefs.hpp"
+#include "rvdsim/userInput.hpp"
+
+namespace rvdsim
+{
+
+//! Relative dynamics propagator.
+/*!
+ * Interface of the models that propagate the chaser state relative to the target. All states are
+ * expressed in the Hill frame, with x radial, y along-track and z cross-track (see Fehse (2003)).
+ * A propagator keeps track of the time elapsed since the start of the simulation, which is needed
+ * by models for which the relative dynamics vary along the target orbit.
+ *
+ * @sa PropagatorSettings, createPropagator
+ */
+class Propagator
+{
+public:
+
+    //! Destroy propagator.
+    virtual ~Propagator( ) { }
+
+    //! Reset propagator to start of simulation.
+    virtual void reset( ) = 0;
+
+    //! Predict end state of ballistic trajectory.
+    /*!
+     * Predicts the state reached from the given state after the given propagation time, starting
+     * at the current epoch of the propagator, without thrust. The prediction is used by the
+     * guidance law and does not advance the epoch of the propagator.
+     *
+     * @param[in]  propagationTime Propagation time [s]
+     * @param[in]  state           Current chaser state [m; m/s]
+     * @param[out] finalState      Predicted chaser state [m; m/s]
+     */
+    virtual void predictBallisticState( const Real propagationTime,
+                                        const Vector6& state,
+                                        Vector6& finalState ) const = 0;
+
+    //! Propagate state under constant thrust acceleration.
+    /*!
+     * Propagates the given state over the given propagation time, starting at the current epoch
+     * of the propagator, under a constant thrust acceleration, and advances the epoch of the
+     * propagator. The final state may refer to the same object as the initial state.
+     *
+     * @param[in]  propagationTime    Propagation time [s]
+     * @param[in]  state              Current chaser state [m; m/s]
+     * @param[in]  thrustAcceleration Thrust acceleration expressed in Hill frame [m/s^2]
+     * @param[out] finalState         Chaser state at end of propagation [m; m/s]
+     */
+    virtual void propagate( const Real propagationTime,
+                            const Vector6& state,
+                            const Vector3& thrustAcceleration,
+                            Vector6& finalState ) = 0;
+
+    //! Get internal state of propagator.
+    /*!
+     * Gets the values that, together with the chaser state, determine all subsequent propagations
+     * (e.g., the current epoch), such that a propagator can be restored to the same point in a
+     * simulation, e.g., when it is resumed from a checkpoint.
+     *
+     * @return Internal state of propagator
+     */
+    virtual std::vector< Real > getInternalState( ) const = 0;
+
+    //! Set internal state of propagator.
+    /*!
+     * Restores the internal state of the propagator. An error is thrown if the internal state
+     * does not match the propagator.
+     *
+     * @param[in] internalState Internal state of propagator, as obtained from getInternalState( )
+     */
+    virtual void setInternalState( const std::vector< Real >& internalState ) = 0;
+
+protected:
+private:
+};
+
+//! Clohessy-Wiltshire propagator.
+/*!
+ * Propagator based on the closed-form Clohessy-Wiltshire solution for a target in a circular
+ * orbit. Propagation over a single thruster pulse uses a pre-computed state transition.
+ *
+ * @sa ClohessyWiltshireStateTransition
+ */
+class ClohessyWiltshirePropagator : public Propagator
+{
+public:
+
+    //! Construct Clohessy-Wiltshire propagator.
+    /*!
+     * @param[in] aMeanMotion      Mean motion of target's orbit [rad/s]
+     * @param[in] aThrustPulseTime Length of thruster pulse [s]
+     */
+    ClohessyWiltshirePropagator( const Real aMeanMotion, const Real aThrustPulseTime );
+
+    //! Reset propagator to start of simulation.
+    void reset( ) { }
+
+    //! Predict end state of ballistic trajectory.
+    void predictBallisticState( const Real propagationTime,
+                                const Vector6& state,
+                                Vector6& finalState ) const;
+
+    //! Propagate state under constant thrust acceleration.
+    void propagate( const Real propagationTime,
+                    const Vector6& state,
+                    const Vector3& thrustAcceleration,
+                    Vector6& finalState );
+
+    //! Get internal state of propagator, which is empty, since the dynamics are time-invariant.
+    std::vector< Real > getInternalState( ) const { return std::vector< Real >( ); }
+
+    //! Set internal state of propagator.
+    void setInternalState( const std::vector< Real >& internalState );
+
+protected:
+private:
+
+    //! Mean motion of target's orbit [rad/s].
+    const Real meanMotion;
+
+    //! Length of thruster pulse [s].
+    const Real thrustPulseTime;
+
+    //! Clohessy-Wiltshire state transition over a single thruster pulse.
+    const ClohessyWiltshireStateTransition pulseStateTransition;
+};
+
+//! Yamanaka-Ankersen propagator.
+/*!
+ * Propagator based on the closed-form state transition of the linearised relative motion with
+ * respect to a target in an eccentric Keplerian orbit (Yamanaka & Ankersen, 2002). The state is
+ * transformed to the scaled coordinates (rho * x, with rho = 1 + e cos( theta )) and the true
+ * anomaly theta as independent variable, in which the in-plane motion is a linear combination of
+ * four fundamental solutions and the out-of-plane motion is harmonic. The true anomaly of the
+ * target is computed from the elapsed time by solving Kepler's equation. For a circular target
+ * orbit, the propagator reduces to the Clohessy-Wiltshire solution.
+ *
+ * Since the state transition is only available in closed form for ballistic motion, a constant
+ * thrust acceleration is applied as two impulses, each equal to half of the velocity change over
+ * the propagation time, at the start and end of the propagation. For a thruster pulse that is
+ * short compared to the orbital period, the error with respect to continuous thrust is of third
+ * order in the pulse length.
+ */
+class YamanakaAnkersenPropagator : public Propagator
+{
+public:
+
+    //! Construct Yamanaka-Ankersen propagator.
+    /*!
+     * @param[in] aGravitationalParameter   Gravitational parameter of central body [m^3 s^-2]
+     * @param[in] aSemiMajorAxis            Semi-major axis of target's orbit [m]
+     * @param[in] anEccentricity            Eccentricity of target's orbit [-]
+     * @param[in] anInitialTrueAnomaly      True anomaly of target at start of simulation [rad]
+     */
+    YamanakaAnkersenPropagator( const Real aGravitationalParameter,
+                                const Real aSemiMajorAxis,
+                                const Real anEccentricity,
+                                const Real anInitialTrueAnomaly );
+
+    //! Reset propagator to start of simulation.
+    void reset( ) { elapsedTime = 0.0; }
+
+    //! Predict end state of ballistic trajectory.
+    void predictBallisticState( const Real propagationTime,
+                                const Vector6& state,
+                                Vector6& finalState ) const;
+
+    //! Propagate state under constant thrust acceleration.
+    void propagate( const Real propagationTime,
+                    const Vector6& state,
+                    const Vector3& thrustAcceleration,
+                    Vector6& finalState );
+
+    //! Advance epoch of propagator without propagating a state.
+    /*!
+     * @param[in] propagationTime Propagation time [s]
+     */
+    void advance( const Real propagationTime ) { elapsedTime += propagationTime; }
+
+    //! Get internal state of propagator: time since start of simulation.
+    std::vector< Real > getInternalState( ) const
+    {
+        return std::vector< Real >( 1, elapsedTime );
+    }
+
+    //! Set internal state of propagator.
+    void setInternalState( const std::vector< Real >& internalState );
+
+    //! Compute true anomaly of target.
+    /*!
+     * Computes true anomaly of target at given time since start of simulation, by solving
+     * Kepler's equation using Newton's method.
+     *
+     * @param[in] time Time since start of simulation [s]
+     * @return         True anomaly of target [rad]
+     */
+    Real computeTrueAnomaly( const Real time ) const;
+
+protected:
+private:
+
+    //! Propagate ballistic state.
+    /*!
+     * @param[in]  startTime       Time since start of simulation at start of propagation [s]
+     * @param[in]  propagationTime Propagation time [s]
+     * @param[in]  state           Initial chaser state [m; m/s]
+     * @param[out] finalState      Final chaser state [m; m/s]
+     */
+    void propagateBallisticState( const Real startTime,
+                                  const Real propagationTime,
+                                  const Vector6& state,
+                                  Vector6& finalState ) const;
+
+    //! Eccentricity of target's orbit [-].
+    const Real eccentricity;
+
+    //! Mean motion of target's orbit [rad/s].
+    const Real meanMotion;
+
+    //! Anomaly rate constant, sqrt( mu / p^3 ), with p the semi-latus rectum [rad/s].
+    const Real anomalyRateConstant;
+
+    //! Mean anomaly of target at start of simulation [rad].
+    const Real initialMeanAnomaly;
+
+    //! Time since start of simulation [s].
+    Real elapsedTime;
+};
+
+//! J2-perturbed nonlinear propagator.
+/*!
+ * Propagator that numerically integrates the nonlinear equations of motion of target and chaser
+ * in the Earth-centred inertial frame, including the J2 perturbation, and transforms the relative
+ * state to and from the Hill frame of the target, which rotates with the instantaneous angular
+ * velocity of the perturbed target orbit. As for the other propagators, the thrust acceleration
+ * is held constant in the Hill frame during a propagation. The target orbit is initialised from
+ * its Keplerian elements at the start of the simulation, with the right ascension of the
+ * ascending node and argument of perigee set to zero.
+ *
+ * The equations of motion are integrated with either a fixed-step, fourth-order Runge-Kutta
+ * integrator, or an adaptive Dormand-Prince 5(4) integrator, whose last accepted step size is
+ * carried over to the next propagation. The integrator stages are stored in the propagator, such
+ * that no allocations take place during the simulation.
+ *
+ * Since the ballistic trajectory cannot be predicted in closed form, the prediction used by the
+ * guidance law is computed with the Yamanaka-Ankersen model of the unperturbed target orbit.
+ *
+ * @sa YamanakaAnkersenPropagator
+ */
+class J2NonlinearPropagator : public Propagator
+{
+public:
+
+    //! Define container for integrated state: target and chaser positions and velocities.
+    typedef std::array< Real, 12 > IntegrationState;
+
+    //! Construct J2-perturbed nonlinear propagator.
+    /*!
+     * @param[in] aGravitationalParameter Gravitational parameter of central body [m^3 s^-2]
+     * @param[in] aSemiMajorAxis          Semi-major axis of target's orbit [m]
+     * @param[in] someSettings            Propagator settings (target orbit, integrator and J2)
+     */
+    J2NonlinearPropagator( const Real aGravitationalParameter,
+                           const Real aSemiMajorAxis,
+                           const PropagatorSettings& someSettings );
+
+    //! Reset propagator to start of simulation.
+    void reset( );
+
+    //! Predict end state of ballistic trajectory.
+    void predictBallisticState( const Real propagationTime,
+                                const Vector6& state,
+                                Vector6& finalState ) const;
+
+    //! Propagate state under constant thrust acceleration.
+    void propagate( const Real propagationTime,
+                    const Vector6& state,
+                    const Vector3& thrustAcceleration,
+                    Vector6& finalState );
+
+    //! Get number of integration steps taken since last reset.
+    /*!
+     * @return Number of accepted integration steps
+     */
+    std::size_t getNumberOfIntegrationSteps( ) const { return numberOfIntegrationSteps; }
+
+    //! Get internal state of propagator.
+    /*!
+     * The internal state consists of the target state in the inertial frame, the step size of
+     * the adaptive integrator, the number of integration steps and the epoch of the prediction
+     * model.
+     *
+     * @return Internal state of propagator
+     */
+    std::vector< Real > getInternalState( ) const;
+
+    //! Set internal state of propagator.
+    void setInternalState( const std::vector< Real >& internalState );
+
+protected:
+private:
+
+    //! Compute Hill frame of target.
+    /*!
+     * Computes the rotation from the inertial frame to the Hill frame, stored row by row, and the
+     * angular velocity of the Hill frame, expressed in the Hill frame, for the current target
+     * state.
+     */
+    void computeHillFrame( );
+
+    //! Compute gravitational acceleration.
+    /*!
+     * @param[in]  position     Position in inertial frame [m]
+     * @param[out] acceleration Gravitational acceleration, including J2 [m/s^2]
+     */
+    void computeGravitationalAcceleration( const Real* position, Real* acceleration ) const;
+
+    //! Compute state derivative.
+    /*!
+     * @param[in]  integrationState Integrated state [m; m/s]
+     * @param[out] stateDerivative  State derivative [m/s; m/s^2]
+     */
+    void computeStateDerivative( const IntegrationState& integrationState,
+                                 IntegrationState& stateDerivative ) const;
+
+    //! Integrate equations of motion with fourth-order Runge-Kutta integrator.
+    /*!
+     * @param[in] propagationTime Propagation time [s]
+     */
+    void integrateRungeKutta4( const Real propagationTime );
+
+    //! Integrate equations of motion with Dormand-Prince 5(4) integrator.
+    /*!
+     * @param[in] propagationTime Propagation time [s]
+     */
+    void integrateDormandPrince45( const Real propagationTime );
+
+    //! Gravitational parameter of central body [m^3 s^-2].
+    const Real gravitationalParameter;
+
+    //! Propagator settings.
+    const PropagatorSettings settings;
+
+    //! Target state at start of simulation, in inertial frame [m; m/s].
+    Vector6 initialTargetState;
+
+    //! Model used to predict ballistic trajectory.
+    YamanakaAnkersenPropagator predictionModel;
+
+    //! Integrated state: target state followed by chaser state, in inertial frame [m; m/s].
+    IntegrationState integrationState;
+
+    //! Thrust acceleration in Hill frame during current propagation [m/s^2].
+    Vector3 hillThrustAcceleration;
+
+    //! Rotation from inertial frame to Hill frame, stored row by row [-].
+    std::array< Vector3, 3 > hillFrameRotation;
+
+    //! Angular velocity of Hill frame, expressed in Hill frame [rad/s].
+    Vector3 hillFrameAngularVelocity;
+
+    //! Integrator stages.
+    std::array< IntegrationState, 7 > stages;
+
+    //! Intermediate state evaluated by integrator.
+    IntegrationState intermediateState;
+
+    //! Candidate state computed by adaptive integrator.
+    IntegrationState candidateState;
+
+    //! Step size of adaptive integrator for next step [s].
+    Real adaptiveStepSize;
+
+    //! Number of accepted integration steps since last reset.
+    std::size_t numberOfIntegrationSteps;
+};
+
+//! Create propagator.
+/*!
+ * Creates the propagator selected in the user input, for the target orbit and thrust frequency
+ * given in the user input.
+ *
+ * @sa PropagatorSettings
+ * @param[in] input User input
+ * @return          Propagator
+ */
+std::unique_ptr< Propagator > createPropagator( const UserInput& input );
+
+} // namespace rvdsim
+
+#endif // RVDSIM_PROPAGATOR_HPP
@@ -0,0 +1,615 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef RVDSIM_SIMULATOR_HPP
+#define RVDSIM_SIMULATOR_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rvdsim/checkpoint.hpp"
+#include "rvdsim/outputSampler.hpp"
+#include "rvdsim/outputSink.hpp"
+#include "rvdsim/propagator.hpp"
+#include "rvdsim/thrustPolicy.hpp"
+#include "rvdsim/timeGrid.hpp"
+#include "rvdsim/typedefs.hpp"
+#include "rvdsim/unconstrainedGuidance.hpp"
+#include "rvdsim/userInput.hpp"
+
+namespace rvdsim
+{
+
+//! Standard acceleration due to gravity, used to convert specific impulse to exhaust velocity
+//! [m/s^2].
+const Real standardGravity = 9.80665;
+
+//! Compute exhaust velocity of thruster.
+/*!
+ * @param[in] specificImpulse Specific impulse of thruster [s]
+ * @return                    Exhaust velocity [m/s]; zero if specific impulse is not positive,
+ *                            i.e., if the chaser mass is constant
+ */
+inline Real computeExhaustVelocity( const Real specificImpulse )
+{
+    return specificImpulse > 0.0 ? specificImpulse * standardGravity : 0.0;
+}
+
+//! Deplete chaser mass over thruster pulse.
+/*!
+ * Computes the chaser mass at the end of a thruster pulse, during which the thrust acceleration
+ * is constant, using the rocket equation, m_1 = m_0 exp( -a dt / v_e ). The propellant consumed
+ * is thus consistent with the delta-V, a dt, accumulated over the pulse.
+ *
+ * @param[in] mass                   Chaser mass at start of thruster pulse [kg]
+ * @param[in] thrustAccelerationNorm Magnitude of thrust acceleration [m/s^2]
+ * @param[in] thrustPulseTime        Thruster pulse length [s]
+ * @param[in] exhaustVelocity        Exhaust velocity of thruster [m/s] (positive)
+ * @return                           Chaser mass at end of thruster pulse [kg]
+ */
+inline Real computeDepletedMass( const Real mass,
+                                 const Real thrustAccelerationNorm,
+                                 const Real thrustPulseTime,
+                                 const Real exhaustVelocity )
+{
+    return mass * std::exp( -thrustAccelerationNorm * thrustPulseTime / exhaustVelocity );
+}
+
+//! Summary of simulation.
+/*!
+ * Compact summary of the outcome of a single simulation, used to report the results of analyses
+ * that execute many simulations, e.g., Monte Carlo analyses.
+ */
+struct SimulationSummary
+{
+public:
+
+    //! Final distance between chaser and target [m].
+    Real finalDistanceToTarget;
+
+    //! Flag indicating if final distance is within arrival distance tolerance.
+    bool isTargetReached;
+
+    //! Total delta-V applied by thruster [m/s].
+    Real totalDeltaV;
+
+    //! Total propellant mass consumed by thruster [kg]; zero if chaser mass is constant.
+    Real propellantMass;
+
+    //! Flag indicating if thruster was throttled to its maximum.
+    bool isThrottleMax;
+
+    //! Total time during which thruster was throttled to its maximum [s].
+    Real throttleSaturationTime;
+
+    //! Epoch at which simulation ended [s].
+    Real terminationTime;
+
+    //! Flag indicating if simulation was terminated before end time.
+    bool isTerminatedEarly;
+
+    //! Flag indicating if any dispersion offset of Monte Carlo sample was redrawn.
+    bool isRedrawn;
+
+protected:
+private:
+};
+
+//! Early termination settings.
+/*!
+ * Settings that allow the simulator to stop before the end time, once the outcome of the
+ * simulation is known, e.g., when evaluating many thruster settings in a parameter sweep. By
+ * default, early termination is disabled.
+ */
+struct TerminationSettings
+{
+public:
+
+    //! Construct early termination settings.
+    /*!
+     * @param[in] isArrivalTerminationEnabledFlag Flag indicating if simulation is terminated as
+     *                                            soon as the chaser is within the arrival
+     *                                            distance tolerance (default: false)
+     * @param[in] aMaximumDistance                Distance to target beyond which simulation is
+     *                                            terminated, since the chaser is considered lost
+     *                                            [m] (default: 0, disabled)
+     */
+    TerminationSettings( const bool isArrivalTerminationEnabledFlag = false,
+                         const Real aMaximumDistance = 0.0 )
+        : isArrivalTerminationEnabled( isArrivalTerminationEnabledFlag ),
+          maximumDistance( aMaximumDistance )
+    { }
+
+    //! Flag indicating if simulation is terminated once chaser is within arrival tolerance.
+    const bool isArrivalTerminationEnabled;
+
+    //! Distance to target beyond which simulation is terminated [m] (0: disabled).
+    const Real maximumDistance;
+
+protected:
+private:
+};
+
+//! Rendezvous simulator.
+/*!
+ * Simulation engine that propagates the motion of the chaser with respect to the target under
+ * ZEM/ZEV (Zero-Effort-Miss/Zero-Effort-Velocity) feedback guidance. The relative dynamics are
+ * modelled using the propagator selected in the user input; by default, the Clohessy-Wiltshire
+ * solution for a circular target orbit is used. The guidance law predicts the ballistic
+ * trajectory over the Time-To-Go with the same propagator (see Propagator).
+ *
+ * All quantities that are constant for a given user input (mean motion, thrust pulse length,
+ * maximum thrust acceleration, thrust policy) are computed once upon construction. For the
+ * Clohessy-Wiltshire model, this includes the state transition over a single thrust pulse, such
+ * that each pulse is propagated as a sparse matrix-vector product, without evaluating
+ * trigonometric functions. The working vectors used inside the guidance loop are fixed-size
+ * members that are reused for each thrust pulse and the storage for the histories is reserved
+ * upon construction, so that the simulator can be executed repeatedly, e.g., from batch drivers,
+ * without reconstructing it or allocating memory. The time loop is specialised at compile time
+ * for each thrust policy (see ThrustPolicyType), such that the thrust mode and thruster
+ * capability are not checked for each thruster pulse.
+ *
+ * Time is represented by the index of the current thruster pulse, from which the current epoch and
+ * Time-To-Go are derived (see TimeGrid). The number of thruster pulses is thus known upon
+ * construction and the epochs in the histories and output sinks do not depend on the number of
+ * pulses taken to reach them, such that results are reproducible, e.g., after coast arcs are
+ * skipped or a simulation is resumed.
+ *
+ * If a specific impulse is given in the user input, the chaser mass is depleted for each thruster
+ * pulse (see computeDepletedMass): the thrust follows from the commanded thrust acceleration and
+ * the current mass, and the maximum thrust acceleration increases as propellant is consumed. The
+ * delta-V and propellant mass are accumulated inside the time loop, at a constant cost per pulse,
+ * so that they are available at the end of the simulation without processing the thrust history.
+ *
+ * If the Clohessy-Wiltshire model is used and the thruster is unconstrained (thrust maximum set
+ * to zero), the guidance law reduces to a linear, time-varying state feedback, and the chaser
+ * state follows the closed-loop recurrence x_k+1 = ( Phi_p + Gamma_p K_k ) x_k. In that case, the
+ * closed-loop transitions of all thruster pulses are computed once, when the simulator is
+ * constructed, and each pulse is simulated with two matrix-vector products, without computing the
+ * ZEM/ZEV, applying a thrust policy or calling the propagator. The transitions are reused each
+ * time the simulation is executed, e.g., from a different initial state. Simulations with more
+ * than maximumNumberOfClosedLoopTransitions thruster pulses use the guidance kernel instead.
+ *
+ * If adaptive scheduling is enabled in the user input and the Clohessy-Wiltshire model is used,
+ * coast arcs in on-off mode are skipped: the chaser is propagated over all thruster pulses for
+ * which the thruster is predicted to remain off in a single step. The histories and output sinks
+ * then only contain the epochs at which the guidance law is evaluated, and early termination
+ * conditions are only checked at those epochs. Both fast paths rely on properties of the
+ * time-invariant Clohessy-Wiltshire dynamics and are disabled for the other propagators.
+ *
+ * For long-running simulations, the simulator can periodically write a checkpoint to file (see
+ * setCheckpointing). A simulation that is interrupted can then be resumed from its last
+ * checkpoint, continuing bit-for-bit identically to an uninterrupted simulation (see resume).
+ *
+ * @sa UserInput, Propagator, computeUnconstrainedFeedbackGain, AdaptiveSchedulingSettings,
+ *     SimulatorCheckpoint
+ */
+class Simulator
+{
+public:
+
+    //! Construct simulator.
+    /*!
+     * Constructs simulator for given user input and pre-computes all quantities that remain
+     * constant throughout the simulation. Storing the state and thrust histories can be switched
+     * off for applications that only require the final state and the summary of the simulation,
+     * e.g., Monte Carlo analyses.
+     *
+     * @param[in] anInput               User input containing simulation settings
+     * @param[in] isHistoryStoredFlag   Flag indicating if histories should be stored
+     *                                  (default: true)
+     * @param[in] someTerminationSettings
+     *                                  Early termination settings (default: disabled)
+     */
+    Simulator( const UserInput& anInput,
+               const bool isHistoryStoredFlag = true,
+               const TerminationSettings& someTerminationSettings = TerminationSettings( ) );
+
+    //! Execute simulation.
+    /*!
+     * Executes simulation, starting from the chaser initial state provided in the user input.
+     * Histories from previous executions are cleared.
+     */
+    void execute( );
+
+    //! Execute simulation from given chaser initial state.
+    /*!
+     * Executes simulation, starting from the given chaser initial state instead of the one
+     * provided in the user input. Histories from previous executions are cleared.
+     *
+     * @param[in] chaserInitialState Chaser initial state [m; m/s]
+     */
+    void execute( const Vector6& chaserInitialState );
+
+    //! Set output sinks.
+    /*!
+     * Sets sinks to which the chaser state and thrust are streamed while the simulation is
+     * executed, with columns (t, x, y, z, xdot, ydot, zdot) and (t, Tx, Ty, Tz) respectively.
+     * Combined with switching off the storage of the histories, this keeps memory use constant
+     * for long simulations. The sinks are not owned by the simulator and must remain valid during
+     * execution; a null pointer disables streaming. The epochs that are streamed are selected
+     * according to the output sampling settings in the user input; the first and final epochs are
+     * always streamed. The histories are not affected by output sampling.
+     *
+     * The trajectory sink combines both in a single row per epoch, with columns (t, x, y, z, xdot,
+     * ydot, zdot, Tx, Ty, Tz), where the thrust is applied from t until the next epoch. Since no
+     * thrust is applied after the final epoch, the thrust in the final row is set to NaN.
+     *
+     * @param[in] aStateSink      Sink for chaser state (default: none)
+     * @param[in] aThrustSink     Sink for chaser thrust (default: none)
+     * @param[in] aTrajectorySink Sink for chaser trajectory (default: none)
+     */
+    void setOutputSinks( OutputSink* aStateSink = 0,
+                         OutputSink* aThrustSink = 0,
+                         OutputSink* aTrajectorySink = 0 );
+
+    //! Set checkpointing.
+    /*!
+     * Enables writing a checkpoint to file each time the given number of thruster pulses has been
+     * simulated, as long as the simulation has not ended. The output sinks are synchronised with
+     * their files when a checkpoint is written (see OutputSink::synchronize). An empty file path
+     * or a step interval of zero disables checkpointing.
+     *
+     * @sa writeCheckpoint
+     * @param[in] aFilePath     Path to checkpoint file
+     * @param[in] aStepInterval Number of thruster pulses between checkpoints
+     */
+    void setCheckpointing( const std::string& aFilePath, const std::size_t aStepInterval );
+
+    //! Resume simulation from checkpoint.
+    /*!
+     * Continues the simulation from the given checkpoint, which must have been created for the
+     * same user input; an error is thrown (std::runtime_error) if the settings stored in the
+     * checkpoint do not match (see SimulatorCheckpoint). To continue writing the output files,
+     * the output sinks must be reopened at the positions stored in the checkpoint before the
+     * simulation is resumed (see createOutputSink). The histories are cleared and only contain the
+     * epochs from the checkpoint onwards.
+     *
+     * @param[in] checkpoint Simulator checkpoint
+     */
+    void resume( const SimulatorCheckpoint& checkpoint );
+
+    //! Create checkpoint of current state of simulation.
+    /*!
+     * Creates checkpoint of the current state of the simulation, which can be used to resume the
+     * simulation. The output sinks are synchronised with their files.
+     *
+     * @return Simulator checkpoint
+     */
+    SimulatorCheckpoint createCheckpoint( );
+
+    //! Get chaser state history.
+    /*!
+     * Returns chaser state history generated by last execution of the simulation.
+     *
+     * @return Chaser state history [s; m, m/s]
+     */
+    const StateHistory& getChaserStateHistory( ) const { return chaserStateHistory; }
+
+    //! Get chaser thrust history.
+    /*!
+     * Returns chaser thrust history generated by last execution of the simulation.
+     *
+     * @return Chaser thrust history [s; N]
+     */
+    const ThrustHistory& getChaserThrustHistory( ) const { return chaserThrustHistory; }
+
+    //! Get chaser final state.
+    /*!
+     * Returns chaser state at the end of the last execution of the simulation.
+     *
+     * @return Chaser final state [m; m/s]
+     */
+    const Vector6& getChaserFinalState( ) const { return currentState; }
+
+    //! Get final distance to target.
+    /*!
+     * Returns distance between chaser and target at the end of the last execution of the
+     * simulation.
+     *
+     * @return Final distance to target [m]
+     */
+    Real getFinalDistanceToTarget( ) const;
+
+    //! Check if target was reached.
+    /*!
+     * Checks if the final distance to the target is within the arrival distance tolerance given in
+     * the user input.
+     *
+     * @return True if target was reached
+     */
+    bool isTargetReached( ) const;
+
+    //! Check if thruster was throttled.
+    /*!
+     * Checks if the thrust required by the guidance law exceeded the thruster capability at any
+     * point during the last execution of the simulation, such that the thruster was throttled.
+     *
+     * @return True if thruster was throttled to its maximum
+     */
+    bool isThrottleMaximumReached( ) const { return isThrottleMax; }
+
+    //! Get total delta-V.
+    /*!
+     * Returns total delta-V applied by the thruster during the last execution of the simulation,
+     * computed as the sum of the magnitudes of the thrust acceleration multiplied by the thruster
+     * pulse length.
+     *
+     * @return Total delta-V [m/s]
+     */
+    Real getTotalDeltaV( ) const { return totalDeltaV; }
+
+    //! Get total propellant mass consumed.
+    /*!
+     * Returns total propellant mass consumed by the thruster during the last execution of the
+     * simulation, which is accumulated for each thruster pulse if a specific impulse is given in
+     * the user input.
+     *
+     * @return Total propellant mass [kg]; zero if chaser mass is constant
+     */
+    Real getPropellantMass( ) const { return propellantMass; }
+
+    //! Get chaser final mass.
+    /*!
+     * Returns chaser mass at the end of the last execution of the simulation.
+     *
+     * @return Chaser final mass [kg]
+     */
+    Real getChaserFinalMass( ) const { return currentMass; }
+
+    //! Get summary of simulation.
+    /*!
+     * Returns summary of the outcome of the last execution of the simulation.
+     *
+     * @return Simulation summary
+     */
+    SimulationSummary getSummary( ) const;
+
+    //! Get maximum thrust acceleration available to chaser.
+    /*!
+     * @return Maximum thrust acceleration at chaser wet mass [m/s^2]
+     */
+    Real getThrustAccelerationMaximum( ) const { return thrustAccelerationMaximum; }
+
+    //! Get length of thruster pulse.
+    /*!
+     * @return Thruster pulse length [s]
+     */
+    Real getThrustPulseTime( ) const { return thrustPulseTime; }
+
+    //! Get number of thruster pulses from start to end time.
+    /*!
+     * @sa TimeGrid
+     * @return Number of thruster pulses
+     */
+    std::size_t getNumberOfThrustPulses( ) const { return timeGrid.getNumberOfSteps( ); }
+
+    //! Get mean motion of target's orbit.
+    /*!
+     * @return Target mean motion [rad/s]
+     */
+    Real getTargetMeanMotion( ) const { return targetMeanMotion; }
+
+    //! Check if unconstrained guidance fast path is used.
+    /*!
+     * @sa ClosedLoopTransition
+     * @return True if precomputed closed-loop transitions are used for unconstrained thruster
+     */
+    bool isUnconstrainedFastPathUsed( ) const { return isClosedLoopTransitionUsed; }
+
+protected:
+
+private:
+
+    //! Execute time loop from current state until end of simulation.
+    /*!
+     * Selects the time loop specialised for the thrust policy of the simulation and executes it.
+     *
+     * @sa ThrustPolicyType
+     */
+    void executeTimeLoop( );
+
+    //! Execute time loop specialised for thrust policy.
+    /*!
+     * Propagates the chaser from the current state until the end time or until an early
+     * termination condition is met, writing checkpoints if enabled, and streams the final epoch
+     * to the output sinks. Since the thrust policy is a template parameter, the checks of the
+     * thrust mode and thruster capability are resolved at compile time.
+     *
+     * @tparam ThrustPolicy Thrust policy (e.g., ThrottleThrustPolicy)
+     */
+    template< typename ThrustPolicy >
+    void executePolicyTimeLoop( );
+
+    //! Compute thrust acceleration using ZEM/ZEV feedback law.
+    /*!
+     * Computes thrust acceleration commanded by the ZEM/ZEV feedback law for the current state and
+     * Time-To-Go (TTG), including the constraints imposed by the thrust policy, using the fused
+     * guidance kernel (see evaluateGuidanceKernel). The result is stored in thrustAcceleration.
+     * For the Clohessy-Wiltshire model, the ballistic trajectory is predicted using the state
+     * transition over the TTG, which is updated incrementally from the previous step; for the
+     * other models, the propagator is used. If precomputed closed-loop transitions are used for an
+     * unconstrained thruster, the feedback gain of the current thruster pulse is applied instead.
+     *
+     * @tparam    ThrustPolicy Thrust policy (e.g., ThrottleThrustPolicy)
+     * @param[in] stepIndex    Index of current thruster pulse
+     * @return                 Norm of thrust acceleration [m/s^2]
+     */
+    template< typename ThrustPolicy >
+    Real computeThrustAcceleration( const std::size_t stepIndex );
+
+    //! Compute number of thruster pulses during which thruster remains off.
+    /*!
+     * Predicts the number of thruster pulses, starting with the current pulse, for which the
+     * thruster remains off, based on the ZEM and ZEV computed for the current pulse, which remain
+     * constant along the ballistic trajectory. The prediction ends at the first pulse for which
+     * the commanded thrust acceleration exceeds the switching threshold, reduced by the adaptive
+     * scheduling tolerance, or at the end of the simulation.
+     *
+     * @sa AdaptiveSchedulingSettings
+     * @return Number of thruster pulses (at least one)
+     */
+    std::size_t computeCoastPulseCount( ) const;
+
+    //! Check if early termination condition is met.
+    /*!
+     * Checks if the current state meets any of the enabled early termination conditions.
+     *
+     * @sa TerminationSettings
+     * @return True if simulation should be terminated
+     */
+    bool isTerminationConditionMet( ) const;
+
+    //! Write current time, state and thrust to output sinks.
+    /*!
+     * @param[in] thrust Chaser thrust applied from current time [N]
+     */
+    void writeOutputRows( const Vector3& thrust );
+
+    //! Write current time and state to state output sink.
+    void writeStateRow( );
+
+    //! Write current time, state and thrust to trajectory output sink.
+    /*!
+     * @param[in] thrust Chaser thrust applied from current time [N]
+     */
+    void writeTrajectoryRow( const Vector3& thrust );
+
+    //! User input.
+    const UserInput input;
+
+    //! Flag indicating if histories are stored.
+    const bool isHistoryStored;
+
+    //! Early termination settings.
+    const TerminationSettings terminationSettings;
+
+    //! Maximum thrust acceleration available to chaser at its wet mass [m/s^2].
+    const Real thrustAccelerationMaximum;
+
+    //! Thrust policy, following from thrust mode and thruster capability.
+    const ThrustPolicyType thrustPolicy;
+
+    //! Exhaust velocity of thruster [m/s]; zero if chaser mass is constant.
+    const Real exhaustVelocity;
+
+    //! Length of thruster pulse [s].
+    const Real thrustPulseTime;
+
+    //! Time grid of thruster pulses.
+    const TimeGrid timeGrid;
+
+    //! Mean motion of target's orbit [rad/s].
+    const Real targetMeanMotion;
+
+    //! Propagator of relative dynamics.
+    const std::unique_ptr< Propagator > propagator;
+
+    //! Flag indicating if Clohessy-Wiltshire model is used to propagate relative dynamics.
+    const bool isClohessyWiltshireUsed;
+
+    //! Clohessy-Wiltshire state transition over Time-To-Go (only used for Clohessy-Wiltshire
+    //! model).
+    ClohessyWiltshireTimeToGoTransition timeToGoTransition;
+
+    //! Flag indicating if precomputed closed-loop transitions are used for unconstrained thruster.
+    const bool isClosedLoopTransitionUsed;
+
+    //! Closed-loop transitions for all thruster pulses (only used for unconstrained thruster with
+    //! Clohessy-Wiltshire model).
+    std::vector< ClosedLoopTransition > closedLoopTransitions;
+
+    //! Flag indicating if coast arcs are skipped using adaptive scheduling.
+    const bool isCoastSkipped;
+
+    //! Zero thrust acceleration [m/s^2].
+    const Vector3 zeroThrustAcceleration;
+
+    //! Index of current thruster pulse.
+    std::size_t currentStepIndex;
+
+    //! Current epoch, derived from index of current thruster pulse [s].
+    Real currentTime;
+
+    //! Current Time-To-Go (TTG), derived from index of current thruster pulse [s].
+    Real timeToGo;
+
+    //! Current chaser state [m; m/s].
+    Vector6 currentState;
+
+    //! Current chaser mass [kg].
+    Real currentMass;
+
+    //! Maximum thrust acceleration available to chaser at current mass [m/s^2].
+    Real currentThrustAccelerationMaximum;
+
+    //! End state resulting from ballistic trajectory over TTG [m; m/s].
+    Vector6 zeroThrustEndState;
+
+    //! Zero-Effort-Miss (ZEM) [m].
+    Vector3 zeroEffortMiss;
+
+    //! Zero-Effort-Velocity (ZEV) [m/s].
+    Vector3 zeroEffortVelocity;
+
+    //! Thrust acceleration commanded for current thruster pulse [m/s^2].
+    Vector3 thrustAcceleration;
+
+    //! Chaser thrust for current thruster pulse [N].
+    Vector3 chaserThrust;
+
+    //! Flag indicating if thruster is throttled to its maximum during current thruster pulse.
+    bool isThrottleSaturated;
+
+    //! Flag indicating if thruster was throttled to its maximum.
+    bool isThrottleMax;
+
+    //! Total delta-V applied by thruster [m/s].
+    Real totalDeltaV;
+
+    //! Total propellant mass consumed by thruster [kg].
+    Real propellantMass;
+
+    //! Total time during which thruster was throttled to its maximum [s].
+    Real throttleSaturationTime;
+
+    //! Flag indicating if simulation was terminated before end time.
+    bool isTerminatedEarly;
+
+    //! Sink to which chaser state is streamed (not owned).
+    OutputSink* stateSink;
+
+    //! Sink to which chaser thrust is streamed (not owned).
+    OutputSink* thrustSink;
+
+    //! Sink to which chaser trajectory is streamed (not owned).
+    OutputSink* trajectorySink;
+
+    //! Output sampler selecting epochs that are streamed to output sinks.
+    OutputSampler outputSampler;
+
+    //! Path to checkpoint file; empty if no checkpoints are written.
+    std::string checkpointFilePath;
+
+    //! Number of thruster pulses between checkpoints.
+    std::size_t checkpointStepInterval;
+
+    //! Index of thruster pulse after which next checkpoint is written.
+    std::size_t nextCheckpointStepIndex;
+
+    //! Chaser state history.
+    StateHistory chaserStateHistory;
+
+    //! Chaser thrust history.
+    ThrustHistory chaserThrustHistory;
+};
+
+} // namespace rvdsim
+
+#endif // RVDSIM_SIMULATOR_HPP
@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef RVDSIM_THREAD_POOL_HPP
+#define RVDSIM_THREAD_POOL_HPP
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace rvdsim
+{
+
+//! Work-stealing thread pool.
+/*!
+ * Thread pool that executes submitted tasks on a fixed set of worker threads. Each worker owns a
+ * task queue. Submitted tasks are distributed over the queues in round-robin fashion. Workers
+ * execute tasks from the back of their own queue and, once their own queue is empty, steal tasks
+ * from the front of the queues of other workers, so that the load stays balanced when tasks have
+ * very different execution times.
+ *
+ * Tasks must not throw exceptions.
+ */
+class ThreadPool
+{
+public:
+
+    //! Define type of task executed by thread pool.
+    typedef std::function< void( ) > Task;
+
+    //! Construct thread pool.
+    /*!
+     * Constructs thread pool and starts worker threads.
+     *
+     * @param[in] aNumberOfThreads Number of worker threads (default: 0, which sets the number of
+     *                             threads equal to the number of hardware threads available)
+     */
+    explicit ThreadPool( const std::size_t aNumberOfThreads = 0 );
+
+    //! Destruct thread pool.
+    /*!
+     * Waits for all submitted tasks to be completed and joins worker threads.
+     */
+    ~ThreadPool( );
+
+    //! Submit task.
+    /*!
+     * Submits task for execution by one of the worker threads.
+     *
+     * @param[in] task Task to execute
+     */
+    void submit( const Task& task );
+
+    //! Wait for completion of all tasks.
+    /*!
+     * Blocks until all tasks submitted so far have been completed.
+     */
+    void wait( );
+
+    //! Get number of worker threads.
+    /*!
+     * @return Number of worker threads
+     */
+    std::size_t getNumberOfThreads( ) const { return workers.size( ); }
+
+protected:
+
+private:
+
+    //! Task queue owned by a worker thread.
+    struct TaskQueue
+    {
+        //! Mutex guarding tasks.
+        std::mutex mutex;
+
+        //! Queued tasks.
+        std::deque< Task > tasks;
+    };
+
+    //! Execute worker loop.
+    /*!
+     * Executes tasks until the thread pool is destructed.
+     *
+     * @param[in] workerIndex Index of worker executing loop
+     */
+    void executeWorker( const std::size_t workerIndex );
+
+    //! Take task from queues.
+    /*!
+     * Takes task from back of own queue or, if own queue is empty, from front of queue of another
+     * worker. Must be called with the state mutex held, after claiming a queued task.
+     *
+     * @param[in]  workerIndex Index of worker taking task
+     * @param[out] task        Task taken from queues
+     */
+    void takeTask( const std::size_t workerIndex, Task& task );
+
+    //! Task queues, one per worker.
+    std::vector< std::unique_ptr< TaskQueue > > queues;
+
+    //! Worker threads.
+    std::vector< std::thread > workers;
+
+    //! Mutex guarding task counters and stop flag.
+    std::mutex stateMutex;
+
+    //! Condition signalled when tasks are queued or the pool is stopped.
+    std::condition_variable taskQueued;
+
+    //! Condition signalled when all tasks have been completed.
+    std::condition_variable tasksCompleted;
+
+    //! Number of tasks that are queued and not yet claimed by a worker.
+    std::size_t numberOfQueuedTasks;
+
+    //! Number of tasks that are submitted and not yet completed.
+    std::size_t numberOfPendingTasks;
+
+    //! Index of queue that next submitted task is added to.
+    std::size_t nextQueueIndex;
+
+    //! Flag indicating that the pool is being destructed.
+    bool isStopping;
+};
+
+//! Execute parallel loop.
+/*!
+ * Executes function for all indices in the range [0, numberOfIterations) using the given thread
+ * pool. The range is split into chunks of given size, which are submitted as separate tasks. This
+ * function blocks until all iterations have been completed.
+ *
+ * The function is called concurrently from different threads and should therefore only write to
+ * data that is unique to the index it is called with.
+ *
+ * @tparam    Function           Type of function, callable as function( std::size_t )
+ * @param[in] threadPool         Thread pool used to execute iterations
+ * @param[in] numberOfIterations Number of iterations
+ * @param[in] chunkSize          Number of iterations per task
+ * @param[in] function           Function executed for each index
+ */
+template< typename Function >
+void executeParallelLoop( ThreadPool& threadPool,
+                          const std::size_t numberOfIterations,
+                          const std::size_t chunkSize,
+                          const Function& function )
+{
+    const std::size_t iterationsPerTask = std::max< std::size_t >( chunkSize, 1 );
+    for ( std::size_t begin = 0; begin < numberOfIterations; begin += iterationsPerTask )
+    {
+        const std::size_t end = std::min( begin + iterationsPerTask, numberOfIterations );
+        threadPool.submit( [ begin, end, &function ]( )
+        {
+            for ( std::size_t i = begin; i < end; ++i )
+            {
+                function( i );
+            }
+        } );
+    }
+    threadPool.wait( );
+}
+
+} // namespace rvdsim
+
+#endif // RVDSIM_THREAD_POOL_HPP
@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef RVDSIM_THRUST_POLICY_HPP
+#define RVDSIM_THRUST_POLICY_HPP
+
+#include <cmath>
+
+#include "rvdsim/typedefs.hpp"
+#include "rvdsim/userInput.hpp"
+
+namespace rvdsim
+{
+
+//! Thrust policy types.
+/*!
+ * Definition of the thrust policies, which follow from the thrust mode and the thruster
+ * capability, and which determine how the thrust acceleration commanded by the guidance law is
+ * applied:
+ *  - noThrustPolicy            : thruster is switched off (see NoThrustPolicy)
+ *  - unconstrainedThrustPolicy : commanded thrust acceleration is applied as is
+ *                                (see UnconstrainedThrustPolicy)
+ *  - throttleThrustPolicy      : commanded thrust acceleration is throttled to the maximum
+ *                                (see ThrottleThrustPolicy)
+ *  - onOffThrustPolicy         : thruster is switched on at maximum thrust or off
+ *                                (see OnOffThrustPolicy)
+ *
+ * Since the policy is fixed for a simulation, the simulator selects the time loop specialised for
+ * the policy once, such that the policy does not have to be checked for each thruster pulse.
+ */
+enum ThrustPolicyType
+{
+    noThrustPolicy,
+    unconstrainedThrustPolicy,
+    throttleThrustPolicy,
+    onOffThrustPolicy
+};
+
+//! Thrust policy for thruster that is switched off.
+struct NoThrustPolicy
+{
+public:
+
+    //! Flag indicating if guidance law is evaluated.
+    static const bool isGuidanceEvaluated = false;
+
+    //! Flag indicating if commanded thrust acceleration is constrained.
+    static const bool isConstrained = false;
+
+    //! Flag indicating if thruster switches between zero and maximum thrust.
+    static const bool isSwitched = false;
+
+    //! Compute scale factor applied to commanded thrust acceleration.
+    /*!
+     * @param[in]  thrustAccelerationNorm    Magnitude of commanded thrust acceleration [m/s^2]
+     * @param[in]  thrustAccelerationMaximum Maximum thrust acceleration [m/s^2]
+     * @param[out] isSaturated               Flag indicating if thruster is throttled
+     * @return                               Scale factor [-]
+     */
+    static Real computeScaleFactor( const Real thrustAccelerationNorm,
+                                    const Real thrustAccelerationMaximum,
+                                    bool& isSaturated )
+    {
+        static_cast< void >( thrustAccelerationNorm );
+        static_cast< void >( thrustAccelerationMaximum );
+        isSaturated = false;
+        return 0.0;
+    }
+
+protected:
+private:
+};
+
+//! Thrust policy for unconstrained thruster.
+struct UnconstrainedThrustPolicy
+{
+public:
+
+    //! Flag indicating if guidance law is evaluated.
+    static const bool isGuidanceEvaluated = true;
+
+    //! Flag indicating if commanded thrust acceleration is constrained.
+    static const bool isConstrained = false;
+
+    //! Flag indicating if thruster switches between zero and maximum thrust.
+    static const bool isSwitched = false;
+
+    //! Compute scale factor applied to commanded thrust acceleration.
+    /*!
+     * @sa NoThrustPolicy::computeScaleFactor
+     */
+    static Real computeScaleFactor( const Real thrustAccelerationNorm,
+                                    const Real thrustAccelerationMaximum,
+                                    bool& isSaturated )
+    {
+        static_cast< void >( thrustAccelerationNorm );
+        static_cast< void >( thrustAccelerationMaximum );
+        isSaturated = false;
+        return 1.0;
+    }
+
+protected:
+private:
+};
+
+//! Thrust policy for throttled thruster.
+/*!
+ * If the magnitude of the commanded thrust acceleration exceeds the maximum thrust acceleration,
+ * the thrust acceleration is scaled down to the maximum, keeping its direction.
+ */
+struct ThrottleThrustPolicy
+{
+public:
+
+    //! Flag indicating if guidance law is evaluated.
+    static const bool isGuidanceEvaluated = true;
+
+    //! Flag indicating if commanded thrust acceleration is constrained.
+    static const bool isConstrained = true;
+
+    //! Flag indicating if thruster switches between zero and maximum thrust.
+    static const bool isSwitched = false;
+
+    //! Compute scale factor applied to commanded thrust acceleration.
+    /*!
+     * @sa NoThrustPolicy::computeScaleFactor
+     */
+    static Real computeScaleFactor( const Real thrustAccelerationNorm,
+                                    const Real thrustAccelerationMaximum,
+                                    bool& isSaturated )
+    {
+        isSaturated = thrustAccelerationNorm > thrustAccelerationMaximum;
+        return isSaturated ? thrustAccelerationMaximum / thrustAccelerationNorm : 1.0;
+    }
+
+protected:
+private:
+};
+
+//! Thrust policy for on-off thruster.
+/*!
+ * If the magnitude of the commanded thrust acceleration exceeds the switching threshold, i.e.,
+ * half the maximum thrust acceleration, the thruster is switched on at maximum thrust in the
+ * commanded direction; otherwise, the thruster is switched off.
+ */
+struct OnOffThrustPolicy
+{
+public:
+
+    //! Flag indicating if guidance law is evaluated.
+    static const bool isGuidanceEvaluated = true;
+
+    //! Flag indicating if commanded thrust acceleration is constrained.
+    static const bool isConstrained = true;
+
+    //! Flag indicating if thruster switches between zero and maximum thrust.
+    static const bool isSwitched = true;
+
+    //! Compute switching threshold.
+    /*!
+     * @param[in] thrustAccelerationMaximum Maximum thrust acceleration [m/s^2]
+     * @return                              Switching threshold [m/s^2]
+     */
+    static Real computeSwitchingThreshold( const Real thrustAccelerationMaximum )
+    {
+        return thrustAccelerationMaximum / 2.0;
+    }
+
+    //! Compute scale factor applied to commanded thrust acceleration.
+    /*!
+     * @sa NoThrustPolicy::computeScaleFactor
+     */
+    static Real computeScaleFactor( const Real thrustAccelerationNorm,
+                                    const Real thrustAccelerationMaximum,
+                                    bool& isSaturated )
+    {
+        isSaturated = false;
+        return thrustAccelerationNorm > computeSwitchingThreshold( thrustAccelerationMaximum )
+               ? thrustAccelerationMaximum / thrustAccelerationNorm : 0.0;
+    }
+
+protected:
+private:
+};
+
+//! Select thrust policy.
+/*!
+ * Selects thrust policy for given thrust mode and thruster capability. A thruster without
+ * maximum thrust acceleration is unconstrained, unless it is switched off.
+ *
+ * @sa ThrustPolicyType
+ * @param[in] thrustMode                Thrust mode
+ * @param[in] thrustAccelerationMaximum Maximum thrust acceleration [m/s^2]
+ * @return                              Thrust policy type
+ */
+ThrustPolicyType selectThrustPolicy( const ThrustMode thrustMode,
+                                     const Real thrustAccelerationMaximum );
+
+//! Apply thrust policy to commanded thrust acceleration.
+/*!
+ * Scales the commanded thrust acceleration according to the given thrust policy. For policies
+ * that do not constrain the thrust acceleration, this reduces to a no-op at compile time.
+ *
+ * @tparam        ThrustPolicy              Thrust policy
+ * @param[in]     thrustAccelerationMaximum Maximum thrust acceleration [m/s^2]
+ * @param[in,out] thrustAcceleration        Thrust acceleration [m/s^2]
+ * @return                                  True if thruster is throttled to its maximum
+ */
+template< typename ThrustPolicy >
+inline bool applyThrustPolicy( const Real thrustAccelerationMaximum, Vector3& thrustAcceleration )
+{
+    if ( !ThrustPolicy::isConstrained )
+    {
+        return false;
+    }
+
+    const Real thrustAccelerationNorm
+        = std::sqrt( thrustAcceleration[ 0 ] * thrustAcceleration[ 0 ]
+                     + thrustAcceleration[ 1 ] * thrustAcceleration[ 1 ]
+                     + thrustAcceleration[ 2 ] * thrustAcceleration[ 2 ] );
+
+    bool isSaturated = false;
+    const Real scaleFactor = ThrustPolicy::computeScaleFactor(
+        thrustAccelerationNorm, thrustAccelerationMaximum, isSaturated );
+    for ( int i = 0; i < 3; ++i )
+    {
+        thrustAcceleration[ i ] *= scaleFactor;
+    }
+
+    return isSaturated;
+}
+
+} // namespace rvdsim
+
+#endif // RVDSIM_THRUST_POLICY_HPP
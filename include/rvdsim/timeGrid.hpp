@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef RVDSIM_TIME_GRID_HPP
+#define RVDSIM_TIME_GRID_HPP
+
+#include <cstddef>
+
+#include "rvdsim/typedefs.hpp"
+
+namespace rvdsim
+{
+
+//! Relative tolerance used to round number of thruster pulses to nearest integer.
+const Real timeGridRelativeTolerance = 1.0e-9;
+
+//! Compute number of thruster pulses in simulation.
+/*!
+ * Computes the number of thruster pulses needed to cover the given duration, i.e., the smallest
+ * number of steps n for which n times the pulse length is not shorter than the duration. If the
+ * duration is an integer multiple of the pulse length up to rounding errors (relative tolerance of
+ * timeGridRelativeTolerance), no additional pulse is added for the rounding remainder. The result
+ * does not depend on the order in which floating-point operations are carried out, such that it is
+ * identical for all simulations with the same settings.
+ *
+ * @param[in] duration        Simulation duration [s]
+ * @param[in] thrustPulseTime Thruster pulse length [s]
+ * @return                    Number of thruster pulses
+ */
+std::size_t computeNumberOfThrustPulses( const Real duration, const Real thrustPulseTime );
+
+//! Time grid of thruster pulses.
+/*!
+ * Time base of a simulation, in which time is represented by the integer index of the thruster
+ * pulse. The epoch and Time-To-Go (TTG) at a step are derived from the step index, instead of
+ * being accumulated from one pulse to the next, such that they carry a single rounding error
+ * irrespective of the number of steps taken, and the number of steps is known before the
+ * simulation starts. The Time-To-Go at the last pulse is the remainder of the duration, which is
+ * shorter than the pulse length if the duration is not an integer multiple of it.
+ *
+ * @sa computeNumberOfThrustPulses
+ */
+class TimeGrid
+{
+public:
+
+    //! Construct time grid.
+    /*!
+     * @param[in] aStartTime       Simulation start time [s]
+     * @param[in] anEndTime        Simulation end time [s]
+     * @param[in] aThrustPulseTime Thruster pulse length [s]
+     */
+    TimeGrid( const Real aStartTime, const Real anEndTime, const Real aThrustPulseTime );
+
+    //! Get number of thruster pulses.
+    /*!
+     * @return Number of thruster pulses
+     */
+    std::size_t getNumberOfSteps( ) const { return numberOfSteps; }
+
+    //! Get thruster pulse length.
+    /*!
+     * @return Thruster pulse length [s]
+     */
+    Real getThrustPulseTime( ) const { return thrustPulseTime; }
+
+    //! Get epoch at start of thruster pulse.
+    /*!
+     * @param[in] stepIndex Index of thruster pulse (number of pulses at end of simulation)
+     * @return              Epoch [s]
+     */
+    Real getEpoch( const std::size_t stepIndex ) const
+    {
+        return startTime + static_cast< Real >( stepIndex ) * thrustPulseTime;
+    }
+
+    //! Get Time-To-Go at start of thruster pulse.
+    /*!
+     * @param[in] stepIndex Index of thruster pulse (number of pulses at end of simulation)
+     * @return              Time-To-Go [s]
+     */
+    Real getTimeToGo( const std::size_t stepIndex ) const
+    {
+        return duration - static_cast< Real >( stepIndex ) * thrustPulseTime;
+    }
+
+protected:
+private:
+
+    //! Simulation start time [s].
+    const Real startTime;
+
+    //! Simulation duration [s].
+    const Real duration;
+
+    //! Thruster pulse length [s].
+    const Real thrustPulseTime;
+
+    //! Number of thruster pulses.
+    const std::size_t numberOfSteps;
+};
+
+} // namespace rvdsim
+
+#endif // RVDSIM_TIME_GRID_HPP
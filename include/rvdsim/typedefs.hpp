@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef RVDSIM_TYPEDEFS_HPP
+#define RVDSIM_TYPEDEFS_HPP
+
+#include <array>
+#include <cmath>
+
+#include <astro/astro.hpp>
+
+#include "rvdsim/history.hpp"
+#include "rvdsim/vectorBatch.hpp"
+
+namespace rvdsim
+{
+
+//! Define type for real, floating-point numbers.
+typedef double Real;
+
+//! Define container for vector of length 3.
+typedef std::array< Real, 3 > Vector3;
+
+//! Define container for vector of length 6.
+typedef std::array< Real, 6 > Vector6;
+
+//! Define container for 6x6 matrix, stored row by row.
+typedef std::array< std::array< Real, 6 >, 6 > Matrix66;
+
+//! Define container for 6x3 matrix, stored row by row.
+typedef std::array< std::array< Real, 3 >, 6 > Matrix63;
+
+//! Define container for 3x6 matrix, stored row by row.
+typedef std::array< std::array< Real, 6 >, 3 > Matrix36;
+
+//! Define container for state history.
+typedef History< Real, 6 > StateHistory;
+
+//! Define container for thrust history.
+typedef History< Real, 3 > ThrustHistory;
+
+//! Define container for batch of states.
+typedef VectorBatch< Real, 6 > StateBatch;
+
+//! Define container for batch of accelerations.
+typedef VectorBatch< Real, 3 > AccelerationBatch;
+
+} // namespace rvdsim
+
+#endif // RVDSIM_TYPEDEFS_HPP
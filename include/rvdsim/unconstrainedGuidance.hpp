@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef RVDSIM_UNCONSTRAINED_GUIDANCE_HPP
+#define RVDSIM_UNCONSTRAINED_GUIDANCE_HPP
+
+#include <cstddef>
+
+#include "rvdsim/clohessyWiltshire.hpp"
+#include "rvdsim/typedefs.hpp"
+
+namespace rvdsim
+{
+
+//! Compute feedback gain of unconstrained ZEM/ZEV guidance.
+/*!
+ * For an unconstrained thruster, the ZEM/ZEV guidance law applied to the linear
+ * Clohessy-Wiltshire dynamics is a linear, time-varying state feedback: the thrust acceleration
+ * commanded at step k is a_k = K_k x_k, with
+ *
+ *   K_k = [ -6 / tgo_k^2 I, 2 / tgo_k I ] Phi( tgo_k ),
+ *
+ * where Phi( tgo_k ) is the Clohessy-Wiltshire state transition matrix over the Time-To-Go at
+ * step k. The gain is formed from the state transition over the Time-To-Go that is maintained
+ * incrementally for each thruster pulse (see ClohessyWiltshireTimeToGoTransition), such that no
+ * trigonometric functions are evaluated.
+ *
+ * @param[in]  timeToGoTransition Clohessy-Wiltshire state transition over Time-To-Go
+ * @param[in]  timeToGo           Time-To-Go [s]
+ * @param[out] feedbackGain       Feedback gain K_k [s^-2; s^-1]
+ */
+inline void computeUnconstrainedFeedbackGain(
+    const ClohessyWiltshireStateTransition& timeToGoTransition,
+    const Real timeToGo,
+    Matrix36& feedbackGain )
+{
+    const Matrix66& phi = timeToGoTransition.stateTransitionMatrix;
+
+    // ZEM and ZEV are the negative of the ballistic end position and velocity, such that
+    // a = 6 ZEM / tgo^2 - 2 ZEV / tgo = -6 / tgo^2 Phi_r x + 2 / tgo Phi_v x.
+    const Real positionGain = -6.0 / ( timeToGo * timeToGo );
+    const Real velocityGain = 2.0 / timeToGo;
+    for ( int i = 0; i < 3; ++i )
+    {
+        for ( int j = 0; j < 6; ++j )
+        {
+            feedbackGain[ i ][ j ]
+                = positionGain * phi[ i ][ j ] + velocityGain * phi[ i + 3 ][ j ];
+        }
+    }
+}
+
+//! Compute thrust acceleration of unconstrained ZEM/ZEV guidance.
+/*!
+ * @sa computeUnconstrainedFeedbackGain
+ * @param[in]  feedbackGain       Feedback gain K_k [s^-2; s^-1]
+ * @param[in]  state              Current state [m; m/s]
+ * @param[out] thrustAcceleration Thrust acceleration [m/s^2]
+ */
+inline void computeUnconstrainedThrustAcceleration( const Matrix36& feedbackGain,
+                                                    const Vector6& state,
+                                                    Vector3& thrustAcceleration )
+{
+    for ( int i = 0; i < 3; ++i )
+    {
+        thrustAcceleration[ i ] = feedbackGain[ i ][ 0 ] * state[ 0 ]
+                                  + feedbackGain[ i ][ 1 ] * state[ 1 ]
+                                  + feedbackGain[ i ][ 2 ] * state[ 2 ]
+                                  + feedbackGain[ i ][ 3 ] * state[ 3 ]
+                                  + feedbackGain[ i ][ 4 ] * state[ 4 ]
+                                  + feedbackGain[ i ][ 5 ] * state[ 5 ];
+    }
+}
+
+//! Closed-loop transition of unconstrained ZEM/ZEV guidance over a thruster pulse.
+/*!
+ * Under the linear feedback a_k = K_k x_k, the Clohessy-Wiltshire state at the end of thruster
+ * pulse k follows from the closed-loop recurrence
+ *
+ *   x_k+1 = ( Phi_p + Gamma_p K_k ) x_k,
+ *
+ * where Phi_p and Gamma_p are the state transition and input matrices over the thruster pulse.
+ * The closed-loop matrix only depends on the mean motion, thruster pulse length and Time-To-Go,
+ * and not on the state, such that it can be computed once for all thruster pulses and reused for
+ * every simulation from a different initial state.
+ *
+ * @sa computeClosedLoopTransition, propagateClosedLoop
+ */
+struct ClosedLoopTransition
+{
+public:
+
+    //! Closed-loop state transition matrix Phi_p + Gamma_p K_k [-, s; s^-1, -].
+    Matrix66 stateTransitionMatrix;
+
+    //! Feedback gain K_k [s^-2; s^-1].
+    Matrix36 feedbackGain;
+
+protected:
+private:
+};
+
+//! Maximum number of thruster pulses for which closed-loop transitions are stored.
+/*!
+ * A closed-loop transition takes 432 bytes, such that the transitions of a simulation take at most
+ * about 28 MB. Simulations with more thruster pulses use the guidance kernel instead.
+ */
+const std::size_t maximumNumberOfClosedLoopTransitions = 65536;
+
+//! Compute closed-loop transition of unconstrained ZEM/ZEV guidance.
+/*!
+ * @sa ClosedLoopTransition
+ * @param[in]  pulseTransition      Clohessy-Wiltshire state transition over thruster pulse
+ * @param[in]  feedbackGain         Feedback gain K_k [s^-2; s^-1]
+ * @param[out] closedLoopTransition Closed-loop transition over thruster pulse
+ */
+inline void computeClosedLoopTransition( const ClohessyWiltshireStateTransition& pulseTransition,
+                                         const Matrix36& feedbackGain,
+                                         ClosedLoopTransition& closedLoopTransition )
+{
+    const Matrix66& phi = pulseTransition.stateTransitionMatrix;
+    const Matrix63& gamma = pulseTransition.inputMatrix;
+
+    closedLoopTransition.feedbackGain = feedbackGain;
+    for ( int i = 0; i < 6; ++i )
+    {
+        for ( int j = 0; j < 6; ++j )
+        {
+            closedLoopTransition.stateTransitionMatrix[ i ][ j ]
+                = phi[ i ][ j ] + gamma[ i ][ 0 ] * feedbackGain[ 0 ][ j ]
+                  + gamma[ i ][ 1 ] * feedbackGain[ 1 ][ j ]
+                  + gamma[ i ][ 2 ] * feedbackGain[ 2 ][ j ];
+        }
+    }
+}
+
+//! Propagate state over thruster pulse using closed-loop transition.
+/*!
+ * @sa ClosedLoopTransition
+ * @param[in]  closedLoopTransition Closed-loop transition over thruster pulse
+ * @param[in]  state                State at start of thruster pulse [m; m/s]
+ * @param[out] finalState           State at end of thruster pulse [m; m/s]; may be the same
+ *                                  object as the state at the start of the pulse
+ */
+inline void propagateClosedLoop( const ClosedLoopTransition& closedLoopTransition,
+                                 const Vector6& state,
+                                 Vector6& finalState )
+{
+    const Matrix66& phi = closedLoopTransition.stateTransitionMatrix;
+    const Vector6 initialState = state;
+    for ( int i = 0; i < 6; ++i )
+    {
+        finalState[ i ] = phi[ i ][ 0 ] * initialState[ 0 ]
+                          + phi[ i ][ 1 ] * initialState[ 1 ]
+                          + phi[ i ][ 2 ] * initialState[ 2 ]
+                          + phi[ i ][ 3 ] * initialState[ 3 ]
+                          + phi[ i ][ 4 ] * initialState[ 4 ]
+                          + phi[ i ][ 5 ] * initialState[ 5 ];
+    }
+}
+
+} // namespace rvdsim
+
+#endif // RVDSIM_UNCONSTRAINED_GUIDANCE_HPP
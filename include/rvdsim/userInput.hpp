@@ -7,10 +7,13 @@
 #ifndef RVDSIM_USER_INPUT_HPP
 #define RVDSIM_USER_INPUT_HPP
 
+#include <iostream>
 #include <string>
 
 #include <rapidjson/document.h>
 
+#include "rvdsim/outputSampler.hpp"
+#include "rvdsim/outputSink.hpp"
 #include "rvdsim/typedefs.hpp"
 
 namespace rvdsim
@@ -33,6 +36,186 @@ enum ThrustMode
     onOff
 };
 
+//! Relative dynamics model used to propagate the chaser.
+/*!
+ * Definition of propagators:
+ *  - clohessy_wiltshire  : closed-form solution of the linearised relative motion with respect to a
+ *                          target in a circular orbit
+ *  - yamanaka_ankersen   : closed-form state transition of the linearised relative motion with
+ *                          respect to a target in an eccentric orbit (Yamanaka & Ankersen, 2002)
+ *  - j2_nonlinear        : numerical integration of the nonlinear relative motion, including the
+ *                          J2 perturbation acting on both chaser and target
+ */
+enum PropagatorType
+{
+    clohessyWiltshirePropagator,
+    yamanakaAnkersenPropagator,
+    j2NonlinearPropagator
+};
+
+//! Numerical integrator used by propagators that integrate the equations of motion.
+enum IntegratorType
+{
+    rungeKutta4Integrator,
+    dormandPrince45Integrator
+};
+
+//! Propagator settings.
+/*!
+ * Settings that select the relative dynamics model and, for the models that support it, the
+ * target orbit and numerical integrator. The target orbit is defined by its semi-major axis, given
+ * in the user input, and the eccentricity, inclination and true anomaly at the start time given
+ * here; the right ascension of the ascending node and argument of perigee are set to zero. By
+ * default, the Clohessy-Wiltshire model is used, for which the state transition over the
+ * Time-To-Go is updated incrementally within the transition tolerance (see
+ * ClohessyWiltshireTimeToGoTransition).
+ */
+struct PropagatorSettings
+{
+public:
+
+    //! Construct propagator settings.
+    /*!
+     * @param[in] aPropagatorType           Propagator type (default: Clohessy-Wiltshire)
+     * @param[in] aTargetEccentricity       Target eccentricity [-] (default: 0)
+     * @param[in] aTargetInclination        Target inclination [rad] (default: 0)
+     * @param[in] aTargetInitialTrueAnomaly Target true anomaly at start time [rad] (default: 0)
+     * @param[in] anIntegratorType          Numerical integrator (default: Dormand-Prince 5(4))
+     * @param[in] aStepSize                 Step size of fixed-step integrator and initial step
+     *                                      size of adaptive integrator [s] (default: 10)
+     * @param[in] aTolerance                Relative tolerance of adaptive integrator [-]
+     *                                      (default: 1e-12)
+     * @param[in] anEarthJ2                 Earth J2 coefficient [-] (default: 1.08262668e-3)
+     * @param[in] anEarthEquatorialRadius   Earth equatorial radius [m] (default: 6378137)
+     * @param[in] aTransitionTolerance      Tolerance of Clohessy-Wiltshire state transition over
+     *                                      Time-To-Go [-] (default: 1e-12)
+     */
+    PropagatorSettings( const PropagatorType aPropagatorType = clohessyWiltshirePropagator,
+                        const Real aTargetEccentricity = 0.0,
+                        const Real aTargetInclination = 0.0,
+                        const Real aTargetInitialTrueAnomaly = 0.0,
+                        const IntegratorType anIntegratorType = dormandPrince45Integrator,
+                        const Real aStepSize = 10.0,
+                        const Real aTolerance = 1.0e-12,
+                        const Real anEarthJ2 = 1.08262668e-3,
+                        const Real anEarthEquatorialRadius = 6378137.0,
+                        const Real aTransitionTolerance = 1.0e-12 )
+        : propagatorType( aPropagatorType ),
+          targetEccentricity( aTargetEccentricity ),
+          targetInclination( aTargetInclination ),
+          targetInitialTrueAnomaly( aTargetInitialTrueAnomaly ),
+          integratorType( anIntegratorType ),
+          stepSize( aStepSize ),
+          tolerance( aTolerance ),
+          earthJ2( anEarthJ2 ),
+          earthEquatorialRadius( anEarthEquatorialRadius ),
+          transitionTolerance( aTransitionTolerance )
+    { }
+
+    //! Propagator type.
+    const PropagatorType propagatorType;
+
+    //! Target eccentricity [-].
+    const Real targetEccentricity;
+
+    //! Target inclination [rad].
+    const Real targetInclination;
+
+    //! Target true anomaly at start time [rad].
+    const Real targetInitialTrueAnomaly;
+
+    //! Numerical integrator.
+    const IntegratorType integratorType;
+
+    //! Step size of fixed-step integrator and initial step size of adaptive integrator [s].
+    const Real stepSize;
+
+    //! Relative tolerance of adaptive integrator [-].
+    const Real tolerance;
+
+    //! Earth J2 coefficient [-].
+    const Real earthJ2;
+
+    //! Earth equatorial radius [m].
+    const Real earthEquatorialRadius;
+
+    //! Tolerance on absolute error of trigonometric terms of Clohessy-Wiltshire state transition
+    //! over Time-To-Go, which is updated incrementally from one thruster pulse to the next [-].
+    const Real transitionTolerance;
+
+protected:
+private:
+};
+
+//! Adaptive control-update scheduling settings.
+/*!
+ * By default, the guidance law is evaluated for each thruster pulse. If adaptive scheduling is
+ * enabled, the simulator skips ahead over coast arcs in on-off mode: as long as the thruster is
+ * off, the chaser follows a ballistic trajectory, such that the ZEM and ZEV remain constant and
+ * the next thruster pulse for which the thruster is switched on can be predicted analytically. The
+ * chaser is then propagated over the complete coast arc in a single Clohessy-Wiltshire step, which
+ * spans an integer number of thruster pulses. The tolerance is the relative margin on the switching
+ * threshold (half the maximum thrust acceleration) that is used for the prediction, such that the
+ * guidance law is evaluated again slightly before the thruster is predicted to switch on.
+ */
+struct AdaptiveSchedulingSettings
+{
+public:
+
+    //! Construct adaptive scheduling settings.
+    /*!
+     * @param[in] isEnabledFlag Flag indicating if adaptive scheduling is enabled (default: false)
+     * @param[in] aTolerance    Relative margin on switching threshold [-] (default: 0.01)
+     */
+    AdaptiveSchedulingSettings( const bool isEnabledFlag = false, const Real aTolerance = 0.01 )
+        : isEnabled( isEnabledFlag ),
+          tolerance( aTolerance )
+    { }
+
+    //! Flag indicating if adaptive scheduling is enabled.
+    const bool isEnabled;
+
+    //! Relative margin on switching threshold [-].
+    const Real tolerance;
+
+protected:
+private:
+};
+
+//! Checkpoint settings.
+/*!
+ * If a checkpoint filename is provided, the simulator periodically writes a checkpoint, containing
+ * the complete state of the simulation and the positions of the output files, to a binary file in
+ * the output directory. A simulation that is interrupted, e.g., when a long-running job is
+ * killed, can then be resumed from the last checkpoint, continuing bit-for-bit identically to an
+ * uninterrupted simulation (see SimulatorCheckpoint).
+ */
+struct CheckpointSettings
+{
+public:
+
+    //! Construct checkpoint settings.
+    /*!
+     * @param[in] aFilename     Checkpoint filename; empty if no checkpoints are written
+     *                          (default: "")
+     * @param[in] aStepInterval Number of thruster pulses between checkpoints (default: 100000)
+     */
+    CheckpointSettings( const std::string& aFilename = "",
+                        const std::size_t aStepInterval = 100000 )
+        : filename( aFilename ),
+          stepInterval( aStepInterval )
+    { }
+
+    //! Checkpoint filename [-]; empty if no checkpoints are written.
+    const std::string filename;
+
+    //! Number of thruster pulses between checkpoints.
+    const std::size_t stepInterval;
+
+protected:
+private:
+};
+
 //! Input parameters provided by user for rvdsim.
 struct UserInput
 {
@@ -51,7 +234,17 @@ public:
                const Real               anArrivalDistanceTolerance,
                const std::string&       anOutputDirectory,
                const std::string&       aChaserStateHistoryFilename,
-               const std::string&       aChaserThrustHistoryFilename )
+               const std::string&       aChaserThrustHistoryFilename,
+               const OutputFormat       anOutputFormat = csvOutput,
+               const std::string&       aChaserTrajectoryFilename = "",
+               const OutputSamplingSettings& someOutputSamplingSettings
+                   = OutputSamplingSettings( ),
+               const std::string&       aMetricsFilename = "",
+               const AdaptiveSchedulingSettings& someAdaptiveSchedulingSettings
+                   = AdaptiveSchedulingSettings( ),
+               const PropagatorSettings& somePropagatorSettings = PropagatorSettings( ),
+               const CheckpointSettings& someCheckpointSettings = CheckpointSettings( ),
+               const Real               aChaserSpecificImpulse = 0.0 )
         : startTime( aStartTime ),
           endTime( anEndTime ),
           earthGravitationalParameter( anEarthGravitationalParameter ),
@@ -61,10 +254,18 @@ public:
           thrustMaximum( aThrustMaximum ),
           thrustFrequency( aThrustFrequency ),
           chaserWetMass( aChaserWetMass ),
+          chaserSpecificImpulse( aChaserSpecificImpulse ),
           arrivalDistanceTolerance( anArrivalDistanceTolerance ),
           outputDirectory( anOutputDirectory ),
           chaserStateHistoryFilename( aChaserStateHistoryFilename ),
-          chaserThrustHistoryFilename( aChaserThrustHistoryFilename )
+          chaserThrustHistoryFilename( aChaserThrustHistoryFilename ),
+          outputFormat( anOutputFormat ),
+          chaserTrajectoryFilename( aChaserTrajectoryFilename ),
+          outputSampling( someOutputSamplingSettings ),
+          metricsFilename( aMetricsFilename ),
+          adaptiveScheduling( someAdaptiveSchedulingSettings ),
+          propagatorSettings( somePropagatorSettings ),
+          checkpoint( someCheckpointSettings )
     { }
 
     //! Simulation start time [s].
@@ -94,6 +295,9 @@ public:
     //! Chaser wet mass [kg].
     const Real chaserWetMass;
 
+    //! Chaser thruster specific impulse [s]; zero if chaser mass is constant.
+    const Real chaserSpecificImpulse;
+
     //! Arrival distance tolerance [-] used to determine when to terminate simulation.
     const Real arrivalDistanceTolerance;
 
@@ -106,21 +310,116 @@ public:
     //! Chaser thrust history filename [-].
     const std::string chaserThrustHistoryFilename;
 
+    //! Output file format.
+    const OutputFormat outputFormat;
+
+    //! Chaser trajectory filename [-]; empty if no binary trajectory file is written.
+    const std::string chaserTrajectoryFilename;
+
+    //! Output sampling settings.
+    const OutputSamplingSettings outputSampling;
+
+    //! Instrumentation metrics filename [-]; empty if no metrics file is written.
+    const std::string metricsFilename;
+
+    //! Adaptive control-update scheduling settings.
+    const AdaptiveSchedulingSettings adaptiveScheduling;
+
+    //! Propagator settings.
+    const PropagatorSettings propagatorSettings;
+
+    //! Checkpoint settings.
+    const CheckpointSettings checkpoint;
+
 protected:
 private:
 };
 
 //! Check input parameters.
 /*!
- * Checks that all inputs for the application are valid. If not, an error is thrown with a short
- * description of the problem. If all inputs are valid, a data struct containing all the inputs is
- * returned, which is subsequently used to execute the application.
+ * Checks that all inputs for the application are valid. If not, an error is thrown
+ * (std::invalid_argument) with a short description of the problem. If all inputs are valid, a data
+ * struct containing all the inputs is returned, which is subsequently used to execute the
+ * application.
+ *
+ * @sa UserInput, checkUserInput
+ * @param[in] config       User-defined configuration options (extracted from JSON input file)
+ * @param[in] outputStream Stream to which valid inputs are reported (default: std::cout)
+ * @return                 Struct containing all valid input to execute application
+ */
+UserInput checkInput( const rapidjson::Document& config,
+                      std::ostream& outputStream = std::cout );
+
+//! Check values of user input.
+/*!
+ * Checks that the values of the user input can be simulated: the simulation end time should not
+ * lie before the start time, the gravitational parameter, target semi-major axis, thruster
+ * frequency and chaser wet mass should be positive, the thrust maximum, specific impulse and
+ * arrival distance tolerance should be non-negative, the target eccentricity should lie in [0, 1)
+ * and a J2-perturbed target orbit should not intersect the Earth. If not, an error is thrown
+ * (std::invalid_argument) with a short description of the problem.
+ *
+ * These rules are applied to all inputs, whether they are read from JSON input (checkInput) or
+ * set through the C API.
+ *
+ * @param[in] input User input
+ */
+void checkUserInput( const UserInput& input );
+
+//! Check output sampling input parameters.
+/*!
+ * Checks that the optional output sampling settings are valid. If not, an error is thrown with a
+ * short description of the problem. If no output sampling settings are provided, the default
+ * settings are returned, such that every thruster pulse is written.
+ *
+ * @sa OutputSamplingSettings
+ * @param[in] config       User-defined configuration options (extracted from JSON input file)
+ * @param[in] outputStream Stream to which valid inputs are reported (default: std::cout)
+ * @return                 Output sampling settings
+ */
+OutputSamplingSettings checkOutputSamplingInput( const rapidjson::Document& config,
+                                                 std::ostream& outputStream = std::cout );
+
+//! Check adaptive scheduling input parameters.
+/*!
+ * Checks that the optional adaptive scheduling settings are valid. If not, an error is thrown with
+ * a short description of the problem. If no adaptive scheduling settings are provided, adaptive
+ * scheduling is disabled.
+ *
+ * @sa AdaptiveSchedulingSettings
+ * @param[in] config       User-defined configuration options (extracted from JSON input file)
+ * @param[in] outputStream Stream to which valid inputs are reported (default: std::cout)
+ * @return                 Adaptive scheduling settings
+ */
+AdaptiveSchedulingSettings checkAdaptiveSchedulingInput( const rapidjson::Document& config,
+                                                         std::ostream& outputStream = std::cout );
+
+//! Check propagator input parameters.
+/*!
+ * Checks that the optional propagator settings are valid. If not, an error is thrown with a short
+ * description of the problem. If no propagator settings are provided, the Clohessy-Wiltshire
+ * model is used.
+ *
+ * @sa PropagatorSettings
+ * @param[in] config       User-defined configuration options (extracted from JSON input file)
+ * @param[in] outputStream Stream to which valid inputs are reported (default: std::cout)
+ * @return                 Propagator settings
+ */
+PropagatorSettings checkPropagatorInput( const rapidjson::Document& config,
+                                         std::ostream& outputStream = std::cout );
+
+//! Check checkpoint input parameters.
+/*!
+ * Checks that the optional checkpoint settings are valid. If not, an error is thrown with a short
+ * description of the problem. If no checkpoint settings are provided, no checkpoints are written.
  *
- * @sa UserInput
- * @param[in] config User-defined configuration options (extracted from JSON input file)
- * @return           Struct containing all valid input to execute application
+ * @sa CheckpointSettings
+ * @param[in] config       User-defined configuration options (extracted from JSON input file)
+ * @param[in] outputStream Stream to which valid inputs are reported (default: std::cout)
+ * @return                 Checkpoint settings
  */
-UserInput checkInput( const rapidjson::Document& config );
+CheckpointSettings checkCheckpointInput( const rapidjson::Document& config,
+                                         std::ostream& outputStream = std::cout );
 
 } // namespace rvdsim
 
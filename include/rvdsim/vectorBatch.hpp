@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef RVDSIM_VECTOR_BATCH_HPP
+#define RVDSIM_VECTOR_BATCH_HPP
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace rvdsim
+{
+
+//! Batch of fixed-size vectors.
+/*!
+ * Container for a batch of vectors of fixed dimension, e.g., the states of many chasers, stored as
+ * a structure-of-arrays: each vector component is stored in a separate, contiguous column, such
+ * that operations that are applied to all vectors in the batch can be vectorized.
+ *
+ * @tparam Real      Floating-point type
+ * @tparam Dimension Dimension of vectors stored in batch
+ */
+template< typename Real, std::size_t Dimension >
+class VectorBatch
+{
+public:
+
+    //! Define type of columns used to store vector components.
+    typedef std::vector< Real > Column;
+
+    //! Construct batch.
+    /*!
+     * Constructs batch of given size, with all vector components set to zero.
+     *
+     * @param[in] aSize Number of vectors in batch (default: 0)
+     */
+    explicit VectorBatch( const std::size_t aSize = 0 )
+    {
+        resize( aSize );
+    }
+
+    //! Resize batch.
+    /*!
+     * Resizes batch. New vectors are set to zero.
+     *
+     * @param[in] aSize Number of vectors in batch
+     */
+    void resize( const std::size_t aSize )
+    {
+        for ( std::size_t i = 0; i < Dimension; ++i )
+        {
+            columns[ i ].resize( aSize, 0.0 );
+        }
+    }
+
+    //! Get number of vectors in batch.
+    /*!
+     * @return Number of vectors
+     */
+    std::size_t size( ) const { return columns[ 0 ].size( ); }
+
+    //! Get vector component.
+    /*!
+     * @param[in] vectorIndex    Index of vector in batch
+     * @param[in] componentIndex Index of vector component
+     * @return                   Reference to vector component
+     */
+    Real& operator( )( const std::size_t vectorIndex, const std::size_t componentIndex )
+    {
+        return columns[ componentIndex ][ vectorIndex ];
+    }
+
+    //! Get vector component.
+    /*!
+     * @param[in] vectorIndex    Index of vector in batch
+     * @param[in] componentIndex Index of vector component
+     * @return                   Vector component
+     */
+    Real operator( )( const std::size_t vectorIndex, const std::size_t componentIndex ) const
+    {
+        return columns[ componentIndex ][ vectorIndex ];
+    }
+
+    //! Set vector.
+    /*!
+     * @tparam    Vector      Vector type, which must provide element access via operator[]
+     * @param[in] vectorIndex Index of vector in batch
+     * @param[in] vector      Vector of length Dimension
+     */
+    template< typename Vector >
+    void setVector( const std::size_t vectorIndex, const Vector& vector )
+    {
+        for ( std::size_t i = 0; i < Dimension; ++i )
+        {
+            columns[ i ][ vectorIndex ] = vector[ i ];
+        }
+    }
+
+    //! Get vector.
+    /*!
+     * @tparam     Vector      Vector type, which must provide element access via operator[]
+     * @param[in]  vectorIndex Index of vector in batch
+     * @param[out] vector      Vector of length Dimension
+     */
+    template< typename Vector >
+    void getVector( const std::size_t vectorIndex, Vector& vector ) const
+    {
+        for ( std::size_t i = 0; i < Dimension; ++i )
+        {
+            vector[ i ] = columns[ i ][ vectorIndex ];
+        }
+    }
+
+    //! Get column of vector component.
+    /*!
+     * @param[in] componentIndex Index of vector component
+     * @return                   Pointer to contiguous column containing vector component
+     */
+    Real* getColumn( const std::size_t componentIndex )
+    {
+        return columns[ componentIndex ].data( );
+    }
+
+    //! Get column of vector component.
+    /*!
+     * @param[in] componentIndex Index of vector component
+     * @return                   Pointer to contiguous column containing vector component
+     */
+    const Real* getColumn( const std::size_t componentIndex ) const
+    {
+        return columns[ componentIndex ].data( );
+    }
+
+protected:
+
+private:
+
+    //! Columns of vector components.
+    std::array< Column, Dimension > columns;
+};
+
+} // namespace rvdsim
+
+#endif // RVDSIM_VECTOR_BATCH_HPP
@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef RVDSIM_WORK_QUEUE_HPP
+#define RVDSIM_WORK_QUEUE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <rapidjson/document.h>
+
+#include "rvdsim/monteCarlo.hpp"
+#include "rvdsim/simulator.hpp"
+#include "rvdsim/typedefs.hpp"
+
+namespace rvdsim
+{
+
+//! Work queue settings.
+/*!
+ * Settings for the distributed execution of a Monte Carlo analysis by a coordinator and a number
+ * of workers that share a queue directory, e.g., on a network file system.
+ *
+ * @sa executeWorkQueueCoordinator, executeWorkQueueWorker
+ */
+struct WorkQueueSettings
+{
+public:
+
+    //! Construct work queue settings.
+    /*!
+     * @param[in] aNumberOfSamplesPerTask Number of Monte Carlo samples per task (default: 64)
+     * @param[in] aPollInterval           Interval at which the queue directory is polled [s]
+     *                                    (default: 0.5)
+     * @param[in] aStragglerFactor        Factor of mean execution time of completed tasks after
+     *                                    which a claimed task is re-dispatched [-] (default: 3.0)
+     * @param[in] aStragglerTimeout       Time after which a claimed task is re-dispatched, as long
+     *                                    as no task has been completed [s] (default: 3600.0)
+     */
+    WorkQueueSettings( const std::size_t aNumberOfSamplesPerTask = 64,
+                       const Real aPollInterval = 0.5,
+                       const Real aStragglerFactor = 3.0,
+                       const Real aStragglerTimeout = 3600.0 )
+        : numberOfSamplesPerTask( aNumberOfSamplesPerTask ),
+          pollInterval( aPollInterval ),
+          stragglerFactor( aStragglerFactor ),
+          stragglerTimeout( aStragglerTimeout )
+    { }
+
+    //! Number of Monte Carlo samples per task.
+    const std::size_t numberOfSamplesPerTask;
+
+    //! Interval at which queue directory is polled [s].
+    const Real pollInterval;
+
+    //! Factor of mean execution time of completed tasks after which claimed task is re-dispatched.
+    const Real stragglerFactor;
+
+    //! Time after which claimed task is re-dispatched, as long as no task has been completed [s].
+    const Real stragglerTimeout;
+
+protected:
+private:
+};
+
+//! Check work queue settings.
+/*!
+ * Checks that the optional work queue settings, given by the "work_queue" object in the JSON
+ * input, are valid. If not, an error is thrown with a short description of the problem. If no
+ * work queue settings are provided, the default settings are returned.
+ *
+ * @sa WorkQueueSettings
+ * @param[in] config       User-defined configuration options (extracted from JSON input file)
+ * @param[in] outputStream Stream to which valid inputs are reported (default: std::cout)
+ * @return                 Work queue settings
+ */
+WorkQueueSettings checkWorkQueueInput( const rapidjson::Document& config,
+                                      std::ostream& outputStream = std::cout );
+
+//! Magic number at start of work queue result files.
+const char workQueueResultMagic[ ] = "RVDSIMW1";
+
+//! Version of work queue result file format.
+const std::uint32_t workQueueResultVersion = 1;
+
+//! Result of work queue task.
+/*!
+ * Summaries of a contiguous range of Monte Carlo samples, as executed by a worker.
+ *
+ * @sa writeWorkQueueResult, readWorkQueueResult
+ */
+struct WorkQueueResult
+{
+public:
+
+    //! Index of first Monte Carlo sample in range.
+    std::size_t firstSampleIndex;
+
+    //! Wall-clock time taken by worker to execute range [s].
+    Real executionTime;
+
+    //! Simulation summaries, ordered by sample index.
+    std::vector< SimulationSummary > summaries;
+
+protected:
+private:
+};
+
+//! Write result of work queue task to file.
+/*!
+ * Writes the result of a task as a compact binary record: the magic number
+ * (workQueueResultMagic), the file format version, the index of the first sample, the number of
+ * samples and the execution time, followed by the numerical values of each summary as
+ * little-endian IEEE-754 doubles and its flags packed into a single byte.
+ *
+ * @sa readWorkQueueResult
+ * @param[in] filePath Path to result file
+ * @param[in] result   Result of task
+ */
+void writeWorkQueueResult( const std::string& filePath, const WorkQueueResult& result );
+
+//! Read result of work queue task from file.
+/*!
+ * Reads the result of a task written by writeWorkQueueResult( ). If the file cannot be read, is
+ * not a result file, has an unsupported version or is truncated, an error is thrown.
+ *
+ * @sa writeWorkQueueResult
+ * @param[in] filePath Path to result file
+ * @return             Result of task
+ */
+WorkQueueResult readWorkQueueResult( const std::string& filePath );
+
+//! Execute coordinator of Monte Carlo analysis distributed over work queue.
+/*!
+ * Coordinates a Monte Carlo analysis that is executed by workers on any number of nodes, which
+ * communicate with the coordinator only through files in a shared queue directory:
+ *
+ *  - campaign.json: the JSON input of the analysis, copied by the coordinator, from which the
+ *    workers read the simulation and dispersion settings;
+ *  - tasks/: one (empty) file per pending task, named "<first sample>_<samples>_<copy>.task",
+ *    which a worker claims by renaming it into claimed/ (only one worker succeeds);
+ *  - results/: one result file per completed task, named "<first sample>_<samples>.result" (see
+ *    writeWorkQueueResult( )), which is written to a temporary file first and then renamed, such
+ *    that the coordinator never reads incomplete results;
+ *  - done: written by the coordinator once all results are merged, upon which the workers exit.
+ *
+ * The coordinator polls the queue directory and merges results as they arrive. Once all tasks
+ * have been claimed, a claimed task that has not been completed after a multiple of the mean
+ * execution time of the completed tasks (or after the straggler timeout, as long as no task has
+ * been completed) is re-dispatched as a new copy, such that slow or failed workers do not hold up
+ * the analysis. Since the summaries only depend on the seed and the sample index, the first
+ * result of any copy is used, and the merged summaries are identical to those computed by
+ * executeMonteCarloAnalysis( ).
+ *
+ * Results already present in the queue directory, e.g., from an interrupted coordinator, are
+ * reused if the queue directory contains the same campaign. If it contains a different campaign,
+ * an error is thrown.
+ *
+ * @sa executeWorkQueueWorker, WorkQueueSettings
+ * @param[in] queueDirectory     Path to queue directory, created if it does not exist
+ * @param[in] campaignFilePath   Path to JSON input file of Monte Carlo analysis
+ * @param[in] dispersionSettings Dispersion settings
+ * @param[in] settings           Work queue settings
+ * @param[in] outputStream       Stream to which progress is reported (default: std::cout)
+ * @return                       Simulation summaries, ordered by sample index
+ */
+std::vector< SimulationSummary > executeWorkQueueCoordinator(
+    const std::string& queueDirectory,
+    const std::string& campaignFilePath,
+    const DispersionSettings& dispersionSettings,
+    const WorkQueueSettings& settings,
+    std::ostream& outputStream = std::cout );
+
+//! Execute worker of Monte Carlo analysis distributed over work queue.
+/*!
+ * Waits for the campaign in the queue directory, and then repeatedly claims a pending task,
+ * executes its range of samples with the in-process simulator on a thread pool (see
+ * executeMonteCarloSamples( )) and writes its result, until the coordinator marks the analysis as
+ * done. Any number of workers can be executed, on the same node or on different nodes.
+ *
+ * @sa executeWorkQueueCoordinator
+ * @param[in] queueDirectory Path to queue directory
+ * @param[in] outputStream   Stream to which progress is reported (default: std::cout)
+ * @return                   Number of tasks executed by worker
+ */
+std::size_t executeWorkQueueWorker( const std::string& queueDirectory,
+                                    std::ostream& outputStream = std::cout );
+
+} // namespace rvdsim
+
+#endif // RVDSIM_WORK_QUEUE_HPP
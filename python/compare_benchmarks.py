@@ -0,0 +1,59 @@
+'''
+Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+Distributed under the MIT License.
+See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+'''
+
+# Compare benchmark results of two builds of rvdsim, generated by the benchmark_rvdsim executable.
+# Usage: python compare_benchmarks.py baseline.json current.json [maximum_slowdown]
+# The script exits with a non-zero status if the median time of any benchmark has increased by
+# more than the maximum slowdown (default: 0.1, i.e., 10%) with respect to the baseline.
+
+# I/O
+import json
+
+# System
+import sys
+
+if len(sys.argv) < 3 or len(sys.argv) > 4:
+    raise Exception("Provide baseline and current benchmark results (JSON) as input!")
+
+maximum_slowdown = 0.1
+if len(sys.argv) == 4:
+    maximum_slowdown = float(sys.argv[3])
+
+def load_benchmarks(file_path):
+    '''
+    Load benchmark results, indexed by benchmark name and problem size.
+    '''
+    with open(file_path) as results_file:
+        results = json.load(results_file)
+    return dict(((benchmark["name"], benchmark["problem_size"]), benchmark)
+                for benchmark in results["benchmarks"])
+
+baseline = load_benchmarks(sys.argv[1])
+current = load_benchmarks(sys.argv[2])
+
+number_of_regressions = 0
+print("%-36s %12s %14s %14s %9s" % ("benchmark", "size", "baseline [s]", "current [s]", "change"))
+for key in sorted(current.keys()):
+    if key not in baseline:
+        print("%-36s %12d %14s %14.6g %9s"
+              % (key[0], key[1], "-", current[key]["median_time"], "new"))
+        continue
+
+    baseline_time = baseline[key]["median_time"]
+    current_time = current[key]["median_time"]
+    change = current_time / baseline_time - 1.0
+    is_regression = change > maximum_slowdown
+    number_of_regressions += 1 if is_regression else 0
+    print("%-36s %12d %14.6g %14.6g %+8.1f%%%s"
+          % (key[0], key[1], baseline_time, current_time, 100.0 * change,
+             " REGRESSION" if is_regression else ""))
+
+if number_of_regressions > 0:
+    print("%d benchmark(s) slowed down by more than %.1f%%!"
+          % (number_of_regressions, 100.0 * maximum_slowdown))
+    sys.exit(1)
+
+print("No performance regressions found.")
@@ -27,6 +27,9 @@ import pandas as pd
 import sys
 import time
 
+# rvdsim output
+from rvdsim_io import load_table
+
 print ""
 print "------------------------------------------------------------------"
 print "                              RVDSim                              "
@@ -64,8 +67,8 @@ print "Input data files being read ..."
 input_path_prefix = config["input_directory"] + "/"
 output_path_prefix = config["output_directory"] + '/'
 
-# Read and store data files.
-chaser_thrust = pd.read_csv(input_path_prefix + config["chaser_thrust"])
+# Read and store data files (binary files are memory-mapped, CSV files are parsed).
+chaser_thrust = load_table(input_path_prefix + config["chaser_thrust"])
 
 print "Input data files successfully read!"
 
@@ -0,0 +1,303 @@
+'''
+Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+Distributed under the MIT License.
+See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+'''
+
+# Set up modules and packages
+# Numerical
+import numpy as np
+
+# System
+import ctypes
+import ctypes.util
+import os
+import sys
+
+# Version of the C API (include/rvdsim/capi.h) that these bindings are written for.
+api_version = 1
+
+# Status code returned by the C API on success.
+success = 0
+
+# Thrust modes and propagators, as defined in the C API.
+thrust_modes = {"off": 0, "throttle": 1, "on_off": 2}
+propagators = {"clohessy_wiltshire": 0, "yamanaka_ankersen": 1, "j2_nonlinear": 2}
+
+# Column names of the state and thrust histories.
+state_columns = ["t", "x", "y", "z", "xdot", "ydot", "zdot"]
+thrust_columns = ["t", "Tx", "Ty", "Tz"]
+
+class Settings(ctypes.Structure):
+    '''
+    Simulation settings, with the same layout as RvdsimSettings in the C API.
+    '''
+    _fields_ = [("startTime", ctypes.c_double),
+                ("endTime", ctypes.c_double),
+                ("earthGravitationalParameter", ctypes.c_double),
+                ("targetSemiMajorAxis", ctypes.c_double),
+                ("thrustMode", ctypes.c_int),
+                ("thrustMaximum", ctypes.c_double),
+                ("thrustFrequency", ctypes.c_double),
+                ("chaserWetMass", ctypes.c_double),
+                ("chaserSpecificImpulse", ctypes.c_double),
+                ("arrivalDistanceTolerance", ctypes.c_double),
+                ("propagator", ctypes.c_int),
+                ("targetEccentricity", ctypes.c_double),
+                ("targetInclination", ctypes.c_double),
+                ("targetInitialTrueAnomaly", ctypes.c_double),
+                ("isHistoryStored", ctypes.c_int)]
+
+# Layout of RvdsimSummary in the C API, used to write summaries directly into a NumPy array.
+summary_dtype = np.dtype([("final_distance", np.float64),
+                          ("total_delta_v", np.float64),
+                          ("propellant_mass", np.float64),
+                          ("throttle_saturation_time", np.float64),
+                          ("termination_time", np.float64),
+                          ("is_target_reached", np.intc),
+                          ("is_throttle_max", np.intc),
+                          ("is_terminated_early", np.intc)], align=True)
+
+# Names of the settings that can be passed as keyword arguments, mapped to the fields of Settings.
+setting_names = {"start_time": "startTime",
+                 "end_time": "endTime",
+                 "earth_gravitational_parameter": "earthGravitationalParameter",
+                 "target_semi_major_axis": "targetSemiMajorAxis",
+                 "thrust_mode": "thrustMode",
+                 "thrust_maximum": "thrustMaximum",
+                 "thrust_frequency": "thrustFrequency",
+                 "chaser_wet_mass": "chaserWetMass",
+                 "chaser_specific_impulse": "chaserSpecificImpulse",
+                 "arrival_distance_tolerance": "arrivalDistanceTolerance",
+                 "propagator": "propagator",
+                 "target_eccentricity": "targetEccentricity",
+                 "target_inclination": "targetInclination",
+                 "target_initial_true_anomaly": "targetInitialTrueAnomaly",
+                 "is_history_stored": "isHistoryStored"}
+
+class RvdsimError(Exception):
+    '''
+    Error reported by the C API.
+    '''
+    pass
+
+def find_library():
+    '''
+    Find the shared rvdsim library. The path can be set explicitly through the RVDSIM_LIBRARY
+    environment variable; otherwise the lib directory of the project is searched, followed by the
+    system library paths.
+    '''
+    if "RVDSIM_LIBRARY" in os.environ:
+        return os.environ["RVDSIM_LIBRARY"]
+
+    if sys.platform.startswith("win"):
+        library_name = "rvdsim.dll"
+    elif sys.platform == "darwin":
+        library_name = "librvdsim.dylib"
+    else:
+        library_name = "librvdsim.so"
+    library_path = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "lib",
+                                library_name)
+    if os.path.isfile(library_path):
+        return library_path
+
+    library_path = ctypes.util.find_library("rvdsim")
+    if library_path is None:
+        raise RvdsimError("Shared rvdsim library could not be found; build with "
+                          "-DBUILD_SHARED_LIBS=on or set RVDSIM_LIBRARY!")
+    return library_path
+
+def load_library(library_path=None):
+    '''
+    Load the shared rvdsim library and declare the signatures of the C API.
+    '''
+    library = ctypes.CDLL(library_path if library_path is not None else find_library())
+
+    simulator_pointer = ctypes.c_void_p
+    double_pointer = ctypes.POINTER(ctypes.c_double)
+    settings_pointer = ctypes.POINTER(Settings)
+
+    library.rvdsimGetApiVersion.restype = ctypes.c_int
+    library.rvdsimGetApiVersion.argtypes = []
+    library.rvdsimGetStatusMessage.restype = ctypes.c_char_p
+    library.rvdsimGetStatusMessage.argtypes = [ctypes.c_int]
+    library.rvdsimInitialiseSettings.restype = ctypes.c_int
+    library.rvdsimInitialiseSettings.argtypes = [settings_pointer]
+    library.rvdsimCreateSimulator.restype = ctypes.c_int
+    library.rvdsimCreateSimulator.argtypes = [settings_pointer, ctypes.POINTER(simulator_pointer)]
+    library.rvdsimDestroySimulator.restype = None
+    library.rvdsimDestroySimulator.argtypes = [simulator_pointer]
+    library.rvdsimExecuteSimulation.restype = ctypes.c_int
+    library.rvdsimExecuteSimulation.argtypes = [simulator_pointer, double_pointer]
+    library.rvdsimGetSummary.restype = ctypes.c_int
+    library.rvdsimGetSummary.argtypes = [simulator_pointer, ctypes.c_void_p]
+    library.rvdsimGetNumberOfStates.restype = ctypes.c_size_t
+    library.rvdsimGetNumberOfStates.argtypes = [simulator_pointer]
+    library.rvdsimGetStateHistoryColumn.restype = ctypes.c_void_p
+    library.rvdsimGetStateHistoryColumn.argtypes = [simulator_pointer, ctypes.c_size_t]
+    library.rvdsimGetNumberOfThrusts.restype = ctypes.c_size_t
+    library.rvdsimGetNumberOfThrusts.argtypes = [simulator_pointer]
+    library.rvdsimGetThrustHistoryColumn.restype = ctypes.c_void_p
+    library.rvdsimGetThrustHistoryColumn.argtypes = [simulator_pointer, ctypes.c_size_t]
+    library.rvdsimExecuteBatch.restype = ctypes.c_int
+    library.rvdsimExecuteBatch.argtypes = [settings_pointer, ctypes.c_size_t, double_pointer,
+                                           ctypes.c_void_p, ctypes.c_size_t]
+
+    if library.rvdsimGetApiVersion() != api_version:
+        raise RvdsimError("Version of C API of rvdsim library does not match bindings!")
+    return library
+
+# Shared rvdsim library, loaded on first use.
+_library = None
+
+def get_library():
+    '''
+    Get the shared rvdsim library, loading it on first use.
+    '''
+    global _library
+    if _library is None:
+        _library = load_library()
+    return _library
+
+def check_status(status):
+    '''
+    Raise an error if a status code returned by the C API indicates failure.
+    '''
+    if status != success:
+        message = get_library().rvdsimGetStatusMessage(status)
+        raise RvdsimError("rvdsim C API call failed: " + message.decode("ascii"))
+
+def create_settings(**settings):
+    '''
+    Create simulation settings, starting from the values set by rvdsimInitialiseSettings and
+    overriding the settings given as keyword arguments (e.g., end_time=5000.0,
+    thrust_mode="on_off"). Thrust mode and propagator can be given by name.
+    '''
+    result = Settings()
+    check_status(get_library().rvdsimInitialiseSettings(ctypes.byref(result)))
+    for name, value in settings.items():
+        if name not in setting_names:
+            raise RvdsimError("Unknown simulation setting \"" + name + "\"!")
+        if name == "thrust_mode" and not isinstance(value, int):
+            value = thrust_modes[value]
+        elif name == "propagator" and not isinstance(value, int):
+            value = propagators[value]
+        elif name == "is_history_stored":
+            value = int(bool(value))
+        setattr(result, setting_names[name], value)
+    return result
+
+def as_initial_states(initial_states):
+    '''
+    Convert chaser initial states to a C-contiguous array of doubles with 6 columns, which is only
+    copied if necessary.
+    '''
+    states = np.ascontiguousarray(initial_states, dtype=np.float64)
+    if states.shape[-1] != 6:
+        raise RvdsimError("Chaser initial states should have 6 components!")
+    return states
+
+def column_view(owner, column_address, number_of_entries):
+    '''
+    Create a read-only NumPy view of a history column stored by the simulator, without copying.
+    The view keeps the owner (the Simulator) alive, such that the memory is not released while the
+    view exists.
+    '''
+    if number_of_entries == 0 or not column_address:
+        return np.empty(0)
+    buffer = (ctypes.c_double * number_of_entries).from_address(column_address)
+    buffer._owner = owner
+    view = np.frombuffer(buffer, dtype=np.float64)
+    view.flags.writeable = False
+    return view
+
+class Simulator(object):
+    '''
+    Simulator executed in-process through the C API.
+
+    The simulator is created once for the given settings and can be executed many times from
+    different chaser initial states. The state and thrust histories are returned as read-only NumPy
+    views of the columns stored by the simulator, which are only valid until the simulator is
+    executed again; copy them (e.g., using np.array) if they need to be kept.
+    '''
+
+    def __init__(self, settings=None, **keyword_settings):
+        '''
+        Create simulator, either from Settings or from settings given as keyword arguments (see
+        create_settings).
+        '''
+        self._library = get_library()
+        self._handle = ctypes.c_void_p()
+        if settings is None:
+            settings = create_settings(**keyword_settings)
+        check_status(self._library.rvdsimCreateSimulator(ctypes.byref(settings),
+                                                         ctypes.byref(self._handle)))
+
+    def __del__(self):
+        '''
+        Destroy simulator.
+        '''
+        if getattr(self, "_handle", None):
+            self._library.rvdsimDestroySimulator(self._handle)
+            self._handle = None
+
+    def execute(self, chaser_initial_state):
+        '''
+        Execute simulation from the given chaser initial state (x, y, z, xdot, ydot, zdot) [m; m/s]
+        and return the summary of the simulation.
+        '''
+        state = as_initial_states(chaser_initial_state)
+        if state.shape != (6,):
+            raise RvdsimError("Chaser initial state should be a vector with 6 components!")
+        check_status(self._library.rvdsimExecuteSimulation(
+            self._handle, state.ctypes.data_as(ctypes.POINTER(ctypes.c_double))))
+        return self.get_summary()
+
+    def get_summary(self):
+        '''
+        Get the summary of the last simulation executed, as a NumPy record with the fields of
+        summary_dtype.
+        '''
+        summary = np.zeros(1, dtype=summary_dtype)
+        check_status(self._library.rvdsimGetSummary(self._handle, summary.ctypes.data))
+        return summary[0]
+
+    def get_state_history(self):
+        '''
+        Get the chaser state history of the last simulation executed, as a dictionary mapping the
+        column names (state_columns) to NumPy views.
+        '''
+        number_of_states = self._library.rvdsimGetNumberOfStates(self._handle)
+        return dict((name, column_view(self,
+                                       self._library.rvdsimGetStateHistoryColumn(self._handle, i),
+                                       number_of_states))
+                    for i, name in enumerate(state_columns))
+
+    def get_thrust_history(self):
+        '''
+        Get the chaser thrust history of the last simulation executed, as a dictionary mapping the
+        column names (thrust_columns) to NumPy views.
+        '''
+        number_of_thrusts = self._library.rvdsimGetNumberOfThrusts(self._handle)
+        return dict((name, column_view(self,
+                                       self._library.rvdsimGetThrustHistoryColumn(self._handle, i),
+                                       number_of_thrusts))
+                    for i, name in enumerate(thrust_columns))
+
+def execute_batch(chaser_initial_states, settings=None, number_of_threads=0, **keyword_settings):
+    '''
+    Execute simulations with the same settings from a batch of chaser initial states (N x 6 array)
+    on a thread pool and return a NumPy array with the N summaries (see summary_dtype), which is
+    written directly by the C API. Histories are not stored.
+    '''
+    states = as_initial_states(chaser_initial_states)
+    if states.ndim != 2:
+        raise RvdsimError("Chaser initial states should be given as an N x 6 array!")
+    if settings is None:
+        settings = create_settings(**keyword_settings)
+    summaries = np.zeros(states.shape[0], dtype=summary_dtype)
+    check_status(get_library().rvdsimExecuteBatch(
+        ctypes.byref(settings), states.shape[0],
+        states.ctypes.data_as(ctypes.POINTER(ctypes.c_double)), summaries.ctypes.data,
+        number_of_threads))
+    return summaries
@@ -0,0 +1,58 @@
+'''
+Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+Distributed under the MIT License.
+See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+'''
+
+# Set up modules and packages
+# Numerical
+import numpy as np
+import pandas as pd
+
+# System
+import struct
+
+# Magic number at start of binary output files generated by rvdsim.
+binary_magic = "RVDSIMB1"
+
+# Binary header layout (little-endian): magic, format version, number of columns, number of rows,
+# offset of first row in bytes. The column names follow as '\0'-terminated strings.
+binary_header_format = "<8sIIQQ"
+
+def is_binary_file(file_path):
+    '''
+    Check if file is a binary output file generated by rvdsim.
+    '''
+    with open(file_path, "rb") as data_file:
+        return data_file.read(len(binary_magic)) == binary_magic
+
+def load_binary_file(file_path):
+    '''
+    Load binary output file generated by rvdsim (e.g., state, thrust or trajectory history).
+
+    The rows are memory-mapped directly from file, without parsing or copying, and returned as a
+    data frame with the column names stored in the file header.
+    '''
+    header_size = struct.calcsize(binary_header_format)
+    with open(file_path, "rb") as data_file:
+        magic, version, number_of_columns, number_of_rows, data_offset \
+            = struct.unpack(binary_header_format, data_file.read(header_size))
+        if magic != binary_magic or version != 1:
+            raise Exception("File " + file_path + " is not a valid rvdsim binary file!")
+        column_names = data_file.read(data_offset - header_size).split("\0")[:number_of_columns]
+
+    if number_of_rows == 0:
+        return pd.DataFrame(columns=column_names)
+
+    data = np.memmap(file_path, dtype="<f8", mode="r", offset=data_offset,
+                     shape=(number_of_rows, number_of_columns))
+    return pd.DataFrame(data, columns=column_names, copy=False)
+
+def load_table(file_path):
+    '''
+    Load output file generated by rvdsim, memory-mapping binary files and falling back to parsing
+    CSV files.
+    '''
+    if is_binary_file(file_path):
+        return load_binary_file(file_path)
+    return pd.read_csv(file_path)
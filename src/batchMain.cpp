@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "rvdsim/batchRunner.hpp"
+#include "rvdsim/instrumentation.hpp"
+#include "rvdsim/outputSink.hpp"
+
+int main( const int numberOfInputs, const char* inputArguments[ ] )
+{
+
+    ///////////////////////////////////////////////////////////////////////////
+
+    std::cout << std::endl;
+    std::cout << "------------------------------------------------------------------" << std::endl;
+    std::cout << std::endl;
+    std::cout << "                           rvdsim-batch                           " << std::endl;
+    std::cout << std::endl;
+    std::cout << "         Copyright (c) 2016, K. Kumar (me@kartikkumar.com)        " << std::endl;
+    std::cout << std::endl;
+    std::cout << "------------------------------------------------------------------" << std::endl;
+    std::cout << std::endl;
+
+    ///////////////////////////////////////////////////////////////////////////
+
+    ///////////////////////////////////////////////////////////////////////////
+
+    std::cout << std::endl;
+    std::cout << "******************************************************************" << std::endl;
+    std::cout << "                          Input parameters                        " << std::endl;
+    std::cout << "******************************************************************" << std::endl;
+    std::cout << std::endl;
+
+    // Check that a manifest and results file have been provided, optionally followed by the
+    // number of threads and the maximum number of scenarios in memory.
+    if ( numberOfInputs - 1 < 2 || numberOfInputs - 1 > 4 )
+    {
+        std::cerr << "ERROR: Number of inputs is wrong. Please provide a JSON-lines manifest and "
+                  << "a results file, optionally followed by the number of threads and the "
+                  << "maximum number of scenarios in memory!" << std::endl;
+        throw;
+    }
+
+    const std::string manifestPath = inputArguments[ 1 ];
+    const std::string resultsPath = inputArguments[ 2 ];
+    const std::size_t numberOfThreads
+        = numberOfInputs - 1 > 2
+          ? static_cast< std::size_t >( std::strtoul( inputArguments[ 3 ], 0, 10 ) ) : 0;
+    const std::size_t maximumNumberOfScenariosInMemory
+        = numberOfInputs - 1 > 3
+          ? static_cast< std::size_t >( std::strtoul( inputArguments[ 4 ], 0, 10 ) ) : 1024;
+    const rvdsim::BatchSettings settings( numberOfThreads, maximumNumberOfScenariosInMemory );
+
+    // Results are written in the binary format if the results file has the extension ".bin".
+    const std::string binaryExtension = ".bin";
+    const rvdsim::OutputFormat outputFormat
+        = ( resultsPath.size( ) > binaryExtension.size( )
+            && !resultsPath.compare( resultsPath.size( ) - binaryExtension.size( ),
+                                     binaryExtension.size( ),
+                                     binaryExtension ) )
+          ? rvdsim::binaryOutput : rvdsim::csvOutput;
+
+    std::cout << "Manifest                                      " << manifestPath << std::endl;
+    std::cout << "Results output file                           " << resultsPath << std::endl;
+    std::cout << "Output format                                 "
+              << ( outputFormat == rvdsim::binaryOutput ? "binary" : "CSV" ) << std::endl;
+    std::cout << "Threads                                       ";
+    if ( numberOfThreads == 0 )
+    {
+        std::cout << "AUTO" << std::endl;
+    }
+    else
+    {
+        std::cout << numberOfThreads << std::endl;
+    }
+    std::cout << "Scenarios in memory                           "
+              << settings.maximumNumberOfScenariosInMemory << std::endl;
+
+    std::ifstream manifest( manifestPath.c_str( ) );
+    if ( !manifest )
+    {
+        std::cerr << "ERROR: Could not open manifest \"" << manifestPath << "\"!" << std::endl;
+        throw;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+
+    ///////////////////////////////////////////////////////////////////////////
+
+    std::cout << std::endl;
+    std::cout << "******************************************************************" << std::endl;
+    std::cout << "                     Batch Execution & Output                     " << std::endl;
+    std::cout << "******************************************************************" << std::endl;
+    std::cout << std::endl;
+
+    std::unique_ptr< rvdsim::OutputSink > resultSink
+        = rvdsim::createOutputSink( outputFormat,
+                                    resultsPath,
+                                    rvdsim::getBatchResultColumnNames( ) );
+
+    std::cout << "Executing scenarios and writing results to file ... " << std::endl;
+
+    const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now( );
+    const std::size_t numberOfScenarios
+        = rvdsim::executeBatch( manifest, manifestPath, settings, *resultSink );
+    resultSink->close( );
+    const double wallTime = std::chrono::duration< double >(
+        std::chrono::steady_clock::now( ) - startTime ).count( );
+
+    std::cout << "Scenarios executed                            " << numberOfScenarios << std::endl;
+    std::cout << "Wall time                     [s]             " << wallTime << std::endl;
+    std::cout << std::endl;
+    std::cout << "Output written to file successfully!" << std::endl;
+
+    // Report time spent per phase and event counters, if instrumentation is enabled.
+    if ( rvdsim::isInstrumentationEnabled( ) )
+    {
+        std::cout << std::endl;
+        rvdsim::writeInstrumentationReport( std::cout );
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+
+    ///////////////////////////////////////////////////////////////////////////
+
+    std::cout << std::endl;
+    std::cout << "------------------------------------------------------------------" << std::endl;
+    std::cout << std::endl;
+    std::cout << "                         Exited successfully!                     " << std::endl;
+    std::cout << std::endl;
+    std::cout << "------------------------------------------------------------------" << std::endl;
+    std::cout << std::endl;
+
+    return EXIT_SUCCESS;
+
+    ///////////////////////////////////////////////////////////////////////////
+}
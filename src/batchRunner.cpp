@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+
+#include "rvdsim/batchRunner.hpp"
+#include "rvdsim/configLoader.hpp"
+#include "rvdsim/simulator.hpp"
+#include "rvdsim/threadPool.hpp"
+#include "rvdsim/typedefs.hpp"
+#include "rvdsim/userInput.hpp"
+
+namespace rvdsim
+{
+
+//! Get column names of batch results.
+std::vector< std::string > getBatchResultColumnNames( )
+{
+    const char* columnNames[ ] = { "scenario",
+                                   "final_distance",
+                                   "is_target_reached",
+                                   "total_delta_v",
+                                   "is_throttle_max",
+                                   "saturation_time",
+                                   "termination_time",
+                                   "propellant_mass" };
+    return std::vector< std::string >( columnNames, columnNames + 8 );
+}
+
+//! Execute batch of scenarios.
+std::size_t executeBatch( std::istream&        manifest,
+                          const std::string&   manifestName,
+                          const BatchSettings& settings,
+                          OutputSink&          resultSink )
+{
+    const std::size_t chunkCapacity
+        = std::max< std::size_t >( settings.maximumNumberOfScenariosInMemory, 1 );
+
+    ThreadPool threadPool( settings.numberOfThreads );
+    std::vector< SimulationSummary > summaries;
+    summaries.reserve( chunkCapacity );
+
+    std::size_t numberOfScenarios = 0;
+    std::size_t lineNumber = 0;
+    std::string line;
+    bool isManifestRead = false;
+    while ( !isManifestRead )
+    {
+        // Read and parse next chunk of scenarios. The chunk is released once its results have
+        // been written, which bounds the memory use.
+        ConfigCollection configs;
+        while ( configs.size( ) < chunkCapacity )
+        {
+            if ( !std::getline( manifest, line ) )
+            {
+                isManifestRead = true;
+                break;
+            }
+            ++lineNumber;
+
+            std::ostringstream name;
+            name << manifestName << ":" << lineNumber;
+            configs.addJsonLine( line, name.str( ) );
+        }
+
+        // Check the input of all scenarios in the chunk before they are executed, since tasks
+        // executed by the thread pool must not throw. The input checks do not report the inputs,
+        // which would only clutter the output of a batch.
+        std::vector< UserInput > inputs;
+        inputs.reserve( configs.size( ) );
+        for ( std::size_t i = 0; i < configs.size( ); ++i )
+        {
+            try
+            {
+                std::ostream silentStream( 0 );
+                inputs.push_back( checkInput( configs.getDocument( i ), silentStream ) );
+            }
+            catch ( const std::invalid_argument& error )
+            {
+                std::cerr << "ERROR: Invalid scenario \"" << configs.getName( i ) << "\"!"
+                          << std::endl;
+                throw std::invalid_argument( configs.getName( i ) + ": " + error.what( ) );
+            }
+        }
+
+        // Each scenario writes to its own summary only, so no synchronisation is needed.
+        summaries.resize( configs.size( ) );
+        executeParallelLoop( threadPool,
+                             configs.size( ),
+                             1,
+                             [ &inputs, &summaries ]( const std::size_t scenarioIndex )
+        {
+            Simulator simulator( inputs[ scenarioIndex ], false );
+            simulator.execute( );
+            summaries[ scenarioIndex ] = simulator.getSummary( );
+        } );
+
+        for ( std::size_t i = 0; i < summaries.size( ); ++i )
+        {
+            const Real row[ 8 ] = { static_cast< Real >( numberOfScenarios + i ),
+                                    summaries[ i ].finalDistanceToTarget,
+                                    summaries[ i ].isTargetReached ? 1.0 : 0.0,
+                                    summaries[ i ].totalDeltaV,
+                                    summaries[ i ].isThrottleMax ? 1.0 : 0.0,
+                                    summaries[ i ].throttleSaturationTime,
+                                    summaries[ i ].terminationTime,
+                                    summaries[ i ].propellantMass };
+            resultSink.writeRow( row );
+        }
+
+        numberOfScenarios += configs.size( );
+    }
+
+    return numberOfScenarios;
+}
+
+} // namespace rvdsim
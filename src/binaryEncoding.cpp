@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+#include "rvdsim/binaryEncoding.hpp"
+
+namespace rvdsim
+{
+
+//! Append unsigned integer to buffer in little-endian byte order.
+void appendLittleEndian( const std::uint64_t value,
+                         const std::size_t numberOfBytes,
+                         std::vector< char >& buffer )
+{
+    for ( std::size_t i = 0; i < numberOfBytes; ++i )
+    {
+        buffer.push_back( static_cast< char >( ( value >> ( 8 * i ) ) & 0xff ) );
+    }
+}
+
+//! Append double to buffer as little-endian IEEE-754 double.
+void appendLittleEndian( const double value, std::vector< char >& buffer )
+{
+    std::uint64_t bits = 0;
+    std::memcpy( &bits, &value, sizeof( bits ) );
+    appendLittleEndian( bits, 8, buffer );
+}
+
+//! Read unsigned integer stored with given number of bytes.
+std::uint64_t LittleEndianReader::readUnsignedInteger( const std::size_t numberOfBytes )
+{
+    checkRemainingSize( numberOfBytes );
+    std::uint64_t value = 0;
+    for ( std::size_t i = 0; i < numberOfBytes; ++i )
+    {
+        value |= static_cast< std::uint64_t >( static_cast< unsigned char >(
+                     contents[ position + i ] ) ) << ( 8 * i );
+    }
+    position += numberOfBytes;
+    return value;
+}
+
+//! Read double.
+double LittleEndianReader::readDouble( )
+{
+    const std::uint64_t bits = readUnsignedInteger( 8 );
+    double value = 0.0;
+    std::memcpy( &value, &bits, sizeof( value ) );
+    return value;
+}
+
+//! Check that all contents have been read.
+void LittleEndianReader::checkEnd( ) const
+{
+    if ( position != contents.size( ) )
+    {
+        reportInvalidFile( );
+    }
+}
+
+//! Check that given number of bytes remains to be read.
+void LittleEndianReader::checkRemainingSize( const std::size_t numberOfBytes ) const
+{
+    if ( contents.size( ) - position < numberOfBytes )
+    {
+        reportInvalidFile( );
+    }
+}
+
+//! Report invalid file.
+void LittleEndianReader::reportInvalidFile( ) const
+{
+    std::cerr << "ERROR: " << fileDescription << " \"" << filePath
+              << "\" is truncated or corrupt!" << std::endl;
+    throw std::runtime_error(
+        fileDescription + " \"" + filePath + "\" is truncated or corrupt" );
+}
+
+} // namespace rvdsim
@@ -0,0 +1,479 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+
+#include "rvdsim/capi.h"
+#include "rvdsim/simulator.hpp"
+#include "rvdsim/threadPool.hpp"
+#include "rvdsim/typedefs.hpp"
+#include "rvdsim/userInput.hpp"
+
+static_assert( std::is_same< rvdsim::Real, double >::value,
+               "C API requires rvdsim::Real to be double" );
+
+//! Simulator handle exposed through C API.
+/*!
+ * Owns the user input and the simulator constructed from it, such that the simulator can be
+ * executed repeatedly from different initial states.
+ */
+struct RvdsimSimulator
+{
+public:
+
+    //! Construct simulator handle.
+    /*!
+     * @param[in] anInput             User input containing simulation settings
+     * @param[in] isHistoryStoredFlag Flag indicating if histories should be stored
+     */
+    RvdsimSimulator( const rvdsim::UserInput& anInput, const bool isHistoryStoredFlag )
+        : input( anInput ),
+          simulator( input, isHistoryStoredFlag ),
+          isExecuted( false )
+    { }
+
+    //! User input containing simulation settings.
+    const rvdsim::UserInput input;
+
+    //! Simulator.
+    rvdsim::Simulator simulator;
+
+    //! Flag indicating if simulator has been executed.
+    bool isExecuted;
+
+protected:
+private:
+};
+
+namespace rvdsim
+{
+namespace
+{
+
+//! Number of simulations executed by each task of a batch.
+const std::size_t batchChunkSize = 16;
+
+//! Check if value is finite.
+/*!
+ * @param[in] value Value to check
+ * @return          True if value is neither infinite nor NaN
+ */
+bool isFinite( const double value )
+{
+    return std::isfinite( value );
+}
+
+//! Check chaser initial state.
+/*!
+ * @param[in] chaserInitialState Chaser initial state [m; m/s]
+ * @return                       True if all components of state are finite
+ */
+bool isValid( const double* chaserInitialState )
+{
+    for ( std::size_t i = 0; i < 6; ++i )
+    {
+        if ( !isFinite( chaserInitialState[ i ] ) )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//! Copy chaser state.
+/*!
+ * @param[in] chaserState Chaser state [m; m/s]
+ * @return                Chaser state [m; m/s]
+ */
+Vector6 copyState( const double* chaserState )
+{
+    Vector6 state;
+    for ( std::size_t i = 0; i < 6; ++i )
+    {
+        state[ i ] = chaserState[ i ];
+    }
+    return state;
+}
+
+//! Create user input from simulation settings.
+/*!
+ * Creates user input from settings and checks its values using checkUserInput( ), which applies
+ * the same rules as for JSON input. If the settings are invalid, an error is thrown
+ * (std::invalid_argument). No output is written by simulations executed through the C API, so
+ * all filenames are left empty.
+ *
+ * @param[in] settings Simulation settings
+ * @return             User input
+ */
+UserInput createUserInput( const RvdsimSettings& settings )
+{
+    ThrustMode thrustMode = off;
+    if ( settings.thrustMode == RVDSIM_THRUST_THROTTLE )
+    {
+        thrustMode = throttle;
+    }
+    else if ( settings.thrustMode == RVDSIM_THRUST_ON_OFF )
+    {
+        thrustMode = onOff;
+    }
+    else if ( settings.thrustMode != RVDSIM_THRUST_OFF )
+    {
+        throw std::invalid_argument( "Unknown thrust mode" );
+    }
+
+    PropagatorType propagatorType = clohessyWiltshirePropagator;
+    if ( settings.propagator == RVDSIM_PROPAGATOR_YAMANAKA_ANKERSEN )
+    {
+        propagatorType = yamanakaAnkersenPropagator;
+    }
+    else if ( settings.propagator == RVDSIM_PROPAGATOR_J2_NONLINEAR )
+    {
+        propagatorType = j2NonlinearPropagator;
+    }
+    else if ( settings.propagator != RVDSIM_PROPAGATOR_CLOHESSY_WILTSHIRE )
+    {
+        throw std::invalid_argument( "Unknown propagator" );
+    }
+
+    const Vector6 chaserInitialState = { { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 } };
+    const UserInput input( settings.startTime,
+                           settings.endTime,
+                           settings.earthGravitationalParameter,
+                           settings.targetSemiMajorAxis,
+                           chaserInitialState,
+                           thrustMode,
+                           settings.thrustMaximum,
+                           settings.thrustFrequency,
+                           settings.chaserWetMass,
+                           settings.arrivalDistanceTolerance,
+                           "",
+                           "",
+                           "",
+                           csvOutput,
+                           "",
+                           OutputSamplingSettings( ),
+                           "",
+                           AdaptiveSchedulingSettings( ),
+                           PropagatorSettings( propagatorType,
+                                               settings.targetEccentricity,
+                                               settings.targetInclination,
+                                               settings.targetInitialTrueAnomaly ),
+                           CheckpointSettings( ),
+                           settings.chaserSpecificImpulse );
+    checkUserInput( input );
+    return input;
+}
+
+//! Convert simulation summary.
+/*!
+ * @param[in] summary Simulation summary
+ * @return            Simulation summary exposed through C API
+ */
+RvdsimSummary convertSummary( const SimulationSummary& summary )
+{
+    RvdsimSummary result;
+    result.finalDistanceToTarget = summary.finalDistanceToTarget;
+    result.totalDeltaV = summary.totalDeltaV;
+    result.propellantMass = summary.propellantMass;
+    result.throttleSaturationTime = summary.throttleSaturationTime;
+    result.terminationTime = summary.terminationTime;
+    result.isTargetReached = summary.isTargetReached ? 1 : 0;
+    result.isThrottleMax = summary.isThrottleMax ? 1 : 0;
+    result.isTerminatedEarly = summary.isTerminatedEarly ? 1 : 0;
+    return result;
+}
+
+} // namespace
+} // namespace rvdsim
+
+//! Get version of C API.
+int rvdsimGetApiVersion( void )
+{
+    return RVDSIM_API_VERSION;
+}
+
+//! Get description of status code.
+const char* rvdsimGetStatusMessage( int status )
+{
+    switch ( status )
+    {
+        case RVDSIM_SUCCESS:
+            return "success";
+
+        case RVDSIM_ERROR_NULL_POINTER:
+            return "null pointer passed as argument";
+
+        case RVDSIM_ERROR_INVALID_SETTINGS:
+            return "invalid simulation settings";
+
+        case RVDSIM_ERROR_INVALID_ARGUMENT:
+            return "invalid argument";
+
+        case RVDSIM_ERROR_OUT_OF_MEMORY:
+            return "out of memory";
+
+        case RVDSIM_ERROR_INTERNAL:
+            return "internal error";
+
+        default:
+            return "unknown status";
+    }
+}
+
+//! Initialise simulation settings.
+int rvdsimInitialiseSettings( RvdsimSettings* settings )
+{
+    if ( settings == 0 )
+    {
+        return RVDSIM_ERROR_NULL_POINTER;
+    }
+
+    settings->startTime = 0.0;
+    settings->endTime = 1000.0;
+    settings->earthGravitationalParameter = 3.986004418e14;
+    settings->targetSemiMajorAxis = 7.0e6;
+    settings->thrustMode = RVDSIM_THRUST_THROTTLE;
+    settings->thrustMaximum = 1.0;
+    settings->thrustFrequency = 1.0;
+    settings->chaserWetMass = 100.0;
+    settings->chaserSpecificImpulse = 0.0;
+    settings->arrivalDistanceTolerance = 1.0;
+    settings->propagator = RVDSIM_PROPAGATOR_CLOHESSY_WILTSHIRE;
+    settings->targetEccentricity = 0.0;
+    settings->targetInclination = 0.0;
+    settings->targetInitialTrueAnomaly = 0.0;
+    settings->isHistoryStored = 1;
+    return RVDSIM_SUCCESS;
+}
+
+//! Create simulator.
+int rvdsimCreateSimulator( const RvdsimSettings* settings, RvdsimSimulator** simulator )
+{
+    if ( settings == 0 || simulator == 0 )
+    {
+        return RVDSIM_ERROR_NULL_POINTER;
+    }
+    *simulator = 0;
+
+    try
+    {
+        *simulator = new RvdsimSimulator( rvdsim::createUserInput( *settings ),
+                                          settings->isHistoryStored != 0 );
+    }
+    catch ( const std::invalid_argument& )
+    {
+        return RVDSIM_ERROR_INVALID_SETTINGS;
+    }
+    catch ( const std::bad_alloc& )
+    {
+        return RVDSIM_ERROR_OUT_OF_MEMORY;
+    }
+    catch ( ... )
+    {
+        return RVDSIM_ERROR_INTERNAL;
+    }
+    return RVDSIM_SUCCESS;
+}
+
+//! Destroy simulator.
+void rvdsimDestroySimulator( RvdsimSimulator* simulator )
+{
+    delete simulator;
+}
+
+//! Execute simulation.
+int rvdsimExecuteSimulation( RvdsimSimulator* simulator, const double chaserInitialState[ 6 ] )
+{
+    if ( simulator == 0 || chaserInitialState == 0 )
+    {
+        return RVDSIM_ERROR_NULL_POINTER;
+    }
+
+    if ( !rvdsim::isValid( chaserInitialState ) )
+    {
+        return RVDSIM_ERROR_INVALID_ARGUMENT;
+    }
+
+    try
+    {
+        simulator->isExecuted = false;
+        simulator->simulator.execute( rvdsim::copyState( chaserInitialState ) );
+        simulator->isExecuted = true;
+    }
+    catch ( const std::bad_alloc& )
+    {
+        return RVDSIM_ERROR_OUT_OF_MEMORY;
+    }
+    catch ( ... )
+    {
+        return RVDSIM_ERROR_INTERNAL;
+    }
+    return RVDSIM_SUCCESS;
+}
+
+//! Get summary of last simulation executed.
+int rvdsimGetSummary( const RvdsimSimulator* simulator, RvdsimSummary* summary )
+{
+    if ( simulator == 0 || summary == 0 )
+    {
+        return RVDSIM_ERROR_NULL_POINTER;
+    }
+
+    if ( !simulator->isExecuted )
+    {
+        return RVDSIM_ERROR_INVALID_ARGUMENT;
+    }
+
+    *summary = rvdsim::convertSummary( simulator->simulator.getSummary( ) );
+    return RVDSIM_SUCCESS;
+}
+
+//! Get number of entries in chaser state history.
+size_t rvdsimGetNumberOfStates( const RvdsimSimulator* simulator )
+{
+    if ( simulator == 0 || !simulator->isExecuted )
+    {
+        return 0;
+    }
+    return simulator->simulator.getChaserStateHistory( ).size( );
+}
+
+//! Get column of chaser state history.
+const double* rvdsimGetStateHistoryColumn( const RvdsimSimulator* simulator,
+                                           const size_t columnIndex )
+{
+    if ( rvdsimGetNumberOfStates( simulator ) == 0 || columnIndex > 6 )
+    {
+        return 0;
+    }
+
+    const rvdsim::StateHistory& history = simulator->simulator.getChaserStateHistory( );
+    return columnIndex == 0 ? history.getEpochs( ).data( )
+                            : history.getColumn( columnIndex - 1 ).data( );
+}
+
+//! Get number of entries in chaser thrust history.
+size_t rvdsimGetNumberOfThrusts( const RvdsimSimulator* simulator )
+{
+    if ( simulator == 0 || !simulator->isExecuted )
+    {
+        return 0;
+    }
+    return simulator->simulator.getChaserThrustHistory( ).size( );
+}
+
+//! Get column of chaser thrust history.
+const double* rvdsimGetThrustHistoryColumn( const RvdsimSimulator* simulator,
+                                            const size_t columnIndex )
+{
+    if ( rvdsimGetNumberOfThrusts( simulator ) == 0 || columnIndex > 3 )
+    {
+        return 0;
+    }
+
+    const rvdsim::ThrustHistory& history = simulator->simulator.getChaserThrustHistory( );
+    return columnIndex == 0 ? history.getEpochs( ).data( )
+                            : history.getColumn( columnIndex - 1 ).data( );
+}
+
+//! Execute batch of simulations.
+int rvdsimExecuteBatch( const RvdsimSettings* settings,
+                        const size_t numberOfSimulations,
+                        const double* chaserInitialStates,
+                        RvdsimSummary* summaries,
+                        const size_t numberOfThreads )
+{
+    if ( settings == 0 || ( numberOfSimulations > 0
+                            && ( chaserInitialStates == 0 || summaries == 0 ) ) )
+    {
+        return RVDSIM_ERROR_NULL_POINTER;
+    }
+
+    try
+    {
+        const rvdsim::UserInput input = rvdsim::createUserInput( *settings );
+
+        // Check all initial states up front, since tasks executed by the thread pool must not
+        // fail.
+        for ( std::size_t i = 0; i < numberOfSimulations; ++i )
+        {
+            if ( !rvdsim::isValid( chaserInitialStates + 6 * i ) )
+            {
+                return RVDSIM_ERROR_INVALID_ARGUMENT;
+            }
+        }
+
+        // Each chunk constructs a single simulator, which is re-executed for each of its initial
+        // states, and writes to its own summaries only, so no synchronisation is needed. Since
+        // tasks executed by the thread pool must not throw, a chunk that fails records its error,
+        // which is returned once all chunks are executed.
+        const std::size_t numberOfChunks
+            = ( numberOfSimulations + rvdsim::batchChunkSize - 1 ) / rvdsim::batchChunkSize;
+        std::atomic< int > status( RVDSIM_SUCCESS );
+        auto executeChunk
+            = [ &input, numberOfSimulations, chaserInitialStates, summaries, &status ](
+                const std::size_t chunkIndex )
+        {
+            try
+            {
+                const std::size_t begin = chunkIndex * rvdsim::batchChunkSize;
+                const std::size_t end
+                    = std::min( begin + rvdsim::batchChunkSize, numberOfSimulations );
+                rvdsim::Simulator simulator( input, false );
+                for ( std::size_t i = begin; i < end; ++i )
+                {
+                    simulator.execute( rvdsim::copyState( chaserInitialStates + 6 * i ) );
+                    summaries[ i ] = rvdsim::convertSummary( simulator.getSummary( ) );
+                }
+            }
+            catch ( const std::bad_alloc& )
+            {
+                status = RVDSIM_ERROR_OUT_OF_MEMORY;
+            }
+            catch ( ... )
+            {
+                status = RVDSIM_ERROR_INTERNAL;
+            }
+        };
+
+        if ( numberOfThreads == 1 || numberOfChunks < 2 )
+        {
+            for ( std::size_t chunkIndex = 0; chunkIndex < numberOfChunks; ++chunkIndex )
+            {
+                executeChunk( chunkIndex );
+            }
+        }
+        else
+        {
+            rvdsim::ThreadPool threadPool( numberOfThreads );
+            rvdsim::executeParallelLoop( threadPool, numberOfChunks, 1, executeChunk );
+        }
+
+        if ( status != RVDSIM_SUCCESS )
+        {
+            return status;
+        }
+    }
+    catch ( const std::invalid_argument& )
+    {
+        return RVDSIM_ERROR_INVALID_SETTINGS;
+    }
+    catch ( const std::bad_alloc& )
+    {
+        return RVDSIM_ERROR_OUT_OF_MEMORY;
+    }
+    catch ( ... )
+    {
+        return RVDSIM_ERROR_INTERNAL;
+    }
+    return RVDSIM_SUCCESS;
+}
@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+
+#include "rvdsim/binaryEncoding.hpp"
+#include "rvdsim/checkpoint.hpp"
+
+namespace rvdsim
+{
+
+namespace
+{
+
+//! Append position of output sink to buffer.
+/*!
+ * @param[in]     position Position of output sink
+ * @param[in,out] buffer   Buffer
+ */
+void appendSinkPosition( const OutputSinkPosition& position, std::vector< char >& buffer )
+{
+    appendLittleEndian( position.fileOffset, 8, buffer );
+    appendLittleEndian( position.numberOfRows, 8, buffer );
+}
+
+//! Read position of output sink.
+/*!
+ * @param[in,out] reader Reader of checkpoint file contents
+ * @return               Position of output sink
+ */
+OutputSinkPosition readSinkPosition( LittleEndianReader& reader )
+{
+    OutputSinkPosition sinkPosition;
+    sinkPosition.fileOffset = reader.readUnsignedInteger( 8 );
+    sinkPosition.numberOfRows = reader.readUnsignedInteger( 8 );
+    return sinkPosition;
+}
+
+} // namespace
+
+//! Write checkpoint to file.
+void writeCheckpoint( const std::string& filePath, const SimulatorCheckpoint& checkpoint )
+{
+    std::vector< char > buffer;
+    buffer.reserve( 512 );
+
+    for ( std::size_t i = 0; i < 8; ++i )
+    {
+        buffer.push_back( checkpointMagic[ i ] );
+    }
+    appendLittleEndian( checkpointVersion, 4, buffer );
+
+    appendLittleEndian( checkpoint.startTime, buffer );
+    appendLittleEndian( checkpoint.endTime, buffer );
+    appendLittleEndian( checkpoint.thrustPulseTime, buffer );
+    appendLittleEndian( checkpoint.thrustMode, 1, buffer );
+    appendLittleEndian( checkpoint.thrustMaximum, buffer );
+    appendLittleEndian( checkpoint.chaserWetMass, buffer );
+    appendLittleEndian( checkpoint.targetSemiMajorAxis, buffer );
+    appendLittleEndian( checkpoint.propagatorType, 1, buffer );
+    appendLittleEndian( checkpoint.stepIndex, 8, buffer );
+    appendLittleEndian( checkpoint.currentTime, buffer );
+    appendLittleEndian( checkpoint.timeToGo, buffer );
+    for ( int i = 0; i < 6; ++i )
+    {
+        appendLittleEndian( checkpoint.currentState[ i ], buffer );
+    }
+    appendLittleEndian( checkpoint.chaserMass, buffer );
+    appendLittleEndian( checkpoint.isThrottleMax, 1, buffer );
+    appendLittleEndian( checkpoint.totalDeltaV, buffer );
+    appendLittleEndian( checkpoint.propellantMass, buffer );
+    appendLittleEndian( checkpoint.throttleSaturationTime, buffer );
+
+    appendLittleEndian( checkpoint.outputSamplerState.nextIntervalIndex, 8, buffer );
+    appendLittleEndian( checkpoint.outputSamplerState.isStarted, 1, buffer );
+    appendLittleEndian( checkpoint.outputSamplerState.wasThrustOn, 1, buffer );
+    appendLittleEndian( checkpoint.outputSamplerState.wasThrottleSaturated, 1, buffer );
+    appendLittleEndian( checkpoint.outputSamplerState.wasWithinArrivalTolerance, 1, buffer );
+
+    appendLittleEndian( checkpoint.propagatorState.size( ), 4, buffer );
+    for ( std::size_t i = 0; i < checkpoint.propagatorState.size( ); ++i )
+    {
+        appendLittleEndian( checkpoint.propagatorState[ i ], buffer );
+    }
+
+    appendSinkPosition( checkpoint.stateSinkPosition, buffer );
+    appendSinkPosition( checkpoint.thrustSinkPosition, buffer );
+    appendSinkPosition( checkpoint.trajectorySinkPosition, buffer );
+
+    // Write checkpoint to temporary file first, such that the previous checkpoint remains intact
+    // until the new one is complete.
+    const std::string temporaryFilePath = filePath + ".tmp";
+    {
+        std::ofstream file( temporaryFilePath.c_str( ), std::ios::binary );
+        file.write( buffer.data( ), static_cast< std::streamsize >( buffer.size( ) ) );
+        file.close( );
+        if ( !file )
+        {
+            std::cerr << "ERROR: Checkpoint file \"" << temporaryFilePath
+                      << "\" could not be written!" << std::endl;
+            throw std::runtime_error(
+                "Checkpoint file \"" + temporaryFilePath + "\" could not be written" );
+        }
+    }
+
+#if defined( _WIN32 )
+    // Renaming does not replace existing files on Windows.
+    std::remove( filePath.c_str( ) );
+#endif
+    if ( std::rename( temporaryFilePath.c_str( ), filePath.c_str( ) ) != 0 )
+    {
+        std::cerr << "ERROR: Checkpoint file \"" << filePath << "\" could not be replaced!"
+                  << std::endl;
+        throw std::runtime_error( "Checkpoint file \"" + filePath + "\" could not be replaced" );
+    }
+}
+
+//! Read checkpoint from file.
+SimulatorCheckpoint readCheckpoint( const std::string& filePath )
+{
+    std::ifstream file( filePath.c_str( ), std::ios::binary );
+    if ( !file.is_open( ) )
+    {
+        std::cerr << "ERROR: Checkpoint file \"" << filePath << "\" could not be opened!"
+                  << std::endl;
+        throw std::runtime_error( "Checkpoint file \"" + filePath + "\" could not be opened" );
+    }
+    const std::vector< char > contents( ( std::istreambuf_iterator< char >( file ) ),
+                                        std::istreambuf_iterator< char >( ) );
+
+    if ( contents.size( ) < 12 || std::memcmp( contents.data( ), checkpointMagic, 8 ) != 0 )
+    {
+        std::cerr << "ERROR: File \"" << filePath << "\" is not a checkpoint file!" << std::endl;
+        throw std::runtime_error( "File \"" + filePath + "\" is not a checkpoint file" );
+    }
+
+    LittleEndianReader reader( contents, "Checkpoint file", filePath );
+    reader.readUnsignedInteger( 8 );
+    const std::uint64_t version = reader.readUnsignedInteger( 4 );
+    if ( version != checkpointVersion )
+    {
+        std::ostringstream message;
+        message << "Checkpoint file \"" << filePath << "\" has unsupported version " << version;
+        std::cerr << "ERROR: " << message.str( ) << "!" << std::endl;
+        throw std::runtime_error( message.str( ) );
+    }
+
+    SimulatorCheckpoint checkpoint;
+    checkpoint.startTime = reader.readDouble( );
+    checkpoint.endTime = reader.readDouble( );
+    checkpoint.thrustPulseTime = reader.readDouble( );
+    checkpoint.thrustMode = static_cast< ThrustMode >( reader.readUnsignedInteger( 1 ) );
+    checkpoint.thrustMaximum = reader.readDouble( );
+    checkpoint.chaserWetMass = reader.readDouble( );
+    checkpoint.targetSemiMajorAxis = reader.readDouble( );
+    checkpoint.propagatorType = static_cast< PropagatorType >( reader.readUnsignedInteger( 1 ) );
+    checkpoint.stepIndex = reader.readUnsignedInteger( 8 );
+    checkpoint.currentTime = reader.readDouble( );
+    checkpoint.timeToGo = reader.readDouble( );
+    for ( int i = 0; i < 6; ++i )
+    {
+        checkpoint.currentState[ i ] = reader.readDouble( );
+    }
+    checkpoint.chaserMass = reader.readDouble( );
+    checkpoint.isThrottleMax = reader.readFlag( );
+    checkpoint.totalDeltaV = reader.readDouble( );
+    checkpoint.propellantMass = reader.readDouble( );
+    checkpoint.throttleSaturationTime = reader.readDouble( );
+
+    checkpoint.outputSamplerState.nextIntervalIndex
+        = static_cast< std::size_t >( reader.readUnsignedInteger( 8 ) );
+    checkpoint.outputSamplerState.isStarted = reader.readFlag( );
+    checkpoint.outputSamplerState.wasThrustOn = reader.readFlag( );
+    checkpoint.outputSamplerState.wasThrottleSaturated = reader.readFlag( );
+    checkpoint.outputSamplerState.wasWithinArrivalTolerance = reader.readFlag( );
+
+    const std::uint64_t propagatorStateSize = reader.readUnsignedInteger( 4 );
+    for ( std::uint64_t i = 0; i < propagatorStateSize; ++i )
+    {
+        checkpoint.propagatorState.push_back( reader.readDouble( ) );
+    }
+
+    checkpoint.stateSinkPosition = readSinkPosition( reader );
+    checkpoint.thrustSinkPosition = readSinkPosition( reader );
+    checkpoint.trajectorySinkPosition = readSinkPosition( reader );
+    reader.checkEnd( );
+
+    return checkpoint;
+}
+
+//! Check if checkpoint file exists.
+bool isCheckpointAvailable( const std::string& filePath )
+{
+    std::ifstream file( filePath.c_str( ), std::ios::binary );
+    return file.is_open( );
+}
+
+} // namespace rvdsim
@@ -0,0 +1,483 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+#if defined( __AVX512F__ ) || defined( __AVX2__ )
+#include <immintrin.h>
+#endif
+
+#include "rvdsim/clohessyWiltshire.hpp"
+
+namespace rvdsim
+{
+
+namespace
+{
+
+//! Entry in cache of Clohessy-Wiltshire state transitions.
+struct CachedStateTransition
+{
+public:
+
+    //! Mean motion of target's orbit [rad/s].
+    Real meanMotion;
+
+    //! Propagation time [s].
+    Real propagationTime;
+
+    //! Clohessy-Wiltshire state transition.
+    ClohessyWiltshireStateTransition transition;
+
+protected:
+private:
+};
+
+//! Maximum number of entries in cache of Clohessy-Wiltshire state transitions.
+const std::size_t stateTransitionCacheCapacity = 32;
+
+//! Mutex guarding cache of Clohessy-Wiltshire state transitions.
+std::mutex stateTransitionCacheMutex;
+
+//! Cache of Clohessy-Wiltshire state transitions.
+std::vector< CachedStateTransition > stateTransitionCache;
+
+//! Index of next cache entry to be replaced once cache is full.
+std::size_t stateTransitionCacheNextIndex = 0;
+
+//! Set non-zero entries of Clohessy-Wiltshire state transition.
+/*!
+ * @param[in]  meanMotion      Mean motion of target's orbit [rad/s]
+ * @param[in]  propagationTime Propagation time [s]
+ * @param[in]  sine            Sine of n t [-]
+ * @param[in]  cosine          Cosine of n t [-]
+ * @param[in]  oneMinusCosine  1 - cos( n t ), computed without cancellation [-]
+ * @param[out] transition      Clohessy-Wiltshire state transition, of which the zero entries are
+ *                             not modified
+ */
+void setStateTransitionEntries( const Real meanMotion,
+                                const Real propagationTime,
+                                const Real sine,
+                                const Real cosine,
+                                const Real oneMinusCosine,
+                                ClohessyWiltshireStateTransition& transition )
+{
+    const Real n = meanMotion;
+    const Real t = propagationTime;
+    const Real nt = n * t;
+
+    Matrix66& phi = transition.stateTransitionMatrix;
+    Matrix63& gamma = transition.inputMatrix;
+
+    // In-plane motion.
+    phi[ 0 ][ 0 ] = 4.0 - 3.0 * cosine;
+    phi[ 0 ][ 3 ] = sine / n;
+    phi[ 0 ][ 4 ] = 2.0 * oneMinusCosine / n;
+    phi[ 1 ][ 0 ] = 6.0 * ( sine - nt );
+    phi[ 1 ][ 1 ] = 1.0;
+    phi[ 1 ][ 3 ] = -2.0 * oneMinusCosine / n;
+    phi[ 1 ][ 4 ] = ( 4.0 * sine - 3.0 * nt ) / n;
+    phi[ 3 ][ 0 ] = 3.0 * n * sine;
+    phi[ 3 ][ 3 ] = cosine;
+    phi[ 3 ][ 4 ] = 2.0 * sine;
+    phi[ 4 ][ 0 ] = -6.0 * n * oneMinusCosine;
+    phi[ 4 ][ 3 ] = -2.0 * sine;
+    phi[ 4 ][ 4 ] = 4.0 * cosine - 3.0;
+
+    gamma[ 0 ][ 0 ] = oneMinusCosine / ( n * n );
+    gamma[ 0 ][ 1 ] = 2.0 * ( nt - sine ) / ( n * n );
+    gamma[ 1 ][ 0 ] = -2.0 * ( nt - sine ) / ( n * n );
+    gamma[ 1 ][ 1 ] = 4.0 * oneMinusCosine / ( n * n ) - 1.5 * t * t;
+    gamma[ 3 ][ 0 ] = sine / n;
+    gamma[ 3 ][ 1 ] = 2.0 * oneMinusCosine / n;
+    gamma[ 4 ][ 0 ] = -2.0 * oneMinusCosine / n;
+    gamma[ 4 ][ 1 ] = 4.0 * sine / n - 3.0 * t;
+
+    // Out-of-plane motion.
+    phi[ 2 ][ 2 ] = cosine;
+    phi[ 2 ][ 5 ] = sine / n;
+    phi[ 5 ][ 2 ] = -n * sine;
+    phi[ 5 ][ 5 ] = cosine;
+
+    gamma[ 2 ][ 2 ] = oneMinusCosine / ( n * n );
+    gamma[ 5 ][ 2 ] = sine / n;
+}
+
+//! Compute synchronisation interval of Clohessy-Wiltshire state transition over Time-To-Go.
+/*!
+ * Each update of the half-angle terms adds an error of a few units of round-off to the terms of
+ * the state transition. A conservative bound of 16 units of round-off per update is used.
+ *
+ * @param[in] tolerance     Tolerance on absolute error of trigonometric terms [-]
+ * @param[in] numberOfSteps Number of thruster pulses in time grid
+ * @return                  Number of thruster pulses between synchronisations
+ */
+std::size_t computeSynchronisationInterval( const Real tolerance,
+                                            const std::size_t numberOfSteps )
+{
+    const Real numberOfUpdates
+        = std::floor( tolerance / ( 16.0 * std::numeric_limits< Real >::epsilon( ) ) );
+    if ( !( numberOfUpdates >= 1.0 ) )
+    {
+        return 1;
+    }
+    if ( numberOfUpdates > static_cast< Real >( numberOfSteps ) )
+    {
+        return numberOfSteps + 1;
+    }
+    return static_cast< std::size_t >( numberOfUpdates );
+}
+
+//! Propagate range of batch of states with scalar loop.
+/*!
+ * @param[in]  transition    Clohessy-Wiltshire state transition
+ * @param[in]  initialStates Batch of initial states [m; m/s]
+ * @param[in]  accelerations Batch of constant accelerations [m/s^2]
+ * @param[out] finalStates   Batch of final states [m; m/s]
+ * @param[in]  begin         Index of first state in range
+ * @param[in]  end           Index one past last state in range
+ */
+void propagateRangeScalar( const ClohessyWiltshireStateTransition& transition,
+                           const StateBatch& initialStates,
+                           const AccelerationBatch& accelerations,
+                           StateBatch& finalStates,
+                           const std::size_t begin,
+                           const std::size_t end )
+{
+    Vector6 initialState;
+    Vector3 acceleration;
+    Vector6 finalState;
+    for ( std::size_t i = begin; i < end; ++i )
+    {
+        initialStates.getVector( i, initialState );
+        accelerations.getVector( i, acceleration );
+        propagateClohessyWiltshire( transition, initialState, acceleration, finalState );
+        finalStates.setVector( i, finalState );
+    }
+}
+
+#if defined( __AVX512F__ ) || defined( __AVX2__ )
+
+#if defined( __AVX512F__ )
+
+//! SIMD operations on AVX-512 registers (8 doubles).
+struct SimdOperations
+{
+    typedef __m512d Register;
+    static const std::size_t width = 8;
+    static Register load( const Real* address ) { return _mm512_loadu_pd( address ); }
+    static void store( Real* address, const Register value ) { _mm512_storeu_pd( address, value ); }
+    static Register broadcast( const Real value ) { return _mm512_set1_pd( value ); }
+    static Register add( const Register a, const Register b ) { return _mm512_add_pd( a, b ); }
+    static Register multiply( const Register a, const Register b ) { return _mm512_mul_pd( a, b ); }
+};
+
+#else
+
+//! SIMD operations on AVX2 registers (4 doubles).
+struct SimdOperations
+{
+    typedef __m256d Register;
+    static const std::size_t width = 4;
+    static Register load( const Real* address ) { return _mm256_loadu_pd( address ); }
+    static void store( Real* address, const Register value ) { _mm256_storeu_pd( address, value ); }
+    static Register broadcast( const Real value ) { return _mm256_set1_pd( value ); }
+    static Register add( const Register a, const Register b ) { return _mm256_add_pd( a, b ); }
+    static Register multiply( const Register a, const Register b ) { return _mm256_mul_pd( a, b ); }
+};
+
+#endif
+
+//! Propagate range of batch of states with SIMD instructions.
+/*!
+ * Propagates states in blocks of SimdOperations::width states. The number of states in the range
+ * must be a multiple of the register width.
+ *
+ * @param[in]  transition       Clohessy-Wiltshire state transition
+ * @param[in]  initialStates    Batch of initial states [m; m/s]
+ * @param[in]  accelerations    Batch of constant accelerations [m/s^2]
+ * @param[out] finalStates      Batch of final states [m; m/s]
+ * @param[in]  numberOfStates   Number of states to propagate, starting from the first state
+ */
+void propagateRangeSimd( const ClohessyWiltshireStateTransition& transition,
+                         const StateBatch& initialStates,
+                         const AccelerationBatch& accelerations,
+                         StateBatch& finalStates,
+                         const std::size_t numberOfStates )
+{
+    typedef SimdOperations Simd;
+    typedef Simd::Register Register;
+
+    const Matrix66& phi = transition.stateTransitionMatrix;
+    const Matrix63& gamma = transition.inputMatrix;
+
+    // Broadcast non-zero entries of transition matrices once for the complete batch.
+    const Register phi00 = Simd::broadcast( phi[ 0 ][ 0 ] );
+    const Register phi03 = Simd::broadcast( phi[ 0 ][ 3 ] );
+    const Register phi04 = Simd::broadcast( phi[ 0 ][ 4 ] );
+    const Register phi10 = Simd::broadcast( phi[ 1 ][ 0 ] );
+    const Register phi13 = Simd::broadcast( phi[ 1 ][ 3 ] );
+    const Register phi14 = Simd::broadcast( phi[ 1 ][ 4 ] );
+    const Register phi22 = Simd::broadcast( phi[ 2 ][ 2 ] );
+    const Register phi25 = Simd::broadcast( phi[ 2 ][ 5 ] );
+    const Register phi30 = Simd::broadcast( phi[ 3 ][ 0 ] );
+    const Register phi33 = Simd::broadcast( phi[ 3 ][ 3 ] );
+    const Register phi34 = Simd::broadcast( phi[ 3 ][ 4 ] );
+    const Register phi40 = Simd::broadcast( phi[ 4 ][ 0 ] );
+    const Register phi43 = Simd::broadcast( phi[ 4 ][ 3 ] );
+    const Register phi44 = Simd::broadcast( phi[ 4 ][ 4 ] );
+    const Register phi52 = Simd::broadcast( phi[ 5 ][ 2 ] );
+    const Register phi55 = Simd::broadcast( phi[ 5 ][ 5 ] );
+    const Register gamma00 = Simd::broadcast( gamma[ 0 ][ 0 ] );
+    const Register gamma01 = Simd::broadcast( gamma[ 0 ][ 1 ] );
+    const Register gamma10 = Simd::broadcast( gamma[ 1 ][ 0 ] );
+    const Register gamma11 = Simd::broadcast( gamma[ 1 ][ 1 ] );
+    const Register gamma22 = Simd::broadcast( gamma[ 2 ][ 2 ] );
+    const Register gamma30 = Simd::broadcast( gamma[ 3 ][ 0 ] );
+    const Register gamma31 = Simd::broadcast( gamma[ 3 ][ 1 ] );
+    const Register gamma40 = Simd::broadcast( gamma[ 4 ][ 0 ] );
+    const Register gamma41 = Simd::broadcast( gamma[ 4 ][ 1 ] );
+    const Register gamma52 = Simd::broadcast( gamma[ 5 ][ 2 ] );
+
+    const Real* xColumn = initialStates.getColumn( 0 );
+    const Real* yColumn = initialStates.getColumn( 1 );
+    const Real* zColumn = initialStates.getColumn( 2 );
+    const Real* xDotColumn = initialStates.getColumn( 3 );
+    const Real* yDotColumn = initialStates.getColumn( 4 );
+    const Real* zDotColumn = initialStates.getColumn( 5 );
+    const Real* axColumn = accelerations.getColumn( 0 );
+    const Real* ayColumn = accelerations.getColumn( 1 );
+    const Real* azColumn = accelerations.getColumn( 2 );
+
+    for ( std::size_t i = 0; i < numberOfStates; i += Simd::width )
+    {
+        // All inputs are loaded before any output is stored, such that the propagation can be
+        // performed in place.
+        const Register x = Simd::load( xColumn + i );
+        const Register y = Simd::load( yColumn + i );
+        const Register z = Simd::load( zColumn + i );
+        const Register xDot = Simd::load( xDotColumn + i );
+        const Register yDot = Simd::load( yDotColumn + i );
+        const Register zDot = Simd::load( zDotColumn + i );
+        const Register ax = Simd::load( axColumn + i );
+        const Register ay = Simd::load( ayColumn + i );
+        const Register az = Simd::load( azColumn + i );
+
+        const Register xFinal = Simd::add(
+            Simd::add( Simd::add( Simd::multiply( phi00, x ), Simd::multiply( phi03, xDot ) ),
+                       Simd::multiply( phi04, yDot ) ),
+            Simd::add( Simd::multiply( gamma00, ax ), Simd::multiply( gamma01, ay ) ) );
+        const Register yFinal = Simd::add(
+            Simd::add( Simd::add( Simd::add( Simd::multiply( phi10, x ), y ),
+                                  Simd::multiply( phi13, xDot ) ),
+                       Simd::multiply( phi14, yDot ) ),
+            Simd::add( Simd::multiply( gamma10, ax ), Simd::multiply( gamma11, ay ) ) );
+        const Register zFinal = Simd::add(
+            Simd::add( Simd::multiply( phi22, z ), Simd::multiply( phi25, zDot ) ),
+            Simd::multiply( gamma22, az ) );
+        const Register xDotFinal = Simd::add(
+            Simd::add( Simd::add( Simd::multiply( phi30, x ), Simd::multiply( phi33, xDot ) ),
+                       Simd::multiply( phi34, yDot ) ),
+            Simd::add( Simd::multiply( gamma30, ax ), Simd::multiply( gamma31, ay ) ) );
+        const Register yDotFinal = Simd::add(
+            Simd::add( Simd::add( Simd::multiply( phi40, x ), Simd::multiply( phi43, xDot ) ),
+                       Simd::multiply( phi44, yDot ) ),
+            Simd::add( Simd::multiply( gamma40, ax ), Simd::multiply( gamma41, ay ) ) );
+        const Register zDotFinal = Simd::add(
+            Simd::add( Simd::multiply( phi52, z ), Simd::multiply( phi55, zDot ) ),
+            Simd::multiply( gamma52, az ) );
+
+        Simd::store( finalStates.getColumn( 0 ) + i, xFinal );
+        Simd::store( finalStates.getColumn( 1 ) + i, yFinal );
+        Simd::store( finalStates.getColumn( 2 ) + i, zFinal );
+        Simd::store( finalStates.getColumn( 3 ) + i, xDotFinal );
+        Simd::store( finalStates.getColumn( 4 ) + i, yDotFinal );
+        Simd::store( finalStates.getColumn( 5 ) + i, zDotFinal );
+    }
+}
+
+#endif
+
+} // namespace
+
+//! Compute Clohessy-Wiltshire state transition.
+ClohessyWiltshireStateTransition computeClohessyWiltshireStateTransition(
+    const Real meanMotion, const Real propagationTime )
+{
+    const Real n = meanMotion;
+    const Real t = propagationTime;
+    const Real nt = n * t;
+    const Real sine = std::sin( nt );
+    const Real cosine = std::cos( nt );
+
+    // Compute 1 - cos( nt ) without cancellation for short propagation times.
+    const Real halfAngleSine = std::sin( 0.5 * nt );
+    const Real oneMinusCosine = 2.0 * halfAngleSine * halfAngleSine;
+
+    ClohessyWiltshireStateTransition transition;
+    for ( int i = 0; i < 6; ++i )
+    {
+        transition.stateTransitionMatrix[ i ].fill( 0.0 );
+        transition.inputMatrix[ i ].fill( 0.0 );
+    }
+    setStateTransitionEntries( n, t, sine, cosine, oneMinusCosine, transition );
+
+    return transition;
+}
+
+//! Get Clohessy-Wiltshire state transition from cache.
+ClohessyWiltshireStateTransition getClohessyWiltshireStateTransition(
+    const Real meanMotion, const Real propagationTime )
+{
+    std::lock_guard< std::mutex > lock( stateTransitionCacheMutex );
+
+    for ( std::size_t i = 0; i < stateTransitionCache.size( ); ++i )
+    {
+        if ( stateTransitionCache[ i ].meanMotion == meanMotion
+             && stateTransitionCache[ i ].propagationTime == propagationTime )
+        {
+            return stateTransitionCache[ i ].transition;
+        }
+    }
+
+    CachedStateTransition entry;
+    entry.meanMotion = meanMotion;
+    entry.propagationTime = propagationTime;
+    entry.transition = computeClohessyWiltshireStateTransition( meanMotion, propagationTime );
+
+    if ( stateTransitionCache.size( ) < stateTransitionCacheCapacity )
+    {
+        stateTransitionCache.push_back( entry );
+    }
+    else
+    {
+        stateTransitionCache[ stateTransitionCacheNextIndex ] = entry;
+        stateTransitionCacheNextIndex
+            = ( stateTransitionCacheNextIndex + 1 ) % stateTransitionCacheCapacity;
+    }
+
+    return entry.transition;
+}
+
+//! Construct Clohessy-Wiltshire state transition over Time-To-Go.
+ClohessyWiltshireTimeToGoTransition::ClohessyWiltshireTimeToGoTransition(
+    const Real aMeanMotion, const TimeGrid& aTimeGrid, const Real aTolerance )
+    : meanMotion( aMeanMotion ),
+      timeGrid( aTimeGrid ),
+      synchronisationInterval(
+          computeSynchronisationInterval( aTolerance, aTimeGrid.getNumberOfSteps( ) ) ),
+      pulseHalfAngleSine( std::sin( 0.5 * ( aMeanMotion * aTimeGrid.getThrustPulseTime( ) ) ) ),
+      pulseHalfAngleCosine( std::cos( 0.5 * ( aMeanMotion * aTimeGrid.getThrustPulseTime( ) ) ) ),
+      isInitialised( false ),
+      currentStepIndex( 0 ),
+      halfAngleSine( 0.0 ),
+      halfAngleCosine( 1.0 ),
+      transition( )
+{
+    for ( int i = 0; i < 6; ++i )
+    {
+        transition.stateTransitionMatrix[ i ].fill( 0.0 );
+        transition.inputMatrix[ i ].fill( 0.0 );
+    }
+}
+
+//! Update state transition to thruster pulse.
+const ClohessyWiltshireStateTransition& ClohessyWiltshireTimeToGoTransition::update(
+    const std::size_t stepIndex )
+{
+    if ( isInitialised && stepIndex == currentStepIndex )
+    {
+        return transition;
+    }
+
+    // Re-synchronise half-angle terms with direct computation at last synchronisation pulse, unless
+    // the current terms were obtained from it.
+    const std::size_t synchronisationStepIndex = stepIndex - stepIndex % synchronisationInterval;
+    if ( !isInitialised
+         || currentStepIndex > stepIndex
+         || currentStepIndex < synchronisationStepIndex )
+    {
+        const Real halfAngle
+            = 0.5 * ( meanMotion * timeGrid.getTimeToGo( synchronisationStepIndex ) );
+        halfAngleSine = std::sin( halfAngle );
+        halfAngleCosine = std::cos( halfAngle );
+        currentStepIndex = synchronisationStepIndex;
+        isInitialised = true;
+    }
+
+    // Subtract half the pulse angle for each pulse up to the requested pulse.
+    while ( currentStepIndex < stepIndex )
+    {
+        const Real sine = halfAngleSine * pulseHalfAngleCosine
+                          - halfAngleCosine * pulseHalfAngleSine;
+        halfAngleCosine = halfAngleCosine * pulseHalfAngleCosine
+                          + halfAngleSine * pulseHalfAngleSine;
+        halfAngleSine = sine;
+        ++currentStepIndex;
+    }
+
+    const Real oneMinusCosine = 2.0 * halfAngleSine * halfAngleSine;
+    setStateTransitionEntries( meanMotion,
+                               timeGrid.getTimeToGo( stepIndex ),
+                               2.0 * halfAngleSine * halfAngleCosine,
+                               1.0 - oneMinusCosine,
+                               oneMinusCosine,
+                               transition );
+    return transition;
+}
+
+//! Propagate batch of states using Clohessy-Wiltshire state transition.
+void propagateClohessyWiltshireBatch( const ClohessyWiltshireStateTransition& transition,
+                                      const StateBatch& initialStates,
+                                      const AccelerationBatch& accelerations,
+                                      StateBatch& finalStates )
+{
+    const std::size_t numberOfStates = initialStates.size( );
+    finalStates.resize( numberOfStates );
+
+#if defined( __AVX512F__ ) || defined( __AVX2__ )
+    const std::size_t numberOfVectorizedStates
+        = numberOfStates - numberOfStates % SimdOperations::width;
+    propagateRangeSimd(
+        transition, initialStates, accelerations, finalStates, numberOfVectorizedStates );
+    propagateRangeScalar(
+        transition, initialStates, accelerations, finalStates,
+        numberOfVectorizedStates, numberOfStates );
+#else
+    propagateRangeScalar(
+        transition, initialStates, accelerations, finalStates, 0, numberOfStates );
+#endif
+}
+
+//! Propagate batch of states using Clohessy-Wiltshire state transition with scalar loop.
+void propagateClohessyWiltshireBatchScalar( const ClohessyWiltshireStateTransition& transition,
+                                            const StateBatch& initialStates,
+                                            const AccelerationBatch& accelerations,
+                                            StateBatch& finalStates )
+{
+    const std::size_t numberOfStates = initialStates.size( );
+    finalStates.resize( numberOfStates );
+    propagateRangeScalar(
+        transition, initialStates, accelerations, finalStates, 0, numberOfStates );
+}
+
+//! Get instruction set used for batch propagation.
+std::string getBatchInstructionSet( )
+{
+#if defined( __AVX512F__ )
+    return "avx512";
+#elif defined( __AVX2__ )
+    return "avx2";
+#else
+    return "scalar";
+#endif
+}
+
+} // namespace rvdsim
@@ -0,0 +1,250 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+#if defined( _WIN32 )
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
+
+#include <rapidjson/error/en.h>
+
+#include "rvdsim/configLoader.hpp"
+
+namespace rvdsim
+{
+
+namespace
+{
+
+//! Check if string ends with given suffix.
+bool hasSuffix( const std::string& text, const std::string& suffix )
+{
+    return text.size( ) >= suffix.size( )
+           && !text.compare( text.size( ) - suffix.size( ), suffix.size( ), suffix );
+}
+
+//! Check if line of JSON-lines input is skipped, i.e., if it is empty or a comment.
+bool isJsonLineSkipped( const char* lineBegin, const char* lineEnd )
+{
+    while ( lineBegin < lineEnd
+            && ( *lineBegin == ' ' || *lineBegin == '\t' || *lineBegin == '\r' ) )
+    {
+        ++lineBegin;
+    }
+
+    return lineBegin == lineEnd
+           || ( lineBegin + 1 < lineEnd && lineBegin[ 0 ] == '/' && lineBegin[ 1 ] == '/' );
+}
+
+//! Check if path is a directory.
+bool isDirectory( const std::string& path )
+{
+#if defined( _WIN32 )
+    const DWORD attributes = GetFileAttributesA( path.c_str( ) );
+    return attributes != INVALID_FILE_ATTRIBUTES && ( attributes & FILE_ATTRIBUTE_DIRECTORY );
+#else
+    struct stat status;
+    return stat( path.c_str( ), &status ) == 0 && S_ISDIR( status.st_mode );
+#endif
+}
+
+//! List names of JSON and JSON-lines files in directory, in alphabetical order.
+std::vector< std::string > listConfigFiles( const std::string& directoryPath )
+{
+    const std::vector< std::string > fileNames = listDirectoryEntries( directoryPath );
+
+    std::vector< std::string > configFileNames;
+    for ( std::size_t i = 0; i < fileNames.size( ); ++i )
+    {
+        if ( hasSuffix( fileNames[ i ], ".json" ) || hasSuffix( fileNames[ i ], ".jsonl" ) )
+        {
+            configFileNames.push_back( fileNames[ i ] );
+        }
+    }
+    std::sort( configFileNames.begin( ), configFileNames.end( ) );
+
+    return configFileNames;
+}
+
+} // namespace
+
+//! Read contents of file.
+std::vector< char > readFileContents( const std::string& filePath )
+{
+    std::ifstream file( filePath.c_str( ), std::ios::in | std::ios::binary );
+    if ( !file )
+    {
+        std::cerr << "ERROR: Could not open file \"" << filePath << "\"!" << std::endl;
+        throw std::runtime_error( "Could not open file \"" + filePath + "\"" );
+    }
+
+    file.seekg( 0, std::ios::end );
+    const std::streamoff fileSize = file.tellg( );
+    file.seekg( 0, std::ios::beg );
+
+    std::vector< char > contents( static_cast< std::size_t >( fileSize ) + 1, '\0' );
+    if ( fileSize > 0 && !file.read( &contents[ 0 ], fileSize ) )
+    {
+        std::cerr << "ERROR: Could not read file \"" << filePath << "\"!" << std::endl;
+        throw std::runtime_error( "Could not read file \"" + filePath + "\"" );
+    }
+
+    return contents;
+}
+
+//! List names of entries in directory.
+std::vector< std::string > listDirectoryEntries( const std::string& directoryPath )
+{
+    std::vector< std::string > entryNames;
+
+#if defined( _WIN32 )
+    WIN32_FIND_DATAA findData;
+    const HANDLE findHandle = FindFirstFileA( ( directoryPath + "\\*" ).c_str( ), &findData );
+    if ( findHandle != INVALID_HANDLE_VALUE )
+    {
+        do
+        {
+            entryNames.push_back( findData.cFileName );
+        } while ( FindNextFileA( findHandle, &findData ) );
+        FindClose( findHandle );
+    }
+#else
+    DIR* directory = opendir( directoryPath.c_str( ) );
+    if ( directory == 0 )
+    {
+        std::cerr << "ERROR: Could not open directory \"" << directoryPath << "\"!" << std::endl;
+        throw std::runtime_error( "Could not open directory \"" + directoryPath + "\"" );
+    }
+    for ( struct dirent* entry = readdir( directory ); entry != 0; entry = readdir( directory ) )
+    {
+        entryNames.push_back( entry->d_name );
+    }
+    closedir( directory );
+#endif
+
+    return entryNames;
+}
+
+//! Add configurations from JSON file.
+void ConfigCollection::addFile( const std::string& filePath )
+{
+    buffers.push_back(
+        std::unique_ptr< std::vector< char > >(
+            new std::vector< char >( readFileContents( filePath ) ) ) );
+    parseDocument( &( *buffers.back( ) )[ 0 ], filePath );
+}
+
+//! Add configurations from JSON-lines file.
+void ConfigCollection::addJsonLinesFile( const std::string& filePath )
+{
+    buffers.push_back(
+        std::unique_ptr< std::vector< char > >(
+            new std::vector< char >( readFileContents( filePath ) ) ) );
+    std::vector< char >& contents = *buffers.back( );
+
+    // Terminate each line, such that it can be parsed in situ as a separate document.
+    std::size_t lineNumber = 1;
+    std::size_t lineStart = 0;
+    for ( std::size_t i = 0; i < contents.size( ); ++i )
+    {
+        if ( contents[ i ] != '\n' && contents[ i ] != '\0' )
+        {
+            continue;
+        }
+        contents[ i ] = '\0';
+
+        if ( !isJsonLineSkipped( &contents[ lineStart ], &contents[ i ] ) )
+        {
+            std::ostringstream name;
+            name << filePath << ":" << lineNumber;
+            parseDocument( &contents[ lineStart ], name.str( ) );
+        }
+
+        lineStart = i + 1;
+        ++lineNumber;
+    }
+}
+
+//! Add configuration from single line of JSON-lines input.
+bool ConfigCollection::addJsonLine( const std::string& line, const std::string& name )
+{
+    if ( isJsonLineSkipped( line.data( ), line.data( ) + line.size( ) ) )
+    {
+        return false;
+    }
+
+    buffers.push_back(
+        std::unique_ptr< std::vector< char > >(
+            new std::vector< char >( line.begin( ), line.end( ) ) ) );
+    buffers.back( )->push_back( '\0' );
+    parseDocument( &( *buffers.back( ) )[ 0 ], name );
+
+    return true;
+}
+
+//! Parse configuration in situ and add it to collection.
+void ConfigCollection::parseDocument( char* json, const std::string& name )
+{
+    std::unique_ptr< rapidjson::Document > document( new rapidjson::Document );
+    document->ParseInsitu< configParseFlags >( json );
+
+    if ( document->HasParseError( ) )
+    {
+        std::ostringstream message;
+        message << "Could not parse JSON input \"" << name << "\": "
+                << rapidjson::GetParseError_En( document->GetParseError( ) )
+                << " (offset " << document->GetErrorOffset( ) << ")";
+        std::cerr << "ERROR: " << message.str( ) << std::endl;
+        throw std::runtime_error( message.str( ) );
+    }
+
+    documents.push_back( std::move( document ) );
+    names.push_back( name );
+}
+
+//! Load configurations.
+ConfigCollection loadConfigs( const std::string& path )
+{
+    ConfigCollection configs;
+
+    if ( isDirectory( path ) )
+    {
+        const std::vector< std::string > fileNames = listConfigFiles( path );
+        for ( std::size_t i = 0; i < fileNames.size( ); ++i )
+        {
+            const std::string filePath = path + "/" + fileNames[ i ];
+            if ( hasSuffix( fileNames[ i ], ".jsonl" ) )
+            {
+                configs.addJsonLinesFile( filePath );
+            }
+            else
+            {
+                configs.addFile( filePath );
+            }
+        }
+    }
+    else if ( hasSuffix( path, ".jsonl" ) )
+    {
+        configs.addJsonLinesFile( path );
+    }
+    else
+    {
+        configs.addFile( path );
+    }
+
+    return configs;
+}
+
+} // namespace rvdsim
@@ -0,0 +1,461 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cmath>
+#include <cstddef>
+
+#if defined( __AVX512F__ ) || defined( __AVX2__ )
+#include <immintrin.h>
+#endif
+
+#include "rvdsim/guidanceKernel.hpp"
+
+namespace rvdsim
+{
+
+namespace
+{
+
+//! Evaluate guidance kernel for range of batch of chasers with the same thrust policy.
+/*!
+ * @tparam     ThrustPolicy             Thrust policy
+ * @param[in]  timeToGoTransition       Clohessy-Wiltshire state transition over Time-To-Go
+ * @param[in]  timeToGo                 Time-To-Go [s]
+ * @param[in]  states                   Batch of current states [m; m/s]
+ * @param[in]  thrustAccelerationMaxima Maximum thrust acceleration of each chaser [m/s^2]
+ * @param[out] thrustAccelerations      Batch of thrust accelerations applied [m/s^2]
+ * @param[out] thrustAccelerationNorms  Norm of thrust acceleration applied to each chaser [m/s^2]
+ * @param[out] isSaturated              Flags indicating if thruster of each chaser is throttled
+ * @param[in]  begin                    Index of first chaser in range
+ * @param[in]  end                      Index one past last chaser in range
+ */
+template< typename ThrustPolicy >
+void evaluateRange( const ClohessyWiltshireStateTransition& timeToGoTransition,
+                    const Real timeToGo,
+                    const StateBatch& states,
+                    const std::vector< Real >& thrustAccelerationMaxima,
+                    AccelerationBatch& thrustAccelerations,
+                    std::vector< Real >& thrustAccelerationNorms,
+                    std::vector< unsigned char >& isSaturated,
+                    const std::size_t begin,
+                    const std::size_t end )
+{
+    Real* axColumn = thrustAccelerations.getColumn( 0 );
+    Real* ayColumn = thrustAccelerations.getColumn( 1 );
+    Real* azColumn = thrustAccelerations.getColumn( 2 );
+    Real* normColumn = thrustAccelerationNorms.data( );
+    unsigned char* isSaturatedColumn = isSaturated.data( );
+
+    if ( !ThrustPolicy::isGuidanceEvaluated )
+    {
+        for ( std::size_t i = begin; i < end; ++i )
+        {
+            axColumn[ i ] = 0.0;
+            ayColumn[ i ] = 0.0;
+            azColumn[ i ] = 0.0;
+            normColumn[ i ] = 0.0;
+            isSaturatedColumn[ i ] = 0;
+        }
+        return;
+    }
+
+    // Copy non-zero entries of state transition matrix once for the complete range, such that
+    // they are kept in registers.
+    const Matrix66& phi = timeToGoTransition.stateTransitionMatrix;
+    const Real phi00 = phi[ 0 ][ 0 ];
+    const Real phi03 = phi[ 0 ][ 3 ];
+    const Real phi04 = phi[ 0 ][ 4 ];
+    const Real phi10 = phi[ 1 ][ 0 ];
+    const Real phi13 = phi[ 1 ][ 3 ];
+    const Real phi14 = phi[ 1 ][ 4 ];
+    const Real phi22 = phi[ 2 ][ 2 ];
+    const Real phi25 = phi[ 2 ][ 5 ];
+    const Real phi30 = phi[ 3 ][ 0 ];
+    const Real phi33 = phi[ 3 ][ 3 ];
+    const Real phi34 = phi[ 3 ][ 4 ];
+    const Real phi40 = phi[ 4 ][ 0 ];
+    const Real phi43 = phi[ 4 ][ 3 ];
+    const Real phi44 = phi[ 4 ][ 4 ];
+    const Real phi52 = phi[ 5 ][ 2 ];
+    const Real phi55 = phi[ 5 ][ 5 ];
+
+    // Evaluate optimal guidance law, a = 6 ZEM / tgo^2 - 2 ZEV / tgo, with ZEM and ZEV equal to
+    // the negative of the ballistic end position and velocity, in the same order of operations as
+    // the single-chaser kernel.
+    const Real positionGain = 6.0 / ( timeToGo * timeToGo );
+    const Real velocityGain = 2.0 / timeToGo;
+
+    const Real* xColumn = states.getColumn( 0 );
+    const Real* yColumn = states.getColumn( 1 );
+    const Real* zColumn = states.getColumn( 2 );
+    const Real* xDotColumn = states.getColumn( 3 );
+    const Real* yDotColumn = states.getColumn( 4 );
+    const Real* zDotColumn = states.getColumn( 5 );
+    const Real* maximumColumn = thrustAccelerationMaxima.data( );
+
+    for ( std::size_t i = begin; i < end; ++i )
+    {
+        const Real x = xColumn[ i ];
+        const Real y = yColumn[ i ];
+        const Real z = zColumn[ i ];
+        const Real xDot = xDotColumn[ i ];
+        const Real yDot = yDotColumn[ i ];
+        const Real zDot = zDotColumn[ i ];
+
+        const Real xFinal = phi00 * x + phi03 * xDot + phi04 * yDot;
+        const Real yFinal = phi10 * x + y + phi13 * xDot + phi14 * yDot;
+        const Real zFinal = phi22 * z + phi25 * zDot;
+        const Real xDotFinal = phi30 * x + phi33 * xDot + phi34 * yDot;
+        const Real yDotFinal = phi40 * x + phi43 * xDot + phi44 * yDot;
+        const Real zDotFinal = phi52 * z + phi55 * zDot;
+
+        const Real ax = positionGain * -xFinal - velocityGain * -xDotFinal;
+        const Real ay = positionGain * -yFinal - velocityGain * -yDotFinal;
+        const Real az = positionGain * -zFinal - velocityGain * -zDotFinal;
+        const Real thrustAccelerationNorm = std::sqrt( ax * ax + ay * ay + az * az );
+
+        bool isThrottled = false;
+        const Real scaleFactor = ThrustPolicy::computeScaleFactor(
+            thrustAccelerationNorm, maximumColumn[ i ], isThrottled );
+
+        axColumn[ i ] = ax * scaleFactor;
+        ayColumn[ i ] = ay * scaleFactor;
+        azColumn[ i ] = az * scaleFactor;
+        normColumn[ i ] = scaleFactor * thrustAccelerationNorm;
+        isSaturatedColumn[ i ] = isThrottled ? 1 : 0;
+    }
+}
+
+#if defined( __AVX512F__ ) || defined( __AVX2__ )
+
+#if defined( __AVX512F__ )
+
+//! SIMD operations on AVX-512 registers (8 doubles).
+struct SimdOperations
+{
+    typedef __m512d Register;
+    typedef __mmask8 Mask;
+    static const std::size_t width = 8;
+    static Register load( const Real* address ) { return _mm512_loadu_pd( address ); }
+    static void store( Real* address, const Register value ) { _mm512_storeu_pd( address, value ); }
+    static Register broadcast( const Real value ) { return _mm512_set1_pd( value ); }
+    static Register add( const Register a, const Register b ) { return _mm512_add_pd( a, b ); }
+    static Register subtract( const Register a, const Register b ) { return _mm512_sub_pd( a, b ); }
+    static Register multiply( const Register a, const Register b ) { return _mm512_mul_pd( a, b ); }
+    static Register divide( const Register a, const Register b ) { return _mm512_div_pd( a, b ); }
+    static Register squareRoot( const Register a ) { return _mm512_sqrt_pd( a ); }
+    static Mask isGreater( const Register a, const Register b )
+    {
+        return _mm512_cmp_pd_mask( a, b, _CMP_GT_OQ );
+    }
+    static Register select( const Mask mask, const Register a, const Register b )
+    {
+        return _mm512_mask_blend_pd( mask, b, a );
+    }
+    static unsigned int getBits( const Mask mask ) { return mask; }
+};
+
+#else
+
+//! SIMD operations on AVX2 registers (4 doubles).
+struct SimdOperations
+{
+    typedef __m256d Register;
+    typedef __m256d Mask;
+    static const std::size_t width = 4;
+    static Register load( const Real* address ) { return _mm256_loadu_pd( address ); }
+    static void store( Real* address, const Register value ) { _mm256_storeu_pd( address, value ); }
+    static Register broadcast( const Real value ) { return _mm256_set1_pd( value ); }
+    static Register add( const Register a, const Register b ) { return _mm256_add_pd( a, b ); }
+    static Register subtract( const Register a, const Register b ) { return _mm256_sub_pd( a, b ); }
+    static Register multiply( const Register a, const Register b ) { return _mm256_mul_pd( a, b ); }
+    static Register divide( const Register a, const Register b ) { return _mm256_div_pd( a, b ); }
+    static Register squareRoot( const Register a ) { return _mm256_sqrt_pd( a ); }
+    static Mask isGreater( const Register a, const Register b )
+    {
+        return _mm256_cmp_pd( a, b, _CMP_GT_OQ );
+    }
+    static Register select( const Mask mask, const Register a, const Register b )
+    {
+        return _mm256_blendv_pd( b, a, mask );
+    }
+    static unsigned int getBits( const Mask mask )
+    {
+        return static_cast< unsigned int >( _mm256_movemask_pd( mask ) );
+    }
+};
+
+#endif
+
+//! Compute scale factor of thrust policy for register of thrust acceleration norms.
+/*!
+ * SIMD counterpart of ThrustPolicy::computeScaleFactor( ), with the saturation flag of each lane
+ * returned as a bit.
+ *
+ * @sa UnconstrainedThrustPolicy::computeScaleFactor
+ * @tparam     ThrustPolicy              Thrust policy
+ * @param[in]  thrustAccelerationNorm    Norms of commanded thrust acceleration [m/s^2]
+ * @param[in]  thrustAccelerationMaximum Maximum thrust accelerations [m/s^2]
+ * @param[out] saturationBits            Bit i set if thruster of lane i is throttled
+ * @return                               Scale factors [-]
+ */
+template< typename ThrustPolicy >
+SimdOperations::Register computeScaleFactorSimd(
+    const SimdOperations::Register thrustAccelerationNorm,
+    const SimdOperations::Register thrustAccelerationMaximum,
+    unsigned int& saturationBits );
+
+template< >
+SimdOperations::Register computeScaleFactorSimd< UnconstrainedThrustPolicy >(
+    const SimdOperations::Register,
+    const SimdOperations::Register,
+    unsigned int& saturationBits )
+{
+    saturationBits = 0;
+    return SimdOperations::broadcast( 1.0 );
+}
+
+template< >
+SimdOperations::Register computeScaleFactorSimd< ThrottleThrustPolicy >(
+    const SimdOperations::Register thrustAccelerationNorm,
+    const SimdOperations::Register thrustAccelerationMaximum,
+    unsigned int& saturationBits )
+{
+    typedef SimdOperations Simd;
+    const Simd::Mask isSaturated
+        = Simd::isGreater( thrustAccelerationNorm, thrustAccelerationMaximum );
+    saturationBits = Simd::getBits( isSaturated );
+    return Simd::select( isSaturated,
+                         Simd::divide( thrustAccelerationMaximum, thrustAccelerationNorm ),
+                         Simd::broadcast( 1.0 ) );
+}
+
+template< >
+SimdOperations::Register computeScaleFactorSimd< OnOffThrustPolicy >(
+    const SimdOperations::Register thrustAccelerationNorm,
+    const SimdOperations::Register thrustAccelerationMaximum,
+    unsigned int& saturationBits )
+{
+    typedef SimdOperations Simd;
+    const Simd::Mask isSwitchedOn = Simd::isGreater(
+        thrustAccelerationNorm,
+        Simd::divide( thrustAccelerationMaximum, Simd::broadcast( 2.0 ) ) );
+    saturationBits = 0;
+    return Simd::select( isSwitchedOn,
+                         Simd::divide( thrustAccelerationMaximum, thrustAccelerationNorm ),
+                         Simd::broadcast( 0.0 ) );
+}
+
+//! Evaluate guidance kernel for range of batch of chasers with SIMD instructions.
+/*!
+ * Evaluates the guidance kernel in blocks of SimdOperations::width chasers. The number of chasers
+ * in the range must be a multiple of the register width. Results agree with the scalar loop up to
+ * rounding, since the compiler may contract the scalar loop into fused multiply-adds.
+ *
+ * @sa evaluateRange
+ */
+template< typename ThrustPolicy >
+void evaluateRangeSimd( const ClohessyWiltshireStateTransition& timeToGoTransition,
+                        const Real timeToGo,
+                        const StateBatch& states,
+                        const std::vector< Real >& thrustAccelerationMaxima,
+                        AccelerationBatch& thrustAccelerations,
+                        std::vector< Real >& thrustAccelerationNorms,
+                        std::vector< unsigned char >& isSaturated,
+                        const std::size_t begin,
+                        const std::size_t end )
+{
+    typedef SimdOperations Simd;
+    typedef Simd::Register Register;
+
+    const Matrix66& phi = timeToGoTransition.stateTransitionMatrix;
+    const Register phi00 = Simd::broadcast( phi[ 0 ][ 0 ] );
+    const Register phi03 = Simd::broadcast( phi[ 0 ][ 3 ] );
+    const Register phi04 = Simd::broadcast( phi[ 0 ][ 4 ] );
+    const Register phi10 = Simd::broadcast( phi[ 1 ][ 0 ] );
+    const Register phi13 = Simd::broadcast( phi[ 1 ][ 3 ] );
+    const Register phi14 = Simd::broadcast( phi[ 1 ][ 4 ] );
+    const Register phi22 = Simd::broadcast( phi[ 2 ][ 2 ] );
+    const Register phi25 = Simd::broadcast( phi[ 2 ][ 5 ] );
+    const Register phi30 = Simd::broadcast( phi[ 3 ][ 0 ] );
+    const Register phi33 = Simd::broadcast( phi[ 3 ][ 3 ] );
+    const Register phi34 = Simd::broadcast( phi[ 3 ][ 4 ] );
+    const Register phi40 = Simd::broadcast( phi[ 4 ][ 0 ] );
+    const Register phi43 = Simd::broadcast( phi[ 4 ][ 3 ] );
+    const Register phi44 = Simd::broadcast( phi[ 4 ][ 4 ] );
+    const Register phi52 = Simd::broadcast( phi[ 5 ][ 2 ] );
+    const Register phi55 = Simd::broadcast( phi[ 5 ][ 5 ] );
+
+    // Since ZEM and ZEV are the negative of the ballistic end state, the guidance law is evaluated
+    // as a = 2 v_f / tgo - 6 r_f / tgo^2.
+    const Register positionGain = Simd::broadcast( 6.0 / ( timeToGo * timeToGo ) );
+    const Register velocityGain = Simd::broadcast( 2.0 / timeToGo );
+
+    const Real* xColumn = states.getColumn( 0 );
+    const Real* yColumn = states.getColumn( 1 );
+    const Real* zColumn = states.getColumn( 2 );
+    const Real* xDotColumn = states.getColumn( 3 );
+    const Real* yDotColumn = states.getColumn( 4 );
+    const Real* zDotColumn = states.getColumn( 5 );
+    const Real* maximumColumn = thrustAccelerationMaxima.data( );
+    Real* axColumn = thrustAccelerations.getColumn( 0 );
+    Real* ayColumn = thrustAccelerations.getColumn( 1 );
+    Real* azColumn = thrustAccelerations.getColumn( 2 );
+    Real* normColumn = thrustAccelerationNorms.data( );
+    unsigned char* isSaturatedColumn = isSaturated.data( );
+
+    for ( std::size_t i = begin; i < end; i += Simd::width )
+    {
+        const Register x = Simd::load( xColumn + i );
+        const Register y = Simd::load( yColumn + i );
+        const Register z = Simd::load( zColumn + i );
+        const Register xDot = Simd::load( xDotColumn + i );
+        const Register yDot = Simd::load( yDotColumn + i );
+        const Register zDot = Simd::load( zDotColumn + i );
+
+        const Register xFinal = Simd::add(
+            Simd::add( Simd::multiply( phi00, x ), Simd::multiply( phi03, xDot ) ),
+            Simd::multiply( phi04, yDot ) );
+        const Register yFinal = Simd::add(
+            Simd::add( Simd::add( Simd::multiply( phi10, x ), y ),
+                       Simd::multiply( phi13, xDot ) ),
+            Simd::multiply( phi14, yDot ) );
+        const Register zFinal
+            = Simd::add( Simd::multiply( phi22, z ), Simd::multiply( phi25, zDot ) );
+        const Register xDotFinal = Simd::add(
+            Simd::add( Simd::multiply( phi30, x ), Simd::multiply( phi33, xDot ) ),
+            Simd::multiply( phi34, yDot ) );
+        const Register yDotFinal = Simd::add(
+            Simd::add( Simd::multiply( phi40, x ), Simd::multiply( phi43, xDot ) ),
+            Simd::multiply( phi44, yDot ) );
+        const Register zDotFinal
+            = Simd::add( Simd::multiply( phi52, z ), Simd::multiply( phi55, zDot ) );
+
+        const Register ax = Simd::subtract( Simd::multiply( velocityGain, xDotFinal ),
+                                            Simd::multiply( positionGain, xFinal ) );
+        const Register ay = Simd::subtract( Simd::multiply( velocityGain, yDotFinal ),
+                                            Simd::multiply( positionGain, yFinal ) );
+        const Register az = Simd::subtract( Simd::multiply( velocityGain, zDotFinal ),
+                                            Simd::multiply( positionGain, zFinal ) );
+        const Register thrustAccelerationNorm = Simd::squareRoot(
+            Simd::add( Simd::add( Simd::multiply( ax, ax ), Simd::multiply( ay, ay ) ),
+                       Simd::multiply( az, az ) ) );
+
+        unsigned int saturationBits = 0;
+        const Register scaleFactor = computeScaleFactorSimd< ThrustPolicy >(
+            thrustAccelerationNorm, Simd::load( maximumColumn + i ), saturationBits );
+
+        Simd::store( axColumn + i, Simd::multiply( ax, scaleFactor ) );
+        Simd::store( ayColumn + i, Simd::multiply( ay, scaleFactor ) );
+        Simd::store( azColumn + i, Simd::multiply( az, scaleFactor ) );
+        Simd::store( normColumn + i, Simd::multiply( scaleFactor, thrustAccelerationNorm ) );
+        for ( std::size_t j = 0; j < Simd::width; ++j )
+        {
+            isSaturatedColumn[ i + j ] = ( saturationBits >> j ) & 1u;
+        }
+    }
+}
+
+#endif
+
+//! Evaluate guidance kernel for range of batch of chasers, using SIMD instructions if available.
+/*!
+ * @sa evaluateRange
+ */
+template< typename ThrustPolicy >
+void evaluateRangeVectorised( const ClohessyWiltshireStateTransition& timeToGoTransition,
+                              const Real timeToGo,
+                              const StateBatch& states,
+                              const std::vector< Real >& thrustAccelerationMaxima,
+                              AccelerationBatch& thrustAccelerations,
+                              std::vector< Real >& thrustAccelerationNorms,
+                              std::vector< unsigned char >& isSaturated,
+                              const std::size_t begin,
+                              const std::size_t end )
+{
+#if defined( __AVX512F__ ) || defined( __AVX2__ )
+    const std::size_t vectorisedEnd = end - ( end - begin ) % SimdOperations::width;
+    evaluateRangeSimd< ThrustPolicy >(
+        timeToGoTransition, timeToGo, states, thrustAccelerationMaxima,
+        thrustAccelerations, thrustAccelerationNorms, isSaturated, begin, vectorisedEnd );
+    evaluateRange< ThrustPolicy >(
+        timeToGoTransition, timeToGo, states, thrustAccelerationMaxima,
+        thrustAccelerations, thrustAccelerationNorms, isSaturated, vectorisedEnd, end );
+#else
+    evaluateRange< ThrustPolicy >(
+        timeToGoTransition, timeToGo, states, thrustAccelerationMaxima,
+        thrustAccelerations, thrustAccelerationNorms, isSaturated, begin, end );
+#endif
+}
+
+} // namespace
+
+//! Evaluate guidance kernel for batch of chasers with Clohessy-Wiltshire dynamics.
+void evaluateGuidanceKernelBatch( const ClohessyWiltshireStateTransition& timeToGoTransition,
+                                  const Real timeToGo,
+                                  const StateBatch& states,
+                                  const std::vector< ThrustPolicyType >& thrustPolicies,
+                                  const std::vector< Real >& thrustAccelerationMaxima,
+                                  AccelerationBatch& thrustAccelerations,
+                                  std::vector< Real >& thrustAccelerationNorms,
+                                  std::vector< unsigned char >& isSaturated )
+{
+    const std::size_t numberOfChasers = states.size( );
+    thrustAccelerations.resize( numberOfChasers );
+    thrustAccelerationNorms.resize( numberOfChasers );
+    isSaturated.resize( numberOfChasers );
+
+    // Process consecutive chasers with the same thrust policy in a single specialised loop.
+    std::size_t begin = 0;
+    while ( begin < numberOfChasers )
+    {
+        const ThrustPolicyType thrustPolicy = thrustPolicies[ begin ];
+        std::size_t end = begin + 1;
+        while ( end < numberOfChasers && thrustPolicies[ end ] == thrustPolicy )
+        {
+            ++end;
+        }
+
+        switch ( thrustPolicy )
+        {
+            case noThrustPolicy:
+            {
+                evaluateRange< NoThrustPolicy >(
+                    timeToGoTransition, timeToGo, states, thrustAccelerationMaxima,
+                    thrustAccelerations, thrustAccelerationNorms, isSaturated, begin, end );
+                break;
+            }
+
+            case unconstrainedThrustPolicy:
+            {
+                evaluateRangeVectorised< UnconstrainedThrustPolicy >(
+                    timeToGoTransition, timeToGo, states, thrustAccelerationMaxima,
+                    thrustAccelerations, thrustAccelerationNorms, isSaturated, begin, end );
+                break;
+            }
+
+            case throttleThrustPolicy:
+            {
+                evaluateRangeVectorised< ThrottleThrustPolicy >(
+                    timeToGoTransition, timeToGo, states, thrustAccelerationMaxima,
+                    thrustAccelerations, thrustAccelerationNorms, isSaturated, begin, end );
+                break;
+            }
+
+            case onOffThrustPolicy:
+            {
+                evaluateRangeVectorised< OnOffThrustPolicy >(
+                    timeToGoTransition, timeToGo, states, thrustAccelerationMaxima,
+                    thrustAccelerations, thrustAccelerationNorms, isSaturated, begin, end );
+                break;
+            }
+        }
+
+        begin = end;
+    }
+}
+
+} // namespace rvdsim
@@ -0,0 +1,341 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <vector>
+
+#include "rvdsim/instrumentation.hpp"
+
+namespace rvdsim
+{
+
+namespace
+{
+
+//! Instrumentation metrics of a single thread.
+/*!
+ * Metrics are only written by the owning thread, such that they can be updated without atomic
+ * read-modify-write operations. Relaxed atomic loads and stores are used, so that other threads
+ * can safely read the metrics while taking a snapshot.
+ */
+struct ThreadMetrics
+{
+public:
+
+    //! Construct thread metrics and register them.
+    ThreadMetrics( );
+
+    //! Destruct thread metrics, merging them into the metrics of exited threads.
+    ~ThreadMetrics( );
+
+    //! Add value to metric.
+    static void add( std::atomic< std::uint64_t >& metric, const std::uint64_t value )
+    {
+        metric.store( metric.load( std::memory_order_relaxed ) + value,
+                      std::memory_order_relaxed );
+    }
+
+    //! Cumulative time spent in each phase [ns].
+    std::atomic< std::uint64_t > phaseTimes[ numberOfInstrumentationPhases ];
+
+    //! Number of times each phase was entered [-].
+    std::atomic< std::uint64_t > phaseCalls[ numberOfInstrumentationPhases ];
+
+    //! Value of each counter [-].
+    std::atomic< std::uint64_t > counters[ numberOfInstrumentationCounters ];
+
+protected:
+private:
+};
+
+//! Registry of thread metrics.
+struct MetricsRegistry
+{
+public:
+
+    //! Construct registry with zero metrics for exited threads.
+    MetricsRegistry( )
+        : mutex( ),
+          threadMetrics( ),
+          exitedThreadMetrics( )
+    {
+        std::fill( exitedThreadMetrics.phaseTimes,
+                   exitedThreadMetrics.phaseTimes + numberOfInstrumentationPhases, 0 );
+        std::fill( exitedThreadMetrics.phaseCalls,
+                   exitedThreadMetrics.phaseCalls + numberOfInstrumentationPhases, 0 );
+        std::fill( exitedThreadMetrics.counters,
+                   exitedThreadMetrics.counters + numberOfInstrumentationCounters, 0 );
+    }
+
+    //! Mutex guarding registry.
+    std::mutex mutex;
+
+    //! Metrics of live threads.
+    std::vector< ThreadMetrics* > threadMetrics;
+
+    //! Accumulated metrics of exited threads.
+    InstrumentationSnapshot exitedThreadMetrics;
+
+protected:
+private:
+};
+
+//! Get registry of thread metrics.
+MetricsRegistry& getMetricsRegistry( )
+{
+    static MetricsRegistry registry;
+    return registry;
+}
+
+//! Construct thread metrics and register them.
+ThreadMetrics::ThreadMetrics( )
+{
+    for ( int i = 0; i < numberOfInstrumentationPhases; ++i )
+    {
+        phaseTimes[ i ].store( 0, std::memory_order_relaxed );
+        phaseCalls[ i ].store( 0, std::memory_order_relaxed );
+    }
+    for ( int i = 0; i < numberOfInstrumentationCounters; ++i )
+    {
+        counters[ i ].store( 0, std::memory_order_relaxed );
+    }
+
+    MetricsRegistry& registry = getMetricsRegistry( );
+    std::lock_guard< std::mutex > lock( registry.mutex );
+    registry.threadMetrics.push_back( this );
+}
+
+//! Destruct thread metrics, merging them into the metrics of exited threads.
+ThreadMetrics::~ThreadMetrics( )
+{
+    MetricsRegistry& registry = getMetricsRegistry( );
+    std::lock_guard< std::mutex > lock( registry.mutex );
+    for ( int i = 0; i < numberOfInstrumentationPhases; ++i )
+    {
+        registry.exitedThreadMetrics.phaseTimes[ i ]
+            += phaseTimes[ i ].load( std::memory_order_relaxed );
+        registry.exitedThreadMetrics.phaseCalls[ i ]
+            += phaseCalls[ i ].load( std::memory_order_relaxed );
+    }
+    for ( int i = 0; i < numberOfInstrumentationCounters; ++i )
+    {
+        registry.exitedThreadMetrics.counters[ i ]
+            += counters[ i ].load( std::memory_order_relaxed );
+    }
+    registry.threadMetrics.erase( std::find( registry.threadMetrics.begin( ),
+                                             registry.threadMetrics.end( ),
+                                             this ) );
+}
+
+//! Get metrics of calling thread.
+ThreadMetrics& getThreadMetrics( )
+{
+    // Ensure that registry outlives thread metrics of main thread.
+    getMetricsRegistry( );
+    static thread_local ThreadMetrics metrics;
+    return metrics;
+}
+
+} // namespace
+
+//! Get name of instrumentation phase.
+std::string getInstrumentationPhaseName( const InstrumentationPhase phase )
+{
+    switch ( phase )
+    {
+        case jsonParsePhase:
+            return "json_parse";
+
+        case inputCheckPhase:
+            return "input_check";
+
+        case simulationPhase:
+            return "simulation";
+
+        case guidancePhase:
+            return "guidance";
+
+        case propagationPhase:
+            return "propagation";
+
+        case outputPhase:
+            return "output";
+
+        case numberOfInstrumentationPhases:
+            break;
+    }
+
+    return "unknown";
+}
+
+//! Get name of instrumentation counter.
+std::string getInstrumentationCounterName( const InstrumentationCounter counter )
+{
+    switch ( counter )
+    {
+        case propagationCounter:
+            return "propagations";
+
+        case guidanceCallCounter:
+            return "guidance_calls";
+
+        case throttleSaturationCounter:
+            return "throttle_saturations";
+
+        case bytesWrittenCounter:
+            return "bytes_written";
+
+        case numberOfInstrumentationCounters:
+            break;
+    }
+
+    return "unknown";
+}
+
+//! Add time spent in phase.
+void addInstrumentationPhaseTime( const InstrumentationPhase phase,
+                                  const std::uint64_t nanoseconds )
+{
+    ThreadMetrics& metrics = getThreadMetrics( );
+    ThreadMetrics::add( metrics.phaseTimes[ phase ], nanoseconds );
+    ThreadMetrics::add( metrics.phaseCalls[ phase ], 1 );
+}
+
+//! Increment instrumentation counter.
+void incrementInstrumentationCounter( const InstrumentationCounter counter,
+                                      const std::uint64_t amount )
+{
+    ThreadMetrics::add( getThreadMetrics( ).counters[ counter ], amount );
+}
+
+//! Get snapshot of instrumentation metrics.
+InstrumentationSnapshot getInstrumentationSnapshot( )
+{
+    MetricsRegistry& registry = getMetricsRegistry( );
+    std::lock_guard< std::mutex > lock( registry.mutex );
+
+    InstrumentationSnapshot snapshot = registry.exitedThreadMetrics;
+    for ( std::size_t j = 0; j < registry.threadMetrics.size( ); ++j )
+    {
+        const ThreadMetrics& metrics = *registry.threadMetrics[ j ];
+        for ( int i = 0; i < numberOfInstrumentationPhases; ++i )
+        {
+            snapshot.phaseTimes[ i ] += metrics.phaseTimes[ i ].load( std::memory_order_relaxed );
+            snapshot.phaseCalls[ i ] += metrics.phaseCalls[ i ].load( std::memory_order_relaxed );
+        }
+        for ( int i = 0; i < numberOfInstrumentationCounters; ++i )
+        {
+            snapshot.counters[ i ] += metrics.counters[ i ].load( std::memory_order_relaxed );
+        }
+    }
+
+    return snapshot;
+}
+
+//! Reset instrumentation metrics.
+void resetInstrumentation( )
+{
+    MetricsRegistry& registry = getMetricsRegistry( );
+    std::lock_guard< std::mutex > lock( registry.mutex );
+
+    std::fill( registry.exitedThreadMetrics.phaseTimes,
+               registry.exitedThreadMetrics.phaseTimes + numberOfInstrumentationPhases, 0 );
+    std::fill( registry.exitedThreadMetrics.phaseCalls,
+               registry.exitedThreadMetrics.phaseCalls + numberOfInstrumentationPhases, 0 );
+    std::fill( registry.exitedThreadMetrics.counters,
+               registry.exitedThreadMetrics.counters + numberOfInstrumentationCounters, 0 );
+
+    for ( std::size_t j = 0; j < registry.threadMetrics.size( ); ++j )
+    {
+        ThreadMetrics& metrics = *registry.threadMetrics[ j ];
+        for ( int i = 0; i < numberOfInstrumentationPhases; ++i )
+        {
+            metrics.phaseTimes[ i ].store( 0, std::memory_order_relaxed );
+            metrics.phaseCalls[ i ].store( 0, std::memory_order_relaxed );
+        }
+        for ( int i = 0; i < numberOfInstrumentationCounters; ++i )
+        {
+            metrics.counters[ i ].store( 0, std::memory_order_relaxed );
+        }
+    }
+}
+
+//! Write instrumentation report.
+void writeInstrumentationReport( std::ostream& stream )
+{
+    const InstrumentationSnapshot snapshot = getInstrumentationSnapshot( );
+
+    stream << std::left << std::setw( 30 ) << "Phase"
+           << std::right << std::setw( 14 ) << "Calls"
+           << std::setw( 16 ) << "Total [s]"
+           << std::setw( 16 ) << "Mean [us]" << std::endl;
+    for ( int i = 0; i < numberOfInstrumentationPhases; ++i )
+    {
+        const double totalTime = 1.0e-9 * static_cast< double >( snapshot.phaseTimes[ i ] );
+        const double meanTime
+            = snapshot.phaseCalls[ i ] == 0
+              ? 0.0 : 1.0e6 * totalTime / static_cast< double >( snapshot.phaseCalls[ i ] );
+        stream << std::left << std::setw( 30 )
+               << getInstrumentationPhaseName( static_cast< InstrumentationPhase >( i ) )
+               << std::right << std::setw( 14 ) << snapshot.phaseCalls[ i ]
+               << std::setw( 16 ) << totalTime
+               << std::setw( 16 ) << meanTime << std::endl;
+    }
+
+    stream << std::endl;
+    stream << std::left << std::setw( 30 ) << "Counter"
+           << std::right << std::setw( 14 ) << "Value" << std::endl;
+    for ( int i = 0; i < numberOfInstrumentationCounters; ++i )
+    {
+        stream << std::left << std::setw( 30 )
+               << getInstrumentationCounterName( static_cast< InstrumentationCounter >( i ) )
+               << std::right << std::setw( 14 ) << snapshot.counters[ i ] << std::endl;
+    }
+    stream << std::left;
+}
+
+//! Write instrumentation metrics to JSON file.
+void writeInstrumentationMetrics( const std::string& filePath )
+{
+    const InstrumentationSnapshot snapshot = getInstrumentationSnapshot( );
+
+    std::ofstream metricsFile( filePath.c_str( ) );
+    if ( !metricsFile.is_open( ) )
+    {
+        std::cerr << "ERROR: Metrics file \"" << filePath << "\" could not be opened!"
+                  << std::endl;
+        throw;
+    }
+
+    metricsFile << "{" << std::endl;
+    metricsFile << "  \"phases\": {" << std::endl;
+    for ( int i = 0; i < numberOfInstrumentationPhases; ++i )
+    {
+        metricsFile << "    \""
+                    << getInstrumentationPhaseName( static_cast< InstrumentationPhase >( i ) )
+                    << "\": { \"calls\": " << snapshot.phaseCalls[ i ]
+                    << ", \"time_ns\": " << snapshot.phaseTimes[ i ] << " }"
+                    << ( i + 1 < numberOfInstrumentationPhases ? "," : "" ) << std::endl;
+    }
+    metricsFile << "  }," << std::endl;
+    metricsFile << "  \"counters\": {" << std::endl;
+    for ( int i = 0; i < numberOfInstrumentationCounters; ++i )
+    {
+        metricsFile << "    \""
+                    << getInstrumentationCounterName( static_cast< InstrumentationCounter >( i ) )
+                    << "\": " << snapshot.counters[ i ]
+                    << ( i + 1 < numberOfInstrumentationCounters ? "," : "" ) << std::endl;
+    }
+    metricsFile << "  }" << std::endl;
+    metricsFile << "}" << std::endl;
+}
+
+} // namespace rvdsim
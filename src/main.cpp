@@ -4,291 +4,648 @@
  * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
  */
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdlib>
-#include <fstream>
 #include <iostream>
+#include <memory>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include <rapidjson/document.h>
 
-#include <astro/astro.hpp>
-#include <sml/sml.hpp>
-#include <control/control.hpp>
-
-#include "rvdsim/userInput.hpp"
+#include "rvdsim/checkpoint.hpp"
+#include "rvdsim/configLoader.hpp"
+#include "rvdsim/instrumentation.hpp"
+#include "rvdsim/monteCarlo.hpp"
+#include "rvdsim/multiChaserSimulator.hpp"
+#include "rvdsim/outputSink.hpp"
+#include "rvdsim/parameterSweep.hpp"
+#include "rvdsim/simulator.hpp"
 #include "rvdsim/typedefs.hpp"
-
-int main( const int numberOfInputs, const char* inputArguments[ ] )
+#include "rvdsim/userInput.hpp"
+#include "rvdsim/workQueue.hpp"
+
+//! Execute simulation mode.
+/*!
+ * Executes single rendezvous simulation and writes chaser state and thrust histories to file. If
+ * checkpoint settings are provided, checkpoints are written periodically. If the simulation is
+ * resumed and a checkpoint file is found, the simulation continues from the last checkpoint and
+ * the output files are continued from the positions stored in the checkpoint; otherwise, the
+ * simulation starts from the beginning.
+ *
+ * @param[in] input     User input containing simulation settings
+ * @param[in] isResumed Flag indicating if simulation is resumed from last checkpoint
+ */
+void executeSimulationMode( const rvdsim::UserInput& input, const bool isResumed )
 {
+    std::cout << std::endl;
+    std::cout << "******************************************************************" << std::endl;
+    std::cout << "                       Simulation & Output                        " << std::endl;
+    std::cout << "******************************************************************" << std::endl;
+    std::cout << std::endl;
 
-    ///////////////////////////////////////////////////////////////////////////
+    // Set up simulator. Histories are not stored, since they are streamed to file instead.
+    rvdsim::Simulator simulator( input, false );
+
+    std::cout << "Chaser acceleration maximum   [m/s^2]         "
+              << simulator.getThrustAccelerationMaximum( ) << std::endl;
+    std::cout << "Chaser thrust pulse           [s]             "
+              << simulator.getThrustPulseTime( ) << std::endl;
+    std::cout << "Target mean motion            [rad/s]         "
+              << simulator.getTargetMeanMotion( ) << std::endl;
+
+    // Read last checkpoint, if simulation is resumed.
+    const std::string checkpointPath = input.outputDirectory + "/" + input.checkpoint.filename;
+    const bool isCheckpointUsed = !input.checkpoint.filename.empty( );
+    rvdsim::SimulatorCheckpoint checkpoint;
+    bool isCheckpointRead = false;
+    if ( isResumed )
+    {
+        if ( isCheckpointUsed && rvdsim::isCheckpointAvailable( checkpointPath ) )
+        {
+            checkpoint = rvdsim::readCheckpoint( checkpointPath );
+            isCheckpointRead = true;
+            std::cout << "Resuming from checkpoint at   [s]             "
+                      << checkpoint.currentTime << std::endl;
+        }
+        else
+        {
+            std::cout << "No checkpoint found, starting simulation from the beginning"
+                      << std::endl;
+        }
+    }
+
+    // Set up output sinks for chaser state and thrust histories.
+    std::ostringstream chaserStateHistoryPath;
+    chaserStateHistoryPath << input.outputDirectory << "/" << input.chaserStateHistoryFilename;
+    const char* stateColumnNames[ ] = { "t", "x", "y", "z", "xdot", "ydot", "zdot" };
+    std::unique_ptr< rvdsim::OutputSink > chaserStateSink
+        = rvdsim::createOutputSink( input.outputFormat,
+                                    chaserStateHistoryPath.str( ),
+                                    std::vector< std::string >( stateColumnNames,
+                                                                stateColumnNames + 7 ),
+                                    isCheckpointRead ? &checkpoint.stateSinkPosition : 0 );
+
+    std::ostringstream chaserThrustHistoryPath;
+    chaserThrustHistoryPath << input.outputDirectory << "/" << input.chaserThrustHistoryFilename;
+    const char* thrustColumnNames[ ] = { "t", "Tx", "Ty", "Tz" };
+    std::unique_ptr< rvdsim::OutputSink > chaserThrustSink
+        = rvdsim::createOutputSink( input.outputFormat,
+                                    chaserThrustHistoryPath.str( ),
+                                    std::vector< std::string >( thrustColumnNames,
+                                                                thrustColumnNames + 4 ),
+                                    isCheckpointRead ? &checkpoint.thrustSinkPosition : 0 );
+
+    // Set up optional output sink for binary chaser trajectory, combining state and thrust.
+    std::unique_ptr< rvdsim::OutputSink > chaserTrajectorySink;
+    if ( !input.chaserTrajectoryFilename.empty( ) )
+    {
+        std::ostringstream chaserTrajectoryPath;
+        chaserTrajectoryPath << input.outputDirectory << "/" << input.chaserTrajectoryFilename;
+        const char* trajectoryColumnNames[ ]
+            = { "t", "x", "y", "z", "xdot", "ydot", "zdot", "Tx", "Ty", "Tz" };
+        chaserTrajectorySink
+            = rvdsim::createOutputSink( rvdsim::binaryOutput,
+                                        chaserTrajectoryPath.str( ),
+                                        std::vector< std::string >( trajectoryColumnNames,
+                                                                    trajectoryColumnNames + 10 ),
+                                        isCheckpointRead ? &checkpoint.trajectorySinkPosition
+                                                         : 0 );
+    }
+
+    simulator.setOutputSinks(
+        chaserStateSink.get( ), chaserThrustSink.get( ), chaserTrajectorySink.get( ) );
+
+    if ( isCheckpointUsed )
+    {
+        simulator.setCheckpointing( checkpointPath, input.checkpoint.stepInterval );
+    }
 
     std::cout << std::endl;
-    std::cout << "------------------------------------------------------------------" << std::endl;
+    std::cout << "Executing simulation and writing output to file ... " << std::endl;
+
+    if ( isCheckpointRead )
+    {
+        simulator.resume( checkpoint );
+    }
+    else
+    {
+        simulator.execute( );
+    }
+
+    chaserStateSink->close( );
+    chaserThrustSink->close( );
+    if ( chaserTrajectorySink )
+    {
+        chaserTrajectorySink->close( );
+    }
+
+    if ( simulator.isThrottleMaximumReached( ) )
+    {
+        std::cout << "Maximum thrust level reached, thruster throttled!" << std::endl;
+    }
+
+    std::cout << "Total delta-V                 [m/s]           "
+              << simulator.getTotalDeltaV( ) << std::endl;
+    if ( input.chaserSpecificImpulse > 0.0 )
+    {
+        std::cout << "Propellant mass consumed      [kg]            "
+                  << simulator.getPropellantMass( ) << std::endl;
+        std::cout << "Chaser final mass             [kg]            "
+                  << simulator.getChaserFinalMass( ) << std::endl;
+    }
+
+    std::cout << "Simulation completed successfully!" << std::endl;
+    std::cout << "Output written to file successfully!" << std::endl;
     std::cout << std::endl;
-    std::cout << "                              rvdsim                              " << std::endl;
+
+    // Check if target was reached.
+    if ( !simulator.isTargetReached( ) )
+    {
+        std::cout << "Target not reached! :(" << std::endl;
+        std::cout << "You are " << simulator.getFinalDistanceToTarget( ) << " m from the target"
+                  << std::endl;
+    }
+    else
+    {
+        std::cout << "Congrats! You reached the target! :)" << std::endl;
+    }
+}
+
+//! Write results of Monte Carlo analysis.
+/*!
+ * Reports statistics over all Monte Carlo samples and writes the simulation summary of each sample
+ * to file.
+ *
+ * @param[in] input              User input containing nominal simulation settings
+ * @param[in] dispersionSettings Dispersion settings
+ * @param[in] summaries          Simulation summaries, ordered by sample index
+ */
+void writeMonteCarloResults( const rvdsim::UserInput&                      input,
+                             const rvdsim::DispersionSettings&             dispersionSettings,
+                             const std::vector< rvdsim::SimulationSummary >& summaries )
+{
+    // Compute statistics over all samples.
+    std::size_t numberOfTargetsReached = 0;
+    std::size_t numberOfThrottledSamples = 0;
+    std::size_t numberOfRedrawnSamples = 0;
+    rvdsim::Real finalDistanceSum = 0.0;
+    rvdsim::Real finalDistanceMaximum = 0.0;
+    rvdsim::Real totalDeltaVSum = 0.0;
+    rvdsim::Real totalDeltaVMaximum = 0.0;
+    rvdsim::Real propellantMassSum = 0.0;
+    rvdsim::Real propellantMassMaximum = 0.0;
+    for ( std::size_t i = 0; i < summaries.size( ); ++i )
+    {
+        numberOfTargetsReached += summaries[ i ].isTargetReached ? 1 : 0;
+        numberOfThrottledSamples += summaries[ i ].isThrottleMax ? 1 : 0;
+        numberOfRedrawnSamples += summaries[ i ].isRedrawn ? 1 : 0;
+        finalDistanceSum += summaries[ i ].finalDistanceToTarget;
+        finalDistanceMaximum = std::max( finalDistanceMaximum,
+                                         summaries[ i ].finalDistanceToTarget );
+        totalDeltaVSum += summaries[ i ].totalDeltaV;
+        totalDeltaVMaximum = std::max( totalDeltaVMaximum, summaries[ i ].totalDeltaV );
+        propellantMassSum += summaries[ i ].propellantMass;
+        propellantMassMaximum = std::max( propellantMassMaximum, summaries[ i ].propellantMass );
+    }
+    const rvdsim::Real numberOfSamples = static_cast< rvdsim::Real >( summaries.size( ) );
+
+    std::cout << "Samples reaching target                       "
+              << numberOfTargetsReached << "/" << summaries.size( ) << std::endl;
+    std::cout << "Samples with throttled thrust                 "
+              << numberOfThrottledSamples << "/" << summaries.size( ) << std::endl;
+    std::cout << "Samples with truncated dispersion             "
+              << numberOfRedrawnSamples << "/" << summaries.size( ) << std::endl;
+    std::cout << "Final distance mean           [m]             "
+              << finalDistanceSum / numberOfSamples << std::endl;
+    std::cout << "Final distance maximum        [m]             "
+              << finalDistanceMaximum << std::endl;
+    std::cout << "Total delta-V mean            [m/s]           "
+              << totalDeltaVSum / numberOfSamples << std::endl;
+    std::cout << "Total delta-V maximum         [m/s]           "
+              << totalDeltaVMaximum << std::endl;
+    if ( input.chaserSpecificImpulse > 0.0 )
+    {
+        std::cout << "Propellant mass mean          [kg]            "
+                  << propellantMassSum / numberOfSamples << std::endl;
+        std::cout << "Propellant mass maximum       [kg]            "
+                  << propellantMassMaximum << std::endl;
+    }
     std::cout << std::endl;
-    std::cout << "         Copyright (c) 2016, K. Kumar (me@kartikkumar.com)        " << std::endl;
+
+    std::cout << "Writing output to file ... " << std::endl;
+
+    // Write Monte Carlo summary to CSV file.
+    std::ostringstream summaryPath;
+    summaryPath << input.outputDirectory << "/" << dispersionSettings.summaryFilename;
+    rvdsim::writeMonteCarloSummary( summaryPath.str( ), summaries );
+
+    std::cout << "Output written to file successfully!" << std::endl;
+}
+
+//! Execute Monte Carlo mode.
+/*!
+ * Executes Monte Carlo analysis, in which the simulation is executed for a set of samples with
+ * dispersed input parameters, and writes the simulation summary of each sample to file.
+ *
+ * @param[in] input              User input containing nominal simulation settings
+ * @param[in] dispersionSettings Dispersion settings
+ */
+void executeMonteCarloMode( const rvdsim::UserInput&          input,
+                            const rvdsim::DispersionSettings& dispersionSettings )
+{
     std::cout << std::endl;
-    std::cout << "------------------------------------------------------------------" << std::endl;
+    std::cout << "******************************************************************" << std::endl;
+    std::cout << "                    Monte Carlo Analysis & Output                 " << std::endl;
+    std::cout << "******************************************************************" << std::endl;
     std::cout << std::endl;
 
-    ///////////////////////////////////////////////////////////////////////////
+    std::cout << "Executing " << dispersionSettings.numberOfSamples << " simulations ... "
+              << std::endl;
 
-    ///////////////////////////////////////////////////////////////////////////
+    const std::vector< rvdsim::SimulationSummary > summaries
+        = rvdsim::executeMonteCarloAnalysis( input, dispersionSettings );
+
+    std::cout << "Simulations completed successfully!" << std::endl;
+    std::cout << std::endl;
+
+    writeMonteCarloResults( input, dispersionSettings, summaries );
+}
 
+//! Execute parameter sweep mode.
+/*!
+ * Executes parameter sweep, in which the simulation is executed for each point on a grid of
+ * thruster settings, and writes the results of all grid points to file.
+ *
+ * @param[in] input         User input containing nominal simulation settings
+ * @param[in] sweepSettings Sweep settings
+ */
+void executeParameterSweepMode( const rvdsim::UserInput&     input,
+                                const rvdsim::SweepSettings& sweepSettings )
+{
     std::cout << std::endl;
     std::cout << "******************************************************************" << std::endl;
-    std::cout << "                          Input parameters                        " << std::endl;
+    std::cout << "                   Parameter Sweep & Output                       " << std::endl;
     std::cout << "******************************************************************" << std::endl;
     std::cout << std::endl;
 
-    // Check that only one input has been provided (a JSON file).
-    if ( numberOfInputs - 1 != 1 )
-    {
-        std::cerr << "ERROR: Number of inputs is wrong. Please only provide a JSON input file!"
-                  << std::endl;
-        throw;
-    }
+    std::cout << "Executing " << sweepSettings.getNumberOfGridPoints( ) << " simulations ... "
+              << std::endl;
 
-    ///////////////////////////////////////////////////////////////////////////
+    const std::vector< rvdsim::SweepResult > results
+        = rvdsim::executeParameterSweep( input, sweepSettings );
 
-   ///////////////////////////////////////////////////////////////////////////
+    std::cout << "Simulations completed successfully!" << std::endl;
+    std::cout << std::endl;
 
-    // Read and store JSON input document (filter out comment lines).
-    // TODO: Need to make comment-line filtering more robust.
-    std::ifstream inputFile( inputArguments[ 1 ] );
-    std::stringstream jsonDocumentBuffer;
-    std::string inputLine;
-    while ( std::getline( inputFile, inputLine ) )
+    std::size_t numberOfTargetsReached = 0;
+    std::size_t numberOfTerminatedGridPoints = 0;
+    for ( std::size_t i = 0; i < results.size( ); ++i )
     {
-        size_t startPosition = inputLine.find_first_not_of( " \t" );
-        if ( std::string::npos != startPosition )
-        {
-            inputLine = inputLine.substr( startPosition );
-        }
-
-        if ( inputLine.substr( 0, 2 ) != "//" )
-        {
-            jsonDocumentBuffer << inputLine << "\n";
-        }
+        numberOfTargetsReached += results[ i ].summary.isTargetReached ? 1 : 0;
+        numberOfTerminatedGridPoints += results[ i ].summary.isTerminatedEarly ? 1 : 0;
     }
 
-    // Parse JSON document.
-    rapidjson::Document config;
-    config.Parse( jsonDocumentBuffer.str( ).c_str( ) );
-
-    // Verify config parameters. Exception is thrown if any of the parameters are missing.
-    const rvdsim::UserInput input = rvdsim::checkInput( config );
+    std::cout << "Grid points reaching target                   "
+              << numberOfTargetsReached << "/" << results.size( ) << std::endl;
+    std::cout << "Grid points terminated early                  "
+              << numberOfTerminatedGridPoints << "/" << results.size( ) << std::endl;
+    std::cout << std::endl;
 
-    ///////////////////////////////////////////////////////////////////////////
+    std::cout << "Writing output to file ... " << std::endl;
 
-    ///////////////////////////////////////////////////////////////////////////
+    // Write sweep results to CSV file.
+    std::ostringstream resultsPath;
+    resultsPath << input.outputDirectory << "/" << sweepSettings.resultsFilename;
+    rvdsim::writeParameterSweepResults( resultsPath.str( ), results );
 
-    // Execute RVD simulation.
+    std::cout << "Output written to file successfully!" << std::endl;
+}
 
+//! Execute multi-chaser mode.
+/*!
+ * Executes simulation of multiple chasers in a single time loop, streams the chaser states and
+ * thrusts to file, and writes the summary of each chaser to file.
+ *
+ * @param[in] input               User input containing shared simulation settings
+ * @param[in] multiChaserSettings Multi-chaser settings
+ */
+void executeMultiChaserMode( const rvdsim::UserInput&           input,
+                             const rvdsim::MultiChaserSettings& multiChaserSettings )
+{
     std::cout << std::endl;
     std::cout << "******************************************************************" << std::endl;
-    std::cout << "                       Simulation & Output                        " << std::endl;
+    std::cout << "                  Multi-Chaser Simulation & Output                " << std::endl;
     std::cout << "******************************************************************" << std::endl;
     std::cout << std::endl;
 
-    // Compute maximum thrust acceleration available to chaser.
-    const rvdsim::Real thrustAccelerationMaximum = input.thrustMaximum / input.chaserWetMass;
-    std::cout << "Chaser acceleration maximum   [m/s^2]         "
-              << thrustAccelerationMaximum << std::endl;
-
-    // Compute length of thruster pulse [s].
-    const rvdsim::Real thrustPulseTime = 1.0 / input.thrustFrequency;
-    std::cout << "Chaser thrust pulse           [s]             " << thrustPulseTime << std::endl;
+    rvdsim::MultiChaserSimulator simulator( input, multiChaserSettings.chasers );
 
-    // Compute current chaser epoch, state and Time-To-Go (TTG) [s].
-    rvdsim::Real    currentTime      = input.startTime;
-    rvdsim::Vector6 currentState     = input.chaserInitialState;
-    rvdsim::Real    timeToGo         = input.endTime - input.startTime;
+    // Set up output sinks for chaser state and thrust histories, with one row per chaser per
+    // epoch.
+    std::ostringstream chaserStateHistoryPath;
+    chaserStateHistoryPath << input.outputDirectory << "/" << input.chaserStateHistoryFilename;
+    const char* stateColumnNames[ ] = { "t", "chaser", "x", "y", "z", "xdot", "ydot", "zdot" };
+    std::unique_ptr< rvdsim::OutputSink > chaserStateSink
+        = rvdsim::createOutputSink( input.outputFormat,
+                                    chaserStateHistoryPath.str( ),
+                                    std::vector< std::string >( stateColumnNames,
+                                                                stateColumnNames + 8 ) );
 
-    // Compute mean motion of target's orbit [rad/s].
-    const rvdsim::Real targetMeanMotion = astro::computeKeplerMeanMotion(
-        input.targetSemiMajorAxis, input.earthGravitationalParameter );
-    std::cout << "Target mean motion            [rad/s]         " << targetMeanMotion << std::endl;
+    std::ostringstream chaserThrustHistoryPath;
+    chaserThrustHistoryPath << input.outputDirectory << "/" << input.chaserThrustHistoryFilename;
+    const char* thrustColumnNames[ ] = { "t", "chaser", "Tx", "Ty", "Tz" };
+    std::unique_ptr< rvdsim::OutputSink > chaserThrustSink
+        = rvdsim::createOutputSink( input.outputFormat,
+                                    chaserThrustHistoryPath.str( ),
+                                    std::vector< std::string >( thrustColumnNames,
+                                                                thrustColumnNames + 5 ) );
 
-    rvdsim::Vector3 zeroThrustAcceleration( 3 );
-    zeroThrustAcceleration[ astro::xPositionIndex ] = 0.0;
-    zeroThrustAcceleration[ astro::yPositionIndex ] = 0.0;
-    zeroThrustAcceleration[ astro::zPositionIndex ] = 0.0;
+    simulator.setOutputSinks( chaserStateSink.get( ), chaserThrustSink.get( ) );
 
-    rvdsim::Vector3 zeroEffortMiss( 3 );
-    rvdsim::Vector3 zeroEffortVelocity( 3 );
+    std::cout << "Executing simulation of " << simulator.getNumberOfChasers( ) << " chasers and "
+              << "writing output to file ... " << std::endl;
 
-    rvdsim::StateHistory chaserStateHistory;
-    chaserStateHistory[ currentTime ] = currentState;
+    simulator.execute( );
 
-    rvdsim::ThrustHistory chaserThrustHistory;
+    chaserStateSink->close( );
+    chaserThrustSink->close( );
 
-    bool isThrottleMax = false;
+    std::cout << "Simulation completed successfully!" << std::endl;
+    std::cout << std::endl;
 
+    const std::vector< rvdsim::SimulationSummary > summaries = simulator.getSummaries( );
+    std::size_t numberOfTargetsReached = 0;
+    for ( std::size_t i = 0; i < summaries.size( ); ++i )
+    {
+        numberOfTargetsReached += summaries[ i ].isTargetReached ? 1 : 0;
+    }
+    std::cout << "Chasers reaching target                       "
+              << numberOfTargetsReached << "/" << summaries.size( ) << std::endl;
     std::cout << std::endl;
-    std::cout << "Executing simulation ... " << std::endl;
 
-    while ( timeToGo > 0.0 )
+    // Write multi-chaser summary to CSV file.
+    std::ostringstream summaryPath;
+    summaryPath << input.outputDirectory << "/" << multiChaserSettings.summaryFilename;
+    rvdsim::writeMultiChaserSummary( summaryPath.str( ), summaries );
+
+    std::cout << "Output written to file successfully!" << std::endl;
+}
+
+//! Execute scenario.
+/*!
+ * Executes RVD simulation, multi-chaser simulation if multi-chaser settings are provided,
+ * parameter sweep if sweep settings are provided, or Monte Carlo analysis if dispersion settings
+ * are provided.
+ *
+ * Checkpoints are only written, and can only be resumed, for single RVD simulations.
+ *
+ * @param[in] config    User-defined configuration options (extracted from JSON input)
+ * @param[in] input     User input containing simulation settings
+ * @param[in] isResumed Flag indicating if simulation is resumed from last checkpoint
+ */
+void executeScenario( const rapidjson::Document& config,
+                      const rvdsim::UserInput& input,
+                      const bool isResumed )
+{
+    if ( rvdsim::hasMultiChaserInput( config ) )
+    {
+        const rvdsim::MultiChaserSettings multiChaserSettings
+            = rvdsim::checkMultiChaserInput( config, input );
+        executeMultiChaserMode( input, multiChaserSettings );
+    }
+    else if ( rvdsim::hasSweepInput( config ) )
     {
-        // Compute end state resulting from ballistic trajectory.
-        rvdsim::Vector6 zeroThrustEndState
-            = astro::propagateClohessyWiltshireSolution( currentState,
-                                                         timeToGo,
-                                                         targetMeanMotion,
-                                                         zeroThrustAcceleration );
+        const rvdsim::SweepSettings sweepSettings = rvdsim::checkSweepInput( config, input );
+        executeParameterSweepMode( input, sweepSettings );
+    }
+    else if ( rvdsim::hasDispersionInput( config ) )
+    {
+        const rvdsim::DispersionSettings dispersionSettings
+            = rvdsim::checkDispersionInput( config, input );
+        executeMonteCarloMode( input, dispersionSettings );
+    }
+    else
+    {
+        executeSimulationMode( input, isResumed );
+    }
+}
 
-        // Compute control action using ZEM/ZEM feedback law.
-        rvdsim::Vector3 thrustAcceleration( 3 );
+//! Execute scenarios.
+/*!
+ * Reads and parses the JSON input, containing one or more scenarios, and executes all scenarios in
+ * sequence, within the same process.
+ *
+ * @param[in] inputPath Path to JSON input file, JSON-lines file or directory
+ * @param[in] isResumed Flag indicating if simulations are resumed from last checkpoint
+ * @return              Path to metrics file of last scenario that sets one; empty if none does
+ */
+std::string executeScenarios( const std::string& inputPath, const bool isResumed )
+{
+    // Read and parse JSON input, containing one or more scenarios. Each file is read in one go
+    // and parsed in situ, allowing comments and trailing commas.
+    rvdsim::ConfigCollection configs;
+    {
+        RVDSIM_SCOPED_TIMER( rvdsim::jsonParsePhase );
+        configs = rvdsim::loadConfigs( inputPath );
+    }
 
-        if ( input.thrustMode == rvdsim::off )
-        {
-            thrustAcceleration = zeroThrustAcceleration;
-        }
-        else
+    if ( configs.size( ) == 0 )
+    {
+        std::cerr << "ERROR: No scenarios found in JSON input!" << std::endl;
+        throw;
+    }
+
+    // Execute all scenarios in sequence, within the same process.
+    std::string metricsPath = "";
+    for ( std::size_t i = 0; i < configs.size( ); ++i )
+    {
+        if ( configs.size( ) > 1 )
         {
-            zeroEffortMiss[ astro::xPositionIndex ] = -zeroThrustEndState[ astro::xPositionIndex ];
-            zeroEffortMiss[ astro::yPositionIndex ] = -zeroThrustEndState[ astro::yPositionIndex ];
-            zeroEffortMiss[ astro::zPositionIndex ] = -zeroThrustEndState[ astro::zPositionIndex ];
-
-            zeroEffortVelocity[ astro::xPositionIndex ]
-                = -zeroThrustEndState[ astro::xVelocityIndex ];
-            zeroEffortVelocity[ astro::yPositionIndex ]
-                = -zeroThrustEndState[ astro::yVelocityIndex ];
-            zeroEffortVelocity[ astro::zPositionIndex ]
-                = -zeroThrustEndState[ astro::zVelocityIndex ];
-
-            thrustAcceleration = control::computeOptimalGuidanceLaw( zeroEffortMiss,
-                                                                     zeroEffortVelocity,
-                                                                     timeToGo );
-
-            // Check if maximum thrust required exceeds thruster capability.
-            if ( thrustAccelerationMaximum > 0.0 )
-            {
-                const rvdsim::Real thrustAccelerationNorm
-                    = sml::norm< double >( thrustAcceleration );
-
-                if ( input.thrustMode == rvdsim::throttle
-                     && thrustAccelerationNorm > thrustAccelerationMaximum )
-                {
-                    isThrottleMax = true;
-
-                    for ( int i = 0; i < 3; ++i )
-                    {
-                        thrustAcceleration[ i ] = thrustAccelerationMaximum
-                                                  * thrustAcceleration[ i ]
-                                                  / thrustAccelerationNorm;
-                    }
-                }
-                else if ( input.thrustMode == rvdsim::onOff )
-                {
-                    if ( thrustAccelerationNorm > thrustAccelerationMaximum / 2.0 )
-                    {
-                        for ( int i = 0; i < 3; ++i )
-                        {
-                            thrustAcceleration[ i ] = thrustAccelerationMaximum
-                                                      * thrustAcceleration[ i ]
-                                                      / thrustAccelerationNorm;
-                        }
-                    }
-                    else
-                    {
-                        thrustAcceleration = zeroThrustAcceleration;
-                    }
-                }
-            }
+            std::cout << "Scenario                                      "
+                      << i + 1 << "/" << configs.size( ) << " (" << configs.getName( i ) << ")"
+                      << std::endl;
+            std::cout << std::endl;
         }
 
-        // Propagate dynamics under control action.
-        rvdsim::Vector6 constantThrustEndState
-            = astro::propagateClohessyWiltshireSolution( currentState,
-                                                         thrustPulseTime,
-                                                         targetMeanMotion,
-                                                         thrustAcceleration );
+        const rapidjson::Document& config = configs.getDocument( i );
 
-        // Add chaser thrust to history.
-        rvdsim::Vector3 chaserThrust( 3 );
-        for ( int i = 0; i < 3; ++i )
-        {
-            chaserThrust[ i ] = thrustAcceleration[ i ] * input.chaserWetMass;
-        }
+        // Verify config parameters. Exception is thrown if any of the parameters are missing.
+        const rvdsim::UserInput input = rvdsim::checkInput( config );
 
-        chaserThrustHistory[ currentTime ] = chaserThrust;
+        executeScenario( config, input, isResumed );
 
-        // Update current state to state at end of thruster pulse.
-        currentState = constantThrustEndState;
+        if ( !input.metricsFilename.empty( ) )
+        {
+            metricsPath = input.outputDirectory + "/" + input.metricsFilename;
+        }
 
-        // Update current time to end of thruster pulse.
-        currentTime = currentTime + thrustPulseTime;
+        std::cout << std::endl;
+    }
 
-        // Recompute Time-To-Go [s].
-        timeToGo = timeToGo - thrustPulseTime;
+    return metricsPath;
+}
 
-        // Add current time and state to chaser history.
-        chaserStateHistory[ currentTime ] = currentState;
+//! Execute coordinator mode.
+/*!
+ * Executes Monte Carlo analysis distributed over workers that share a queue directory, and writes
+ * the simulation summary of each sample to file, as in Monte Carlo mode.
+ *
+ * @sa rvdsim::executeWorkQueueCoordinator
+ * @param[in] queueDirectory   Path to queue directory
+ * @param[in] campaignFilePath Path to JSON input file containing a single Monte Carlo analysis
+ * @return                     Path to metrics file; empty if not set
+ */
+std::string executeCoordinatorMode( const std::string& queueDirectory,
+                                    const std::string& campaignFilePath )
+{
+    rvdsim::ConfigCollection configs;
+    {
+        RVDSIM_SCOPED_TIMER( rvdsim::jsonParsePhase );
+        configs = rvdsim::loadConfigs( campaignFilePath );
     }
 
-    if ( isThrottleMax )
+    if ( configs.size( ) != 1 || !rvdsim::hasDispersionInput( configs.getDocument( 0 ) ) )
     {
-        std::cout << "Maximum thrust level reached, thruster throttled!" << std::endl;
+        std::cerr << "ERROR: Coordinator mode requires a JSON input file containing a single "
+                  << "Monte Carlo analysis!" << std::endl;
+        throw;
     }
+    const rapidjson::Document& config = configs.getDocument( 0 );
+
+    // Verify config parameters. Exception is thrown if any of the parameters are missing.
+    const rvdsim::UserInput input = rvdsim::checkInput( config );
+    const rvdsim::DispersionSettings dispersionSettings
+        = rvdsim::checkDispersionInput( config, input );
+    const rvdsim::WorkQueueSettings workQueueSettings = rvdsim::checkWorkQueueInput( config );
 
-    std::cout << "Simulation completed successfully!" << std::endl;
+    std::cout << std::endl;
+    std::cout << "******************************************************************" << std::endl;
+    std::cout << "              Distributed Monte Carlo Analysis & Output           " << std::endl;
+    std::cout << "******************************************************************" << std::endl;
     std::cout << std::endl;
 
-    std::cout << "Writing output to file ... " << std::endl;
+    std::cout << "Executing " << dispersionSettings.numberOfSamples << " simulations on workers "
+              << "... " << std::endl;
 
-    // Write chaser state history to CSV file.
-    std::ostringstream chaserStateHistoryPath;
-    chaserStateHistoryPath << input.outputDirectory << "/" << input.chaserStateHistoryFilename;
-    std::ofstream chaserStateHistoryFile(  chaserStateHistoryPath.str( ) );
-    chaserStateHistoryFile << "t,x,y,z,xdot,ydot,zdot" << std::endl;
-    for ( rvdsim::StateHistory::iterator it = chaserStateHistory.begin( );
-          it != chaserStateHistory.end( );
-          ++it )
-    {
-        chaserStateHistoryFile << it->first << ","
-                               << it->second[ 0 ] << ","
-                               << it->second[ 1 ] << ","
-                               << it->second[ 2 ] << ","
-                               << it->second[ 3 ] << ","
-                               << it->second[ 4 ] << ","
-                               << it->second[ 5 ] << std::endl;
-    }
-    chaserStateHistoryFile.close( );
+    const std::vector< rvdsim::SimulationSummary > summaries
+        = rvdsim::executeWorkQueueCoordinator(
+            queueDirectory, campaignFilePath, dispersionSettings, workQueueSettings );
 
-    // Write chaser thrust history to CSV file.
-    std::ostringstream chaserThrustHistoryPath;
-    chaserThrustHistoryPath << input.outputDirectory << "/" << input.chaserThrustHistoryFilename;
-    std::ofstream chaserThrustHistoryFile(  chaserThrustHistoryPath.str( ) );
-    chaserThrustHistoryFile << "t,Tx,Ty,Tz" << std::endl;
-    for ( rvdsim::ThrustHistory::iterator it = chaserThrustHistory.begin( );
-          it != chaserThrustHistory.end( );
-          ++it )
+    std::cout << "Simulations completed successfully!" << std::endl;
+    std::cout << std::endl;
+
+    writeMonteCarloResults( input, dispersionSettings, summaries );
+
+    return input.metricsFilename.empty( ) ? ""
+                                          : input.outputDirectory + "/" + input.metricsFilename;
+}
+
+//! Execute worker mode.
+/*!
+ * Executes tasks of a Monte Carlo analysis distributed by a coordinator over a queue directory,
+ * until the coordinator marks the analysis as done. The simulation settings are read from the
+ * campaign in the queue directory.
+ *
+ * @sa rvdsim::executeWorkQueueWorker
+ * @param[in] queueDirectory Path to queue directory
+ */
+void executeWorkerMode( const std::string& queueDirectory )
+{
+    rvdsim::executeWorkQueueWorker( queueDirectory );
+
+    std::cout << "Worker completed successfully!" << std::endl;
+}
+
+int main( const int numberOfInputs, const char* inputArguments[ ] )
+{
+
+    ///////////////////////////////////////////////////////////////////////////
+
+    std::cout << std::endl;
+    std::cout << "------------------------------------------------------------------" << std::endl;
+    std::cout << std::endl;
+    std::cout << "                              rvdsim                              " << std::endl;
+    std::cout << std::endl;
+    std::cout << "         Copyright (c) 2016, K. Kumar (me@kartikkumar.com)        " << std::endl;
+    std::cout << std::endl;
+    std::cout << "------------------------------------------------------------------" << std::endl;
+    std::cout << std::endl;
+
+    ///////////////////////////////////////////////////////////////////////////
+
+    ///////////////////////////////////////////////////////////////////////////
+
+    std::cout << std::endl;
+    std::cout << "******************************************************************" << std::endl;
+    std::cout << "                          Input parameters                        " << std::endl;
+    std::cout << "******************************************************************" << std::endl;
+    std::cout << std::endl;
+
+    // Check that only one input has been provided (a JSON file, JSON-lines file or directory),
+    // optionally preceded by the --resume flag, which resumes simulations from their last
+    // checkpoint. Alternatively, a Monte Carlo analysis is distributed over a queue directory by
+    // a coordinator (--coordinate queue_directory config.json) and any number of workers
+    // (--work queue_directory).
+    const std::string mode = numberOfInputs > 1 ? inputArguments[ 1 ] : "";
+    const bool isResumed = numberOfInputs - 1 == 2 && !mode.compare( "--resume" );
+    const bool isCoordinator = numberOfInputs - 1 == 3 && !mode.compare( "--coordinate" );
+    const bool isWorker = numberOfInputs - 1 == 2 && !mode.compare( "--work" );
+    if ( !isCoordinator && !isWorker && numberOfInputs - 1 != ( isResumed ? 2 : 1 ) )
     {
-        chaserThrustHistoryFile << it->first << ","
-                                << it->second[ 0 ] << ","
-                                << it->second[ 1 ] << ","
-                                << it->second[ 2 ] << std::endl;
+        std::cerr << "ERROR: Number of inputs is wrong. Please only provide a JSON input file, "
+                  << "JSON-lines file or directory, optionally preceded by --resume, or use "
+                  << "--coordinate queue_directory config.json or --work queue_directory!"
+                  << std::endl;
+        throw;
     }
-    chaserThrustHistoryFile.close( );
 
-    std::cout << "Output written to file successfully!" << std::endl;
-    std::cout << std::endl;
+    ///////////////////////////////////////////////////////////////////////////
 
-    // Check if target was reached.
-    rvdsim::Vector6 finalState = chaserStateHistory.rbegin( )->second;
-    const rvdsim::Real finalDistanceToTarget = sml::norm< double >( finalState );
-    if ( finalDistanceToTarget > input.arrivalDistanceTolerance )
+    ///////////////////////////////////////////////////////////////////////////
+
+    // Execute worker or coordinator of distributed Monte Carlo analysis, or execute all scenarios
+    // in the JSON input.
+    std::string metricsPath = "";
+    if ( isWorker )
     {
-        std::cout << "Target not reached! :(" << std::endl;
-        std::cout << "You are " << finalDistanceToTarget << " m from the target" << std::endl;
+        executeWorkerMode( inputArguments[ 2 ] );
+    }
+    else if ( isCoordinator )
+    {
+        metricsPath = executeCoordinatorMode( inputArguments[ 2 ], inputArguments[ 3 ] );
     }
     else
     {
-        std::cout << "Congrats! You reached the target! :)" << std::endl;
+        metricsPath = executeScenarios( inputArguments[ isResumed ? 2 : 1 ], isResumed );
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+
+    ///////////////////////////////////////////////////////////////////////////
+
+    // Report time spent per phase and event counters, if instrumentation is enabled.
+    if ( rvdsim::isInstrumentationEnabled( ) )
+    {
+        std::cout << std::endl;
+        std::cout << "******************************************************************"
+                  << std::endl;
+        std::cout << "                         Instrumentation                          "
+                  << std::endl;
+        std::cout << "******************************************************************"
+                  << std::endl;
+        std::cout << std::endl;
+
+        rvdsim::writeInstrumentationReport( std::cout );
+
+        if ( !metricsPath.empty( ) )
+        {
+            rvdsim::writeInstrumentationMetrics( metricsPath );
+            std::cout << std::endl;
+            std::cout << "Metrics written to file successfully!" << std::endl;
+        }
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,588 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "rvdsim/monteCarlo.hpp"
+#include "rvdsim/threadPool.hpp"
+
+namespace rvdsim
+{
+
+namespace
+{
+
+//! Parse dispersion of a single input parameter.
+/*!
+ * Parses dispersion given as [distribution, first parameter, second parameter] in JSON input,
+ * where distribution is "normal" (mean, standard deviation) or "uniform" (lower bound, upper
+ * bound).
+ *
+ * @param[in] dispersionConfig JSON array containing dispersion
+ * @param[in] parameterName    Name of dispersed parameter, used for error messages
+ * @return                     Dispersion of input parameter
+ */
+Dispersion parseDispersion( const rapidjson::Value& dispersionConfig,
+                            const std::string& parameterName )
+{
+    if ( !dispersionConfig.IsArray( ) || dispersionConfig.Size( ) != 3 )
+    {
+        std::cerr << "ERROR: Dispersion of \"" << parameterName << "\" should be given as "
+                  << "[\"normal\", mean, standard deviation] or "
+                  << "[\"uniform\", lower bound, upper bound]!"
+                  << std::endl;
+        throw std::invalid_argument( "Dispersion of \"" + parameterName + "\" should be given as "
+                                     "[\"normal\", mean, standard deviation] or "
+                                     "[\"uniform\", lower bound, upper bound]" );
+    }
+
+    const std::string distributionString = dispersionConfig[ 0 ].GetString( );
+    const Real firstParameter = dispersionConfig[ 1 ].GetDouble( );
+    const Real secondParameter = dispersionConfig[ 2 ].GetDouble( );
+
+    if ( !distributionString.compare( "normal" ) )
+    {
+        if ( secondParameter < 0.0 )
+        {
+            std::cerr << "ERROR: Standard deviation of \"" << parameterName << "\" should be "
+                      << "non-negative!" << std::endl;
+            throw std::invalid_argument(
+                "Standard deviation of \"" + parameterName + "\" should be non-negative" );
+        }
+        return Dispersion( normalDispersion, firstParameter, secondParameter );
+    }
+    else if ( !distributionString.compare( "uniform" ) )
+    {
+        if ( secondParameter < firstParameter )
+        {
+            std::cerr << "ERROR: Upper bound of \"" << parameterName << "\" should not be smaller "
+                      << "than lower bound!" << std::endl;
+            throw std::invalid_argument( "Upper bound of \"" + parameterName
+                                         + "\" should not be smaller than lower bound" );
+        }
+        return Dispersion( uniformDispersion, firstParameter, secondParameter );
+    }
+
+    std::cerr << "ERROR: Distribution of \"" << parameterName << "\" should be \"normal\" or "
+              << "\"uniform\"!" << std::endl;
+    throw std::invalid_argument(
+        "Distribution of \"" + parameterName + "\" should be \"normal\" or \"uniform\"" );
+}
+
+//! Parse optional dispersion of a single input parameter.
+/*!
+ * Parses dispersion of a single input parameter, if it is present in the given dispersion
+ * settings. If it is not present, the parameter is not dispersed.
+ *
+ * @param[in] dispersionSettings JSON object containing dispersion settings
+ * @param[in] parameterName      Name of dispersed parameter
+ * @return                       Dispersion of input parameter
+ */
+Dispersion parseOptionalDispersion( const rapidjson::Value& dispersionSettings,
+                                    const std::string& parameterName )
+{
+    rapidjson::Value::ConstMemberIterator dispersionIterator
+        = dispersionSettings.FindMember( parameterName.c_str( ) );
+    if ( dispersionIterator == dispersionSettings.MemberEnd( ) )
+    {
+        return Dispersion( );
+    }
+    return parseDispersion( dispersionIterator->value, parameterName );
+}
+
+//! Print dispersion of a single input parameter.
+/*!
+ * @param[in]     dispersion   Dispersion of input parameter
+ * @param[in,out] outputStream Stream to which dispersion is printed
+ */
+void printDispersion( const Dispersion& dispersion, std::ostream& outputStream )
+{
+    if ( dispersion.distribution == normalDispersion )
+    {
+        outputStream << "normal (" << dispersion.firstParameter << ", "
+                     << dispersion.secondParameter << ")";
+    }
+    else if ( dispersion.distribution == uniformDispersion )
+    {
+        outputStream << "uniform [" << dispersion.firstParameter << ", "
+                     << dispersion.secondParameter << "]";
+    }
+    else
+    {
+        outputStream << "NONE";
+    }
+}
+
+//! Draw random offset for dispersed parameter.
+/*!
+ * Draws random offset for dispersed parameter. Two uniform random numbers are consumed for each
+ * call, irrespective of the distribution, such that the offsets drawn for one parameter do not
+ * depend on the distributions selected for other parameters. The transformation from uniform to
+ * normal random numbers (Box-Muller) is implemented here, since the standard library
+ * distributions are not guaranteed to produce identical sequences across implementations.
+ *
+ * @param[in]     dispersion Dispersion of input parameter
+ * @param[in,out] generator  Random number generator
+ * @return                   Random offset
+ */
+Real drawOffset( const Dispersion& dispersion, std::mt19937_64& generator )
+{
+    // Generate uniform random numbers in [0, 1) with 53 bits of randomness.
+    const Real scale = 1.0 / 9007199254740992.0;
+    const Real firstUniform = static_cast< Real >( generator( ) >> 11 ) * scale;
+    const Real secondUniform = static_cast< Real >( generator( ) >> 11 ) * scale;
+
+    if ( dispersion.distribution == normalDispersion )
+    {
+        const Real pi = 3.14159265358979323846;
+        return dispersion.firstParameter
+               + dispersion.secondParameter
+                 * std::sqrt( -2.0 * std::log( 1.0 - firstUniform ) )
+                 * std::cos( 2.0 * pi * secondUniform );
+    }
+    else if ( dispersion.distribution == uniformDispersion )
+    {
+        return dispersion.firstParameter
+               + ( dispersion.secondParameter - dispersion.firstParameter ) * firstUniform;
+    }
+
+    return 0.0;
+}
+
+//! Maximum number of times a random offset is redrawn for a single parameter.
+const std::size_t maximumNumberOfRedraws = 1000;
+
+//! Check if dispersed value lies within valid range of parameter.
+/*!
+ * @param[in] value           Dispersed value
+ * @param[in] lowerLimit      Lower limit of valid range
+ * @param[in] isLimitIncluded Flag indicating if lower limit is part of valid range
+ * @return                    True if value lies within valid range
+ */
+bool isWithinValidRange( const Real value, const Real lowerLimit, const bool isLimitIncluded )
+{
+    return isLimitIncluded ? value >= lowerLimit : value > lowerLimit;
+}
+
+//! Check that dispersion of a single input parameter yields valid values.
+/*!
+ * Checks that the value obtained by adding the mean (normal distribution) or the lower bound
+ * (uniform distribution) of the offset to the nominal value lies within the valid range of the
+ * parameter. Uniform offsets then always yield valid values, and normal offsets that yield invalid
+ * values are redrawn (see redrawInvalidOffset).
+ *
+ * @param[in] dispersion      Dispersion of input parameter
+ * @param[in] nominalValue    Nominal value of input parameter
+ * @param[in] lowerLimit      Lower limit of valid range
+ * @param[in] isLimitIncluded Flag indicating if lower limit is part of valid range
+ * @param[in] parameterName   Name of dispersed parameter, used for error messages
+ */
+void checkDispersionRange( const Dispersion& dispersion,
+                           const Real nominalValue,
+                           const Real lowerLimit,
+                           const bool isLimitIncluded,
+                           const std::string& parameterName )
+{
+    if ( dispersion.distribution == noDispersion
+         || isWithinValidRange( nominalValue + dispersion.firstParameter,
+                                lowerLimit,
+                                isLimitIncluded ) )
+    {
+        return;
+    }
+
+    std::ostringstream message;
+    message << ( dispersion.distribution == normalDispersion ? "Mean" : "Lower bound" )
+            << " of dispersion of \"" << parameterName << "\" yields a value "
+            << ( isLimitIncluded ? "smaller than " : "smaller than or equal to " ) << lowerLimit;
+    std::cerr << "ERROR: " << message.str( ) << "!" << std::endl;
+    throw std::invalid_argument( message.str( ) );
+}
+
+//! Redraw random offset until dispersed parameter is valid.
+/*!
+ * Truncates the distribution of a dispersed parameter to the valid range of the parameter, by
+ * redrawing the offset for as long as the dispersed value is invalid. The dispersion should have
+ * been checked using checkDispersionRange( ), such that at least half of the draws are valid. If
+ * all redraws are nevertheless invalid, the offset is set to the mean (normal distribution) or the
+ * lower bound (uniform distribution), which is valid, such that this function does not fail.
+ *
+ * @param[in]     dispersion      Dispersion of input parameter
+ * @param[in]     nominalValue    Nominal value of input parameter
+ * @param[in]     lowerLimit      Lower limit of valid range
+ * @param[in]     isLimitIncluded Flag indicating if lower limit is part of valid range
+ * @param[in,out] generator       Random number generator
+ * @param[in,out] offset          Random offset, redrawn if dispersed value is invalid
+ * @return                        True if offset was redrawn
+ */
+bool redrawInvalidOffset( const Dispersion& dispersion,
+                          const Real nominalValue,
+                          const Real lowerLimit,
+                          const bool isLimitIncluded,
+                          std::mt19937_64& generator,
+                          Real& offset )
+{
+    if ( dispersion.distribution == noDispersion )
+    {
+        return false;
+    }
+
+    std::size_t numberOfRedraws = 0;
+    while ( !isWithinValidRange( nominalValue + offset, lowerLimit, isLimitIncluded ) )
+    {
+        if ( numberOfRedraws == maximumNumberOfRedraws )
+        {
+            offset = dispersion.firstParameter;
+            break;
+        }
+        offset = drawOffset( dispersion, generator );
+        ++numberOfRedraws;
+    }
+    return numberOfRedraws > 0;
+}
+
+//! Check that dispersions yield valid values.
+/*!
+ * Checks that the dispersed wet mass and semi-major axis remain positive, and that a constrained
+ * thruster remains constrained, since a thrust maximum of zero selects an unconstrained thruster
+ * (see checkDispersionRange).
+ *
+ * @param[in] nominalInput                  User input containing nominal simulation settings
+ * @param[in] chaserWetMassDispersion       Dispersion of chaser wet mass
+ * @param[in] thrustMaximumDispersion       Dispersion of thrust maximum
+ * @param[in] targetSemiMajorAxisDispersion Dispersion of target semi-major axis
+ */
+void checkDispersionRanges( const UserInput&  nominalInput,
+                            const Dispersion& chaserWetMassDispersion,
+                            const Dispersion& thrustMaximumDispersion,
+                            const Dispersion& targetSemiMajorAxisDispersion )
+{
+    checkDispersionRange(
+        chaserWetMassDispersion, nominalInput.chaserWetMass, 0.0, false, "chaser_wet_mass" );
+    checkDispersionRange( thrustMaximumDispersion,
+                          nominalInput.thrustMaximum,
+                          0.0,
+                          !( nominalInput.thrustMaximum > 0.0 ),
+                          "thrust_maximum" );
+    checkDispersionRange( targetSemiMajorAxisDispersion,
+                          nominalInput.targetSemiMajorAxis,
+                          0.0,
+                          false,
+                          "target_semi_major_axis" );
+}
+
+} // namespace
+
+//! Check if dispersion settings are provided.
+bool hasDispersionInput( const rapidjson::Document& config )
+{
+    return config.FindMember( "dispersion" ) != config.MemberEnd( );
+}
+
+//! Check dispersion settings.
+DispersionSettings checkDispersionInput( const rapidjson::Document& config,
+                                         const UserInput& nominalInput,
+                                         std::ostream& outputStream )
+{
+    // Search for dispersion settings in config.
+    rapidjson::Value::ConstMemberIterator dispersionIterator = config.FindMember( "dispersion" );
+    if ( dispersionIterator == config.MemberEnd( ) )
+    {
+        std::cerr << "ERROR: Configuration option \"dispersion\" could not be found in JSON input!"
+                  << std::endl;
+        throw std::invalid_argument(
+            "Configuration option \"dispersion\" could not be found in JSON input" );
+    }
+    const rapidjson::Value& dispersionSettings = dispersionIterator->value;
+
+    // Search for number of samples in dispersion settings.
+    rapidjson::Value::ConstMemberIterator numberOfSamplesIterator
+        = dispersionSettings.FindMember( "samples" );
+    if ( numberOfSamplesIterator == dispersionSettings.MemberEnd( )
+         || numberOfSamplesIterator->value.GetUint64( ) == 0 )
+    {
+        std::cerr << "ERROR: Dispersion option \"samples\" should be a positive integer!"
+                  << std::endl;
+        throw std::invalid_argument( "Dispersion option \"samples\" should be a positive integer" );
+    }
+    const std::size_t numberOfSamples
+        = static_cast< std::size_t >( numberOfSamplesIterator->value.GetUint64( ) );
+    outputStream << "Monte Carlo samples                           " << numberOfSamples
+                 << std::endl;
+
+    // Search for seed in dispersion settings.
+    rapidjson::Value::ConstMemberIterator seedIterator = dispersionSettings.FindMember( "seed" );
+    if ( seedIterator == dispersionSettings.MemberEnd( ) )
+    {
+        std::cerr << "ERROR: Dispersion option \"seed\" could not be found in JSON input!"
+                  << std::endl;
+        throw std::invalid_argument(
+            "Dispersion option \"seed\" could not be found in JSON input" );
+    }
+    const std::uint64_t seed = seedIterator->value.GetUint64( );
+    outputStream << "Monte Carlo seed                              " << seed << std::endl;
+
+    // Search for number of threads in dispersion settings (optional).
+    std::size_t numberOfThreads = 0;
+    rapidjson::Value::ConstMemberIterator numberOfThreadsIterator
+        = dispersionSettings.FindMember( "threads" );
+    if ( numberOfThreadsIterator != dispersionSettings.MemberEnd( ) )
+    {
+        numberOfThreads = static_cast< std::size_t >( numberOfThreadsIterator->value.GetUint( ) );
+    }
+    outputStream << "Monte Carlo threads                           ";
+    if ( numberOfThreads == 0 )
+    {
+        outputStream << "AUTO" << std::endl;
+    }
+    else
+    {
+        outputStream << numberOfThreads << std::endl;
+    }
+
+    // Search for dispersion of chaser initial state in dispersion settings (optional).
+    StateDispersion chaserInitialStateDispersion;
+    rapidjson::Value::ConstMemberIterator chaserInitialStateIterator
+        = dispersionSettings.FindMember( "chaser_initial_state" );
+    if ( chaserInitialStateIterator != dispersionSettings.MemberEnd( ) )
+    {
+        if ( !chaserInitialStateIterator->value.IsArray( )
+             || chaserInitialStateIterator->value.Size( ) != 6 )
+        {
+            std::cerr << "ERROR: Dispersion of \"chaser_initial_state\" should contain a "
+                      << "dispersion for each of the 6 state components!" << std::endl;
+            throw std::invalid_argument(
+                "Dispersion of \"chaser_initial_state\" should contain a dispersion for each "
+                "of the 6 state components" );
+        }
+
+        for ( int i = 0; i < 6; ++i )
+        {
+            chaserInitialStateDispersion[ i ]
+                = parseDispersion( chaserInitialStateIterator->value[ i ],
+                                   "chaser_initial_state" );
+        }
+    }
+    outputStream << "Chaser initial state dispersion [m; m/s]      [";
+    for ( int i = 0; i < 6; ++i )
+    {
+        printDispersion( chaserInitialStateDispersion[ i ], outputStream );
+        outputStream << ( i < 5 ? ", " : "]" );
+    }
+    outputStream << std::endl;
+
+    // Search for dispersions of remaining parameters in dispersion settings (optional).
+    const Dispersion chaserWetMassDispersion
+        = parseOptionalDispersion( dispersionSettings, "chaser_wet_mass" );
+    outputStream << "Chaser wet mass dispersion    [kg]            ";
+    printDispersion( chaserWetMassDispersion, outputStream );
+    outputStream << std::endl;
+
+    const Dispersion thrustMaximumDispersion
+        = parseOptionalDispersion( dispersionSettings, "thrust_maximum" );
+    outputStream << "Thrust maximum dispersion     [N]             ";
+    printDispersion( thrustMaximumDispersion, outputStream );
+    outputStream << std::endl;
+
+    const Dispersion targetSemiMajorAxisDispersion
+        = parseOptionalDispersion( dispersionSettings, "target_semi_major_axis" );
+    outputStream << "Target semi-major axis dispersion [m]         ";
+    printDispersion( targetSemiMajorAxisDispersion, outputStream );
+    outputStream << std::endl;
+
+    // Check that dispersions yield valid values.
+    checkDispersionRanges( nominalInput,
+                           chaserWetMassDispersion,
+                           thrustMaximumDispersion,
+                           targetSemiMajorAxisDispersion );
+
+    // Search for summary filename in dispersion settings.
+    rapidjson::Value::ConstMemberIterator summaryFilenameIterator
+        = dispersionSettings.FindMember( "summary_filename" );
+    if ( summaryFilenameIterator == dispersionSettings.MemberEnd( ) )
+    {
+        std::cerr << "ERROR: Dispersion option \"summary_filename\" could not be found in JSON "
+                  << "input!" << std::endl;
+        throw std::invalid_argument(
+            "Dispersion option \"summary_filename\" could not be found in JSON input" );
+    }
+    const std::string summaryFilename = summaryFilenameIterator->value.GetString( );
+    outputStream << "Monte Carlo summary output file               "
+                 << summaryFilename << std::endl;
+
+    return DispersionSettings( numberOfSamples,
+                               seed,
+                               numberOfThreads,
+                               chaserInitialStateDispersion,
+                               chaserWetMassDispersion,
+                               thrustMaximumDispersion,
+                               targetSemiMajorAxisDispersion,
+                               summaryFilename );
+}
+
+//! Compute dispersed user input.
+UserInput computeDispersedInput( const UserInput&          nominalInput,
+                                 const DispersionSettings& settings,
+                                 const std::size_t         sampleIndex )
+{
+    bool isRedrawn = false;
+    return computeDispersedInput( nominalInput, settings, sampleIndex, isRedrawn );
+}
+
+//! Compute dispersed user input and check if any offset was redrawn.
+UserInput computeDispersedInput( const UserInput&          nominalInput,
+                                 const DispersionSettings& settings,
+                                 const std::size_t         sampleIndex,
+                                 bool&                     isRedrawn )
+{
+    // Check that dispersions yield valid values, such that redrawing invalid offsets cannot fail.
+    checkDispersionRanges( nominalInput,
+                           settings.chaserWetMassDispersion,
+                           settings.thrustMaximumDispersion,
+                           settings.targetSemiMajorAxisDispersion );
+
+    // Seed generator from user-defined seed and sample index. The seed sequence algorithm and the
+    // Mersenne Twister engine are fully specified by the standard, which makes the sequence
+    // reproducible across platforms.
+    const std::uint64_t sample = static_cast< std::uint64_t >( sampleIndex );
+    std::seed_seq seedSequence = { static_cast< std::uint32_t >( settings.seed ),
+                                   static_cast< std::uint32_t >( settings.seed >> 32 ),
+                                   static_cast< std::uint32_t >( sample ),
+                                   static_cast< std::uint32_t >( sample >> 32 ) };
+    std::mt19937_64 generator( seedSequence );
+
+    Vector6 chaserInitialState = nominalInput.chaserInitialState;
+    for ( int i = 0; i < 6; ++i )
+    {
+        chaserInitialState[ i ] += drawOffset( settings.chaserInitialStateDispersion[ i ],
+                                               generator );
+    }
+
+    Real chaserWetMassOffset = drawOffset( settings.chaserWetMassDispersion, generator );
+    Real thrustMaximumOffset = drawOffset( settings.thrustMaximumDispersion, generator );
+    Real targetSemiMajorAxisOffset
+        = drawOffset( settings.targetSemiMajorAxisDispersion, generator );
+
+    // Redraw offsets that yield invalid values only after all offsets have been drawn, such that
+    // the offsets of samples with valid values do not depend on the redraws.
+    isRedrawn = redrawInvalidOffset( settings.chaserWetMassDispersion,
+                                     nominalInput.chaserWetMass,
+                                     0.0,
+                                     false,
+                                     generator,
+                                     chaserWetMassOffset );
+    isRedrawn = redrawInvalidOffset( settings.thrustMaximumDispersion,
+                                     nominalInput.thrustMaximum,
+                                     0.0,
+                                     !( nominalInput.thrustMaximum > 0.0 ),
+                                     generator,
+                                     thrustMaximumOffset )
+                || isRedrawn;
+    isRedrawn = redrawInvalidOffset( settings.targetSemiMajorAxisDispersion,
+                                     nominalInput.targetSemiMajorAxis,
+                                     0.0,
+                                     false,
+                                     generator,
+                                     targetSemiMajorAxisOffset )
+                || isRedrawn;
+
+    const Real chaserWetMass = nominalInput.chaserWetMass + chaserWetMassOffset;
+    const Real thrustMaximum = nominalInput.thrustMaximum + thrustMaximumOffset;
+    const Real targetSemiMajorAxis = nominalInput.targetSemiMajorAxis + targetSemiMajorAxisOffset;
+
+    return UserInput( nominalInput.startTime,
+                      nominalInput.endTime,
+                      nominalInput.earthGravitationalParameter,
+                      targetSemiMajorAxis,
+                      chaserInitialState,
+                      nominalInput.thrustMode,
+                      thrustMaximum,
+                      nominalInput.thrustFrequency,
+                      chaserWetMass,
+                      nominalInput.arrivalDistanceTolerance,
+                      nominalInput.outputDirectory,
+                      nominalInput.chaserStateHistoryFilename,
+                      nominalInput.chaserThrustHistoryFilename,
+                      nominalInput.outputFormat,
+                      nominalInput.chaserTrajectoryFilename,
+                      nominalInput.outputSampling,
+                      nominalInput.metricsFilename,
+                      nominalInput.adaptiveScheduling,
+                      nominalInput.propagatorSettings,
+                      nominalInput.checkpoint,
+                      nominalInput.chaserSpecificImpulse );
+}
+
+//! Execute range of Monte Carlo samples.
+std::vector< SimulationSummary > executeMonteCarloSamples( const UserInput&          nominalInput,
+                                                           const DispersionSettings& settings,
+                                                           const std::size_t firstSampleIndex,
+                                                           const std::size_t numberOfSamples )
+{
+    std::vector< SimulationSummary > summaries( numberOfSamples );
+
+    // Check the dispersions before the samples are executed, since tasks executed by the thread
+    // pool must not throw. Computing the dispersed inputs cannot fail once they are checked.
+    checkDispersionRanges( nominalInput,
+                           settings.chaserWetMassDispersion,
+                           settings.thrustMaximumDispersion,
+                           settings.targetSemiMajorAxisDispersion );
+
+    // Each sample writes to its own summary only, so no synchronisation is needed. Samples are
+    // submitted in small chunks to keep the load balanced, since the execution time of a sample
+    // depends on its dispersed input.
+    ThreadPool threadPool( settings.numberOfThreads );
+    executeParallelLoop( threadPool,
+                         numberOfSamples,
+                         4,
+                         [ &nominalInput, &settings, firstSampleIndex, &summaries ](
+                             const std::size_t i )
+    {
+        bool isRedrawn = false;
+        const UserInput input
+            = computeDispersedInput( nominalInput, settings, firstSampleIndex + i, isRedrawn );
+        Simulator simulator( input, false );
+        simulator.execute( );
+        summaries[ i ] = simulator.getSummary( );
+        summaries[ i ].isRedrawn = isRedrawn;
+    } );
+
+    return summaries;
+}
+
+//! Execute Monte Carlo analysis.
+std::vector< SimulationSummary > executeMonteCarloAnalysis( const UserInput&          nominalInput,
+                                                            const DispersionSettings& settings )
+{
+    return executeMonteCarloSamples( nominalInput, settings, 0, settings.numberOfSamples );
+}
+
+//! Write Monte Carlo summary to file.
+void writeMonteCarloSummary( const std::string&                      filePath,
+                             const std::vector< SimulationSummary >& summaries )
+{
+    std::ofstream summaryFile( filePath.c_str( ) );
+    summaryFile << "sample,final_distance,is_target_reached,total_delta_v,is_throttle_max,"
+                << "propellant_mass\n";
+    for ( std::size_t i = 0; i < summaries.size( ); ++i )
+    {
+        summaryFile << i << ","
+                    << summaries[ i ].finalDistanceToTarget << ","
+                    << summaries[ i ].isTargetReached << ","
+                    << summaries[ i ].totalDeltaV << ","
+                    << summaries[ i ].isThrottleMax << ","
+                    << summaries[ i ].propellantMass << "\n";
+    }
+    summaryFile.close( );
+}
+
+} // namespace rvdsim
@@ -0,0 +1,463 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cmath>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#include <astro/astro.hpp>
+
+#include "rvdsim/guidanceKernel.hpp"
+#include "rvdsim/instrumentation.hpp"
+#include "rvdsim/multiChaserSimulator.hpp"
+#include "rvdsim/thrustPolicy.hpp"
+
+namespace rvdsim
+{
+
+namespace
+{
+
+//! Report invalid setting of a single chaser.
+/*!
+ * Reports that a setting of a chaser violates a rule and throws an error (std::invalid_argument).
+ *
+ * @param[in] settingName Name of setting, e.g., "Wet mass"
+ * @param[in] chaserIndex Index of chaser in "chasers" array
+ * @param[in] rule        Rule that is violated, e.g., "positive"
+ */
+void reportInvalidChaserSetting( const std::string& settingName,
+                                 const rapidjson::SizeType chaserIndex,
+                                 const std::string& rule )
+{
+    std::ostringstream message;
+    message << settingName << " of chaser " << chaserIndex << " should be " << rule;
+    std::cerr << "ERROR: " << message.str( ) << "!" << std::endl;
+    throw std::invalid_argument( message.str( ) );
+}
+
+//! Check that user input only selects settings supported by multi-chaser simulations.
+/*!
+ * Multi-chaser simulations only support the Clohessy-Wiltshire propagator and the sampling mode
+ * of the output sampling settings. Event-triggered output samples, adaptive scheduling and
+ * checkpointing are not supported. An error is thrown (std::invalid_argument) if any of these
+ * settings is selected, rather than silently ignoring it.
+ *
+ * @param[in] input User input containing shared simulation settings
+ */
+void checkMultiChaserSupport( const UserInput& input )
+{
+    if ( input.propagatorSettings.propagatorType != clohessyWiltshirePropagator )
+    {
+        std::cerr << "ERROR: Multi-chaser simulations only support the \"clohessy_wiltshire\" "
+                  << "propagator!" << std::endl;
+        throw std::invalid_argument(
+            "Multi-chaser simulations only support the \"clohessy_wiltshire\" propagator" );
+    }
+
+    if ( input.outputSampling.isThrustSwitchEventEnabled
+         || input.outputSampling.isThrottleSaturationEventEnabled
+         || input.outputSampling.isArrivalEventEnabled )
+    {
+        std::cerr << "ERROR: Multi-chaser simulations do not support output sampling events!"
+                  << std::endl;
+        throw std::invalid_argument(
+            "Multi-chaser simulations do not support output sampling events" );
+    }
+
+    if ( input.adaptiveScheduling.isEnabled )
+    {
+        std::cerr << "ERROR: Multi-chaser simulations do not support adaptive scheduling!"
+                  << std::endl;
+        throw std::invalid_argument(
+            "Multi-chaser simulations do not support adaptive scheduling" );
+    }
+
+    if ( !input.checkpoint.filename.empty( ) )
+    {
+        std::cerr << "ERROR: Multi-chaser simulations do not support checkpointing!"
+                  << std::endl;
+        throw std::invalid_argument( "Multi-chaser simulations do not support checkpointing" );
+    }
+}
+
+} // namespace
+
+//! Check if multi-chaser settings are provided.
+bool hasMultiChaserInput( const rapidjson::Document& config )
+{
+    return config.FindMember( "multi_chaser" ) != config.MemberEnd( );
+}
+
+//! Check multi-chaser settings.
+MultiChaserSettings checkMultiChaserInput( const rapidjson::Document& config,
+                                           const UserInput& nominalInput,
+                                           std::ostream& outputStream )
+{
+    // Check that the nominal input does not select settings that multi-chaser simulations ignore.
+    checkMultiChaserSupport( nominalInput );
+
+    // Search for multi-chaser settings in config.
+    rapidjson::Value::ConstMemberIterator multiChaserIterator = config.FindMember( "multi_chaser" );
+    if ( multiChaserIterator == config.MemberEnd( ) )
+    {
+        std::cerr << "ERROR: Configuration option \"multi_chaser\" could not be found in JSON "
+                  << "input!" << std::endl;
+        throw std::invalid_argument(
+            "Configuration option \"multi_chaser\" could not be found in JSON input" );
+    }
+    const rapidjson::Value& multiChaserSettings = multiChaserIterator->value;
+
+    // Search for chasers in multi-chaser settings.
+    rapidjson::Value::ConstMemberIterator chasersIterator
+        = multiChaserSettings.FindMember( "chasers" );
+    if ( chasersIterator == multiChaserSettings.MemberEnd( )
+         || !chasersIterator->value.IsArray( )
+         || chasersIterator->value.Size( ) == 0 )
+    {
+        std::cerr << "ERROR: Multi-chaser option \"chasers\" should be a non-empty array!"
+                  << std::endl;
+        throw std::invalid_argument(
+            "Multi-chaser option \"chasers\" should be a non-empty array" );
+    }
+    const rapidjson::Value& chasersConfig = chasersIterator->value;
+
+    std::vector< ChaserSettings > chasers;
+    for ( rapidjson::SizeType i = 0; i < chasersConfig.Size( ); ++i )
+    {
+        const rapidjson::Value& chaserConfig = chasersConfig[ i ];
+
+        Vector6 initialState = nominalInput.chaserInitialState;
+        rapidjson::Value::ConstMemberIterator initialStateIterator
+            = chaserConfig.FindMember( "initial_state" );
+        if ( initialStateIterator != chaserConfig.MemberEnd( ) )
+        {
+            for ( int j = 0; j < 6; ++j )
+            {
+                initialState[ j ] = initialStateIterator->value[ j ].GetDouble( );
+            }
+        }
+
+        ThrustMode thrustMode = nominalInput.thrustMode;
+        Real thrustMaximum = nominalInput.thrustMaximum;
+        rapidjson::Value::ConstMemberIterator thrustSettingsIterator
+            = chaserConfig.FindMember( "thrust_settings" );
+        if ( thrustSettingsIterator != chaserConfig.MemberEnd( ) )
+        {
+            const std::string thrustModeString = thrustSettingsIterator->value[ 0 ].GetString( );
+            if ( !thrustModeString.compare( "off" ) )
+            {
+                thrustMode = off;
+            }
+            else if ( !thrustModeString.compare( "throttle" ) )
+            {
+                thrustMode = throttle;
+            }
+            else if ( !thrustModeString.compare( "on_off" ) )
+            {
+                thrustMode = onOff;
+            }
+            else
+            {
+                reportInvalidChaserSetting(
+                    "Thrust mode", i, "\"throttle\", \"on_off\" or \"off\"" );
+            }
+
+            thrustMaximum = thrustSettingsIterator->value[ 1 ].GetDouble( );
+            if ( thrustMaximum < 0.0 )
+            {
+                reportInvalidChaserSetting( "Thrust maximum", i, "non-negative" );
+            }
+
+            // On-off mode only works if a maximum thrust level is defined.
+            if ( thrustMode == onOff && !( thrustMaximum > 0.0 ) )
+            {
+                reportInvalidChaserSetting( "Thrust maximum", i, "positive in on-off mode" );
+            }
+        }
+
+        Real wetMass = nominalInput.chaserWetMass;
+        rapidjson::Value::ConstMemberIterator wetMassIterator
+            = chaserConfig.FindMember( "wet_mass" );
+        if ( wetMassIterator != chaserConfig.MemberEnd( ) )
+        {
+            wetMass = wetMassIterator->value.GetDouble( );
+            if ( !( wetMass > 0.0 ) )
+            {
+                reportInvalidChaserSetting( "Wet mass", i, "positive" );
+            }
+        }
+
+        chasers.push_back( ChaserSettings( initialState, thrustMode, thrustMaximum, wetMass ) );
+    }
+    outputStream << "Number of chasers                             "
+                 << chasers.size( ) << std::endl;
+
+    // Search for summary filename in multi-chaser settings.
+    rapidjson::Value::ConstMemberIterator summaryFilenameIterator
+        = multiChaserSettings.FindMember( "summary_filename" );
+    if ( summaryFilenameIterator == multiChaserSettings.MemberEnd( ) )
+    {
+        std::cerr << "ERROR: Multi-chaser option \"summary_filename\" could not be found in JSON "
+                  << "input!" << std::endl;
+        throw std::invalid_argument(
+            "Multi-chaser option \"summary_filename\" could not be found in JSON input" );
+    }
+    const std::string summaryFilename = summaryFilenameIterator->value.GetString( );
+    outputStream << "Multi-chaser summary file                     "
+                 << summaryFilename << std::endl;
+
+    return MultiChaserSettings( chasers, summaryFilename );
+}
+
+//! Construct multi-chaser simulator.
+MultiChaserSimulator::MultiChaserSimulator( const UserInput& anInput,
+                                            const std::vector< ChaserSettings >& someChasers )
+    : input( anInput ),
+      chasers( someChasers ),
+      thrustPulseTime( 1.0 / anInput.thrustFrequency ),
+      timeGrid( anInput.startTime, anInput.endTime, thrustPulseTime ),
+      exhaustVelocity( computeExhaustVelocity( anInput.chaserSpecificImpulse ) ),
+      targetMeanMotion( astro::computeKeplerMeanMotion( anInput.targetSemiMajorAxis,
+                                                        anInput.earthGravitationalParameter ) ),
+      pulseStateTransition( getClohessyWiltshireStateTransition( targetMeanMotion,
+                                                                 thrustPulseTime ) ),
+      timeToGoTransition( targetMeanMotion,
+                          timeGrid,
+                          anInput.propagatorSettings.transitionTolerance ),
+      thrustPolicies( someChasers.size( ), noThrustPolicy ),
+      thrustAccelerationMaxima( someChasers.size( ) ),
+      currentTime( anInput.startTime ),
+      timeToGo( anInput.endTime - anInput.startTime ),
+      currentStates( someChasers.size( ) ),
+      thrustAccelerations( someChasers.size( ) ),
+      thrustAccelerationNorms( someChasers.size( ), 0.0 ),
+      isThrottleSaturated( someChasers.size( ), 0 ),
+      totalDeltaV( someChasers.size( ), 0.0 ),
+      chaserMasses( someChasers.size( ), 0.0 ),
+      propellantMass( someChasers.size( ), 0.0 ),
+      throttleSaturationTime( someChasers.size( ), 0.0 ),
+      isThrottleMax( someChasers.size( ), false ),
+      stateSink( 0 ),
+      thrustSink( 0 ),
+      outputSampler( OutputSamplingSettings( anInput.outputSampling.samplingMode,
+                                             anInput.outputSampling.stepInterval,
+                                             anInput.outputSampling.timeInterval ),
+                     anInput.startTime )
+{
+    checkMultiChaserSupport( input );
+
+    for ( std::size_t i = 0; i < chasers.size( ); ++i )
+    {
+        thrustAccelerationMaxima[ i ] = chasers[ i ].thrustMaximum / chasers[ i ].wetMass;
+        thrustPolicies[ i ]
+            = selectThrustPolicy( chasers[ i ].thrustMode, thrustAccelerationMaxima[ i ] );
+    }
+}
+
+//! Set output sinks.
+void MultiChaserSimulator::setOutputSinks( OutputSink* aStateSink, OutputSink* aThrustSink )
+{
+    stateSink = aStateSink;
+    thrustSink = aThrustSink;
+}
+
+//! Execute simulation.
+void MultiChaserSimulator::execute( )
+{
+    RVDSIM_SCOPED_TIMER( simulationPhase );
+
+    const std::size_t numberOfChasers = chasers.size( );
+
+    // Reset current epoch, chaser states and Time-To-Go (TTG) [s].
+    std::size_t stepIndex = 0;
+    currentTime = timeGrid.getEpoch( stepIndex );
+    timeToGo = timeGrid.getTimeToGo( stepIndex );
+    for ( std::size_t i = 0; i < numberOfChasers; ++i )
+    {
+        currentStates.setVector( i, chasers[ i ].initialState );
+        totalDeltaV[ i ] = 0.0;
+        chaserMasses[ i ] = chasers[ i ].wetMass;
+        propellantMass[ i ] = 0.0;
+        thrustAccelerationMaxima[ i ] = chasers[ i ].thrustMaximum / chaserMasses[ i ];
+        throttleSaturationTime[ i ] = 0.0;
+        isThrottleMax[ i ] = false;
+    }
+
+    outputSampler.reset( );
+    const bool isOutputStreamed = stateSink != 0 || thrustSink != 0;
+
+    const std::size_t numberOfSteps = timeGrid.getNumberOfSteps( );
+    while ( stepIndex < numberOfSteps )
+    {
+        // Compute control actions of all chasers using ZEM/ZEV feedback law.
+        computeThrustAccelerations( stepIndex );
+
+        // Stream current states and thrusts to output sinks, if current epoch is sampled.
+        if ( isOutputStreamed
+             && outputSampler.isSampled( stepIndex, currentTime, false, false, false ) )
+        {
+            writeOutputRows( true );
+        }
+
+        // Accumulate delta-V applied during thruster pulse and deplete chaser masses by
+        // propellant consumed.
+        for ( std::size_t i = 0; i < numberOfChasers; ++i )
+        {
+            const Real thrustAccelerationNorm = thrustAccelerationNorms[ i ];
+            totalDeltaV[ i ] += thrustAccelerationNorm * thrustPulseTime;
+
+            if ( exhaustVelocity > 0.0 && thrustAccelerationNorm > 0.0 )
+            {
+                const Real depletedMass = computeDepletedMass(
+                    chaserMasses[ i ], thrustAccelerationNorm, thrustPulseTime, exhaustVelocity );
+                propellantMass[ i ] += chaserMasses[ i ] - depletedMass;
+                chaserMasses[ i ] = depletedMass;
+                thrustAccelerationMaxima[ i ] = chasers[ i ].thrustMaximum / depletedMass;
+            }
+        }
+
+        // Propagate all chasers over thruster pulse using the shared state transition.
+        {
+            RVDSIM_SCOPED_TIMER( propagationPhase );
+            propagateClohessyWiltshireBatch(
+                pulseStateTransition, currentStates, thrustAccelerations, currentStates );
+        }
+        RVDSIM_INCREMENT_COUNTER( propagationCounter, numberOfChasers );
+
+        // Update current time and Time-To-Go to end of thruster pulse.
+        ++stepIndex;
+        currentTime = timeGrid.getEpoch( stepIndex );
+        timeToGo = timeGrid.getTimeToGo( stepIndex );
+    }
+
+    // Stream final epoch to output sinks, after which no thrust is applied.
+    if ( stateSink != 0 )
+    {
+        writeOutputRows( false );
+    }
+}
+
+//! Get summaries of simulation.
+std::vector< SimulationSummary > MultiChaserSimulator::getSummaries( ) const
+{
+    std::vector< SimulationSummary > summaries( chasers.size( ) );
+    for ( std::size_t i = 0; i < chasers.size( ); ++i )
+    {
+        const Real finalDistanceToTarget
+            = std::sqrt( currentStates( i, 0 ) * currentStates( i, 0 )
+                         + currentStates( i, 1 ) * currentStates( i, 1 )
+                         + currentStates( i, 2 ) * currentStates( i, 2 ) );
+
+        summaries[ i ].finalDistanceToTarget = finalDistanceToTarget;
+        summaries[ i ].isTargetReached
+            = !( finalDistanceToTarget > input.arrivalDistanceTolerance );
+        summaries[ i ].totalDeltaV = totalDeltaV[ i ];
+        summaries[ i ].propellantMass = propellantMass[ i ];
+        summaries[ i ].isThrottleMax = isThrottleMax[ i ];
+        summaries[ i ].throttleSaturationTime = throttleSaturationTime[ i ];
+        summaries[ i ].terminationTime = currentTime;
+        summaries[ i ].isTerminatedEarly = false;
+        summaries[ i ].isRedrawn = false;
+    }
+    return summaries;
+}
+
+//! Compute thrust accelerations of all chasers using ZEM/ZEV feedback law.
+void MultiChaserSimulator::computeThrustAccelerations( const std::size_t stepIndex )
+{
+    RVDSIM_SCOPED_TIMER( guidancePhase );
+
+    const std::size_t numberOfChasers = chasers.size( );
+
+    // Evaluate fused guidance kernel for all chasers. All chasers share the Time-To-Go, such that
+    // a single state transition, updated incrementally from the previous step, is used for the
+    // complete batch.
+    evaluateGuidanceKernelBatch( timeToGoTransition.update( stepIndex ),
+                                 timeToGo,
+                                 currentStates,
+                                 thrustPolicies,
+                                 thrustAccelerationMaxima,
+                                 thrustAccelerations,
+                                 thrustAccelerationNorms,
+                                 isThrottleSaturated );
+    RVDSIM_INCREMENT_COUNTER( guidanceCallCounter, numberOfChasers );
+
+    for ( std::size_t i = 0; i < numberOfChasers; ++i )
+    {
+        if ( isThrottleSaturated[ i ] )
+        {
+            isThrottleMax[ i ] = true;
+            throttleSaturationTime[ i ] += thrustPulseTime;
+            RVDSIM_INCREMENT_COUNTER( throttleSaturationCounter, 1 );
+        }
+    }
+}
+
+//! Write current states and thrusts to output sinks.
+void MultiChaserSimulator::writeOutputRows( const bool isThrustWritten )
+{
+    RVDSIM_SCOPED_TIMER( outputPhase );
+
+    for ( std::size_t i = 0; i < chasers.size( ); ++i )
+    {
+        if ( stateSink != 0 )
+        {
+            const Real stateRow[ 8 ] = { currentTime,
+                                         static_cast< Real >( i ),
+                                         currentStates( i, 0 ),
+                                         currentStates( i, 1 ),
+                                         currentStates( i, 2 ),
+                                         currentStates( i, 3 ),
+                                         currentStates( i, 4 ),
+                                         currentStates( i, 5 ) };
+            stateSink->writeRow( stateRow );
+        }
+
+        if ( thrustSink != 0 && isThrustWritten )
+        {
+            const Real mass = chaserMasses[ i ];
+            const Real thrustRow[ 5 ] = { currentTime,
+                                          static_cast< Real >( i ),
+                                          thrustAccelerations( i, 0 ) * mass,
+                                          thrustAccelerations( i, 1 ) * mass,
+                                          thrustAccelerations( i, 2 ) * mass };
+            thrustSink->writeRow( thrustRow );
+        }
+    }
+}
+
+//! Write multi-chaser summary to file.
+void writeMultiChaserSummary( const std::string&                      filePath,
+                              const std::vector< SimulationSummary >& summaries )
+{
+    const char* columnNames[ ] = { "chaser",
+                                   "final_distance",
+                                   "is_target_reached",
+                                   "total_delta_v",
+                                   "is_throttle_max",
+                                   "saturation_time",
+                                   "propellant_mass" };
+    CsvOutputSink summarySink( filePath, std::vector< std::string >( columnNames, columnNames + 7 ),
+                               12 );
+
+    for ( std::size_t i = 0; i < summaries.size( ); ++i )
+    {
+        const Real row[ 7 ] = { static_cast< Real >( i ),
+                                summaries[ i ].finalDistanceToTarget,
+                                summaries[ i ].isTargetReached ? 1.0 : 0.0,
+                                summaries[ i ].totalDeltaV,
+                                summaries[ i ].isThrottleMax ? 1.0 : 0.0,
+                                summaries[ i ].throttleSaturationTime,
+                                summaries[ i ].propellantMass };
+        summarySink.writeRow( row );
+    }
+
+    summarySink.close( );
+}
+
+} // namespace rvdsim
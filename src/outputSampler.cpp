@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cmath>
+
+#include "rvdsim/outputSampler.hpp"
+
+namespace rvdsim
+{
+
+//! Construct output sampler.
+OutputSampler::OutputSampler( const OutputSamplingSettings& someSettings, const Real aStartTime )
+    : settings( someSettings ),
+      startTime( aStartTime ),
+      nextIntervalIndex( 0 ),
+      isStarted( false ),
+      wasThrustOn( false ),
+      wasThrottleSaturated( false ),
+      wasWithinArrivalTolerance( false )
+{ }
+
+//! Reset sampler to start of simulation.
+void OutputSampler::reset( )
+{
+    nextIntervalIndex = 0;
+    isStarted = false;
+    wasThrustOn = false;
+    wasThrottleSaturated = false;
+    wasWithinArrivalTolerance = false;
+}
+
+//! Check if epoch is sampled.
+bool OutputSampler::isSampled( const std::size_t stepIndex,
+                               const Real time,
+                               const bool isThrustOn,
+                               const bool isThrottleSaturated,
+                               const bool isWithinArrivalTolerance )
+{
+    bool isSampledEpoch = false;
+
+    switch ( settings.samplingMode )
+    {
+        case everyStep:
+        {
+            isSampledEpoch = true;
+            break;
+        }
+
+        case everyNthStep:
+        {
+            isSampledEpoch = settings.stepInterval < 2 || stepIndex % settings.stepInterval == 0;
+            break;
+        }
+
+        case fixedInterval:
+        {
+            if ( !( settings.timeInterval > 0.0 ) )
+            {
+                isSampledEpoch = true;
+                break;
+            }
+
+            // Output times are computed from the start time, such that they do not drift. A small
+            // tolerance avoids skipping output times that coincide with epochs due to round-off.
+            const Real elapsedIntervals
+                = ( time - startTime ) / settings.timeInterval + 1.0e-9;
+            if ( elapsedIntervals >= static_cast< Real >( nextIntervalIndex ) )
+            {
+                isSampledEpoch = true;
+                nextIntervalIndex
+                    = static_cast< std::size_t >( std::floor( elapsedIntervals ) ) + 1;
+            }
+            break;
+        }
+    }
+
+    if ( isStarted )
+    {
+        isSampledEpoch = isSampledEpoch
+                         || ( settings.isThrustSwitchEventEnabled && isThrustOn != wasThrustOn )
+                         || ( settings.isThrottleSaturationEventEnabled
+                              && isThrottleSaturated != wasThrottleSaturated )
+                         || ( settings.isArrivalEventEnabled
+                              && isWithinArrivalTolerance != wasWithinArrivalTolerance );
+    }
+    else
+    {
+        isSampledEpoch = true;
+        isStarted = true;
+    }
+
+    wasThrustOn = isThrustOn;
+    wasThrottleSaturated = isThrottleSaturated;
+    wasWithinArrivalTolerance = isWithinArrivalTolerance;
+
+    return isSampledEpoch;
+}
+
+//! Get state of sampler.
+OutputSamplerState OutputSampler::getState( ) const
+{
+    OutputSamplerState state;
+    state.nextIntervalIndex = nextIntervalIndex;
+    state.isStarted = isStarted;
+    state.wasThrustOn = wasThrustOn;
+    state.wasThrottleSaturated = wasThrottleSaturated;
+    state.wasWithinArrivalTolerance = wasWithinArrivalTolerance;
+    return state;
+}
+
+//! Set state of sampler.
+void OutputSampler::setState( const OutputSamplerState& state )
+{
+    nextIntervalIndex = state.nextIntervalIndex;
+    isStarted = state.isStarted;
+    wasThrustOn = state.wasThrustOn;
+    wasThrottleSaturated = state.wasThrottleSaturated;
+    wasWithinArrivalTolerance = state.wasWithinArrivalTolerance;
+}
+
+} // namespace rvdsim
@@ -0,0 +1,316 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cstdio>
+#include <iostream>
+
+#if defined( _WIN32 )
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "rvdsim/binaryEncoding.hpp"
+#include "rvdsim/instrumentation.hpp"
+#include "rvdsim/outputSink.hpp"
+
+namespace rvdsim
+{
+
+namespace
+{
+
+//! Truncate file to given size.
+/*!
+ * @param[in] filePath Path to file
+ * @param[in] fileSize Size of file after truncation [bytes]
+ * @return            Flag indicating if file was truncated successfully
+ */
+bool truncateFile( const std::string& filePath, const std::uint64_t fileSize )
+{
+#if defined( _WIN32 )
+    const HANDLE fileHandle = CreateFileA( filePath.c_str( ), GENERIC_WRITE, 0, NULL,
+                                           OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+    if ( fileHandle == INVALID_HANDLE_VALUE )
+    {
+        return false;
+    }
+    LARGE_INTEGER distance;
+    distance.QuadPart = static_cast< LONGLONG >( fileSize );
+    const bool isTruncated = SetFilePointerEx( fileHandle, distance, NULL, FILE_BEGIN )
+                             && SetEndOfFile( fileHandle );
+    CloseHandle( fileHandle );
+    return isTruncated;
+#else
+    return truncate( filePath.c_str( ), static_cast< off_t >( fileSize ) ) == 0;
+#endif
+}
+
+//! Prepare output file for sink and get mode in which it is opened.
+/*!
+ * For a new sink, the file is opened for writing from scratch. For a resumed sink, the existing
+ * file is truncated to the resume position, discarding rows written after it was recorded, and
+ * opened for updating without truncation.
+ *
+ * @param[in] filePath       Path to output file
+ * @param[in] resumePosition Position at which existing file is resumed (null for new sink)
+ * @return                   Mode in which output file is opened
+ */
+std::ios::openmode prepareOutputFile( const std::string& filePath,
+                                      const OutputSinkPosition* resumePosition )
+{
+    if ( resumePosition == 0 )
+    {
+        return std::ios::binary;
+    }
+
+    if ( !truncateFile( filePath, resumePosition->fileOffset ) )
+    {
+        std::cerr << "ERROR: Output file \"" << filePath << "\" could not be resumed!"
+                  << std::endl;
+        throw;
+    }
+    return std::ios::binary | std::ios::in | std::ios::out;
+}
+
+} // namespace
+
+//! Construct output sink.
+OutputSink::OutputSink( const std::vector< std::string >& someColumnNames )
+    : columnNames( someColumnNames ),
+      numberOfRows( 0 )
+{ }
+
+//! Construct CSV output sink.
+CsvOutputSink::CsvOutputSink( const std::string& aFilePath,
+                              const std::vector< std::string >& someColumnNames,
+                              const int aPrecision,
+                              const std::size_t aBufferSize,
+                              const OutputSinkPosition* aResumePosition )
+    : OutputSink( someColumnNames ),
+      file( aFilePath.c_str( ), prepareOutputFile( aFilePath, aResumePosition ) ),
+      precision( aPrecision ),
+      bufferSize( aBufferSize ),
+      buffer( )
+{
+    if ( !file.is_open( ) )
+    {
+        std::cerr << "ERROR: Output file \"" << aFilePath << "\" could not be opened!"
+                  << std::endl;
+        throw;
+    }
+
+    buffer.reserve( bufferSize );
+
+    if ( aResumePosition != 0 )
+    {
+        file.seekp( 0, std::ios::end );
+        numberOfRows = static_cast< std::size_t >( aResumePosition->numberOfRows );
+        return;
+    }
+
+    for ( std::size_t i = 0; i < columnNames.size( ); ++i )
+    {
+        if ( i > 0 )
+        {
+            buffer += ',';
+        }
+        buffer += columnNames[ i ];
+    }
+    buffer += '\n';
+}
+
+//! Destruct CSV output sink, closing file if still open.
+CsvOutputSink::~CsvOutputSink( )
+{
+    close( );
+}
+
+//! Write row.
+void CsvOutputSink::writeRow( const Real* row )
+{
+    char value[ 32 ];
+    for ( std::size_t i = 0; i < columnNames.size( ); ++i )
+    {
+        if ( i > 0 )
+        {
+            buffer += ',';
+        }
+        const int length = std::snprintf( value, sizeof( value ), "%.*g", precision, row[ i ] );
+        buffer.append( value, static_cast< std::size_t >( length ) );
+    }
+    buffer += '\n';
+    ++numberOfRows;
+
+    if ( buffer.size( ) >= bufferSize )
+    {
+        flush( );
+    }
+}
+
+//! Close sink.
+void CsvOutputSink::close( )
+{
+    if ( !file.is_open( ) )
+    {
+        return;
+    }
+
+    flush( );
+    file.close( );
+}
+
+//! Synchronise sink with file.
+OutputSinkPosition CsvOutputSink::synchronize( )
+{
+    flush( );
+    file.flush( );
+
+    OutputSinkPosition position;
+    position.fileOffset = static_cast< std::uint64_t >( file.tellp( ) );
+    position.numberOfRows = numberOfRows;
+    return position;
+}
+
+//! Flush buffer to file.
+void CsvOutputSink::flush( )
+{
+    file.write( buffer.data( ), static_cast< std::streamsize >( buffer.size( ) ) );
+    RVDSIM_INCREMENT_COUNTER( bytesWrittenCounter, buffer.size( ) );
+    buffer.clear( );
+}
+
+//! Construct binary output sink.
+BinaryOutputSink::BinaryOutputSink( const std::string& aFilePath,
+                                    const std::vector< std::string >& someColumnNames,
+                                    const std::size_t aBufferSize,
+                                    const OutputSinkPosition* aResumePosition )
+    : OutputSink( someColumnNames ),
+      file( aFilePath.c_str( ), prepareOutputFile( aFilePath, aResumePosition ) ),
+      bufferSize( aBufferSize ),
+      buffer( )
+{
+    if ( !file.is_open( ) )
+    {
+        std::cerr << "ERROR: Output file \"" << aFilePath << "\" could not be opened!"
+                  << std::endl;
+        throw;
+    }
+
+    buffer.reserve( bufferSize );
+
+    if ( aResumePosition != 0 )
+    {
+        file.seekp( 0, std::ios::end );
+        numberOfRows = static_cast< std::size_t >( aResumePosition->numberOfRows );
+        return;
+    }
+
+    // Compute size of header, padded to alignment of data section.
+    std::size_t headerSize = 32;
+    for ( std::size_t i = 0; i < columnNames.size( ); ++i )
+    {
+        headerSize += columnNames[ i ].size( ) + 1;
+    }
+    headerSize = ( ( headerSize + binaryOutputAlignment - 1 ) / binaryOutputAlignment )
+                 * binaryOutputAlignment;
+
+    for ( std::size_t i = 0; i < 8; ++i )
+    {
+        buffer.push_back( binaryOutputMagic[ i ] );
+    }
+    appendLittleEndian( binaryOutputVersion, 4, buffer );
+    appendLittleEndian( columnNames.size( ), 4, buffer );
+    appendLittleEndian( 0, 8, buffer );
+    appendLittleEndian( headerSize, 8, buffer );
+    for ( std::size_t i = 0; i < columnNames.size( ); ++i )
+    {
+        for ( std::size_t j = 0; j < columnNames[ i ].size( ); ++j )
+        {
+            buffer.push_back( columnNames[ i ][ j ] );
+        }
+        buffer.push_back( '\0' );
+    }
+    buffer.resize( headerSize, '\0' );
+}
+
+//! Destruct binary output sink, closing file if still open.
+BinaryOutputSink::~BinaryOutputSink( )
+{
+    close( );
+}
+
+//! Write row.
+void BinaryOutputSink::writeRow( const Real* row )
+{
+    for ( std::size_t i = 0; i < columnNames.size( ); ++i )
+    {
+        appendLittleEndian( static_cast< double >( row[ i ] ), buffer );
+    }
+    ++numberOfRows;
+
+    if ( buffer.size( ) >= bufferSize )
+    {
+        flush( );
+    }
+}
+
+//! Close sink.
+void BinaryOutputSink::close( )
+{
+    if ( !file.is_open( ) )
+    {
+        return;
+    }
+
+    flush( );
+
+    // Patch number of rows in header, now that it is known.
+    appendLittleEndian( numberOfRows, 8, buffer );
+    file.seekp( 16 );
+    flush( );
+    file.close( );
+}
+
+//! Synchronise sink with file.
+OutputSinkPosition BinaryOutputSink::synchronize( )
+{
+    flush( );
+    file.flush( );
+
+    // The number of rows in the header is only patched when the sink is closed, such that it is
+    // part of the position, rather than of the file contents.
+    OutputSinkPosition position;
+    position.fileOffset = static_cast< std::uint64_t >( file.tellp( ) );
+    position.numberOfRows = numberOfRows;
+    return position;
+}
+
+//! Flush buffer to file.
+void BinaryOutputSink::flush( )
+{
+    file.write( buffer.data( ), static_cast< std::streamsize >( buffer.size( ) ) );
+    RVDSIM_INCREMENT_COUNTER( bytesWrittenCounter, buffer.size( ) );
+    buffer.clear( );
+}
+
+//! Create output sink.
+std::unique_ptr< OutputSink > createOutputSink( const OutputFormat outputFormat,
+                                                const std::string& filePath,
+                                                const std::vector< std::string >& columnNames,
+                                                const OutputSinkPosition* resumePosition )
+{
+    if ( outputFormat == binaryOutput )
+    {
+        return std::unique_ptr< OutputSink >(
+            new BinaryOutputSink( filePath, columnNames, 1 << 20, resumePosition ) );
+    }
+
+    return std::unique_ptr< OutputSink >(
+        new CsvOutputSink( filePath, columnNames, 6, 1 << 20, resumePosition ) );
+}
+
+} // namespace rvdsim
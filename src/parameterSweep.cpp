@@ -0,0 +1,323 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <iostream>
+#include <string>
+
+#include "rvdsim/outputSink.hpp"
+#include "rvdsim/parameterSweep.hpp"
+#include "rvdsim/threadPool.hpp"
+
+namespace rvdsim
+{
+
+namespace
+{
+
+//! Parse values of swept parameter.
+/*!
+ * Parses values of swept parameter, given as an array of values, or as an object
+ * {"from", "to", "points"} describing evenly spaced values (including both end points). If the
+ * parameter is not present in the sweep settings, its nominal value is used.
+ *
+ * @param[in] sweepSettings JSON object containing sweep settings
+ * @param[in] parameterName Name of swept parameter
+ * @param[in] nominalValue  Nominal value of parameter
+ * @return                  Values of swept parameter
+ */
+std::vector< Real > parseSweepValues( const rapidjson::Value& sweepSettings,
+                                      const std::string& parameterName,
+                                      const Real nominalValue )
+{
+    std::vector< Real > values;
+
+    rapidjson::Value::ConstMemberIterator valuesIterator
+        = sweepSettings.FindMember( parameterName.c_str( ) );
+    if ( valuesIterator == sweepSettings.MemberEnd( ) )
+    {
+        values.push_back( nominalValue );
+        return values;
+    }
+
+    const rapidjson::Value& valuesConfig = valuesIterator->value;
+    if ( valuesConfig.IsArray( ) )
+    {
+        for ( rapidjson::SizeType i = 0; i < valuesConfig.Size( ); ++i )
+        {
+            values.push_back( valuesConfig[ i ].GetDouble( ) );
+        }
+    }
+    else if ( valuesConfig.IsObject( )
+              && valuesConfig.FindMember( "from" ) != valuesConfig.MemberEnd( )
+              && valuesConfig.FindMember( "to" ) != valuesConfig.MemberEnd( )
+              && valuesConfig.FindMember( "points" ) != valuesConfig.MemberEnd( ) )
+    {
+        const Real from = valuesConfig[ "from" ].GetDouble( );
+        const Real to = valuesConfig[ "to" ].GetDouble( );
+        const std::size_t numberOfPoints
+            = static_cast< std::size_t >( valuesConfig[ "points" ].GetUint( ) );
+        for ( std::size_t i = 0; i < numberOfPoints; ++i )
+        {
+            values.push_back( numberOfPoints < 2
+                              ? from
+                              : from + ( to - from ) * static_cast< Real >( i )
+                                       / static_cast< Real >( numberOfPoints - 1 ) );
+        }
+    }
+
+    if ( values.empty( ) )
+    {
+        std::cerr << "ERROR: Sweep values of \"" << parameterName << "\" should be given as a "
+                  << "non-empty array of values or as {\"from\", \"to\", \"points\"}!"
+                  << std::endl;
+        throw;
+    }
+
+    return values;
+}
+
+//! Print values of swept parameter.
+/*!
+ * @param[in]     values       Values of swept parameter
+ * @param[in,out] outputStream Stream to which values are printed
+ */
+void printSweepValues( const std::vector< Real >& values, std::ostream& outputStream )
+{
+    outputStream << "[";
+    for ( std::size_t i = 0; i < values.size( ); ++i )
+    {
+        outputStream << values[ i ] << ( i + 1 < values.size( ) ? ", " : "]" );
+    }
+    outputStream << std::endl;
+}
+
+} // namespace
+
+//! Check if sweep settings are provided.
+bool hasSweepInput( const rapidjson::Document& config )
+{
+    return config.FindMember( "sweep" ) != config.MemberEnd( );
+}
+
+//! Check sweep settings.
+SweepSettings checkSweepInput( const rapidjson::Document& config,
+                               const UserInput& nominalInput,
+                               std::ostream& outputStream )
+{
+    // Search for sweep settings in config.
+    rapidjson::Value::ConstMemberIterator sweepIterator = config.FindMember( "sweep" );
+    if ( sweepIterator == config.MemberEnd( ) )
+    {
+        std::cerr << "ERROR: Configuration option \"sweep\" could not be found in JSON input!"
+                  << std::endl;
+        throw;
+    }
+    const rapidjson::Value& sweepSettings = sweepIterator->value;
+
+    // Search for values of swept thruster settings (optional).
+    const std::vector< Real > thrustMaximumValues
+        = parseSweepValues( sweepSettings, "thrust_maximum", nominalInput.thrustMaximum );
+    for ( std::size_t i = 0; i < thrustMaximumValues.size( ); ++i )
+    {
+        if ( thrustMaximumValues[ i ] < 0.0 )
+        {
+            std::cerr << "ERROR: Sweep values of \"thrust_maximum\" should be non-negative!"
+                      << std::endl;
+            throw;
+        }
+
+        // On-off mode only works if a maximum thrust level is defined.
+        if ( nominalInput.thrustMode == onOff && !( thrustMaximumValues[ i ] > 0.0 ) )
+        {
+            std::cerr << "ERROR: Sweep values of \"thrust_maximum\" should be positive in on-off "
+                      << "mode!" << std::endl;
+            throw;
+        }
+    }
+    outputStream << "Sweep thrust maximum          [N]             ";
+    printSweepValues( thrustMaximumValues, outputStream );
+
+    const std::vector< Real > thrustFrequencyValues
+        = parseSweepValues( sweepSettings, "thrust_frequency", nominalInput.thrustFrequency );
+    for ( std::size_t i = 0; i < thrustFrequencyValues.size( ); ++i )
+    {
+        if ( !( thrustFrequencyValues[ i ] > 0.0 ) )
+        {
+            std::cerr << "ERROR: Sweep values of \"thrust_frequency\" should be positive!"
+                      << std::endl;
+            throw;
+        }
+    }
+    outputStream << "Sweep thrust frequency        [Hz]            ";
+    printSweepValues( thrustFrequencyValues, outputStream );
+
+    // Search for number of threads in sweep settings (optional).
+    std::size_t numberOfThreads = 0;
+    rapidjson::Value::ConstMemberIterator numberOfThreadsIterator
+        = sweepSettings.FindMember( "threads" );
+    if ( numberOfThreadsIterator != sweepSettings.MemberEnd( ) )
+    {
+        numberOfThreads = static_cast< std::size_t >( numberOfThreadsIterator->value.GetUint( ) );
+    }
+    outputStream << "Sweep threads                                 ";
+    if ( numberOfThreads == 0 )
+    {
+        outputStream << "AUTO" << std::endl;
+    }
+    else
+    {
+        outputStream << numberOfThreads << std::endl;
+    }
+
+    // Search for early termination settings in sweep settings (optional).
+    bool isArrivalTerminationEnabled = false;
+    rapidjson::Value::ConstMemberIterator arrivalTerminationIterator
+        = sweepSettings.FindMember( "terminate_on_arrival" );
+    if ( arrivalTerminationIterator != sweepSettings.MemberEnd( ) )
+    {
+        isArrivalTerminationEnabled = arrivalTerminationIterator->value.GetBool( );
+    }
+    outputStream << "Sweep terminate on arrival                    "
+                 << ( isArrivalTerminationEnabled ? "ON" : "OFF" ) << std::endl;
+
+    Real maximumDistance = 0.0;
+    rapidjson::Value::ConstMemberIterator maximumDistanceIterator
+        = sweepSettings.FindMember( "maximum_distance" );
+    if ( maximumDistanceIterator != sweepSettings.MemberEnd( ) )
+    {
+        maximumDistance = maximumDistanceIterator->value.GetDouble( );
+        if ( maximumDistance < 0.0 )
+        {
+            std::cerr << "ERROR: Sweep option \"maximum_distance\" should be non-negative!"
+                      << std::endl;
+            throw;
+        }
+    }
+    outputStream << "Sweep maximum distance        [m]             ";
+    if ( maximumDistance > 0.0 )
+    {
+        outputStream << maximumDistance << std::endl;
+    }
+    else
+    {
+        outputStream << "NONE" << std::endl;
+    }
+
+    // Search for results filename in sweep settings.
+    rapidjson::Value::ConstMemberIterator resultsFilenameIterator
+        = sweepSettings.FindMember( "results_filename" );
+    if ( resultsFilenameIterator == sweepSettings.MemberEnd( ) )
+    {
+        std::cerr << "ERROR: Sweep option \"results_filename\" could not be found in JSON input!"
+                  << std::endl;
+        throw;
+    }
+    const std::string resultsFilename = resultsFilenameIterator->value.GetString( );
+    outputStream << "Sweep results output file                     "
+                 << resultsFilename << std::endl;
+
+    return SweepSettings( thrustMaximumValues,
+                          thrustFrequencyValues,
+                          numberOfThreads,
+                          TerminationSettings( isArrivalTerminationEnabled, maximumDistance ),
+                          resultsFilename );
+}
+
+//! Compute user input for grid point.
+UserInput computeGridPointInput( const UserInput&     nominalInput,
+                                 const SweepSettings& settings,
+                                 const std::size_t    gridPointIndex )
+{
+    const std::size_t numberOfFrequencies = settings.thrustFrequencyValues.size( );
+
+    return UserInput( nominalInput.startTime,
+                      nominalInput.endTime,
+                      nominalInput.earthGravitationalParameter,
+                      nominalInput.targetSemiMajorAxis,
+                      nominalInput.chaserInitialState,
+                      nominalInput.thrustMode,
+                      settings.thrustMaximumValues[ gridPointIndex / numberOfFrequencies ],
+                      settings.thrustFrequencyValues[ gridPointIndex % numberOfFrequencies ],
+                      nominalInput.chaserWetMass,
+                      nominalInput.arrivalDistanceTolerance,
+                      nominalInput.outputDirectory,
+                      nominalInput.chaserStateHistoryFilename,
+                      nominalInput.chaserThrustHistoryFilename,
+                      nominalInput.outputFormat,
+                      nominalInput.chaserTrajectoryFilename,
+                      nominalInput.outputSampling,
+                      nominalInput.metricsFilename,
+                      nominalInput.adaptiveScheduling,
+                      nominalInput.propagatorSettings,
+                      nominalInput.checkpoint,
+                      nominalInput.chaserSpecificImpulse );
+}
+
+//! Execute parameter sweep.
+std::vector< SweepResult > executeParameterSweep( const UserInput&     nominalInput,
+                                                  const SweepSettings& settings )
+{
+    const std::size_t numberOfGridPoints = settings.getNumberOfGridPoints( );
+    std::vector< SweepResult > results( numberOfGridPoints );
+
+    // Each grid point writes to its own result only, so no synchronisation is needed. Grid points
+    // are submitted one at a time, since their execution time varies strongly with the thrust
+    // frequency and early termination.
+    ThreadPool threadPool( settings.numberOfThreads );
+    executeParallelLoop( threadPool,
+                         numberOfGridPoints,
+                         1,
+                         [ &nominalInput, &settings, &results ]( const std::size_t gridPointIndex )
+    {
+        const UserInput input = computeGridPointInput( nominalInput, settings, gridPointIndex );
+        Simulator simulator( input, false, settings.terminationSettings );
+        simulator.execute( );
+
+        SweepResult& result = results[ gridPointIndex ];
+        result.gridPointIndex = gridPointIndex;
+        result.thrustMaximum = input.thrustMaximum;
+        result.thrustFrequency = input.thrustFrequency;
+        result.summary = simulator.getSummary( );
+    } );
+
+    return results;
+}
+
+//! Write parameter sweep results to file.
+void writeParameterSweepResults( const std::string&                filePath,
+                                 const std::vector< SweepResult >& results )
+{
+    const char* columnNames[ ] = { "grid_point",
+                                   "thrust_maximum",
+                                   "thrust_frequency",
+                                   "final_distance",
+                                   "is_target_reached",
+                                   "total_delta_v",
+                                   "saturation_time",
+                                   "termination_time",
+                                   "propellant_mass" };
+    CsvOutputSink resultsSink( filePath, std::vector< std::string >( columnNames, columnNames + 9 ),
+                               12 );
+
+    for ( std::size_t i = 0; i < results.size( ); ++i )
+    {
+        const SimulationSummary& summary = results[ i ].summary;
+        const Real row[ 9 ] = { static_cast< Real >( results[ i ].gridPointIndex ),
+                                results[ i ].thrustMaximum,
+                                results[ i ].thrustFrequency,
+                                summary.finalDistanceToTarget,
+                                summary.isTargetReached ? 1.0 : 0.0,
+                                summary.totalDeltaV,
+                                summary.throttleSaturationTime,
+                                summary.terminationTime,
+                                summary.propellantMass };
+        resultsSink.writeRow( row );
+    }
+
+    resultsSink.close( );
+}
+
+} // namespace rvdsim
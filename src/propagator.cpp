@@ -0,0 +1,701 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+
+#include <astro/astro.hpp>
+
+#include "rvdsim/propagator.hpp"
+
+namespace rvdsim
+{
+
+namespace
+{
+
+//! Check size of internal state of propagator.
+/*!
+ * @param[in] internalState Internal state of propagator
+ * @param[in] expectedSize  Size of internal state expected by propagator
+ */
+void checkInternalStateSize( const std::vector< Real >& internalState,
+                             const std::size_t expectedSize )
+{
+    if ( internalState.size( ) != expectedSize )
+    {
+        std::cerr << "ERROR: Internal state of propagator has " << internalState.size( )
+                  << " values, while " << expectedSize << " are expected!" << std::endl;
+        throw std::runtime_error( "Internal state of propagator has unexpected size" );
+    }
+}
+
+//! Full revolution [rad].
+const Real fullRevolution = 2.0 * std::acos( -1.0 );
+
+//! Maximum number of Newton iterations used to solve Kepler's equation.
+const int maximumNumberOfKeplerIterations = 50;
+
+//! Dormand-Prince 5(4) coefficients of stages (lower-triangular Butcher tableau).
+const Real dormandPrinceStageCoefficients[ 6 ][ 6 ]
+    = { { 1.0 / 5.0, 0.0, 0.0, 0.0, 0.0, 0.0 },
+        { 3.0 / 40.0, 9.0 / 40.0, 0.0, 0.0, 0.0, 0.0 },
+        { 44.0 / 45.0, -56.0 / 15.0, 32.0 / 9.0, 0.0, 0.0, 0.0 },
+        { 19372.0 / 6561.0, -25360.0 / 2187.0, 64448.0 / 6561.0, -212.0 / 729.0, 0.0, 0.0 },
+        { 9017.0 / 3168.0, -355.0 / 33.0, 46732.0 / 5247.0, 49.0 / 176.0, -5103.0 / 18656.0,
+          0.0 },
+        { 35.0 / 384.0, 0.0, 500.0 / 1113.0, 125.0 / 192.0, -2187.0 / 6784.0, 11.0 / 84.0 } };
+
+//! Dormand-Prince 5(4) coefficients of error estimate (fifth- minus fourth-order weights).
+const Real dormandPrinceErrorCoefficients[ 7 ]
+    = { 71.0 / 57600.0, 0.0, -71.0 / 16695.0, 71.0 / 1920.0, -17253.0 / 339200.0, 22.0 / 525.0,
+        -1.0 / 40.0 };
+
+//! Compute cross product of two vectors.
+/*!
+ * @param[in]  left    Left-hand vector
+ * @param[in]  right   Right-hand vector
+ * @param[out] product Cross product
+ */
+void computeCrossProduct( const Real* left, const Real* right, Real* product )
+{
+    product[ 0 ] = left[ 1 ] * right[ 2 ] - left[ 2 ] * right[ 1 ];
+    product[ 1 ] = left[ 2 ] * right[ 0 ] - left[ 0 ] * right[ 2 ];
+    product[ 2 ] = left[ 0 ] * right[ 1 ] - left[ 1 ] * right[ 0 ];
+}
+
+//! Compute axes of Hill frame.
+/*!
+ * @param[in]  position        Position of target in inertial frame [m]
+ * @param[in]  velocity        Velocity of target in inertial frame [m/s]
+ * @param[out] rotation        Rotation from inertial frame to Hill frame, stored row by row [-]
+ * @param[out] radius          Distance of target to central body [m]
+ * @param[out] angularMomentum Norm of specific angular momentum of target [m^2/s]
+ */
+void computeHillFrameAxes( const Real* position,
+                           const Real* velocity,
+                           std::array< Vector3, 3 >& rotation,
+                           Real& radius,
+                           Real& angularMomentum )
+{
+    Real angularMomentumVector[ 3 ];
+    computeCrossProduct( position, velocity, angularMomentumVector );
+
+    radius = std::sqrt( position[ 0 ] * position[ 0 ]
+                        + position[ 1 ] * position[ 1 ]
+                        + position[ 2 ] * position[ 2 ] );
+    angularMomentum = std::sqrt( angularMomentumVector[ 0 ] * angularMomentumVector[ 0 ]
+                                 + angularMomentumVector[ 1 ] * angularMomentumVector[ 1 ]
+                                 + angularMomentumVector[ 2 ] * angularMomentumVector[ 2 ] );
+
+    for ( int i = 0; i < 3; ++i )
+    {
+        rotation[ 0 ][ i ] = position[ i ] / radius;
+        rotation[ 2 ][ i ] = angularMomentumVector[ i ] / angularMomentum;
+    }
+    computeCrossProduct( &rotation[ 2 ][ 0 ], &rotation[ 0 ][ 0 ], &rotation[ 1 ][ 0 ] );
+}
+
+} // namespace
+
+//! Construct Clohessy-Wiltshire propagator.
+ClohessyWiltshirePropagator::ClohessyWiltshirePropagator( const Real aMeanMotion,
+                                                          const Real aThrustPulseTime )
+    : meanMotion( aMeanMotion ),
+      thrustPulseTime( aThrustPulseTime ),
+      pulseStateTransition( getClohessyWiltshireStateTransition( aMeanMotion, aThrustPulseTime ) )
+{ }
+
+//! Predict end state of ballistic trajectory.
+void ClohessyWiltshirePropagator::predictBallisticState( const Real propagationTime,
+                                                         const Vector6& state,
+                                                         Vector6& finalState ) const
+{
+    const Vector3 zeroAcceleration = { { 0.0, 0.0, 0.0 } };
+    finalState = astro::propagateClohessyWiltshireSolution( state,
+                                                            propagationTime,
+                                                            meanMotion,
+                                                            zeroAcceleration );
+}
+
+//! Propagate state under constant thrust acceleration.
+void ClohessyWiltshirePropagator::propagate( const Real propagationTime,
+                                             const Vector6& state,
+                                             const Vector3& thrustAcceleration,
+                                             Vector6& finalState )
+{
+    if ( propagationTime == thrustPulseTime )
+    {
+        propagateClohessyWiltshire( pulseStateTransition, state, thrustAcceleration, finalState );
+    }
+    else
+    {
+        propagateClohessyWiltshire(
+            computeClohessyWiltshireStateTransition( meanMotion, propagationTime ),
+            state,
+            thrustAcceleration,
+            finalState );
+    }
+}
+
+//! Set internal state of propagator.
+void ClohessyWiltshirePropagator::setInternalState( const std::vector< Real >& internalState )
+{
+    checkInternalStateSize( internalState, 0 );
+}
+
+//! Construct Yamanaka-Ankersen propagator.
+YamanakaAnkersenPropagator::YamanakaAnkersenPropagator( const Real aGravitationalParameter,
+                                                        const Real aSemiMajorAxis,
+                                                        const Real anEccentricity,
+                                                        const Real anInitialTrueAnomaly )
+    : eccentricity( anEccentricity ),
+      meanMotion( std::sqrt( aGravitationalParameter
+                             / ( aSemiMajorAxis * aSemiMajorAxis * aSemiMajorAxis ) ) ),
+      anomalyRateConstant(
+          std::sqrt( aGravitationalParameter
+                     / std::pow( aSemiMajorAxis * ( 1.0 - anEccentricity * anEccentricity ),
+                                 3.0 ) ) ),
+      initialMeanAnomaly( std::atan2( std::sqrt( 1.0 - anEccentricity * anEccentricity )
+                                        * std::sin( anInitialTrueAnomaly ),
+                                      anEccentricity + std::cos( anInitialTrueAnomaly ) )
+                          - anEccentricity
+                            * std::sqrt( 1.0 - anEccentricity * anEccentricity )
+                            * std::sin( anInitialTrueAnomaly )
+                            / ( 1.0 + anEccentricity * std::cos( anInitialTrueAnomaly ) ) ),
+      elapsedTime( 0.0 )
+{ }
+
+//! Predict end state of ballistic trajectory.
+void YamanakaAnkersenPropagator::predictBallisticState( const Real propagationTime,
+                                                        const Vector6& state,
+                                                        Vector6& finalState ) const
+{
+    propagateBallisticState( elapsedTime, propagationTime, state, finalState );
+}
+
+//! Propagate state under constant thrust acceleration.
+void YamanakaAnkersenPropagator::propagate( const Real propagationTime,
+                                            const Vector6& state,
+                                            const Vector3& thrustAcceleration,
+                                            Vector6& finalState )
+{
+    // Apply half of velocity change at start and half at end of propagation.
+    Vector6 initialState = state;
+    for ( int i = 0; i < 3; ++i )
+    {
+        initialState[ i + 3 ] += 0.5 * thrustAcceleration[ i ] * propagationTime;
+    }
+
+    propagateBallisticState( elapsedTime, propagationTime, initialState, finalState );
+
+    for ( int i = 0; i < 3; ++i )
+    {
+        finalState[ i + 3 ] += 0.5 * thrustAcceleration[ i ] * propagationTime;
+    }
+
+    elapsedTime += propagationTime;
+}
+
+//! Compute true anomaly of target.
+Real YamanakaAnkersenPropagator::computeTrueAnomaly( const Real time ) const
+{
+    // The mean anomaly is reduced to a single revolution, since only trigonometric functions of
+    // the true anomaly are used.
+    const Real meanAnomaly = std::fmod( initialMeanAnomaly + meanMotion * time, fullRevolution );
+
+    Real eccentricAnomaly = meanAnomaly;
+    for ( int i = 0; i < maximumNumberOfKeplerIterations; ++i )
+    {
+        const Real correction
+            = ( eccentricAnomaly - eccentricity * std::sin( eccentricAnomaly ) - meanAnomaly )
+              / ( 1.0 - eccentricity * std::cos( eccentricAnomaly ) );
+        eccentricAnomaly -= correction;
+        if ( std::fabs( correction ) < 1.0e-14 )
+        {
+            break;
+        }
+    }
+
+    return std::atan2( std::sqrt( 1.0 - eccentricity * eccentricity )
+                         * std::sin( eccentricAnomaly ),
+                       std::cos( eccentricAnomaly ) - eccentricity );
+}
+
+//! Set internal state of propagator.
+void YamanakaAnkersenPropagator::setInternalState( const std::vector< Real >& internalState )
+{
+    checkInternalStateSize( internalState, 1 );
+    elapsedTime = internalState[ 0 ];
+}
+
+//! Propagate ballistic state.
+void YamanakaAnkersenPropagator::propagateBallisticState( const Real startTime,
+                                                          const Real propagationTime,
+                                                          const Vector6& state,
+                                                          Vector6& finalState ) const
+{
+    const Real e = eccentricity;
+    const Real k2 = anomalyRateConstant;
+
+    // Evaluate functions of true anomaly at start of propagation.
+    const Real initialTrueAnomaly = computeTrueAnomaly( startTime );
+    const Real sin0 = std::sin( initialTrueAnomaly );
+    const Real cos0 = std::cos( initialTrueAnomaly );
+    const Real rho0 = 1.0 + e * cos0;
+    const Real s0 = rho0 * sin0;
+    const Real c0 = rho0 * cos0;
+    const Real sPrime0 = cos0 + e * ( cos0 * cos0 - sin0 * sin0 );
+    const Real cPrime0 = -( sin0 + 2.0 * e * sin0 * cos0 );
+
+    // Transform state to scaled coordinates and derivatives with respect to true anomaly.
+    const Real scaledX = rho0 * state[ 0 ];
+    const Real scaledY = rho0 * state[ 1 ];
+    const Real scaledZ = rho0 * state[ 2 ];
+    const Real scaledXPrime = state[ 3 ] / ( k2 * rho0 ) - e * sin0 * state[ 0 ];
+    const Real scaledYPrime = state[ 4 ] / ( k2 * rho0 ) - e * sin0 * state[ 1 ];
+    const Real scaledZPrime = state[ 5 ] / ( k2 * rho0 ) - e * sin0 * state[ 2 ];
+
+    // Solve for coefficients of the four in-plane fundamental solutions. The fourth solution is a
+    // constant along-track offset, such that the first three coefficients follow from the
+    // equations for X, X' and Y' (solved using Cramer's rule).
+    const Real a11 = s0;
+    const Real a12 = c0;
+    const Real a13 = 2.0;
+    const Real a21 = sPrime0;
+    const Real a22 = cPrime0;
+    const Real a23 = -3.0 * e * s0 / ( rho0 * rho0 );
+    const Real a31 = cPrime0 - sin0;
+    const Real a32 = -( sPrime0 + cos0 );
+    const Real a33 = -3.0;
+
+    const Real determinant = a11 * ( a22 * a33 - a23 * a32 )
+                             - a12 * ( a21 * a33 - a23 * a31 )
+                             + a13 * ( a21 * a32 - a22 * a31 );
+    const Real coefficient1 = ( scaledX * ( a22 * a33 - a23 * a32 )
+                                - a12 * ( scaledXPrime * a33 - a23 * scaledYPrime )
+                                + a13 * ( scaledXPrime * a32 - a22 * scaledYPrime ) )
+                              / determinant;
+    const Real coefficient2 = ( a11 * ( scaledXPrime * a33 - a23 * scaledYPrime )
+                                - scaledX * ( a21 * a33 - a23 * a31 )
+                                + a13 * ( a21 * scaledYPrime - scaledXPrime * a31 ) )
+                              / determinant;
+    const Real coefficient3 = ( a11 * ( a22 * scaledYPrime - scaledXPrime * a32 )
+                                - a12 * ( a21 * scaledYPrime - scaledXPrime * a31 )
+                                + scaledX * ( a21 * a32 - a22 * a31 ) )
+                              / determinant;
+    const Real coefficient4 = scaledY - coefficient1 * ( c0 + cos0 )
+                              + coefficient2 * ( s0 + sin0 );
+
+    // Evaluate fundamental solutions at end of propagation.
+    const Real finalTrueAnomaly = computeTrueAnomaly( startTime + propagationTime );
+    const Real sin1 = std::sin( finalTrueAnomaly );
+    const Real cos1 = std::cos( finalTrueAnomaly );
+    const Real rho1 = 1.0 + e * cos1;
+    const Real s1 = rho1 * sin1;
+    const Real c1 = rho1 * cos1;
+    const Real sPrime1 = cos1 + e * ( cos1 * cos1 - sin1 * sin1 );
+    const Real cPrime1 = -( sin1 + 2.0 * e * sin1 * cos1 );
+    const Real j = k2 * propagationTime;
+
+    const Real finalScaledX = coefficient1 * s1
+                              + coefficient2 * c1
+                              + coefficient3 * ( 2.0 - 3.0 * e * s1 * j );
+    const Real finalScaledY = coefficient1 * ( c1 + cos1 )
+                              - coefficient2 * ( s1 + sin1 )
+                              - 3.0 * coefficient3 * rho1 * rho1 * j
+                              + coefficient4;
+    const Real finalScaledXPrime = coefficient1 * sPrime1
+                                   + coefficient2 * cPrime1
+                                   - 3.0 * e * coefficient3
+                                     * ( sPrime1 * j + s1 / ( rho1 * rho1 ) );
+    const Real finalScaledYPrime = coefficient1 * ( cPrime1 - sin1 )
+                                   - coefficient2 * ( sPrime1 + cos1 )
+                                   + coefficient3 * ( 6.0 * e * rho1 * sin1 * j - 3.0 );
+
+    // Out-of-plane motion is harmonic in the true anomaly.
+    const Real cosDelta = cos1 * cos0 + sin1 * sin0;
+    const Real sinDelta = sin1 * cos0 - cos1 * sin0;
+    const Real finalScaledZ = scaledZ * cosDelta + scaledZPrime * sinDelta;
+    const Real finalScaledZPrime = -scaledZ * sinDelta + scaledZPrime * cosDelta;
+
+    // Transform back to Hill frame.
+    finalState[ 0 ] = finalScaledX / rho1;
+    finalState[ 1 ] = finalScaledY / rho1;
+    finalState[ 2 ] = finalScaledZ / rho1;
+    finalState[ 3 ] = k2 * ( rho1 * finalScaledXPrime + e * sin1 * finalScaledX );
+    finalState[ 4 ] = k2 * ( rho1 * finalScaledYPrime + e * sin1 * finalScaledY );
+    finalState[ 5 ] = k2 * ( rho1 * finalScaledZPrime + e * sin1 * finalScaledZ );
+}
+
+//! Construct J2-perturbed nonlinear propagator.
+J2NonlinearPropagator::J2NonlinearPropagator( const Real aGravitationalParameter,
+                                              const Real aSemiMajorAxis,
+                                              const PropagatorSettings& someSettings )
+    : gravitationalParameter( aGravitationalParameter ),
+      settings( someSettings ),
+      initialTargetState( ),
+      predictionModel( aGravitationalParameter,
+                       aSemiMajorAxis,
+                       someSettings.targetEccentricity,
+                       someSettings.targetInitialTrueAnomaly ),
+      integrationState( ),
+      hillThrustAcceleration( ),
+      hillFrameRotation( ),
+      hillFrameAngularVelocity( ),
+      stages( ),
+      intermediateState( ),
+      candidateState( ),
+      adaptiveStepSize( someSettings.stepSize ),
+      numberOfIntegrationSteps( 0 )
+{
+    // Compute target state from Keplerian elements, with right ascension of ascending node and
+    // argument of perigee equal to zero.
+    const Real eccentricity = settings.targetEccentricity;
+    const Real trueAnomaly = settings.targetInitialTrueAnomaly;
+    const Real semiLatusRectum = aSemiMajorAxis * ( 1.0 - eccentricity * eccentricity );
+    const Real radius = semiLatusRectum / ( 1.0 + eccentricity * std::cos( trueAnomaly ) );
+    const Real velocityScale = std::sqrt( aGravitationalParameter / semiLatusRectum );
+
+    const Real perifocalPosition[ 2 ] = { radius * std::cos( trueAnomaly ),
+                                          radius * std::sin( trueAnomaly ) };
+    const Real perifocalVelocity[ 2 ] = { -velocityScale * std::sin( trueAnomaly ),
+                                          velocityScale * ( eccentricity
+                                                            + std::cos( trueAnomaly ) ) };
+
+    const Real cosInclination = std::cos( settings.targetInclination );
+    const Real sinInclination = std::sin( settings.targetInclination );
+    initialTargetState[ 0 ] = perifocalPosition[ 0 ];
+    initialTargetState[ 1 ] = perifocalPosition[ 1 ] * cosInclination;
+    initialTargetState[ 2 ] = perifocalPosition[ 1 ] * sinInclination;
+    initialTargetState[ 3 ] = perifocalVelocity[ 0 ];
+    initialTargetState[ 4 ] = perifocalVelocity[ 1 ] * cosInclination;
+    initialTargetState[ 5 ] = perifocalVelocity[ 1 ] * sinInclination;
+
+    reset( );
+}
+
+//! Reset propagator to start of simulation.
+void J2NonlinearPropagator::reset( )
+{
+    std::copy( initialTargetState.begin( ), initialTargetState.end( ), integrationState.begin( ) );
+    predictionModel.reset( );
+    adaptiveStepSize = settings.stepSize;
+    numberOfIntegrationSteps = 0;
+}
+
+//! Predict end state of ballistic trajectory.
+void J2NonlinearPropagator::predictBallisticState( const Real propagationTime,
+                                                   const Vector6& state,
+                                                   Vector6& finalState ) const
+{
+    predictionModel.predictBallisticState( propagationTime, state, finalState );
+}
+
+//! Propagate state under constant thrust acceleration.
+void J2NonlinearPropagator::propagate( const Real propagationTime,
+                                       const Vector6& state,
+                                       const Vector3& thrustAcceleration,
+                                       Vector6& finalState )
+{
+    // Transform relative state from Hill frame to inertial frame, using
+    // v_inertial = R^T ( rho_dot + omega x rho ).
+    computeHillFrame( );
+
+    Real transportVelocity[ 3 ];
+    computeCrossProduct( &hillFrameAngularVelocity[ 0 ], &state[ 0 ], transportVelocity );
+    for ( int i = 0; i < 3; ++i )
+    {
+        integrationState[ 6 + i ] = 0.0;
+        integrationState[ 9 + i ] = 0.0;
+        for ( int j = 0; j < 3; ++j )
+        {
+            integrationState[ 6 + i ] += hillFrameRotation[ j ][ i ] * state[ j ];
+            integrationState[ 9 + i ]
+                += hillFrameRotation[ j ][ i ] * ( state[ 3 + j ] + transportVelocity[ j ] );
+        }
+    }
+
+    hillThrustAcceleration = thrustAcceleration;
+    if ( settings.integratorType == rungeKutta4Integrator )
+    {
+        integrateRungeKutta4( propagationTime );
+    }
+    else
+    {
+        integrateDormandPrince45( propagationTime );
+    }
+
+    // Transform relative state back to Hill frame of target at end of propagation, using
+    // rho_dot = R v_inertial - omega x rho.
+    computeHillFrame( );
+
+    for ( int i = 0; i < 3; ++i )
+    {
+        finalState[ i ] = 0.0;
+        finalState[ 3 + i ] = 0.0;
+        for ( int j = 0; j < 3; ++j )
+        {
+            finalState[ i ] += hillFrameRotation[ i ][ j ] * integrationState[ 6 + j ];
+            finalState[ 3 + i ] += hillFrameRotation[ i ][ j ] * integrationState[ 9 + j ];
+        }
+    }
+    computeCrossProduct( &hillFrameAngularVelocity[ 0 ], &finalState[ 0 ], transportVelocity );
+    for ( int i = 0; i < 3; ++i )
+    {
+        finalState[ 3 + i ] -= transportVelocity[ i ];
+    }
+
+    predictionModel.advance( propagationTime );
+}
+
+//! Get internal state of propagator.
+std::vector< Real > J2NonlinearPropagator::getInternalState( ) const
+{
+    std::vector< Real > internalState( integrationState.begin( ), integrationState.begin( ) + 6 );
+    internalState.push_back( adaptiveStepSize );
+    internalState.push_back( static_cast< Real >( numberOfIntegrationSteps ) );
+    internalState.push_back( predictionModel.getInternalState( )[ 0 ] );
+    return internalState;
+}
+
+//! Set internal state of propagator.
+void J2NonlinearPropagator::setInternalState( const std::vector< Real >& internalState )
+{
+    checkInternalStateSize( internalState, 9 );
+    std::copy( internalState.begin( ), internalState.begin( ) + 6, integrationState.begin( ) );
+    adaptiveStepSize = internalState[ 6 ];
+    numberOfIntegrationSteps = static_cast< std::size_t >( internalState[ 7 ] );
+    predictionModel.setInternalState( std::vector< Real >( 1, internalState[ 8 ] ) );
+}
+
+//! Compute Hill frame of target.
+void J2NonlinearPropagator::computeHillFrame( )
+{
+    const Real* position = &integrationState[ 0 ];
+    Real radius = 0.0;
+    Real angularMomentumNorm = 0.0;
+    computeHillFrameAxes(
+        position, &integrationState[ 3 ], hillFrameRotation, radius, angularMomentumNorm );
+
+    // The orbital plane rotates about the radial direction due to the out-of-plane component of
+    // the perturbing acceleration (the central acceleration has no out-of-plane component).
+    Real gravitationalAcceleration[ 3 ];
+    computeGravitationalAcceleration( position, gravitationalAcceleration );
+    const Real outOfPlaneAcceleration
+        = gravitationalAcceleration[ 0 ] * hillFrameRotation[ 2 ][ 0 ]
+          + gravitationalAcceleration[ 1 ] * hillFrameRotation[ 2 ][ 1 ]
+          + gravitationalAcceleration[ 2 ] * hillFrameRotation[ 2 ][ 2 ];
+
+    hillFrameAngularVelocity[ 0 ] = radius * outOfPlaneAcceleration / angularMomentumNorm;
+    hillFrameAngularVelocity[ 1 ] = 0.0;
+    hillFrameAngularVelocity[ 2 ] = angularMomentumNorm / ( radius * radius );
+}
+
+//! Compute gravitational acceleration.
+void J2NonlinearPropagator::computeGravitationalAcceleration( const Real* position,
+                                                              Real* acceleration ) const
+{
+    const Real radiusSquared = position[ 0 ] * position[ 0 ]
+                               + position[ 1 ] * position[ 1 ]
+                               + position[ 2 ] * position[ 2 ];
+    const Real radius = std::sqrt( radiusSquared );
+    const Real centralFactor = -gravitationalParameter / ( radiusSquared * radius );
+    const Real j2Factor = -1.5 * settings.earthJ2 * gravitationalParameter
+                          * settings.earthEquatorialRadius * settings.earthEquatorialRadius
+                          / ( radiusSquared * radiusSquared * radius );
+    const Real zRatio = 5.0 * position[ 2 ] * position[ 2 ] / radiusSquared;
+
+    acceleration[ 0 ] = ( centralFactor + j2Factor * ( 1.0 - zRatio ) ) * position[ 0 ];
+    acceleration[ 1 ] = ( centralFactor + j2Factor * ( 1.0 - zRatio ) ) * position[ 1 ];
+    acceleration[ 2 ] = ( centralFactor + j2Factor * ( 3.0 - zRatio ) ) * position[ 2 ];
+}
+
+//! Compute state derivative.
+void J2NonlinearPropagator::computeStateDerivative( const IntegrationState& integrationState,
+                                                    IntegrationState& stateDerivative ) const
+{
+    // The chaser state is integrated relative to the target, such that the integrator error
+    // control acts on the relative motion directly.
+    Real chaserPosition[ 3 ];
+    for ( int i = 0; i < 3; ++i )
+    {
+        stateDerivative[ i ] = integrationState[ 3 + i ];
+        stateDerivative[ 6 + i ] = integrationState[ 9 + i ];
+        chaserPosition[ i ] = integrationState[ i ] + integrationState[ 6 + i ];
+    }
+
+    // The thrust acceleration is constant in the Hill frame, which rotates with the target.
+    std::array< Vector3, 3 > rotation;
+    Real radius = 0.0;
+    Real angularMomentum = 0.0;
+    computeHillFrameAxes(
+        &integrationState[ 0 ], &integrationState[ 3 ], rotation, radius, angularMomentum );
+
+    Real chaserAcceleration[ 3 ];
+    computeGravitationalAcceleration( &integrationState[ 0 ], &stateDerivative[ 3 ] );
+    computeGravitationalAcceleration( chaserPosition, chaserAcceleration );
+    for ( int i = 0; i < 3; ++i )
+    {
+        stateDerivative[ 9 + i ] = chaserAcceleration[ i ]
+                                   - stateDerivative[ 3 + i ]
+                                   + rotation[ 0 ][ i ] * hillThrustAcceleration[ 0 ]
+                                   + rotation[ 1 ][ i ] * hillThrustAcceleration[ 1 ]
+                                   + rotation[ 2 ][ i ] * hillThrustAcceleration[ 2 ];
+    }
+}
+
+//! Integrate equations of motion with fourth-order Runge-Kutta integrator.
+void J2NonlinearPropagator::integrateRungeKutta4( const Real propagationTime )
+{
+    const int numberOfSteps
+        = std::max( 1, static_cast< int >( std::ceil( propagationTime / settings.stepSize ) ) );
+    const Real stepSize = propagationTime / numberOfSteps;
+    const std::size_t stateSize = integrationState.size( );
+
+    for ( int step = 0; step < numberOfSteps; ++step )
+    {
+        computeStateDerivative( integrationState, stages[ 0 ] );
+        for ( std::size_t i = 0; i < stateSize; ++i )
+        {
+            intermediateState[ i ] = integrationState[ i ] + 0.5 * stepSize * stages[ 0 ][ i ];
+        }
+        computeStateDerivative( intermediateState, stages[ 1 ] );
+        for ( std::size_t i = 0; i < stateSize; ++i )
+        {
+            intermediateState[ i ] = integrationState[ i ] + 0.5 * stepSize * stages[ 1 ][ i ];
+        }
+        computeStateDerivative( intermediateState, stages[ 2 ] );
+        for ( std::size_t i = 0; i < stateSize; ++i )
+        {
+            intermediateState[ i ] = integrationState[ i ] + stepSize * stages[ 2 ][ i ];
+        }
+        computeStateDerivative( intermediateState, stages[ 3 ] );
+        for ( std::size_t i = 0; i < stateSize; ++i )
+        {
+            integrationState[ i ] += stepSize / 6.0 * ( stages[ 0 ][ i ]
+                                                        + 2.0 * stages[ 1 ][ i ]
+                                                        + 2.0 * stages[ 2 ][ i ]
+                                                        + stages[ 3 ][ i ] );
+        }
+        ++numberOfIntegrationSteps;
+    }
+}
+
+//! Integrate equations of motion with Dormand-Prince 5(4) integrator.
+void J2NonlinearPropagator::integrateDormandPrince45( const Real propagationTime )
+{
+    const std::size_t stateSize = integrationState.size( );
+
+    // The derivative at the end of an accepted step equals the first stage of the next step
+    // (first same as last), such that it is only evaluated once per propagation.
+    computeStateDerivative( integrationState, stages[ 0 ] );
+
+    Real remainingTime = propagationTime;
+    while ( remainingTime > 0.0 )
+    {
+        const bool isStepTruncated = !( adaptiveStepSize < remainingTime );
+        const Real stepSize = isStepTruncated ? remainingTime : adaptiveStepSize;
+
+        for ( int stage = 1; stage < 7; ++stage )
+        {
+            for ( std::size_t i = 0; i < stateSize; ++i )
+            {
+                Real increment = 0.0;
+                for ( int k = 0; k < stage; ++k )
+                {
+                    increment += dormandPrinceStageCoefficients[ stage - 1 ][ k ]
+                                 * stages[ k ][ i ];
+                }
+                intermediateState[ i ] = integrationState[ i ] + stepSize * increment;
+            }
+            computeStateDerivative( intermediateState, stages[ stage ] );
+            if ( stage == 6 )
+            {
+                candidateState = intermediateState;
+            }
+        }
+
+        // Compute root-mean-square of error estimate, scaled by the tolerance.
+        Real errorNormSquared = 0.0;
+        for ( std::size_t i = 0; i < stateSize; ++i )
+        {
+            Real errorEstimate = 0.0;
+            for ( int k = 0; k < 7; ++k )
+            {
+                errorEstimate += dormandPrinceErrorCoefficients[ k ] * stages[ k ][ i ];
+            }
+            const Real stateMagnitude = std::max( std::fabs( integrationState[ i ] ),
+                                                  std::fabs( candidateState[ i ] ) );
+            const Real errorScale = settings.tolerance * std::max( 1.0, stateMagnitude );
+            const Real scaledError = stepSize * errorEstimate / errorScale;
+            errorNormSquared += scaledError * scaledError;
+        }
+        const Real errorNorm = std::sqrt( errorNormSquared / static_cast< Real >( stateSize ) );
+
+        const Real stepSizeFactor
+            = errorNorm > 0.0
+              ? std::min( 5.0, std::max( 0.2, 0.9 * std::pow( errorNorm, -0.2 ) ) ) : 5.0;
+
+        if ( !( errorNorm > 1.0 ) )
+        {
+            integrationState = candidateState;
+            stages[ 0 ] = stages[ 6 ];
+            remainingTime -= stepSize;
+            ++numberOfIntegrationSteps;
+
+            // A step truncated to the end of the propagation does not reflect the step size that
+            // the error allows, unless the step size is increased.
+            if ( !isStepTruncated || stepSize * stepSizeFactor > adaptiveStepSize )
+            {
+                adaptiveStepSize = stepSize * stepSizeFactor;
+            }
+        }
+        else
+        {
+            adaptiveStepSize = stepSize * stepSizeFactor;
+            if ( adaptiveStepSize < 1.0e-12 * propagationTime )
+            {
+                std::cerr << "ERROR: Step size of Dormand-Prince integrator is too small to meet "
+                          << "tolerance!"
+                          << std::endl;
+                throw std::runtime_error(
+                    "Step size of Dormand-Prince integrator is too small to meet tolerance" );
+            }
+        }
+    }
+}
+
+//! Create propagator.
+std::unique_ptr< Propagator > createPropagator( const UserInput& input )
+{
+    const PropagatorSettings& settings = input.propagatorSettings;
+    if ( settings.propagatorType == yamanakaAnkersenPropagator )
+    {
+        return std::unique_ptr< Propagator >(
+            new YamanakaAnkersenPropagator( input.earthGravitationalParameter,
+                                            input.targetSemiMajorAxis,
+                                            settings.targetEccentricity,
+                                            settings.targetInitialTrueAnomaly ) );
+    }
+    else if ( settings.propagatorType == j2NonlinearPropagator )
+    {
+        return std::unique_ptr< Propagator >(
+            new J2NonlinearPropagator( input.earthGravitationalParameter,
+                                       input.targetSemiMajorAxis,
+                                       settings ) );
+    }
+
+    return std::unique_ptr< Propagator >(
+        new ClohessyWiltshirePropagator(
+            astro::computeKeplerMeanMotion( input.targetSemiMajorAxis,
+                                            input.earthGravitationalParameter ),
+            1.0 / input.thrustFrequency ) );
+}
+
+} // namespace rvdsim
@@ -0,0 +1,603 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+
+#include <astro/astro.hpp>
+
+#include "rvdsim/checkpoint.hpp"
+#include "rvdsim/guidanceKernel.hpp"
+#include "rvdsim/instrumentation.hpp"
+#include "rvdsim/propagator.hpp"
+#include "rvdsim/simulator.hpp"
+#include "rvdsim/thrustPolicy.hpp"
+#include "rvdsim/unconstrainedGuidance.hpp"
+
+namespace rvdsim
+{
+
+//! Construct simulator.
+Simulator::Simulator( const UserInput& anInput,
+                      const bool isHistoryStoredFlag,
+                      const TerminationSettings& someTerminationSettings )
+    : input( anInput ),
+      isHistoryStored( isHistoryStoredFlag ),
+      terminationSettings( someTerminationSettings ),
+      thrustAccelerationMaximum( anInput.thrustMaximum / anInput.chaserWetMass ),
+      thrustPolicy( selectThrustPolicy( anInput.thrustMode, thrustAccelerationMaximum ) ),
+      exhaustVelocity( computeExhaustVelocity( anInput.chaserSpecificImpulse ) ),
+      thrustPulseTime( 1.0 / anInput.thrustFrequency ),
+      timeGrid( anInput.startTime, anInput.endTime, thrustPulseTime ),
+      targetMeanMotion( astro::computeKeplerMeanMotion( anInput.targetSemiMajorAxis,
+                                                        anInput.earthGravitationalParameter ) ),
+      propagator( createPropagator( anInput ) ),
+      isClohessyWiltshireUsed(
+          anInput.propagatorSettings.propagatorType == clohessyWiltshirePropagator ),
+      timeToGoTransition( targetMeanMotion,
+                          timeGrid,
+                          anInput.propagatorSettings.transitionTolerance ),
+      isClosedLoopTransitionUsed(
+          isClohessyWiltshireUsed
+          && thrustPolicy == unconstrainedThrustPolicy
+          && !( timeGrid.getNumberOfSteps( ) > maximumNumberOfClosedLoopTransitions ) ),
+      closedLoopTransitions( ),
+      isCoastSkipped( isClohessyWiltshireUsed
+                      && anInput.adaptiveScheduling.isEnabled
+                      && thrustPolicy == onOffThrustPolicy ),
+      zeroThrustAcceleration( ),
+      currentStepIndex( 0 ),
+      currentTime( anInput.startTime ),
+      timeToGo( anInput.endTime - anInput.startTime ),
+      currentState( anInput.chaserInitialState ),
+      currentMass( anInput.chaserWetMass ),
+      currentThrustAccelerationMaximum( thrustAccelerationMaximum ),
+      zeroThrustEndState( ),
+      zeroEffortMiss( ),
+      zeroEffortVelocity( ),
+      thrustAcceleration( ),
+      chaserThrust( ),
+      isThrottleSaturated( false ),
+      isThrottleMax( false ),
+      totalDeltaV( 0.0 ),
+      propellantMass( 0.0 ),
+      throttleSaturationTime( 0.0 ),
+      isTerminatedEarly( false ),
+      stateSink( 0 ),
+      thrustSink( 0 ),
+      trajectorySink( 0 ),
+      outputSampler( anInput.outputSampling, anInput.startTime ),
+      checkpointFilePath( "" ),
+      checkpointStepInterval( 0 ),
+      nextCheckpointStepIndex( 0 ),
+      chaserStateHistory( ),
+      chaserThrustHistory( )
+{
+    // Compute closed-loop transitions for all thruster pulses, such that the time loop reduces to
+    // matrix-vector products for an unconstrained thruster.
+    if ( isClosedLoopTransitionUsed )
+    {
+        const std::size_t numberOfSteps = timeGrid.getNumberOfSteps( );
+        const ClohessyWiltshireStateTransition pulseTransition
+            = getClohessyWiltshireStateTransition( targetMeanMotion, thrustPulseTime );
+        closedLoopTransitions.resize( numberOfSteps );
+        Matrix36 feedbackGain;
+        for ( std::size_t stepIndex = 0; stepIndex < numberOfSteps; ++stepIndex )
+        {
+            computeUnconstrainedFeedbackGain( timeToGoTransition.update( stepIndex ),
+                                              timeGrid.getTimeToGo( stepIndex ),
+                                              feedbackGain );
+            computeClosedLoopTransition(
+                pulseTransition, feedbackGain, closedLoopTransitions[ stepIndex ] );
+        }
+    }
+
+    if ( !isHistoryStored )
+    {
+        return;
+    }
+
+    // Reserve storage for histories, such that no allocations take place during execution.
+    const std::size_t numberOfPulses = timeGrid.getNumberOfSteps( );
+    chaserStateHistory.reserve( numberOfPulses + 1 );
+    chaserThrustHistory.reserve( numberOfPulses );
+}
+
+//! Set output sinks.
+void Simulator::setOutputSinks( OutputSink* aStateSink,
+                                OutputSink* aThrustSink,
+                                OutputSink* aTrajectorySink )
+{
+    stateSink = aStateSink;
+    thrustSink = aThrustSink;
+    trajectorySink = aTrajectorySink;
+}
+
+//! Set checkpointing.
+void Simulator::setCheckpointing( const std::string& aFilePath, const std::size_t aStepInterval )
+{
+    checkpointFilePath = aFilePath;
+    checkpointStepInterval = aStepInterval;
+}
+
+//! Execute simulation.
+void Simulator::execute( )
+{
+    execute( input.chaserInitialState );
+}
+
+//! Execute simulation from given chaser initial state.
+void Simulator::execute( const Vector6& chaserInitialState )
+{
+    RVDSIM_SCOPED_TIMER( simulationPhase );
+
+    // Reset current thruster pulse, chaser epoch, state and Time-To-Go (TTG) [s].
+    currentStepIndex = 0;
+    currentTime = timeGrid.getEpoch( currentStepIndex );
+    currentState = chaserInitialState;
+    timeToGo = timeGrid.getTimeToGo( currentStepIndex );
+    currentMass = input.chaserWetMass;
+    currentThrustAccelerationMaximum = input.thrustMaximum / currentMass;
+    isThrottleMax = false;
+    totalDeltaV = 0.0;
+    propellantMass = 0.0;
+    throttleSaturationTime = 0.0;
+    isTerminatedEarly = false;
+    propagator->reset( );
+
+    chaserStateHistory.clear( );
+    chaserThrustHistory.clear( );
+
+    if ( isHistoryStored )
+    {
+        chaserStateHistory.push_back( currentTime, currentState );
+    }
+
+    outputSampler.reset( );
+
+    executeTimeLoop( );
+}
+
+//! Resume simulation from checkpoint.
+void Simulator::resume( const SimulatorCheckpoint& checkpoint )
+{
+    RVDSIM_SCOPED_TIMER( simulationPhase );
+
+    if ( checkpoint.startTime != input.startTime
+         || checkpoint.endTime != input.endTime
+         || checkpoint.thrustPulseTime != thrustPulseTime
+         || checkpoint.thrustMode != input.thrustMode
+         || checkpoint.thrustMaximum != input.thrustMaximum
+         || checkpoint.chaserWetMass != input.chaserWetMass
+         || checkpoint.targetSemiMajorAxis != input.targetSemiMajorAxis
+         || checkpoint.propagatorType != input.propagatorSettings.propagatorType )
+    {
+        std::cerr << "ERROR: Checkpoint does not match simulation settings!" << std::endl;
+        throw std::runtime_error( "Checkpoint does not match simulation settings" );
+    }
+
+    // Restore current thruster pulse, chaser epoch, state and Time-To-Go (TTG) [s], together with
+    // the totals accumulated up to the checkpoint.
+    currentStepIndex = static_cast< std::size_t >( checkpoint.stepIndex );
+    currentTime = timeGrid.getEpoch( currentStepIndex );
+    currentState = checkpoint.currentState;
+    timeToGo = timeGrid.getTimeToGo( currentStepIndex );
+    currentMass = checkpoint.chaserMass;
+    currentThrustAccelerationMaximum = input.thrustMaximum / currentMass;
+    isThrottleMax = checkpoint.isThrottleMax;
+    totalDeltaV = checkpoint.totalDeltaV;
+    propellantMass = checkpoint.propellantMass;
+    throttleSaturationTime = checkpoint.throttleSaturationTime;
+    isTerminatedEarly = false;
+    propagator->setInternalState( checkpoint.propagatorState );
+
+    chaserStateHistory.clear( );
+    chaserThrustHistory.clear( );
+
+    if ( isHistoryStored )
+    {
+        chaserStateHistory.push_back( currentTime, currentState );
+    }
+
+    outputSampler.setState( checkpoint.outputSamplerState );
+
+    executeTimeLoop( );
+}
+
+//! Create checkpoint of current state of simulation.
+SimulatorCheckpoint Simulator::createCheckpoint( )
+{
+    SimulatorCheckpoint checkpoint;
+    checkpoint.startTime = input.startTime;
+    checkpoint.endTime = input.endTime;
+    checkpoint.thrustPulseTime = thrustPulseTime;
+    checkpoint.thrustMode = input.thrustMode;
+    checkpoint.thrustMaximum = input.thrustMaximum;
+    checkpoint.chaserWetMass = input.chaserWetMass;
+    checkpoint.targetSemiMajorAxis = input.targetSemiMajorAxis;
+    checkpoint.propagatorType = input.propagatorSettings.propagatorType;
+    checkpoint.stepIndex = currentStepIndex;
+    checkpoint.currentTime = currentTime;
+    checkpoint.timeToGo = timeToGo;
+    checkpoint.currentState = currentState;
+    checkpoint.chaserMass = currentMass;
+    checkpoint.isThrottleMax = isThrottleMax;
+    checkpoint.totalDeltaV = totalDeltaV;
+    checkpoint.propellantMass = propellantMass;
+    checkpoint.throttleSaturationTime = throttleSaturationTime;
+    checkpoint.outputSamplerState = outputSampler.getState( );
+    checkpoint.propagatorState = propagator->getInternalState( );
+
+    // Synchronise output sinks, such that all rows up to the checkpoint are stored on disk.
+    const OutputSinkPosition noPosition = { 0, 0 };
+    checkpoint.stateSinkPosition = stateSink != 0 ? stateSink->synchronize( ) : noPosition;
+    checkpoint.thrustSinkPosition = thrustSink != 0 ? thrustSink->synchronize( ) : noPosition;
+    checkpoint.trajectorySinkPosition
+        = trajectorySink != 0 ? trajectorySink->synchronize( ) : noPosition;
+
+    return checkpoint;
+}
+
+//! Execute time loop from current state until end of simulation.
+void Simulator::executeTimeLoop( )
+{
+    switch ( thrustPolicy )
+    {
+        case noThrustPolicy:
+        {
+            executePolicyTimeLoop< NoThrustPolicy >( );
+            break;
+        }
+
+        case unconstrainedThrustPolicy:
+        {
+            executePolicyTimeLoop< UnconstrainedThrustPolicy >( );
+            break;
+        }
+
+        case throttleThrustPolicy:
+        {
+            executePolicyTimeLoop< ThrottleThrustPolicy >( );
+            break;
+        }
+
+        case onOffThrustPolicy:
+        {
+            executePolicyTimeLoop< OnOffThrustPolicy >( );
+            break;
+        }
+    }
+}
+
+//! Execute time loop specialised for thrust policy.
+template< typename ThrustPolicy >
+void Simulator::executePolicyTimeLoop( )
+{
+    const bool isOutputStreamed = stateSink != 0 || thrustSink != 0 || trajectorySink != 0;
+    const bool isCheckpointWritten = !checkpointFilePath.empty( ) && checkpointStepInterval > 0;
+    nextCheckpointStepIndex = currentStepIndex + checkpointStepInterval;
+
+    const std::size_t numberOfSteps = timeGrid.getNumberOfSteps( );
+    while ( currentStepIndex < numberOfSteps )
+    {
+        // Compute control action using ZEM/ZEV feedback law.
+        const Real thrustAccelerationNorm
+            = computeThrustAcceleration< ThrustPolicy >( currentStepIndex );
+
+        // Accumulate delta-V applied and time spent at maximum thrust during thruster pulse.
+        totalDeltaV += thrustAccelerationNorm * thrustPulseTime;
+        if ( isThrottleSaturated )
+        {
+            throttleSaturationTime += thrustPulseTime;
+        }
+
+        for ( int i = 0; i < 3; ++i )
+        {
+            chaserThrust[ i ] = thrustAcceleration[ i ] * currentMass;
+        }
+
+        // Deplete chaser mass by propellant consumed during thruster pulse, such that the maximum
+        // thrust acceleration available for the next pulse increases.
+        if ( exhaustVelocity > 0.0 && thrustAccelerationNorm > 0.0 )
+        {
+            const Real depletedMass = computeDepletedMass(
+                currentMass, thrustAccelerationNorm, thrustPulseTime, exhaustVelocity );
+            propellantMass += currentMass - depletedMass;
+            currentMass = depletedMass;
+            currentThrustAccelerationMaximum = input.thrustMaximum / currentMass;
+        }
+
+        // Add chaser thrust to history.
+        if ( isHistoryStored )
+        {
+            chaserThrustHistory.push_back( currentTime, chaserThrust );
+        }
+
+        // Stream current state and thrust to output sinks, if current epoch is sampled.
+        if ( isOutputStreamed
+             && outputSampler.isSampled( currentStepIndex,
+                                         currentTime,
+                                         thrustAccelerationNorm > 0.0,
+                                         isThrottleSaturated,
+                                         !( getFinalDistanceToTarget( )
+                                            > input.arrivalDistanceTolerance ) ) )
+        {
+            writeOutputRows( chaserThrust );
+        }
+
+        // Predict number of thruster pulses during which thruster remains off, if coast arcs are
+        // skipped.
+        const std::size_t numberOfPulses
+            = ( ThrustPolicy::isSwitched && isCoastSkipped && !( thrustAccelerationNorm > 0.0 ) )
+              ? computeCoastPulseCount( ) : 1;
+
+        // Propagate dynamics under control action and update current state to state at end of
+        // thruster pulse. Coast arcs spanning multiple thruster pulses are propagated in a single
+        // step. For an unconstrained thruster, the precomputed closed-loop transition is applied.
+        {
+            RVDSIM_SCOPED_TIMER( propagationPhase );
+            if ( !ThrustPolicy::isConstrained && isClosedLoopTransitionUsed )
+            {
+                propagateClosedLoop(
+                    closedLoopTransitions[ currentStepIndex ], currentState, currentState );
+            }
+            else
+            {
+                propagator->propagate( static_cast< Real >( numberOfPulses ) * thrustPulseTime,
+                                       currentState,
+                                       thrustAcceleration,
+                                       currentState );
+            }
+            RVDSIM_INCREMENT_COUNTER( propagationCounter, 1 );
+        }
+
+        // Update current time and Time-To-Go to end of thruster pulse.
+        currentStepIndex += numberOfPulses;
+        currentTime = timeGrid.getEpoch( currentStepIndex );
+        timeToGo = timeGrid.getTimeToGo( currentStepIndex );
+
+        // Add current time and state to chaser history.
+        if ( isHistoryStored )
+        {
+            chaserStateHistory.push_back( currentTime, currentState );
+        }
+
+        // Terminate simulation early if outcome is already known.
+        if ( isTerminationConditionMet( ) )
+        {
+            isTerminatedEarly = currentStepIndex < numberOfSteps;
+            break;
+        }
+
+        // Write checkpoint, from which the remainder of the simulation can be resumed.
+        if ( isCheckpointWritten
+             && currentStepIndex < numberOfSteps
+             && !( currentStepIndex < nextCheckpointStepIndex ) )
+        {
+            writeCheckpoint( checkpointFilePath, createCheckpoint( ) );
+            nextCheckpointStepIndex = currentStepIndex + checkpointStepInterval;
+        }
+    }
+
+    // Stream final epoch to output sinks, after which no thrust is applied.
+    RVDSIM_SCOPED_TIMER( outputPhase );
+    if ( stateSink != 0 )
+    {
+        writeStateRow( );
+    }
+
+    if ( trajectorySink != 0 )
+    {
+        const Real noThrust = std::numeric_limits< Real >::quiet_NaN( );
+        const Vector3 finalThrust = { { noThrust, noThrust, noThrust } };
+        writeTrajectoryRow( finalThrust );
+    }
+}
+
+//! Write current time, state and thrust to output sinks.
+void Simulator::writeOutputRows( const Vector3& thrust )
+{
+    RVDSIM_SCOPED_TIMER( outputPhase );
+
+    if ( stateSink != 0 )
+    {
+        writeStateRow( );
+    }
+
+    if ( thrustSink != 0 )
+    {
+        const Real thrustRow[ 4 ] = { currentTime, thrust[ 0 ], thrust[ 1 ], thrust[ 2 ] };
+        thrustSink->writeRow( thrustRow );
+    }
+
+    if ( trajectorySink != 0 )
+    {
+        writeTrajectoryRow( thrust );
+    }
+}
+
+//! Write current time and state to state output sink.
+void Simulator::writeStateRow( )
+{
+    const Real stateRow[ 7 ] = { currentTime,
+                                 currentState[ 0 ],
+                                 currentState[ 1 ],
+                                 currentState[ 2 ],
+                                 currentState[ 3 ],
+                                 currentState[ 4 ],
+                                 currentState[ 5 ] };
+    stateSink->writeRow( stateRow );
+}
+
+//! Write current time, state and thrust to trajectory output sink.
+void Simulator::writeTrajectoryRow( const Vector3& thrust )
+{
+    const Real trajectoryRow[ 10 ] = { currentTime,
+                                       currentState[ 0 ],
+                                       currentState[ 1 ],
+                                       currentState[ 2 ],
+                                       currentState[ 3 ],
+                                       currentState[ 4 ],
+                                       currentState[ 5 ],
+                                       thrust[ 0 ],
+                                       thrust[ 1 ],
+                                       thrust[ 2 ] };
+    trajectorySink->writeRow( trajectoryRow );
+}
+
+//! Get final distance to target.
+Real Simulator::getFinalDistanceToTarget( ) const
+{
+    return std::sqrt( currentState[ astro::xPositionIndex ] * currentState[ astro::xPositionIndex ]
+                      + currentState[ astro::yPositionIndex ]
+                        * currentState[ astro::yPositionIndex ]
+                      + currentState[ astro::zPositionIndex ]
+                        * currentState[ astro::zPositionIndex ] );
+}
+
+//! Check if target was reached.
+bool Simulator::isTargetReached( ) const
+{
+    return !( getFinalDistanceToTarget( ) > input.arrivalDistanceTolerance );
+}
+
+//! Get summary of simulation.
+SimulationSummary Simulator::getSummary( ) const
+{
+    SimulationSummary summary;
+    summary.finalDistanceToTarget = getFinalDistanceToTarget( );
+    summary.isTargetReached = isTargetReached( );
+    summary.totalDeltaV = totalDeltaV;
+    summary.propellantMass = propellantMass;
+    summary.isThrottleMax = isThrottleMax;
+    summary.throttleSaturationTime = throttleSaturationTime;
+    summary.terminationTime = currentTime;
+    summary.isTerminatedEarly = isTerminatedEarly;
+    summary.isRedrawn = false;
+    return summary;
+}
+
+//! Check if early termination condition is met.
+bool Simulator::isTerminationConditionMet( ) const
+{
+    if ( !terminationSettings.isArrivalTerminationEnabled
+         && !( terminationSettings.maximumDistance > 0.0 ) )
+    {
+        return false;
+    }
+
+    const Real distanceToTarget = getFinalDistanceToTarget( );
+
+    return ( terminationSettings.isArrivalTerminationEnabled
+             && !( distanceToTarget > input.arrivalDistanceTolerance ) )
+           || ( terminationSettings.maximumDistance > 0.0
+                && distanceToTarget > terminationSettings.maximumDistance );
+}
+
+//! Compute number of thruster pulses during which thruster remains off.
+std::size_t Simulator::computeCoastPulseCount( ) const
+{
+    // The ZEM and ZEV are constant along the ballistic trajectory, such that the thrust
+    // acceleration commanded at future thruster pulses only depends on the Time-To-Go.
+    const Real switchingThreshold
+        = ( 1.0 - input.adaptiveScheduling.tolerance )
+          * OnOffThrustPolicy::computeSwitchingThreshold( currentThrustAccelerationMaximum );
+    const Real switchingThresholdSquared = switchingThreshold * switchingThreshold;
+
+    const std::size_t numberOfSteps = timeGrid.getNumberOfSteps( );
+    std::size_t numberOfPulses = 1;
+    while ( currentStepIndex + numberOfPulses < numberOfSteps )
+    {
+        const Real predictedTimeToGo = timeGrid.getTimeToGo( currentStepIndex + numberOfPulses );
+        const Real positionGain = 6.0 / ( predictedTimeToGo * predictedTimeToGo );
+        const Real velocityGain = 2.0 / predictedTimeToGo;
+
+        Real thrustAccelerationNormSquared = 0.0;
+        for ( int i = 0; i < 3; ++i )
+        {
+            const Real thrustAccelerationComponent
+                = positionGain * zeroEffortMiss[ i ] - velocityGain * zeroEffortVelocity[ i ];
+            thrustAccelerationNormSquared
+                += thrustAccelerationComponent * thrustAccelerationComponent;
+        }
+
+        if ( thrustAccelerationNormSquared > switchingThresholdSquared )
+        {
+            break;
+        }
+
+        ++numberOfPulses;
+    }
+
+    return numberOfPulses;
+}
+
+//! Compute thrust acceleration using ZEM/ZEV feedback law.
+template< typename ThrustPolicy >
+Real Simulator::computeThrustAcceleration( const std::size_t stepIndex )
+{
+    isThrottleSaturated = false;
+
+    if ( !ThrustPolicy::isGuidanceEvaluated )
+    {
+        thrustAcceleration = zeroThrustAcceleration;
+        return 0.0;
+    }
+
+    RVDSIM_SCOPED_TIMER( guidancePhase );
+    RVDSIM_INCREMENT_COUNTER( guidanceCallCounter, 1 );
+
+    // Apply precomputed feedback gain if thruster is unconstrained.
+    if ( !ThrustPolicy::isConstrained && isClosedLoopTransitionUsed )
+    {
+        computeUnconstrainedThrustAcceleration(
+            closedLoopTransitions[ stepIndex ].feedbackGain, currentState, thrustAcceleration );
+        return std::sqrt( thrustAcceleration[ 0 ] * thrustAcceleration[ 0 ]
+                          + thrustAcceleration[ 1 ] * thrustAcceleration[ 1 ]
+                          + thrustAcceleration[ 2 ] * thrustAcceleration[ 2 ] );
+    }
+
+    // Compute end state resulting from ballistic trajectory, ZEM/ZEV, commanded thrust
+    // acceleration and its norm, and constrain thrust acceleration to thruster capability, in a
+    // single pass.
+    Real thrustAccelerationNorm = 0.0;
+    if ( isClohessyWiltshireUsed )
+    {
+        thrustAccelerationNorm
+            = evaluateGuidanceKernel< ThrustPolicy >( timeToGoTransition.update( stepIndex ),
+                                                      timeToGo,
+                                                      currentState,
+                                                      currentThrustAccelerationMaximum,
+                                                      zeroEffortMiss,
+                                                      zeroEffortVelocity,
+                                                      thrustAcceleration,
+                                                      isThrottleSaturated );
+    }
+    else
+    {
+        propagator->predictBallisticState( timeToGo, currentState, zeroThrustEndState );
+        thrustAccelerationNorm
+            = evaluateGuidanceKernel< ThrustPolicy >( zeroThrustEndState,
+                                                      timeToGo,
+                                                      currentThrustAccelerationMaximum,
+                                                      zeroEffortMiss,
+                                                      zeroEffortVelocity,
+                                                      thrustAcceleration,
+                                                      isThrottleSaturated );
+    }
+    if ( isThrottleSaturated )
+    {
+        isThrottleMax = true;
+        RVDSIM_INCREMENT_COUNTER( throttleSaturationCounter, 1 );
+    }
+
+    return thrustAccelerationNorm;
+}
+
+} // namespace rvdsim
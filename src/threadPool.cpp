@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include "rvdsim/threadPool.hpp"
+
+namespace rvdsim
+{
+
+//! Construct thread pool.
+ThreadPool::ThreadPool( const std::size_t aNumberOfThreads )
+    : queues( ),
+      workers( ),
+      stateMutex( ),
+      taskQueued( ),
+      tasksCompleted( ),
+      numberOfQueuedTasks( 0 ),
+      numberOfPendingTasks( 0 ),
+      nextQueueIndex( 0 ),
+      isStopping( false )
+{
+    std::size_t numberOfThreads = aNumberOfThreads;
+    if ( numberOfThreads == 0 )
+    {
+        numberOfThreads = std::max< std::size_t >( std::thread::hardware_concurrency( ), 1 );
+    }
+
+    for ( std::size_t i = 0; i < numberOfThreads; ++i )
+    {
+        queues.push_back( std::unique_ptr< TaskQueue >( new TaskQueue ) );
+    }
+
+    for ( std::size_t i = 0; i < numberOfThreads; ++i )
+    {
+        workers.push_back( std::thread( &ThreadPool::executeWorker, this, i ) );
+    }
+}
+
+//! Destruct thread pool.
+ThreadPool::~ThreadPool( )
+{
+    wait( );
+
+    {
+        std::lock_guard< std::mutex > lock( stateMutex );
+        isStopping = true;
+    }
+    taskQueued.notify_all( );
+
+    for ( std::size_t i = 0; i < workers.size( ); ++i )
+    {
+        workers[ i ].join( );
+    }
+}
+
+//! Submit task.
+void ThreadPool::submit( const Task& task )
+{
+    std::size_t queueIndex = 0;
+    {
+        std::lock_guard< std::mutex > lock( stateMutex );
+        queueIndex = nextQueueIndex;
+        nextQueueIndex = ( nextQueueIndex + 1 ) % queues.size( );
+        ++numberOfPendingTasks;
+    }
+
+    {
+        std::lock_guard< std::mutex > lock( queues[ queueIndex ]->mutex );
+        queues[ queueIndex ]->tasks.push_back( task );
+    }
+
+    // The task is only announced once it is in a queue, such that a worker that claims it is
+    // guaranteed to find a task in one of the queues.
+    {
+        std::lock_guard< std::mutex > lock( stateMutex );
+        ++numberOfQueuedTasks;
+    }
+    taskQueued.notify_one( );
+}
+
+//! Wait for completion of all tasks.
+void ThreadPool::wait( )
+{
+    std::unique_lock< std::mutex > lock( stateMutex );
+    tasksCompleted.wait( lock, [ this ]( ) { return numberOfPendingTasks == 0; } );
+}
+
+//! Execute worker loop.
+void ThreadPool::executeWorker( const std::size_t workerIndex )
+{
+    Task task;
+    while ( true )
+    {
+        {
+            std::unique_lock< std::mutex > lock( stateMutex );
+            taskQueued.wait( lock, [ this ]( ) { return isStopping || numberOfQueuedTasks > 0; } );
+            if ( numberOfQueuedTasks == 0 )
+            {
+                return;
+            }
+
+            // Claim one of the queued tasks and take it under the same lock. Since tasks are only
+            // announced once they are in a queue, and only taken under this lock, the queues hold
+            // at least as many tasks as are announced, such that the task is always found.
+            --numberOfQueuedTasks;
+            takeTask( workerIndex, task );
+        }
+
+        task( );
+        task = Task( );
+
+        {
+            std::lock_guard< std::mutex > lock( stateMutex );
+            --numberOfPendingTasks;
+            if ( numberOfPendingTasks == 0 )
+            {
+                tasksCompleted.notify_all( );
+            }
+        }
+    }
+}
+
+//! Take task from queues.
+void ThreadPool::takeTask( const std::size_t workerIndex, Task& task )
+{
+    {
+        TaskQueue& ownQueue = *queues[ workerIndex ];
+        std::lock_guard< std::mutex > lock( ownQueue.mutex );
+        if ( !ownQueue.tasks.empty( ) )
+        {
+            task = ownQueue.tasks.back( );
+            ownQueue.tasks.pop_back( );
+            return;
+        }
+    }
+
+    for ( std::size_t i = 1; i < queues.size( ); ++i )
+    {
+        TaskQueue& otherQueue = *queues[ ( workerIndex + i ) % queues.size( ) ];
+        std::lock_guard< std::mutex > lock( otherQueue.mutex );
+        if ( !otherQueue.tasks.empty( ) )
+        {
+            task = otherQueue.tasks.front( );
+            otherQueue.tasks.pop_front( );
+            return;
+        }
+    }
+}
+
+} // namespace rvdsim
@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include "rvdsim/thrustPolicy.hpp"
+
+namespace rvdsim
+{
+
+//! Select thrust policy.
+ThrustPolicyType selectThrustPolicy( const ThrustMode thrustMode,
+                                     const Real thrustAccelerationMaximum )
+{
+    if ( thrustMode == off )
+    {
+        return noThrustPolicy;
+    }
+
+    if ( !( thrustAccelerationMaximum > 0.0 ) )
+    {
+        return unconstrainedThrustPolicy;
+    }
+
+    return thrustMode == onOff ? onOffThrustPolicy : throttleThrustPolicy;
+}
+
+} // namespace rvdsim
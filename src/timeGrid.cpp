@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cmath>
+
+#include "rvdsim/timeGrid.hpp"
+
+namespace rvdsim
+{
+
+//! Compute number of thruster pulses in simulation.
+std::size_t computeNumberOfThrustPulses( const Real duration, const Real thrustPulseTime )
+{
+    if ( !( duration > 0.0 ) )
+    {
+        return 0;
+    }
+
+    // Discard rounding remainder of a duration that is an integer multiple of the pulse length,
+    // e.g., 1000 s at 1.3 Hz yields 1300.0000000000002 pulses.
+    const Real numberOfPulses = duration / thrustPulseTime;
+    return static_cast< std::size_t >(
+        std::ceil( numberOfPulses - timeGridRelativeTolerance * numberOfPulses ) );
+}
+
+//! Construct time grid.
+TimeGrid::TimeGrid( const Real aStartTime, const Real anEndTime, const Real aThrustPulseTime )
+    : startTime( aStartTime ),
+      duration( anEndTime - aStartTime ),
+      thrustPulseTime( aThrustPulseTime ),
+      numberOfSteps( computeNumberOfThrustPulses( duration, thrustPulseTime ) )
+{ }
+
+} // namespace rvdsim
@@ -4,17 +4,44 @@
  * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
  */
 
+#include <cmath>
+#include <cstddef>
 #include <iostream>
 #include <limits>
+#include <stdexcept>
+#include <string>
 
+#include "rvdsim/instrumentation.hpp"
 #include "rvdsim/userInput.hpp"
 
 namespace rvdsim
 {
 
+namespace
+{
+
+//! Check that value of user input satisfies rule.
+/*!
+ * @param[in] isSatisfied Flag indicating if rule is satisfied
+ * @param[in] rule        Description of rule, used for error message
+ */
+void checkRule( const bool isSatisfied, const std::string& rule )
+{
+    if ( !isSatisfied )
+    {
+        std::cerr << "ERROR: " << rule << "!" << std::endl;
+        throw std::invalid_argument( rule );
+    }
+}
+
+} // namespace
+
 //! Check input parameters.
-UserInput checkInput( const rapidjson::Document& config )
+UserInput checkInput( const rapidjson::Document& config,
+                      std::ostream& outputStream )
 {
+    RVDSIM_SCOPED_TIMER( inputCheckPhase );
+
     // Search for propagation settings in config.
     rapidjson::Value::ConstMemberIterator propagationSettingsIterator
         = config.FindMember( "propagation_settings" );
@@ -23,13 +50,14 @@ UserInput checkInput( const rapidjson::Document& config )
         std::cerr << "ERROR: Configuration option \"propagation_settings\" could not be found in "
                   << "JSON input!"
                   << std::endl;
-        throw;
+        throw std::invalid_argument(
+            "Configuration option \"propagation_settings\" could not be found in JSON input" );
     }
 
     const rvdsim::Real startTime = propagationSettingsIterator->value[ 0 ].GetDouble( );
-    std::cout << "Start time                    [s]             " << startTime << std::endl;
+    outputStream << "Start time                    [s]             " << startTime << std::endl;
     const rvdsim::Real endTime   = propagationSettingsIterator->value[ 1 ].GetDouble( );
-    std::cout << "End time                      [s]             " << endTime << std::endl;
+    outputStream << "End time                      [s]             " << endTime << std::endl;
 
     // Search for Earth gravitational parameter in config [m^3 s^-2].
     rapidjson::Value::ConstMemberIterator gravitationalParameterIterator
@@ -39,12 +67,14 @@ UserInput checkInput( const rapidjson::Document& config )
         std::cerr << "ERROR: Configuration option \"earth_gravitational_parameter\" could not be "
                   << "found in JSON input!"
                   << std::endl;
-        throw;
+        throw std::invalid_argument(
+            "Configuration option \"earth_gravitational_parameter\" could not be found in "
+            "JSON input" );
     }
     const rvdsim::Real earthGravitationalParameter
         = gravitationalParameterIterator->value.GetDouble( );
-    std::cout << "Earth gravitational parameter [m^3 s^-2]      "
-              << earthGravitationalParameter << std::endl;
+    outputStream << "Earth gravitational parameter [m^3 s^-2]      "
+                 << earthGravitationalParameter << std::endl;
 
     // Search for target's semi-major axis in config [m].
     rapidjson::Value::ConstMemberIterator targetSemiMajorAxisIterator
@@ -54,11 +84,12 @@ UserInput checkInput( const rapidjson::Document& config )
         std::cerr << "ERROR: Configuration option \"target_semi_major_axis\" could not be found in "
                   << "JSON input!"
                   << std::endl;
-        throw;
+        throw std::invalid_argument(
+            "Configuration option \"target_semi_major_axis\" could not be found in JSON input" );
     }
     const rvdsim::Real targetSemiMajorAxis = targetSemiMajorAxisIterator->value.GetDouble( );
-    std::cout << "Target semi-major axis        [m]             "
-              << targetSemiMajorAxis << std::endl;
+    outputStream << "Target semi-major axis        [m]             "
+                 << targetSemiMajorAxis << std::endl;
 
     // Search for chaser initial state in config.
     rapidjson::Value::ConstMemberIterator chaserInitialStateIterator
@@ -68,20 +99,21 @@ UserInput checkInput( const rapidjson::Document& config )
         std::cerr << "ERROR: Configuration option \"chaser_initial_state\" could not be found in "
                   << "JSON input!"
                   << std::endl;
-        throw;
+        throw std::invalid_argument(
+            "Configuration option \"chaser_initial_state\" could not be found in JSON input" );
     }
-    rvdsim::Vector6 chaserInitialState( 6 );
+    rvdsim::Vector6 chaserInitialState;
     for ( int i = 0; i < 6; ++i )
     {
         chaserInitialState[ i ] = chaserInitialStateIterator->value[ i ].GetDouble( );
     }
-    std::cout << "Chaser initial state          [m; m/s]        "
-              << "[";
+    outputStream << "Chaser initial state          [m; m/s]        "
+                 << "[";
     for ( int i = 0; i < 5; ++i )
     {
-        std::cout << chaserInitialState[ i ] << ", ";
+        outputStream << chaserInitialState[ i ] << ", ";
     }
-    std::cout << chaserInitialState[ 5 ] << "]" << std::endl;
+    outputStream << chaserInitialState[ 5 ] << "]" << std::endl;
 
     // Search for chaser thruster settings in config.
     rapidjson::Value::ConstMemberIterator chaserThrustSettingsIterator
@@ -91,60 +123,52 @@ UserInput checkInput( const rapidjson::Document& config )
         std::cerr << "ERROR: Configuration option \"chaser_thrust_settings\" could not be found in "
                   << "JSON input!"
                   << std::endl;
-        throw;
+        throw std::invalid_argument(
+            "Configuration option \"chaser_thrust_settings\" could not be found in JSON input" );
     }
     std::string chaserThrustModeString = chaserThrustSettingsIterator->value[ 0 ].GetString( );
     ThrustMode chaserThrustMode;
-    std::cout << "Chaser thrust mode                            ";
+    outputStream << "Chaser thrust mode                            ";
     if ( !chaserThrustModeString.compare( "off" ) )
     {
         chaserThrustMode = off;
-        std::cout << "OFF" << std::endl;
+        outputStream << "OFF" << std::endl;
     }
     else if ( !chaserThrustModeString.compare( "throttle" ) )
     {
         chaserThrustMode = throttle;
-        std::cout << "throttle" << std::endl;
+        outputStream << "throttle" << std::endl;
     }
     else if ( !chaserThrustModeString.compare( "on_off" ) )
     {
         chaserThrustMode = onOff;
-        std::cout << "ON-OFF" << std::endl;
+        outputStream << "ON-OFF" << std::endl;
     }
     else
     {
         std::cerr << "ERROR: 2nd configuration option for \"chaser_thrust_settings\" should be "
                   << "\"throttle\", \"on_off\" or \"off\"!"
                   << std::endl;
-        throw;
+        throw std::invalid_argument(
+            "2nd configuration option for \"chaser_thrust_settings\" should be \"throttle\", "
+            "\"on_off\" or \"off\"" );
     }
     const rvdsim::Real chaserThrustMaximum = chaserThrustSettingsIterator->value[ 1 ].GetDouble( );
-    std::cout << "Chaser thrust maximum         [N]             ";
-    if ( chaserThrustMaximum < 0.0 )
-    {
-        std::cout << std::endl;
-        std::cerr << "ERROR: \"chaser thrust maximum\" should be non-negative!" << std::endl;
-        throw;
-    }
-    else if ( chaserThrustMaximum < std::numeric_limits< double >::epsilon( ) )
+    outputStream << "Chaser thrust maximum         [N]             ";
+    if ( !( chaserThrustMaximum < 0.0 )
+         && chaserThrustMaximum < std::numeric_limits< double >::epsilon( ) )
     {
-        std::cout << "UNCONSTRAINED" << std::endl;
+        outputStream << "UNCONSTRAINED" << std::endl;
     }
     else
     {
-        std::cout << chaserThrustMaximum << std::endl;
+        outputStream << chaserThrustMaximum << std::endl;
     }
 
     const rvdsim::Real chaserThrustFrequency
         = chaserThrustSettingsIterator->value[ 2 ].GetDouble( );
-    if ( chaserThrustFrequency < std::numeric_limits< double >::epsilon( ) )
-    {
-        std::cout << std::endl;
-        std::cerr << "ERROR: \"chaser thrust frequency\" should be positive!" << std::endl;
-        throw;
-    }
-    std::cout << "Chaser thrust frequency       [Hz]            "
-              << chaserThrustFrequency << std::endl;
+    outputStream << "Chaser thrust frequency       [Hz]            "
+                 << chaserThrustFrequency << std::endl;
 
     // Search for chaser mass in config.
     rapidjson::Value::ConstMemberIterator chaserWetMassIterator
@@ -153,10 +177,27 @@ UserInput checkInput( const rapidjson::Document& config )
     {
         std::cerr << "ERROR: Configuration option \"chaser_wet_mass\" could not be found in JSON "
                   << "input!" << std::endl;
-        throw;
+        throw std::invalid_argument(
+            "Configuration option \"chaser_wet_mass\" could not be found in JSON input" );
     }
     const rvdsim::Real chaserWetMass = chaserWetMassIterator->value.GetDouble( );
-    std::cout << "Chaser wet mass               [kg]            " << chaserWetMass << std::endl;
+    outputStream << "Chaser wet mass               [kg]            " << chaserWetMass << std::endl;
+
+    // Search for optional chaser specific impulse in config (default: constant chaser mass).
+    rvdsim::Real chaserSpecificImpulse = 0.0;
+    rapidjson::Value::ConstMemberIterator chaserSpecificImpulseIterator
+        = config.FindMember( "chaser_specific_impulse" );
+    if ( chaserSpecificImpulseIterator != config.MemberEnd( ) )
+    {
+        chaserSpecificImpulse = chaserSpecificImpulseIterator->value.GetDouble( );
+        if ( !( chaserSpecificImpulse > 0.0 ) )
+        {
+            std::cerr << "ERROR: \"chaser_specific_impulse\" should be positive!" << std::endl;
+            throw std::invalid_argument( "\"chaser_specific_impulse\" should be positive" );
+        }
+        outputStream << "Chaser specific impulse       [s]             "
+                     << chaserSpecificImpulse << std::endl;
+    }
 
     // Search for arrival distance tolerance in config.
     rapidjson::Value::ConstMemberIterator arrivalDistanceToleranceIterator
@@ -166,12 +207,14 @@ UserInput checkInput( const rapidjson::Document& config )
         std::cerr << "ERROR: Configuration option \"arrival_distance_tolerance\" could not be "
                   << "found in JSON input!"
                   << std::endl;
-        throw;
+        throw std::invalid_argument(
+            "Configuration option \"arrival_distance_tolerance\" could not be found in JSON "
+            "input" );
     }
     const rvdsim::Real arrivalDistanceTolerance
         = arrivalDistanceToleranceIterator->value.GetDouble( );
-    std::cout << "Arrival distance tolerance    [m]             "
-              << arrivalDistanceTolerance << std::endl;
+    outputStream << "Arrival distance tolerance    [m]             "
+                 << arrivalDistanceTolerance << std::endl;
 
     // Search for output directory in config.
     rapidjson::Value::ConstMemberIterator outputDirectoryIterator
@@ -181,11 +224,12 @@ UserInput checkInput( const rapidjson::Document& config )
         std::cerr << "ERROR: Configuration option \"output_directory\" could not be found in "
                   << "JSON input!"
                   << std::endl;
-        throw;
+        throw std::invalid_argument(
+            "Configuration option \"output_directory\" could not be found in JSON input" );
     }
     const std::string outputDirectory = outputDirectoryIterator->value.GetString( );
-    std::cout << "Output directory                              "
-              << outputDirectory << std::endl;
+    outputStream << "Output directory                              "
+                 << outputDirectory << std::endl;
 
     // Search for chaser state history filename in config.
     rapidjson::Value::ConstMemberIterator chaserStateHistoryFilenameIterator
@@ -195,12 +239,14 @@ UserInput checkInput( const rapidjson::Document& config )
         std::cerr << "ERROR: Configuration option \"chaser_state_history_filename\" could not be "
                   << "found in JSON input!"
                   << std::endl;
-        throw;
+        throw std::invalid_argument(
+            "Configuration option \"chaser_state_history_filename\" could not be found in "
+            "JSON input" );
     }
     const std::string chaserStateHistoryFilename
         = chaserStateHistoryFilenameIterator->value.GetString( );
-    std::cout << "State history output file                     "
-              << chaserStateHistoryFilename << std::endl;
+    outputStream << "State history output file                     "
+                 << chaserStateHistoryFilename << std::endl;
 
     // Search for chaser thrust history filename in config.
     rapidjson::Value::ConstMemberIterator chaserThrustHistoryFilenameIterator
@@ -210,26 +256,522 @@ UserInput checkInput( const rapidjson::Document& config )
         std::cerr << "ERROR: Configuration option \"chaser_thrust_history_filename\" could not be "
                   << "found in JSON input!"
                   << std::endl;
-        throw;
+        throw std::invalid_argument(
+            "Configuration option \"chaser_thrust_history_filename\" could not be found in "
+            "JSON input" );
     }
     const std::string chaserThrustHistoryFilename
         = chaserThrustHistoryFilenameIterator->value.GetString( );
-    std::cout << "Thrust history output file                    "
-              << chaserThrustHistoryFilename << std::endl;
-
-    return UserInput( startTime,
-                      endTime,
-                      earthGravitationalParameter,
-                      targetSemiMajorAxis,
-                      chaserInitialState,
-                      chaserThrustMode,
-                      chaserThrustMaximum,
-                      chaserThrustFrequency,
-                      chaserWetMass,
-                      arrivalDistanceTolerance,
-                      outputDirectory,
-                      chaserStateHistoryFilename,
-                      chaserThrustHistoryFilename );
+    outputStream << "Thrust history output file                    "
+                 << chaserThrustHistoryFilename << std::endl;
+
+    // Search for optional output format in config (default: CSV).
+    OutputFormat outputFormat = csvOutput;
+    rapidjson::Value::ConstMemberIterator outputFormatIterator
+        = config.FindMember( "output_format" );
+    if ( outputFormatIterator != config.MemberEnd( ) )
+    {
+        const std::string outputFormatString = outputFormatIterator->value.GetString( );
+        if ( !outputFormatString.compare( "binary" ) )
+        {
+            outputFormat = binaryOutput;
+        }
+        else if ( outputFormatString.compare( "csv" ) )
+        {
+            std::cerr << "ERROR: Configuration option \"output_format\" should be \"csv\" or "
+                      << "\"binary\"!"
+                      << std::endl;
+            throw std::invalid_argument(
+                "Configuration option \"output_format\" should be \"csv\" or \"binary\"" );
+        }
+    }
+    outputStream << "Output format                                 "
+                 << ( outputFormat == binaryOutput ? "binary" : "CSV" ) << std::endl;
+
+    // Search for optional chaser trajectory filename in config.
+    std::string chaserTrajectoryFilename = "";
+    rapidjson::Value::ConstMemberIterator chaserTrajectoryFilenameIterator
+        = config.FindMember( "chaser_trajectory_filename" );
+    if ( chaserTrajectoryFilenameIterator != config.MemberEnd( ) )
+    {
+        chaserTrajectoryFilename = chaserTrajectoryFilenameIterator->value.GetString( );
+        outputStream << "Trajectory output file                        "
+                     << chaserTrajectoryFilename << std::endl;
+    }
+
+    // Search for optional output sampling settings in config (default: every step).
+    const OutputSamplingSettings outputSampling = checkOutputSamplingInput( config, outputStream );
+
+    // Search for optional instrumentation metrics filename in config.
+    std::string metricsFilename = "";
+    rapidjson::Value::ConstMemberIterator metricsFilenameIterator
+        = config.FindMember( "metrics_filename" );
+    if ( metricsFilenameIterator != config.MemberEnd( ) )
+    {
+        metricsFilename = metricsFilenameIterator->value.GetString( );
+        outputStream << "Metrics output file                           "
+                     << metricsFilename << std::endl;
+    }
+
+    // Search for optional adaptive scheduling settings in config (default: disabled).
+    const AdaptiveSchedulingSettings adaptiveScheduling
+        = checkAdaptiveSchedulingInput( config, outputStream );
+
+    // Search for optional propagator settings in config (default: Clohessy-Wiltshire).
+    const PropagatorSettings propagatorSettings = checkPropagatorInput( config, outputStream );
+
+    // Search for optional checkpoint settings in config (default: no checkpoints).
+    const CheckpointSettings checkpoint = checkCheckpointInput( config, outputStream );
+
+    const UserInput input( startTime,
+                                  endTime,
+                                  earthGravitationalParameter,
+                             targetSemiMajorAxis,
+                             chaserInitialState,
+                             chaserThrustMode,
+                             chaserThrustMaximum,
+                             chaserThrustFrequency,
+                             chaserWetMass,
+                             arrivalDistanceTolerance,
+                             outputDirectory,
+                             chaserStateHistoryFilename,
+                             chaserThrustHistoryFilename,
+                             outputFormat,
+                             chaserTrajectoryFilename,
+                             outputSampling,
+                             metricsFilename,
+                             adaptiveScheduling,
+                             propagatorSettings,
+                           checkpoint,
+                           chaserSpecificImpulse );
+
+    // Check values that are subject to rules shared with other sources of user input.
+    checkUserInput( input );
+
+    return input;
+}
+
+//! Check values of user input.
+void checkUserInput( const UserInput& input )
+{
+    checkRule( std::isfinite( input.startTime ) && std::isfinite( input.endTime ),
+               "Simulation start and end time should be finite" );
+    checkRule( !( input.endTime < input.startTime ),
+               "Simulation end time should not lie before start time" );
+    checkRule( input.earthGravitationalParameter > 0.0
+               && std::isfinite( input.earthGravitationalParameter ),
+               "Earth gravitational parameter should be positive" );
+    checkRule( input.targetSemiMajorAxis > 0.0 && std::isfinite( input.targetSemiMajorAxis ),
+               "Target semi-major axis should be positive" );
+    for ( int i = 0; i < 6; ++i )
+    {
+        checkRule( std::isfinite( input.chaserInitialState[ i ] ),
+                   "Chaser initial state should be finite" );
+    }
+    checkRule( input.thrustMaximum >= 0.0 && std::isfinite( input.thrustMaximum ),
+               "Chaser thrust maximum should be non-negative" );
+    checkRule( input.thrustFrequency > 0.0 && std::isfinite( input.thrustFrequency ),
+               "Chaser thrust frequency should be positive" );
+    checkRule( input.chaserWetMass > 0.0 && std::isfinite( input.chaserWetMass ),
+               "Chaser wet mass should be positive" );
+    checkRule( input.chaserSpecificImpulse >= 0.0 && std::isfinite( input.chaserSpecificImpulse ),
+               "Chaser specific impulse should be non-negative" );
+    checkRule( input.arrivalDistanceTolerance >= 0.0,
+               "Arrival distance tolerance should be non-negative" );
+
+    const PropagatorSettings& propagatorSettings = input.propagatorSettings;
+    checkRule( propagatorSettings.targetEccentricity >= 0.0
+               && propagatorSettings.targetEccentricity < 1.0,
+               "Target eccentricity should be in the range [0, 1)" );
+    checkRule( std::isfinite( propagatorSettings.targetInclination )
+               && std::isfinite( propagatorSettings.targetInitialTrueAnomaly ),
+               "Target inclination and initial true anomaly should be finite" );
+
+    // The integration of the J2-perturbed target orbit fails near the centre of the Earth.
+    checkRule( propagatorSettings.propagatorType != j2NonlinearPropagator
+               || input.targetSemiMajorAxis * ( 1.0 - propagatorSettings.targetEccentricity )
+                  > propagatorSettings.earthEquatorialRadius,
+               "J2-perturbed target orbit should not intersect the Earth" );
+}
+
+//! Check output sampling input parameters.
+OutputSamplingSettings checkOutputSamplingInput( const rapidjson::Document& config,
+                                                 std::ostream& outputStream )
+{
+    rapidjson::Value::ConstMemberIterator outputSamplingIterator
+        = config.FindMember( "output_sampling" );
+    if ( outputSamplingIterator == config.MemberEnd( ) )
+    {
+        return OutputSamplingSettings( );
+    }
+    const rapidjson::Value& outputSamplingConfig = outputSamplingIterator->value;
+
+    // Search for sampling mode.
+    rapidjson::Value::ConstMemberIterator modeIterator = outputSamplingConfig.FindMember( "mode" );
+    if ( modeIterator == outputSamplingConfig.MemberEnd( ) )
+    {
+        std::cerr << "ERROR: Configuration option \"mode\" could not be found in "
+                  << "\"output_sampling\"!"
+                  << std::endl;
+        throw std::invalid_argument(
+            "Configuration option \"mode\" could not be found in \"output_sampling\"" );
+    }
+    const std::string modeString = modeIterator->value.GetString( );
+    SamplingMode samplingMode = everyStep;
+    std::size_t stepInterval = 1;
+    Real timeInterval = 0.0;
+    outputStream << "Output sampling mode                          ";
+    if ( !modeString.compare( "every_step" ) )
+    {
+        outputStream << "every step" << std::endl;
+    }
+    else if ( !modeString.compare( "every_nth_step" ) )
+    {
+        samplingMode = everyNthStep;
+        rapidjson::Value::ConstMemberIterator stepIntervalIterator
+            = outputSamplingConfig.FindMember( "step_interval" );
+        if ( stepIntervalIterator == outputSamplingConfig.MemberEnd( )
+             || stepIntervalIterator->value.GetInt( ) < 1 )
+        {
+            outputStream << std::endl;
+            std::cerr << "ERROR: \"step_interval\" in \"output_sampling\" should be a positive "
+                      << "integer!"
+                      << std::endl;
+            throw std::invalid_argument(
+                "\"step_interval\" in \"output_sampling\" should be a positive integer" );
+        }
+        stepInterval = static_cast< std::size_t >( stepIntervalIterator->value.GetInt( ) );
+        outputStream << "every " << stepInterval << " steps" << std::endl;
+    }
+    else if ( !modeString.compare( "interval" ) )
+    {
+        samplingMode = fixedInterval;
+        rapidjson::Value::ConstMemberIterator timeIntervalIterator
+            = outputSamplingConfig.FindMember( "time_interval" );
+        if ( timeIntervalIterator == outputSamplingConfig.MemberEnd( )
+             || !( timeIntervalIterator->value.GetDouble( ) > 0.0 ) )
+        {
+            outputStream << std::endl;
+            std::cerr << "ERROR: \"time_interval\" in \"output_sampling\" should be positive!"
+                      << std::endl;
+            throw std::invalid_argument(
+                "\"time_interval\" in \"output_sampling\" should be positive" );
+        }
+        timeInterval = timeIntervalIterator->value.GetDouble( );
+        outputStream << "every " << timeInterval << " s" << std::endl;
+    }
+    else
+    {
+        outputStream << std::endl;
+        std::cerr << "ERROR: \"mode\" in \"output_sampling\" should be \"every_step\", "
+                  << "\"every_nth_step\" or \"interval\"!"
+                  << std::endl;
+        throw std::invalid_argument(
+            "\"mode\" in \"output_sampling\" should be \"every_step\", \"every_nth_step\" or "
+            "\"interval\"" );
+    }
+
+    // Search for optional events that trigger output.
+    bool isThrustSwitchEventEnabled = false;
+    bool isThrottleSaturationEventEnabled = false;
+    bool isArrivalEventEnabled = false;
+    rapidjson::Value::ConstMemberIterator eventsIterator
+        = outputSamplingConfig.FindMember( "events" );
+    if ( eventsIterator != outputSamplingConfig.MemberEnd( ) )
+    {
+        for ( rapidjson::SizeType i = 0; i < eventsIterator->value.Size( ); ++i )
+        {
+            const std::string eventString = eventsIterator->value[ i ].GetString( );
+            if ( !eventString.compare( "thrust_switch" ) )
+            {
+                isThrustSwitchEventEnabled = true;
+            }
+            else if ( !eventString.compare( "throttle_saturation" ) )
+            {
+                isThrottleSaturationEventEnabled = true;
+            }
+            else if ( !eventString.compare( "arrival" ) )
+            {
+                isArrivalEventEnabled = true;
+            }
+            else
+            {
+                std::cerr << "ERROR: \"events\" in \"output_sampling\" should be "
+                          << "\"thrust_switch\", \"throttle_saturation\" or \"arrival\"!"
+                          << std::endl;
+                throw std::invalid_argument(
+                    "\"events\" in \"output_sampling\" should be \"thrust_switch\", "
+                    "\"throttle_saturation\" or \"arrival\"" );
+            }
+            outputStream << "Output sampling event                         "
+                         << eventString << std::endl;
+        }
+    }
+
+    return OutputSamplingSettings( samplingMode,
+                                   stepInterval,
+                                   timeInterval,
+                                   isThrustSwitchEventEnabled,
+                                   isThrottleSaturationEventEnabled,
+                                   isArrivalEventEnabled );
+}
+
+//! Check adaptive scheduling input parameters.
+AdaptiveSchedulingSettings checkAdaptiveSchedulingInput( const rapidjson::Document& config,
+                                                         std::ostream& outputStream )
+{
+    rapidjson::Value::ConstMemberIterator adaptiveSchedulingIterator
+        = config.FindMember( "adaptive_scheduling" );
+    if ( adaptiveSchedulingIterator == config.MemberEnd( ) )
+    {
+        return AdaptiveSchedulingSettings( );
+    }
+    const rapidjson::Value& adaptiveSchedulingConfig = adaptiveSchedulingIterator->value;
+
+    // Search for optional tolerance (default: 0.01).
+    Real tolerance = AdaptiveSchedulingSettings( ).tolerance;
+    rapidjson::Value::ConstMemberIterator toleranceIterator
+        = adaptiveSchedulingConfig.FindMember( "tolerance" );
+    if ( toleranceIterator != adaptiveSchedulingConfig.MemberEnd( ) )
+    {
+        tolerance = toleranceIterator->value.GetDouble( );
+        if ( tolerance < 0.0 || !( tolerance < 1.0 ) )
+        {
+            std::cerr << "ERROR: \"tolerance\" in \"adaptive_scheduling\" should be in the range "
+                      << "[0, 1)!"
+                      << std::endl;
+            throw std::invalid_argument(
+                "\"tolerance\" in \"adaptive_scheduling\" should be in the range [0, 1)" );
+        }
+    }
+    outputStream << "Adaptive scheduling tolerance [-]             " << tolerance << std::endl;
+
+    return AdaptiveSchedulingSettings( true, tolerance );
+}
+
+//! Check propagator input parameters.
+PropagatorSettings checkPropagatorInput( const rapidjson::Document& config,
+                                         std::ostream& outputStream )
+{
+    rapidjson::Value::ConstMemberIterator propagatorIterator = config.FindMember( "propagator" );
+    if ( propagatorIterator == config.MemberEnd( ) )
+    {
+        return PropagatorSettings( );
+    }
+    const rapidjson::Value& propagatorConfig = propagatorIterator->value;
+    const PropagatorSettings defaultSettings;
+
+    // Search for propagator model.
+    rapidjson::Value::ConstMemberIterator modelIterator = propagatorConfig.FindMember( "model" );
+    if ( modelIterator == propagatorConfig.MemberEnd( ) )
+    {
+        std::cerr << "ERROR: Configuration option \"model\" could not be found in "
+                  << "\"propagator\"!"
+                  << std::endl;
+        throw std::invalid_argument(
+            "Configuration option \"model\" could not be found in \"propagator\"" );
+    }
+    const std::string modelString = modelIterator->value.GetString( );
+    PropagatorType propagatorType = clohessyWiltshirePropagator;
+    if ( !modelString.compare( "yamanaka_ankersen" ) )
+    {
+        propagatorType = yamanakaAnkersenPropagator;
+    }
+    else if ( !modelString.compare( "j2_nonlinear" ) )
+    {
+        propagatorType = j2NonlinearPropagator;
+    }
+    else if ( modelString.compare( "clohessy_wiltshire" ) )
+    {
+        std::cerr << "ERROR: \"model\" in \"propagator\" should be \"clohessy_wiltshire\", "
+                  << "\"yamanaka_ankersen\" or \"j2_nonlinear\"!"
+                  << std::endl;
+        throw std::invalid_argument(
+            "\"model\" in \"propagator\" should be \"clohessy_wiltshire\", "
+            "\"yamanaka_ankersen\" or \"j2_nonlinear\"" );
+    }
+    outputStream << "Propagator                                    " << modelString << std::endl;
+
+    // Search for optional target orbit settings.
+    Real targetEccentricity = defaultSettings.targetEccentricity;
+    rapidjson::Value::ConstMemberIterator eccentricityIterator
+        = propagatorConfig.FindMember( "target_eccentricity" );
+    if ( eccentricityIterator != propagatorConfig.MemberEnd( ) )
+    {
+        targetEccentricity = eccentricityIterator->value.GetDouble( );
+    }
+
+    Real targetInclination = defaultSettings.targetInclination;
+    rapidjson::Value::ConstMemberIterator inclinationIterator
+        = propagatorConfig.FindMember( "target_inclination" );
+    if ( inclinationIterator != propagatorConfig.MemberEnd( ) )
+    {
+        targetInclination = inclinationIterator->value.GetDouble( );
+    }
+
+    Real targetInitialTrueAnomaly = defaultSettings.targetInitialTrueAnomaly;
+    rapidjson::Value::ConstMemberIterator trueAnomalyIterator
+        = propagatorConfig.FindMember( "target_true_anomaly" );
+    if ( trueAnomalyIterator != propagatorConfig.MemberEnd( ) )
+    {
+        targetInitialTrueAnomaly = trueAnomalyIterator->value.GetDouble( );
+    }
+
+    if ( propagatorType != clohessyWiltshirePropagator )
+    {
+        outputStream << "Target eccentricity           [-]             "
+                     << targetEccentricity << std::endl;
+        outputStream << "Target initial true anomaly   [rad]           "
+                     << targetInitialTrueAnomaly << std::endl;
+    }
+
+    // Search for optional integrator settings.
+    IntegratorType integratorType = defaultSettings.integratorType;
+    rapidjson::Value::ConstMemberIterator integratorIterator
+        = propagatorConfig.FindMember( "integrator" );
+    if ( integratorIterator != propagatorConfig.MemberEnd( ) )
+    {
+        const std::string integratorString = integratorIterator->value.GetString( );
+        if ( !integratorString.compare( "rk4" ) )
+        {
+            integratorType = rungeKutta4Integrator;
+        }
+        else if ( integratorString.compare( "dormand_prince" ) )
+        {
+            std::cerr << "ERROR: \"integrator\" in \"propagator\" should be \"rk4\" or "
+                      << "\"dormand_prince\"!"
+                      << std::endl;
+            throw std::invalid_argument(
+                "\"integrator\" in \"propagator\" should be \"rk4\" or \"dormand_prince\"" );
+        }
+    }
+
+    Real stepSize = defaultSettings.stepSize;
+    rapidjson::Value::ConstMemberIterator stepSizeIterator
+        = propagatorConfig.FindMember( "step_size" );
+    if ( stepSizeIterator != propagatorConfig.MemberEnd( ) )
+    {
+        stepSize = stepSizeIterator->value.GetDouble( );
+        if ( !( stepSize > 0.0 ) )
+        {
+            std::cerr << "ERROR: \"step_size\" in \"propagator\" should be positive!"
+                      << std::endl;
+            throw std::invalid_argument( "\"step_size\" in \"propagator\" should be positive" );
+        }
+    }
+
+    Real tolerance = defaultSettings.tolerance;
+    rapidjson::Value::ConstMemberIterator toleranceIterator
+        = propagatorConfig.FindMember( "tolerance" );
+    if ( toleranceIterator != propagatorConfig.MemberEnd( ) )
+    {
+        tolerance = toleranceIterator->value.GetDouble( );
+        if ( !( tolerance > 0.0 ) )
+        {
+            std::cerr << "ERROR: \"tolerance\" in \"propagator\" should be positive!"
+                      << std::endl;
+            throw std::invalid_argument( "\"tolerance\" in \"propagator\" should be positive" );
+        }
+    }
+
+    Real transitionTolerance = defaultSettings.transitionTolerance;
+    rapidjson::Value::ConstMemberIterator transitionToleranceIterator
+        = propagatorConfig.FindMember( "transition_tolerance" );
+    if ( transitionToleranceIterator != propagatorConfig.MemberEnd( ) )
+    {
+        transitionTolerance = transitionToleranceIterator->value.GetDouble( );
+        if ( !( transitionTolerance >= 0.0 ) )
+        {
+            std::cerr << "ERROR: \"transition_tolerance\" in \"propagator\" should be "
+                      << "non-negative!"
+                      << std::endl;
+            throw std::invalid_argument(
+                "\"transition_tolerance\" in \"propagator\" should be non-negative" );
+        }
+    }
+
+    if ( propagatorType == clohessyWiltshirePropagator )
+    {
+        outputStream << "Transition tolerance          [-]             "
+                     << transitionTolerance << std::endl;
+    }
+
+    if ( propagatorType == j2NonlinearPropagator )
+    {
+        outputStream << "Target inclination            [rad]           "
+                     << targetInclination << std::endl;
+        outputStream << "Integrator                                    "
+                     << ( integratorType == rungeKutta4Integrator ? "rk4" : "dormand_prince" )
+                     << std::endl;
+        outputStream << "Integrator step size          [s]             " << stepSize << std::endl;
+        if ( integratorType == dormandPrince45Integrator )
+        {
+            outputStream << "Integrator tolerance          [-]             "
+                         << tolerance << std::endl;
+        }
+    }
+
+    return PropagatorSettings( propagatorType,
+                               targetEccentricity,
+                               targetInclination,
+                               targetInitialTrueAnomaly,
+                               integratorType,
+                               stepSize,
+                               tolerance,
+                               defaultSettings.earthJ2,
+                               defaultSettings.earthEquatorialRadius,
+                               transitionTolerance );
+}
+
+//! Check checkpoint input parameters.
+CheckpointSettings checkCheckpointInput( const rapidjson::Document& config,
+                                         std::ostream& outputStream )
+{
+    rapidjson::Value::ConstMemberIterator checkpointIterator = config.FindMember( "checkpoint" );
+    if ( checkpointIterator == config.MemberEnd( ) )
+    {
+        return CheckpointSettings( );
+    }
+    const rapidjson::Value& checkpointConfig = checkpointIterator->value;
+
+    // Search for checkpoint filename.
+    rapidjson::Value::ConstMemberIterator filenameIterator
+        = checkpointConfig.FindMember( "filename" );
+    if ( filenameIterator == checkpointConfig.MemberEnd( ) )
+    {
+        std::cerr << "ERROR: Configuration option \"filename\" could not be found in "
+                  << "\"checkpoint\"!"
+                  << std::endl;
+        throw std::invalid_argument(
+            "Configuration option \"filename\" could not be found in \"checkpoint\"" );
+    }
+    const std::string filename = filenameIterator->value.GetString( );
+    if ( filename.empty( ) )
+    {
+        std::cerr << "ERROR: \"filename\" in \"checkpoint\" should not be empty!" << std::endl;
+        throw std::invalid_argument( "\"filename\" in \"checkpoint\" should not be empty" );
+    }
+    outputStream << "Checkpoint file                               " << filename << std::endl;
+
+    // Search for optional number of thruster pulses between checkpoints (default: 100000).
+    std::size_t stepInterval = CheckpointSettings( ).stepInterval;
+    rapidjson::Value::ConstMemberIterator stepIntervalIterator
+        = checkpointConfig.FindMember( "step_interval" );
+    if ( stepIntervalIterator != checkpointConfig.MemberEnd( ) )
+    {
+        if ( stepIntervalIterator->value.GetInt( ) < 1 )
+        {
+            std::cerr << "ERROR: \"step_interval\" in \"checkpoint\" should be a positive "
+                      << "integer!"
+                      << std::endl;
+            throw std::invalid_argument(
+                "\"step_interval\" in \"checkpoint\" should be a positive integer" );
+        }
+        stepInterval = static_cast< std::size_t >( stepIntervalIterator->value.GetInt( ) );
+    }
+    outputStream << "Checkpoint step interval      [-]             " << stepInterval << std::endl;
+
+    return CheckpointSettings( filename, stepInterval );
 }
 
 } // namespace rvdsim
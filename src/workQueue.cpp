@@ -0,0 +1,704 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <set>
+#include <sstream>
+#include <thread>
+
+#if defined( _WIN32 )
+#include <windows.h>
+#else
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+
+#include "rvdsim/binaryEncoding.hpp"
+#include "rvdsim/configLoader.hpp"
+#include "rvdsim/userInput.hpp"
+#include "rvdsim/workQueue.hpp"
+
+namespace rvdsim
+{
+
+namespace
+{
+
+//! Clock used to measure age of claimed tasks.
+typedef std::chrono::steady_clock WorkQueueClock;
+
+//! State of task, as tracked by coordinator.
+struct CoordinatorTask
+{
+public:
+
+    //! Index of first Monte Carlo sample in range.
+    std::size_t firstSampleIndex;
+
+    //! Number of Monte Carlo samples in range.
+    std::size_t numberOfSamples;
+
+    //! Number of copies of task dispatched.
+    std::size_t numberOfCopies;
+
+    //! Flag indicating if last copy of task is waiting to be claimed.
+    bool isPending;
+
+    //! Flag indicating if result of task has been merged.
+    bool isCompleted;
+
+    //! Time at which coordinator found last copy of task to be claimed.
+    WorkQueueClock::time_point claimTime;
+
+protected:
+private:
+};
+
+//! Check if string ends with given suffix.
+bool hasSuffix( const std::string& text, const std::string& suffix )
+{
+    return text.size( ) >= suffix.size( )
+           && !text.compare( text.size( ) - suffix.size( ), suffix.size( ), suffix );
+}
+
+//! Check if file exists.
+bool isFileAvailable( const std::string& filePath )
+{
+    std::ifstream file( filePath.c_str( ), std::ios::binary );
+    return file.is_open( );
+}
+
+//! Create directory, unless it exists already.
+void createDirectory( const std::string& directoryPath )
+{
+#if defined( _WIN32 )
+    const bool isCreated = CreateDirectoryA( directoryPath.c_str( ), 0 ) != 0
+                           || GetLastError( ) == ERROR_ALREADY_EXISTS;
+#else
+    const bool isCreated = mkdir( directoryPath.c_str( ), 0777 ) == 0 || errno == EEXIST;
+#endif
+    if ( !isCreated )
+    {
+        std::cerr << "ERROR: Directory \"" << directoryPath << "\" could not be created!"
+                  << std::endl;
+        throw;
+    }
+}
+
+//! Write contents to file.
+void writeFile( const std::string& filePath, const std::vector< char >& contents )
+{
+    std::ofstream file( filePath.c_str( ), std::ios::binary );
+    file.write( contents.data( ), static_cast< std::streamsize >( contents.size( ) ) );
+    file.close( );
+    if ( !file )
+    {
+        std::cerr << "ERROR: File \"" << filePath << "\" could not be written!" << std::endl;
+        throw;
+    }
+}
+
+//! Read campaign file, without the terminating null character added by readFileContents( ).
+std::vector< char > readCampaign( const std::string& filePath )
+{
+    std::vector< char > campaign = readFileContents( filePath );
+    campaign.pop_back( );
+    return campaign;
+}
+
+//! Sleep for given interval [s].
+void sleepFor( const Real interval )
+{
+    std::this_thread::sleep_for( std::chrono::duration< Real >( interval ) );
+}
+
+//! Create name of task file.
+std::string createTaskFileName( const std::size_t firstSampleIndex,
+                                const std::size_t numberOfSamples,
+                                const std::size_t copyIndex )
+{
+    std::ostringstream fileName;
+    fileName << firstSampleIndex << "_" << numberOfSamples << "_" << copyIndex << ".task";
+    return fileName.str( );
+}
+
+//! Parse name of task file; returns false if name is not the name of a task file.
+bool parseTaskFileName( const std::string& fileName,
+                        std::size_t& firstSampleIndex,
+                        std::size_t& numberOfSamples )
+{
+    if ( !hasSuffix( fileName, ".task" ) )
+    {
+        return false;
+    }
+
+    std::istringstream fileNameStream( fileName );
+    char firstSeparator = 0;
+    char secondSeparator = 0;
+    std::size_t copyIndex = 0;
+    fileNameStream >> firstSampleIndex >> firstSeparator
+                   >> numberOfSamples >> secondSeparator >> copyIndex;
+    return !fileNameStream.fail( ) && firstSeparator == '_' && secondSeparator == '_';
+}
+
+//! Create name of result file.
+std::string createResultFileName( const std::size_t firstSampleIndex,
+                                  const std::size_t numberOfSamples )
+{
+    std::ostringstream fileName;
+    fileName << firstSampleIndex << "_" << numberOfSamples << ".result";
+    return fileName.str( );
+}
+
+//! Create name of worker that is unique across nodes, processes and threads.
+std::string createWorkerName( )
+{
+    static std::atomic< unsigned int > numberOfWorkers( 0 );
+
+    std::ostringstream workerName;
+#if defined( _WIN32 )
+    char hostName[ MAX_COMPUTERNAME_LENGTH + 1 ] = "";
+    DWORD hostNameSize = sizeof( hostName );
+    GetComputerNameA( hostName, &hostNameSize );
+    workerName << hostName << "-" << GetCurrentProcessId( );
+#else
+    char hostName[ 256 ] = "";
+    gethostname( hostName, sizeof( hostName ) - 1 );
+    workerName << hostName << "-" << getpid( );
+#endif
+    workerName << "-" << numberOfWorkers++;
+    return workerName.str( );
+}
+
+//! Merge result of task into summaries of Monte Carlo analysis.
+/*!
+ * @param[in]     resultPath     Path to result file
+ * @param[in]     task           Task
+ * @param[in,out] summaries      Simulation summaries of Monte Carlo analysis
+ * @param[in,out] executionTimes Execution times of completed tasks [s]
+ */
+void mergeResult( const std::string& resultPath,
+                  const CoordinatorTask& task,
+                  std::vector< SimulationSummary >& summaries,
+                  std::vector< Real >& executionTimes )
+{
+    const WorkQueueResult result = readWorkQueueResult( resultPath );
+    if ( result.firstSampleIndex != task.firstSampleIndex
+         || result.summaries.size( ) != task.numberOfSamples )
+    {
+        std::cerr << "ERROR: Result file \"" << resultPath << "\" does not match its task!"
+                  << std::endl;
+        throw;
+    }
+
+    for ( std::size_t i = 0; i < task.numberOfSamples; ++i )
+    {
+        summaries[ task.firstSampleIndex + i ] = result.summaries[ i ];
+    }
+    executionTimes.push_back( result.executionTime );
+}
+
+} // namespace
+
+//! Check work queue settings.
+WorkQueueSettings checkWorkQueueInput( const rapidjson::Document& config,
+                                       std::ostream& outputStream )
+{
+    rapidjson::Value::ConstMemberIterator workQueueIterator = config.FindMember( "work_queue" );
+    if ( workQueueIterator == config.MemberEnd( ) )
+    {
+        return WorkQueueSettings( );
+    }
+    const rapidjson::Value& workQueueConfig = workQueueIterator->value;
+    const WorkQueueSettings defaultSettings;
+
+    // Search for optional number of samples per task.
+    std::size_t numberOfSamplesPerTask = defaultSettings.numberOfSamplesPerTask;
+    rapidjson::Value::ConstMemberIterator samplesPerTaskIterator
+        = workQueueConfig.FindMember( "samples_per_task" );
+    if ( samplesPerTaskIterator != workQueueConfig.MemberEnd( ) )
+    {
+        if ( samplesPerTaskIterator->value.GetUint64( ) == 0 )
+        {
+            std::cerr << "ERROR: \"samples_per_task\" in \"work_queue\" should be a positive "
+                      << "integer!" << std::endl;
+            throw;
+        }
+        numberOfSamplesPerTask
+            = static_cast< std::size_t >( samplesPerTaskIterator->value.GetUint64( ) );
+    }
+    outputStream << "Work queue samples per task   [-]             "
+                 << numberOfSamplesPerTask << std::endl;
+
+    // Search for optional poll interval.
+    Real pollInterval = defaultSettings.pollInterval;
+    rapidjson::Value::ConstMemberIterator pollIntervalIterator
+        = workQueueConfig.FindMember( "poll_interval" );
+    if ( pollIntervalIterator != workQueueConfig.MemberEnd( ) )
+    {
+        pollInterval = pollIntervalIterator->value.GetDouble( );
+        if ( !( pollInterval > 0.0 ) )
+        {
+            std::cerr << "ERROR: \"poll_interval\" in \"work_queue\" should be positive!"
+                      << std::endl;
+            throw;
+        }
+    }
+    outputStream << "Work queue poll interval      [s]             " << pollInterval << std::endl;
+
+    // Search for optional straggler factor.
+    Real stragglerFactor = defaultSettings.stragglerFactor;
+    rapidjson::Value::ConstMemberIterator stragglerFactorIterator
+        = workQueueConfig.FindMember( "straggler_factor" );
+    if ( stragglerFactorIterator != workQueueConfig.MemberEnd( ) )
+    {
+        stragglerFactor = stragglerFactorIterator->value.GetDouble( );
+        if ( !( stragglerFactor >= 1.0 ) )
+        {
+            std::cerr << "ERROR: \"straggler_factor\" in \"work_queue\" should be at least 1!"
+                      << std::endl;
+            throw;
+        }
+    }
+    outputStream << "Straggler factor              [-]             " << stragglerFactor
+                 << std::endl;
+
+    // Search for optional straggler timeout.
+    Real stragglerTimeout = defaultSettings.stragglerTimeout;
+    rapidjson::Value::ConstMemberIterator stragglerTimeoutIterator
+        = workQueueConfig.FindMember( "straggler_timeout" );
+    if ( stragglerTimeoutIterator != workQueueConfig.MemberEnd( ) )
+    {
+        stragglerTimeout = stragglerTimeoutIterator->value.GetDouble( );
+        if ( !( stragglerTimeout > 0.0 ) )
+        {
+            std::cerr << "ERROR: \"straggler_timeout\" in \"work_queue\" should be positive!"
+                      << std::endl;
+            throw;
+        }
+    }
+    outputStream << "Straggler timeout             [s]             " << stragglerTimeout
+                 << std::endl;
+
+    return WorkQueueSettings( numberOfSamplesPerTask,
+                              pollInterval,
+                              stragglerFactor,
+                              stragglerTimeout );
+}
+
+//! Write result of work queue task to file.
+void writeWorkQueueResult( const std::string& filePath, const WorkQueueResult& result )
+{
+    std::vector< char > buffer;
+    buffer.reserve( 36 + 41 * result.summaries.size( ) );
+
+    for ( std::size_t i = 0; i < 8; ++i )
+    {
+        buffer.push_back( workQueueResultMagic[ i ] );
+    }
+    appendLittleEndian( workQueueResultVersion, 4, buffer );
+    appendLittleEndian( result.firstSampleIndex, 8, buffer );
+    appendLittleEndian( result.summaries.size( ), 8, buffer );
+    appendLittleEndian( result.executionTime, buffer );
+
+    for ( std::size_t i = 0; i < result.summaries.size( ); ++i )
+    {
+        const SimulationSummary& summary = result.summaries[ i ];
+        appendLittleEndian( summary.finalDistanceToTarget, buffer );
+        appendLittleEndian( summary.totalDeltaV, buffer );
+        appendLittleEndian( summary.propellantMass, buffer );
+        appendLittleEndian( summary.throttleSaturationTime, buffer );
+        appendLittleEndian( summary.terminationTime, buffer );
+        appendLittleEndian( ( summary.isTargetReached ? 1 : 0 )
+                            | ( summary.isThrottleMax ? 2 : 0 )
+                            | ( summary.isTerminatedEarly ? 4 : 0 )
+                            | ( summary.isRedrawn ? 8 : 0 ), 1, buffer );
+    }
+
+    writeFile( filePath, buffer );
+}
+
+//! Read result of work queue task from file.
+WorkQueueResult readWorkQueueResult( const std::string& filePath )
+{
+    std::ifstream file( filePath.c_str( ), std::ios::binary );
+    if ( !file.is_open( ) )
+    {
+        std::cerr << "ERROR: Result file \"" << filePath << "\" could not be opened!"
+                  << std::endl;
+        throw;
+    }
+    const std::vector< char > contents( ( std::istreambuf_iterator< char >( file ) ),
+                                        std::istreambuf_iterator< char >( ) );
+
+    if ( contents.size( ) < 12 || std::memcmp( contents.data( ), workQueueResultMagic, 8 ) != 0 )
+    {
+        std::cerr << "ERROR: File \"" << filePath << "\" is not a work queue result file!"
+                  << std::endl;
+        throw;
+    }
+
+    LittleEndianReader reader( contents, "Result file", filePath );
+    reader.readUnsignedInteger( 8 );
+    const std::uint64_t version = reader.readUnsignedInteger( 4 );
+    if ( version != workQueueResultVersion )
+    {
+        std::cerr << "ERROR: Result file \"" << filePath << "\" has unsupported version "
+                  << version << "!" << std::endl;
+        throw;
+    }
+
+    WorkQueueResult result;
+    result.firstSampleIndex = static_cast< std::size_t >( reader.readUnsignedInteger( 8 ) );
+    const std::uint64_t numberOfSamples = reader.readUnsignedInteger( 8 );
+    result.executionTime = reader.readDouble( );
+
+    for ( std::uint64_t i = 0; i < numberOfSamples; ++i )
+    {
+        SimulationSummary summary;
+        summary.finalDistanceToTarget = reader.readDouble( );
+        summary.totalDeltaV = reader.readDouble( );
+        summary.propellantMass = reader.readDouble( );
+        summary.throttleSaturationTime = reader.readDouble( );
+        summary.terminationTime = reader.readDouble( );
+        const std::uint64_t flags = reader.readUnsignedInteger( 1 );
+        summary.isTargetReached = ( flags & 1 ) != 0;
+        summary.isThrottleMax = ( flags & 2 ) != 0;
+        summary.isTerminatedEarly = ( flags & 4 ) != 0;
+        summary.isRedrawn = ( flags & 8 ) != 0;
+        result.summaries.push_back( summary );
+    }
+    reader.checkEnd( );
+
+    return result;
+}
+
+//! Execute coordinator of Monte Carlo analysis distributed over work queue.
+std::vector< SimulationSummary > executeWorkQueueCoordinator(
+    const std::string& queueDirectory,
+    const std::string& campaignFilePath,
+    const DispersionSettings& dispersionSettings,
+    const WorkQueueSettings& settings,
+    std::ostream& outputStream )
+{
+    const std::string tasksDirectory = queueDirectory + "/tasks";
+    const std::string claimedDirectory = queueDirectory + "/claimed";
+    const std::string resultsDirectory = queueDirectory + "/results";
+    createDirectory( queueDirectory );
+    createDirectory( tasksDirectory );
+    createDirectory( claimedDirectory );
+    createDirectory( resultsDirectory );
+    std::remove( ( queueDirectory + "/done" ).c_str( ) );
+
+    // Copy campaign to queue directory, or check that the queue directory contains the same
+    // campaign, in which case results that are already present are reused.
+    const std::vector< char > campaign = readCampaign( campaignFilePath );
+    const std::string queueCampaignPath = queueDirectory + "/campaign.json";
+    if ( isFileAvailable( queueCampaignPath ) )
+    {
+        if ( readCampaign( queueCampaignPath ) != campaign )
+        {
+            std::cerr << "ERROR: Queue directory \"" << queueDirectory << "\" contains a "
+                      << "different campaign!" << std::endl;
+            throw;
+        }
+    }
+    else
+    {
+        // The campaign is renamed into place, such that workers never read an incomplete copy.
+        writeFile( queueCampaignPath + ".tmp", campaign );
+        if ( std::rename( ( queueCampaignPath + ".tmp" ).c_str( ),
+                          queueCampaignPath.c_str( ) ) != 0 )
+        {
+            std::cerr << "ERROR: Campaign file \"" << queueCampaignPath << "\" could not be "
+                      << "written!" << std::endl;
+            throw;
+        }
+    }
+
+    // Remove tasks left pending by an interrupted coordinator.
+    const std::vector< std::string > staleTaskNames = listDirectoryEntries( tasksDirectory );
+    for ( std::size_t i = 0; i < staleTaskNames.size( ); ++i )
+    {
+        if ( hasSuffix( staleTaskNames[ i ], ".task" ) )
+        {
+            std::remove( ( tasksDirectory + "/" + staleTaskNames[ i ] ).c_str( ) );
+        }
+    }
+
+    // Split Monte Carlo samples into tasks, and dispatch tasks without result.
+    const std::vector< std::string > resultNames = listDirectoryEntries( resultsDirectory );
+    const std::set< std::string > existingResultNames( resultNames.begin( ), resultNames.end( ) );
+    std::vector< SimulationSummary > summaries( dispersionSettings.numberOfSamples );
+    std::vector< Real > executionTimes;
+    std::vector< CoordinatorTask > tasks;
+    std::size_t numberOfCompletedTasks = 0;
+    for ( std::size_t firstSampleIndex = 0;
+          firstSampleIndex < dispersionSettings.numberOfSamples;
+          firstSampleIndex += settings.numberOfSamplesPerTask )
+    {
+        CoordinatorTask task;
+        task.firstSampleIndex = firstSampleIndex;
+        task.numberOfSamples = std::min( settings.numberOfSamplesPerTask,
+                                         dispersionSettings.numberOfSamples - firstSampleIndex );
+        task.numberOfCopies = 0;
+        task.isPending = false;
+        task.isCompleted = false;
+
+        const std::string resultName
+            = createResultFileName( task.firstSampleIndex, task.numberOfSamples );
+        if ( existingResultNames.count( resultName ) > 0 )
+        {
+            mergeResult( resultsDirectory + "/" + resultName, task, summaries, executionTimes );
+            task.isCompleted = true;
+            ++numberOfCompletedTasks;
+        }
+        else
+        {
+            writeFile( tasksDirectory + "/" + createTaskFileName(
+                           task.firstSampleIndex, task.numberOfSamples, 0 ),
+                       std::vector< char >( ) );
+            task.numberOfCopies = 1;
+            task.isPending = true;
+        }
+        tasks.push_back( task );
+    }
+
+    outputStream << "Tasks dispatched                              "
+                 << tasks.size( ) - numberOfCompletedTasks << "/" << tasks.size( ) << std::endl;
+    outputStream << "Waiting for workers on queue directory        " << queueDirectory
+                 << std::endl;
+
+    std::size_t numberOfRedispatchedTasks = 0;
+    while ( numberOfCompletedTasks < tasks.size( ) )
+    {
+        sleepFor( settings.pollInterval );
+        const WorkQueueClock::time_point now = WorkQueueClock::now( );
+
+        // Merge results that have arrived, and withdraw remaining copies of their tasks.
+        const std::vector< std::string > currentResultNames
+            = listDirectoryEntries( resultsDirectory );
+        const std::set< std::string > availableResultNames( currentResultNames.begin( ),
+                                                            currentResultNames.end( ) );
+        for ( std::size_t i = 0; i < tasks.size( ); ++i )
+        {
+            CoordinatorTask& task = tasks[ i ];
+            const std::string resultName
+                = createResultFileName( task.firstSampleIndex, task.numberOfSamples );
+            if ( task.isCompleted || availableResultNames.count( resultName ) == 0 )
+            {
+                continue;
+            }
+
+            mergeResult( resultsDirectory + "/" + resultName, task, summaries, executionTimes );
+            task.isCompleted = true;
+            ++numberOfCompletedTasks;
+            for ( std::size_t copyIndex = 0; copyIndex < task.numberOfCopies; ++copyIndex )
+            {
+                std::remove( ( tasksDirectory + "/" + createTaskFileName(
+                                   task.firstSampleIndex, task.numberOfSamples, copyIndex ) )
+                             .c_str( ) );
+            }
+        }
+
+        // Record time at which pending tasks are found to be claimed.
+        const std::vector< std::string > pendingTaskNames = listDirectoryEntries( tasksDirectory );
+        const std::set< std::string > availableTaskNames( pendingTaskNames.begin( ),
+                                                          pendingTaskNames.end( ) );
+        bool isAnyTaskPending = false;
+        for ( std::size_t i = 0; i < tasks.size( ); ++i )
+        {
+            CoordinatorTask& task = tasks[ i ];
+            if ( task.isCompleted || !task.isPending )
+            {
+                continue;
+            }
+
+            if ( availableTaskNames.count( createTaskFileName(
+                     task.firstSampleIndex, task.numberOfSamples, task.numberOfCopies - 1 ) ) > 0 )
+            {
+                isAnyTaskPending = true;
+            }
+            else
+            {
+                task.isPending = false;
+                task.claimTime = now;
+            }
+        }
+
+        // Once all tasks have been claimed, re-dispatch claimed tasks that take much longer than
+        // completed tasks took on average, e.g., because their worker is slow or has failed.
+        if ( isAnyTaskPending || numberOfCompletedTasks == tasks.size( ) )
+        {
+            continue;
+        }
+
+        Real stragglerTime = settings.stragglerTimeout;
+        if ( !executionTimes.empty( ) )
+        {
+            Real executionTimeSum = 0.0;
+            for ( std::size_t i = 0; i < executionTimes.size( ); ++i )
+            {
+                executionTimeSum += executionTimes[ i ];
+            }
+            stragglerTime = settings.stragglerFactor * executionTimeSum
+                            / static_cast< Real >( executionTimes.size( ) );
+        }
+
+        for ( std::size_t i = 0; i < tasks.size( ); ++i )
+        {
+            CoordinatorTask& task = tasks[ i ];
+            if ( task.isCompleted
+                 || std::chrono::duration< Real >( now - task.claimTime ).count( )
+                    <= stragglerTime )
+            {
+                continue;
+            }
+
+            writeFile( tasksDirectory + "/" + createTaskFileName(
+                           task.firstSampleIndex, task.numberOfSamples, task.numberOfCopies ),
+                       std::vector< char >( ) );
+            ++task.numberOfCopies;
+            task.isPending = true;
+            ++numberOfRedispatchedTasks;
+            outputStream << "Re-dispatched straggling task of samples      "
+                         << task.firstSampleIndex << "-"
+                         << task.firstSampleIndex + task.numberOfSamples - 1 << std::endl;
+        }
+    }
+
+    // Signal workers that the analysis is done.
+    writeFile( queueDirectory + "/done", std::vector< char >( ) );
+
+    outputStream << "Tasks completed                               "
+                 << numberOfCompletedTasks << "/" << tasks.size( ) << std::endl;
+    outputStream << "Tasks re-dispatched                           "
+                 << numberOfRedispatchedTasks << std::endl;
+
+    return summaries;
+}
+
+//! Execute worker of Monte Carlo analysis distributed over work queue.
+std::size_t executeWorkQueueWorker( const std::string& queueDirectory,
+                                    std::ostream& outputStream )
+{
+    const std::string campaignPath = queueDirectory + "/campaign.json";
+    const std::string donePath = queueDirectory + "/done";
+    const std::string tasksDirectory = queueDirectory + "/tasks";
+    const std::string claimedDirectory = queueDirectory + "/claimed";
+    const std::string resultsDirectory = queueDirectory + "/results";
+
+    // Wait for coordinator to provide campaign.
+    while ( !isFileAvailable( campaignPath ) )
+    {
+        sleepFor( WorkQueueSettings( ).pollInterval );
+    }
+
+    const ConfigCollection configs = loadConfigs( campaignPath );
+    const rapidjson::Document& config = configs.getDocument( 0 );
+    const UserInput nominalInput = checkInput( config, outputStream );
+    const DispersionSettings dispersionSettings
+        = checkDispersionInput( config, nominalInput, outputStream );
+    const WorkQueueSettings settings = checkWorkQueueInput( config, outputStream );
+
+    const std::string workerName = createWorkerName( );
+    outputStream << "Worker                                        " << workerName << std::endl;
+
+    std::size_t numberOfExecutedTasks = 0;
+    while ( !isFileAvailable( donePath ) )
+    {
+        // Claim first pending task that is not claimed by another worker first.
+        const std::vector< std::string > taskNames = listDirectoryEntries( tasksDirectory );
+        bool isTaskClaimed = false;
+        for ( std::size_t i = 0; i < taskNames.size( ) && !isTaskClaimed; ++i )
+        {
+            std::size_t firstSampleIndex = 0;
+            std::size_t numberOfSamples = 0;
+            if ( !parseTaskFileName( taskNames[ i ], firstSampleIndex, numberOfSamples ) )
+            {
+                continue;
+            }
+
+            const std::string claimedPath = claimedDirectory + "/" + taskNames[ i ] + "."
+                                            + workerName;
+            if ( std::rename( ( tasksDirectory + "/" + taskNames[ i ] ).c_str( ),
+                              claimedPath.c_str( ) ) != 0 )
+            {
+                continue;
+            }
+            isTaskClaimed = true;
+
+            if ( numberOfSamples == 0
+                 || firstSampleIndex + numberOfSamples > dispersionSettings.numberOfSamples )
+            {
+                std::cerr << "ERROR: Task \"" << taskNames[ i ] << "\" does not belong to "
+                          << "campaign in queue directory \"" << queueDirectory << "\"!"
+                          << std::endl;
+                throw;
+            }
+
+            // Another copy of the task may have been completed already.
+            const std::string resultPath
+                = resultsDirectory + "/" + createResultFileName( firstSampleIndex,
+                                                                 numberOfSamples );
+            if ( !isFileAvailable( resultPath ) )
+            {
+                outputStream << "Executing samples                             "
+                             << firstSampleIndex << "-"
+                             << firstSampleIndex + numberOfSamples - 1 << std::endl;
+
+                const WorkQueueClock::time_point startTime = WorkQueueClock::now( );
+                WorkQueueResult result;
+                result.firstSampleIndex = firstSampleIndex;
+                result.summaries = executeMonteCarloSamples(
+                    nominalInput, dispersionSettings, firstSampleIndex, numberOfSamples );
+                result.executionTime
+                    = std::chrono::duration< Real >( WorkQueueClock::now( ) - startTime ).count( );
+
+                // The result is renamed into place, such that the coordinator never reads an
+                // incomplete result. Renaming fails on Windows if another copy of the task has
+                // been completed in the meantime, which yields an identical result.
+                const std::string temporaryPath = resultsDirectory + "/" + taskNames[ i ] + "."
+                                                  + workerName + ".tmp";
+                writeWorkQueueResult( temporaryPath, result );
+                if ( std::rename( temporaryPath.c_str( ), resultPath.c_str( ) ) != 0 )
+                {
+                    std::remove( temporaryPath.c_str( ) );
+                    if ( !isFileAvailable( resultPath ) )
+                    {
+                        std::cerr << "ERROR: Result file \"" << resultPath << "\" could not be "
+                                  << "written!" << std::endl;
+                        throw;
+                    }
+                }
+                ++numberOfExecutedTasks;
+            }
+
+            std::remove( claimedPath.c_str( ) );
+        }
+
+        if ( !isTaskClaimed )
+        {
+            sleepFor( settings.pollInterval );
+        }
+    }
+
+    outputStream << "Tasks executed by worker                      " << numberOfExecutedTasks
+                 << std::endl;
+
+    return numberOfExecutedTasks;
+}
+
+} // namespace rvdsim
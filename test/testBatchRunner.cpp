@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cstddef>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <catch.hpp>
+
+#include "rvdsim/batchRunner.hpp"
+#include "rvdsim/outputSink.hpp"
+#include "rvdsim/simulator.hpp"
+#include "rvdsim/typedefs.hpp"
+#include "rvdsim/userInput.hpp"
+
+#include "testInputFactory.hpp"
+
+namespace rvdsim
+{
+namespace tests
+{
+
+//! Output sink that records batch results in memory.
+class BatchResultRecordingSink : public OutputSink
+{
+public:
+
+    BatchResultRecordingSink( )
+        : OutputSink( getBatchResultColumnNames( ) ),
+          rows( )
+    { }
+
+    void writeRow( const Real* row )
+    {
+        rows.push_back( std::vector< Real >( row, row + 8 ) );
+        ++numberOfRows;
+    }
+
+    void close( ) { }
+
+    std::vector< std::vector< Real > > rows;
+};
+
+//! Create manifest line for batch runner tests.
+std::string createManifestLine( const std::string& thrustMode, const Real thrustMaximum )
+{
+    std::ostringstream line;
+    line << "{ \"propagation_settings\" : [0.0, 500.0], "
+         << "\"earth_gravitational_parameter\" : 3.986004418e14, "
+         << "\"target_semi_major_axis\" : 6778.0e3, "
+         << "\"chaser_initial_state\" : [-100.0, -1000.0, 10.0, 0.0, 0.1, 0.0], "
+         << "\"chaser_thrust_settings\" : [\"" << thrustMode << "\", " << thrustMaximum
+         << ", 1.0], "
+         << "\"chaser_wet_mass\" : 100.0, "
+         << "\"chaser_specific_impulse\" : 220.0, "
+         << "\"arrival_distance_tolerance\" : 1.0, "
+         << "\"output_directory\" : \".\", "
+         << "\"chaser_state_history_filename\" : \"state.csv\", "
+         << "\"chaser_thrust_history_filename\" : \"thrust.csv\" }";
+    return line.str( );
+}
+
+TEST_CASE( "Test batch runner", "[batch_runner]" )
+{
+    const char* thrustModes[ ] = { "throttle", "on_off", "off", "throttle", "throttle" };
+    const Real thrustMaxima[ ] = { 0.05, 0.5, 0.0, 0.0, 5.0 };
+    const ThrustMode thrustModeValues[ ] = { throttle, onOff, off, throttle, throttle };
+
+    // Empty lines and comments are skipped and do not count as scenarios.
+    std::stringstream manifest;
+    manifest << "// Batch runner test manifest.\n";
+    for ( int i = 0; i < 5; ++i )
+    {
+        manifest << createManifestLine( thrustModes[ i ], thrustMaxima[ i ] ) << "\n";
+        if ( i == 2 )
+        {
+            manifest << "\n";
+        }
+    }
+
+    // Hold at most two scenarios in memory, such that the manifest is read in several chunks.
+    BatchResultRecordingSink resultSink;
+    const std::size_t numberOfScenarios
+        = executeBatch( manifest, "manifest.jsonl", BatchSettings( 2, 2 ), resultSink );
+    REQUIRE( numberOfScenarios == 5 );
+    REQUIRE( resultSink.rows.size( ) == 5 );
+
+    // Results are written in the order of the manifest and match the single simulator.
+    for ( std::size_t i = 0; i < 5; ++i )
+    {
+        const UserInput input = createTestInput( thrustModeValues[ i ],
+                                                 thrustMaxima[ i ],
+                                                 500.0,
+                                                 1.0,
+                                                 testChaserInitialState,
+                                                 100.0,
+                                                 1.0,
+                                                 PropagatorSettings( ),
+                                                 220.0 );
+        Simulator simulator( input, false );
+        simulator.execute( );
+
+        const std::vector< Real >& row = resultSink.rows[ i ];
+        REQUIRE( row[ 0 ] == static_cast< Real >( i ) );
+        REQUIRE( row[ 1 ] == Approx( simulator.getFinalDistanceToTarget( ) ) );
+        REQUIRE( row[ 2 ] == ( simulator.isTargetReached( ) ? 1.0 : 0.0 ) );
+        REQUIRE( row[ 3 ] == Approx( simulator.getTotalDeltaV( ) ) );
+        REQUIRE( row[ 4 ] == ( simulator.isThrottleMaximumReached( ) ? 1.0 : 0.0 ) );
+        REQUIRE( row[ 6 ] == Approx( 500.0 ) );
+        REQUIRE( row[ 7 ] == Approx( simulator.getPropellantMass( ) ) );
+    }
+}
+
+TEST_CASE( "Test batch runner with invalid scenario", "[batch_runner]" )
+{
+    // The invalid scenario is in the second chunk, such that the first chunk has been written.
+    std::stringstream manifest;
+    manifest << createManifestLine( "throttle", 0.05 ) << "\n"
+             << createManifestLine( "on_off", 0.5 ) << "\n"
+             << createManifestLine( "throttle", -1.0 ) << "\n"
+             << createManifestLine( "throttle", 0.5 ) << "\n";
+
+    BatchResultRecordingSink resultSink;
+    REQUIRE_THROWS_AS(
+        executeBatch( manifest, "manifest.jsonl", BatchSettings( 2, 2 ), resultSink ),
+        std::invalid_argument );
+    REQUIRE( resultSink.rows.size( ) == 2 );
+
+    std::stringstream unparsableManifest;
+    unparsableManifest << "{ \"propagation_settings\" : }\n";
+    REQUIRE_THROWS_AS( executeBatch( unparsableManifest,
+                                     "manifest.jsonl",
+                                     BatchSettings( 2, 2 ),
+                                     resultSink ),
+                       std::runtime_error );
+}
+
+} // namespace tests
+} // namespace rvdsim
@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <catch.hpp>
+
+#include "rvdsim/capi.h"
+#include "rvdsim/simulator.hpp"
+#include "rvdsim/typedefs.hpp"
+#include "rvdsim/userInput.hpp"
+
+#include "testInputFactory.hpp"
+
+namespace rvdsim
+{
+namespace tests
+{
+
+//! Create settings for C API tests.
+RvdsimSettings createCApiSettings( )
+{
+    RvdsimSettings settings;
+    REQUIRE( rvdsimInitialiseSettings( &settings ) == RVDSIM_SUCCESS );
+    settings.endTime = 500.0;
+    settings.targetSemiMajorAxis = 6778.0e3;
+    settings.thrustMaximum = 0.5;
+    settings.chaserSpecificImpulse = 220.0;
+    return settings;
+}
+
+TEST_CASE( "Test C API simulation", "[c_api]" )
+{
+    REQUIRE( rvdsimGetApiVersion( ) == RVDSIM_API_VERSION );
+
+    const RvdsimSettings settings = createCApiSettings( );
+    const double chaserInitialState[ 6 ] = { -100.0, -1000.0, 10.0, 0.0, 0.1, 0.0 };
+    const Vector6 expectedInitialState = { { -100.0, -1000.0, 10.0, 0.0, 0.1, 0.0 } };
+
+    Simulator expectedSimulator( createTestInput( throttle,
+                                                  0.5,
+                                                  500.0,
+                                                  1.0,
+                                                  expectedInitialState,
+                                                  100.0,
+                                                  1.0,
+                                                  PropagatorSettings( ),
+                                                  220.0 ) );
+    expectedSimulator.execute( );
+
+    RvdsimSimulator* simulator = 0;
+    REQUIRE( rvdsimCreateSimulator( &settings, &simulator ) == RVDSIM_SUCCESS );
+    REQUIRE( simulator != 0 );
+
+    // Summary and histories are only available once the simulator has been executed.
+    RvdsimSummary summary;
+    REQUIRE( rvdsimGetSummary( simulator, &summary ) == RVDSIM_ERROR_INVALID_ARGUMENT );
+    REQUIRE( rvdsimGetNumberOfStates( simulator ) == 0 );
+    REQUIRE( rvdsimGetStateHistoryColumn( simulator, 0 ) == 0 );
+
+    SECTION( "Test summary and histories" )
+    {
+        // Executing the simulator more than once yields identical results.
+        for ( int execution = 0; execution < 2; ++execution )
+        {
+            REQUIRE( rvdsimExecuteSimulation( simulator, chaserInitialState ) == RVDSIM_SUCCESS );
+
+            REQUIRE( rvdsimGetSummary( simulator, &summary ) == RVDSIM_SUCCESS );
+            const SimulationSummary expectedSummary = expectedSimulator.getSummary( );
+            REQUIRE( summary.finalDistanceToTarget == expectedSummary.finalDistanceToTarget );
+            REQUIRE( summary.totalDeltaV == expectedSummary.totalDeltaV );
+            REQUIRE( summary.propellantMass == expectedSummary.propellantMass );
+            REQUIRE( summary.propellantMass > 0.0 );
+            REQUIRE( summary.throttleSaturationTime == expectedSummary.throttleSaturationTime );
+            REQUIRE( summary.terminationTime == expectedSummary.terminationTime );
+            REQUIRE( summary.isTargetReached == ( expectedSummary.isTargetReached ? 1 : 0 ) );
+            REQUIRE( summary.isThrottleMax == ( expectedSummary.isThrottleMax ? 1 : 0 ) );
+            REQUIRE( summary.isTerminatedEarly == 0 );
+
+            const StateHistory& expectedStates = expectedSimulator.getChaserStateHistory( );
+            REQUIRE( rvdsimGetNumberOfStates( simulator ) == expectedStates.size( ) );
+            REQUIRE( rvdsimGetStateHistoryColumn( simulator, 7 ) == 0 );
+            for ( std::size_t i = 0; i < expectedStates.size( ); ++i )
+            {
+                REQUIRE( rvdsimGetStateHistoryColumn( simulator, 0 )[ i ]
+                         == expectedStates.getEpoch( i ) );
+                for ( std::size_t j = 0; j < 6; ++j )
+                {
+                    REQUIRE( rvdsimGetStateHistoryColumn( simulator, j + 1 )[ i ]
+                             == expectedStates( i, j ) );
+                }
+            }
+
+            const ThrustHistory& expectedThrusts = expectedSimulator.getChaserThrustHistory( );
+            REQUIRE( rvdsimGetNumberOfThrusts( simulator ) == expectedThrusts.size( ) );
+            REQUIRE( rvdsimGetThrustHistoryColumn( simulator, 4 ) == 0 );
+            for ( std::size_t i = 0; i < expectedThrusts.size( ); ++i )
+            {
+                REQUIRE( rvdsimGetThrustHistoryColumn( simulator, 0 )[ i ]
+                         == expectedThrusts.getEpoch( i ) );
+                for ( std::size_t j = 0; j < 3; ++j )
+                {
+                    REQUIRE( rvdsimGetThrustHistoryColumn( simulator, j + 1 )[ i ]
+                             == expectedThrusts( i, j ) );
+                }
+            }
+        }
+    }
+
+    SECTION( "Test invalid initial state" )
+    {
+        const double invalidInitialState[ 6 ]
+            = { std::numeric_limits< double >::quiet_NaN( ), 0.0, 0.0, 0.0, 0.0, 0.0 };
+        REQUIRE( rvdsimExecuteSimulation( simulator, invalidInitialState )
+                 == RVDSIM_ERROR_INVALID_ARGUMENT );
+        REQUIRE( rvdsimExecuteSimulation( simulator, 0 ) == RVDSIM_ERROR_NULL_POINTER );
+        REQUIRE( rvdsimExecuteSimulation( 0, chaserInitialState ) == RVDSIM_ERROR_NULL_POINTER );
+    }
+
+    rvdsimDestroySimulator( simulator );
+    rvdsimDestroySimulator( 0 );
+}
+
+TEST_CASE( "Test C API invalid settings", "[c_api]" )
+{
+    RvdsimSimulator* simulator = 0;
+    REQUIRE( rvdsimCreateSimulator( 0, &simulator ) == RVDSIM_ERROR_NULL_POINTER );
+    REQUIRE( rvdsimInitialiseSettings( 0 ) == RVDSIM_ERROR_NULL_POINTER );
+
+    RvdsimSettings settings = createCApiSettings( );
+    REQUIRE( rvdsimCreateSimulator( &settings, 0 ) == RVDSIM_ERROR_NULL_POINTER );
+
+    SECTION( "Test non-positive thrust frequency" )
+    {
+        settings.thrustFrequency = 0.0;
+    }
+
+    SECTION( "Test non-positive chaser wet mass" )
+    {
+        settings.chaserWetMass = -1.0;
+    }
+
+    SECTION( "Test negative maximum thrust" )
+    {
+        settings.thrustMaximum = -1.0;
+    }
+
+    SECTION( "Test unknown thrust mode" )
+    {
+        settings.thrustMode = 3;
+    }
+
+    SECTION( "Test unknown propagator" )
+    {
+        settings.propagator = -1;
+    }
+
+    SECTION( "Test hyperbolic target orbit" )
+    {
+        settings.propagator = RVDSIM_PROPAGATOR_YAMANAKA_ANKERSEN;
+        settings.targetEccentricity = 1.0;
+    }
+
+    SECTION( "Test J2-perturbed target orbit intersecting the Earth" )
+    {
+        settings.propagator = RVDSIM_PROPAGATOR_J2_NONLINEAR;
+        settings.targetSemiMajorAxis = 6000.0e3;
+    }
+
+    SECTION( "Test end time before start time" )
+    {
+        settings.endTime = -1.0;
+    }
+
+    REQUIRE( rvdsimCreateSimulator( &settings, &simulator ) == RVDSIM_ERROR_INVALID_SETTINGS );
+    REQUIRE( simulator == 0 );
+    REQUIRE( rvdsimExecuteBatch( &settings, 0, 0, 0, 1 ) == RVDSIM_ERROR_INVALID_SETTINGS );
+    REQUIRE( std::string( rvdsimGetStatusMessage( RVDSIM_ERROR_INVALID_SETTINGS ) )
+             == "invalid simulation settings" );
+}
+
+TEST_CASE( "Test C API batch of simulations", "[c_api]" )
+{
+    RvdsimSettings settings = createCApiSettings( );
+    settings.isHistoryStored = 1;
+
+    const std::size_t numberOfSimulations = 37;
+    std::vector< double > chaserInitialStates( 6 * numberOfSimulations, 0.0 );
+    for ( std::size_t i = 0; i < numberOfSimulations; ++i )
+    {
+        chaserInitialStates[ 6 * i ] = -100.0 + 10.0 * static_cast< double >( i );
+        chaserInitialStates[ 6 * i + 1 ] = -1000.0;
+        chaserInitialStates[ 6 * i + 4 ] = 0.1;
+    }
+
+    // Summaries are identical to executing the simulations one by one, irrespective of the number
+    // of threads.
+    RvdsimSimulator* simulator = 0;
+    REQUIRE( rvdsimCreateSimulator( &settings, &simulator ) == RVDSIM_SUCCESS );
+    std::vector< RvdsimSummary > expectedSummaries( numberOfSimulations );
+    for ( std::size_t i = 0; i < numberOfSimulations; ++i )
+    {
+        REQUIRE( rvdsimExecuteSimulation( simulator, &chaserInitialStates[ 6 * i ] )
+                 == RVDSIM_SUCCESS );
+        REQUIRE( rvdsimGetSummary( simulator, &expectedSummaries[ i ] ) == RVDSIM_SUCCESS );
+    }
+    rvdsimDestroySimulator( simulator );
+
+    const std::size_t numbersOfThreads[ 3 ] = { 1, 4, 0 };
+    for ( std::size_t t = 0; t < 3; ++t )
+    {
+        std::vector< RvdsimSummary > summaries( numberOfSimulations );
+        REQUIRE( rvdsimExecuteBatch( &settings,
+                                     numberOfSimulations,
+                                     &chaserInitialStates[ 0 ],
+                                     &summaries[ 0 ],
+                                     numbersOfThreads[ t ] ) == RVDSIM_SUCCESS );
+        for ( std::size_t i = 0; i < numberOfSimulations; ++i )
+        {
+            REQUIRE( summaries[ i ].finalDistanceToTarget
+                     == expectedSummaries[ i ].finalDistanceToTarget );
+            REQUIRE( summaries[ i ].totalDeltaV == expectedSummaries[ i ].totalDeltaV );
+            REQUIRE( summaries[ i ].propellantMass == expectedSummaries[ i ].propellantMass );
+            REQUIRE( summaries[ i ].isTargetReached == expectedSummaries[ i ].isTargetReached );
+        }
+    }
+
+    REQUIRE( rvdsimExecuteBatch( &settings, 0, 0, 0, 4 ) == RVDSIM_SUCCESS );
+    REQUIRE( rvdsimExecuteBatch( &settings, numberOfSimulations, 0, 0, 4 )
+             == RVDSIM_ERROR_NULL_POINTER );
+
+    chaserInitialStates[ 6 * 20 + 3 ] = std::numeric_limits< double >::infinity( );
+    std::vector< RvdsimSummary > summaries( numberOfSimulations );
+    REQUIRE( rvdsimExecuteBatch( &settings,
+                                 numberOfSimulations,
+                                 &chaserInitialStates[ 0 ],
+                                 &summaries[ 0 ],
+                                 4 ) == RVDSIM_ERROR_INVALID_ARGUMENT );
+}
+
+} // namespace tests
+} // namespace rvdsim
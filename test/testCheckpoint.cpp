@@ -0,0 +1,362 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <catch.hpp>
+
+#include "rvdsim/checkpoint.hpp"
+#include "rvdsim/outputSink.hpp"
+#include "rvdsim/simulator.hpp"
+#include "rvdsim/typedefs.hpp"
+#include "rvdsim/userInput.hpp"
+
+#include "testInputFactory.hpp"
+
+namespace rvdsim
+{
+namespace tests
+{
+
+//! Read contents of file written by checkpoint tests.
+std::string readCheckpointTestFile( const std::string& filePath )
+{
+    std::ifstream file( filePath.c_str( ), std::ios::binary );
+    return std::string( std::istreambuf_iterator< char >( file ),
+                        std::istreambuf_iterator< char >( ) );
+}
+
+//! Create output sinks for checkpoint tests and run simulation, optionally from checkpoint.
+void runCheckpointTestSimulation( const UserInput& input,
+                                  const std::string& filePrefix,
+                                  const std::string& checkpointPath,
+                                  const SimulatorCheckpoint* checkpoint,
+                                  Simulator& simulator )
+{
+    const char* stateColumnNames[ ] = { "t", "x", "y", "z", "xdot", "ydot", "zdot" };
+    const char* thrustColumnNames[ ] = { "t", "Tx", "Ty", "Tz" };
+    const char* trajectoryColumnNames[ ]
+        = { "t", "x", "y", "z", "xdot", "ydot", "zdot", "Tx", "Ty", "Tz" };
+    std::unique_ptr< OutputSink > stateSink = createOutputSink(
+        input.outputFormat,
+        filePrefix + "_state",
+        std::vector< std::string >( stateColumnNames, stateColumnNames + 7 ),
+        checkpoint != 0 ? &checkpoint->stateSinkPosition : 0 );
+    std::unique_ptr< OutputSink > thrustSink = createOutputSink(
+        input.outputFormat,
+        filePrefix + "_thrust",
+        std::vector< std::string >( thrustColumnNames, thrustColumnNames + 4 ),
+        checkpoint != 0 ? &checkpoint->thrustSinkPosition : 0 );
+    std::unique_ptr< OutputSink > trajectorySink = createOutputSink(
+        binaryOutput,
+        filePrefix + "_trajectory",
+        std::vector< std::string >( trajectoryColumnNames, trajectoryColumnNames + 10 ),
+        checkpoint != 0 ? &checkpoint->trajectorySinkPosition : 0 );
+
+    simulator.setOutputSinks( stateSink.get( ), thrustSink.get( ), trajectorySink.get( ) );
+    if ( !checkpointPath.empty( ) )
+    {
+        simulator.setCheckpointing( checkpointPath, 300 );
+    }
+
+    if ( checkpoint != 0 )
+    {
+        simulator.resume( *checkpoint );
+    }
+    else
+    {
+        simulator.execute( );
+    }
+
+    stateSink->close( );
+    thrustSink->close( );
+    trajectorySink->close( );
+    simulator.setOutputSinks( );
+}
+
+TEST_CASE( "Test checkpoint file", "[checkpoint]" )
+{
+    const std::string filePath = "test_checkpoint.bin";
+
+    SimulatorCheckpoint checkpoint;
+    checkpoint.startTime = 0.0;
+    checkpoint.endTime = 1000.0;
+    checkpoint.thrustPulseTime = 0.1;
+    checkpoint.thrustMode = onOff;
+    checkpoint.thrustMaximum = 0.5;
+    checkpoint.chaserWetMass = 100.0;
+    checkpoint.targetSemiMajorAxis = 6778.0e3;
+    checkpoint.propagatorType = j2NonlinearPropagator;
+    checkpoint.stepIndex = 1234;
+    checkpoint.currentTime = 123.4;
+    checkpoint.timeToGo = 876.6;
+    const Vector6 currentState = { { -1.0, 2.0, -3.0e-17, 4.0, 5.0, 1.0 / 3.0 } };
+    checkpoint.currentState = currentState;
+    checkpoint.chaserMass = 99.875;
+    checkpoint.isThrottleMax = true;
+    checkpoint.totalDeltaV = 0.123;
+    checkpoint.propellantMass = 0.125;
+    checkpoint.throttleSaturationTime = 12.5;
+    checkpoint.outputSamplerState.nextIntervalIndex = 17;
+    checkpoint.outputSamplerState.isStarted = true;
+    checkpoint.outputSamplerState.wasThrustOn = false;
+    checkpoint.outputSamplerState.wasThrottleSaturated = true;
+    checkpoint.outputSamplerState.wasWithinArrivalTolerance = false;
+    checkpoint.propagatorState.push_back( 1.0e7 );
+    checkpoint.propagatorState.push_back( -0.5 );
+    checkpoint.stateSinkPosition.fileOffset = 1000;
+    checkpoint.stateSinkPosition.numberOfRows = 20;
+    checkpoint.thrustSinkPosition.fileOffset = 500;
+    checkpoint.thrustSinkPosition.numberOfRows = 19;
+    checkpoint.trajectorySinkPosition.fileOffset = 0;
+    checkpoint.trajectorySinkPosition.numberOfRows = 0;
+
+    std::remove( filePath.c_str( ) );
+    REQUIRE( !isCheckpointAvailable( filePath ) );
+
+    // Writing a checkpoint replaces the previous one.
+    writeCheckpoint( filePath, SimulatorCheckpoint( checkpoint ) );
+    checkpoint.stepIndex = 1235;
+    writeCheckpoint( filePath, checkpoint );
+    REQUIRE( isCheckpointAvailable( filePath ) );
+    REQUIRE( readCheckpointTestFile( filePath ).compare( 0, 8, checkpointMagic ) == 0 );
+
+    const SimulatorCheckpoint readBack = readCheckpoint( filePath );
+    REQUIRE( readBack.startTime == checkpoint.startTime );
+    REQUIRE( readBack.endTime == checkpoint.endTime );
+    REQUIRE( readBack.thrustPulseTime == checkpoint.thrustPulseTime );
+    REQUIRE( readBack.thrustMode == onOff );
+    REQUIRE( readBack.thrustMaximum == checkpoint.thrustMaximum );
+    REQUIRE( readBack.chaserWetMass == checkpoint.chaserWetMass );
+    REQUIRE( readBack.targetSemiMajorAxis == checkpoint.targetSemiMajorAxis );
+    REQUIRE( readBack.propagatorType == j2NonlinearPropagator );
+    REQUIRE( readBack.stepIndex == 1235 );
+    REQUIRE( readBack.currentTime == checkpoint.currentTime );
+    REQUIRE( readBack.timeToGo == checkpoint.timeToGo );
+    for ( int i = 0; i < 6; ++i )
+    {
+        REQUIRE( readBack.currentState[ i ] == checkpoint.currentState[ i ] );
+    }
+    REQUIRE( readBack.chaserMass == checkpoint.chaserMass );
+    REQUIRE( readBack.isThrottleMax );
+    REQUIRE( readBack.totalDeltaV == checkpoint.totalDeltaV );
+    REQUIRE( readBack.propellantMass == checkpoint.propellantMass );
+    REQUIRE( readBack.throttleSaturationTime == checkpoint.throttleSaturationTime );
+    REQUIRE( readBack.outputSamplerState.nextIntervalIndex == 17 );
+    REQUIRE( readBack.outputSamplerState.isStarted );
+    REQUIRE( !readBack.outputSamplerState.wasThrustOn );
+    REQUIRE( readBack.outputSamplerState.wasThrottleSaturated );
+    REQUIRE( !readBack.outputSamplerState.wasWithinArrivalTolerance );
+    REQUIRE( readBack.propagatorState == checkpoint.propagatorState );
+    REQUIRE( readBack.stateSinkPosition.fileOffset == 1000 );
+    REQUIRE( readBack.stateSinkPosition.numberOfRows == 20 );
+    REQUIRE( readBack.thrustSinkPosition.fileOffset == 500 );
+    REQUIRE( readBack.thrustSinkPosition.numberOfRows == 19 );
+    REQUIRE( readBack.trajectorySinkPosition.fileOffset == 0 );
+
+    // Truncated checkpoint files are rejected.
+    const std::string contents = readCheckpointTestFile( filePath );
+    {
+        std::ofstream file( filePath.c_str( ), std::ios::binary );
+        file.write( contents.data( ), static_cast< std::streamsize >( contents.size( ) - 1 ) );
+    }
+    REQUIRE_THROWS_AS( readCheckpoint( filePath ), std::runtime_error );
+
+    std::remove( filePath.c_str( ) );
+    REQUIRE_THROWS_AS( readCheckpoint( filePath ), std::runtime_error );
+}
+
+TEST_CASE( "Test resuming output sinks", "[checkpoint]" )
+{
+    std::vector< std::string > columnNames;
+    columnNames.push_back( "t" );
+    columnNames.push_back( "x" );
+
+    SECTION( "Test CSV output sink" )
+    {
+        const std::string filePath = "test_checkpoint_sink.csv";
+        OutputSinkPosition position;
+        {
+            CsvOutputSink sink( filePath, columnNames, 6, 16 );
+            const Real firstRow[ 2 ] = { 0.0, 1.5 };
+            sink.writeRow( firstRow );
+            position = sink.synchronize( );
+
+            // Rows written after the position was recorded are discarded when resuming.
+            const Real discardedRow[ 2 ] = { 1.0, -7.0 };
+            sink.writeRow( discardedRow );
+        }
+        REQUIRE( position.fileOffset == 10 );
+        REQUIRE( position.numberOfRows == 1 );
+
+        {
+            CsvOutputSink sink( filePath, columnNames, 6, 16, &position );
+            REQUIRE( sink.getNumberOfRows( ) == 1 );
+            const Real secondRow[ 2 ] = { 1.0, 2.5 };
+            sink.writeRow( secondRow );
+        }
+        REQUIRE( readCheckpointTestFile( filePath ) == "t,x\n0,1.5\n1,2.5\n" );
+
+        std::remove( filePath.c_str( ) );
+    }
+
+    SECTION( "Test binary output sink" )
+    {
+        const std::string filePath = "test_checkpoint_sink.bin";
+        const std::string expectedFilePath = "test_checkpoint_sink_expected.bin";
+        const Real rows[ 3 ][ 2 ] = { { 0.0, 1.5 }, { 1.0, -7.0 }, { 2.0, 2.5 } };
+
+        {
+            BinaryOutputSink expectedSink( expectedFilePath, columnNames );
+            expectedSink.writeRow( rows[ 0 ] );
+            expectedSink.writeRow( rows[ 2 ] );
+        }
+
+        OutputSinkPosition position;
+        {
+            BinaryOutputSink sink( filePath, columnNames, 8 );
+            sink.writeRow( rows[ 0 ] );
+            position = sink.synchronize( );
+            sink.writeRow( rows[ 1 ] );
+        }
+        REQUIRE( position.numberOfRows == 1 );
+
+        {
+            BinaryOutputSink sink( filePath, columnNames, 8, &position );
+            sink.writeRow( rows[ 2 ] );
+        }
+
+        // The number of rows in the header is updated when the resumed sink is closed.
+        REQUIRE( readCheckpointTestFile( filePath )
+                 == readCheckpointTestFile( expectedFilePath ) );
+
+        std::remove( filePath.c_str( ) );
+        std::remove( expectedFilePath.c_str( ) );
+    }
+}
+
+TEST_CASE( "Test resuming simulation from checkpoint", "[checkpoint]" )
+{
+    const std::string checkpointPath = "test_checkpoint_simulation.bin";
+    const OutputFormat outputFormats[ ] = { csvOutput, binaryOutput };
+    const PropagatorSettings propagatorSettings[ ]
+        = { PropagatorSettings( ), PropagatorSettings( j2NonlinearPropagator, 0.05, 0.9, 2.0 ) };
+    const Real chaserSpecificImpulses[ ] = { 0.0, 220.0 };
+    const char* fileTypes[ ] = { "_state", "_thrust", "_trajectory" };
+
+    for ( int j = 0; j < 2; ++j )
+    {
+        const UserInput input
+            = createTestInput( onOff,
+                               0.5,
+                               1000.0,
+                               1.0,
+                               testChaserInitialState,
+                               100.0,
+                               1.0,
+                               propagatorSettings[ j ],
+                               chaserSpecificImpulses[ j ],
+                               outputFormats[ j ],
+                               OutputSamplingSettings( fixedInterval, 1, 7.0, true ) );
+
+        // Uninterrupted reference simulation.
+        Simulator referenceSimulator( input, false );
+        runCheckpointTestSimulation( input, "test_reference", "", 0, referenceSimulator );
+
+        // Simulation that writes checkpoints; the output files written after the last checkpoint
+        // play the role of the partial output of an interrupted simulation.
+        std::remove( checkpointPath.c_str( ) );
+        Simulator interruptedSimulator( input, false );
+        runCheckpointTestSimulation(
+            input, "test_resumed", checkpointPath, 0, interruptedSimulator );
+        REQUIRE( isCheckpointAvailable( checkpointPath ) );
+
+        const SimulatorCheckpoint checkpoint = readCheckpoint( checkpointPath );
+        REQUIRE( checkpoint.stepIndex == 900 );
+        REQUIRE( checkpoint.currentTime < input.endTime );
+
+        // Resume simulation from last checkpoint with a new simulator.
+        Simulator resumedSimulator( input, true );
+        runCheckpointTestSimulation(
+            input, "test_resumed", "", &checkpoint, resumedSimulator );
+
+        for ( int i = 0; i < 6; ++i )
+        {
+            REQUIRE( resumedSimulator.getChaserFinalState( )[ i ]
+                     == referenceSimulator.getChaserFinalState( )[ i ] );
+        }
+        REQUIRE( resumedSimulator.getTotalDeltaV( ) == referenceSimulator.getTotalDeltaV( ) );
+        REQUIRE( resumedSimulator.getPropellantMass( )
+                 == referenceSimulator.getPropellantMass( ) );
+        REQUIRE( resumedSimulator.getChaserFinalMass( )
+                 == referenceSimulator.getChaserFinalMass( ) );
+        REQUIRE( resumedSimulator.isThrottleMaximumReached( )
+                 == referenceSimulator.isThrottleMaximumReached( ) );
+        REQUIRE( resumedSimulator.getChaserStateHistory( ).size( ) == 101 );
+
+        for ( int k = 0; k < 3; ++k )
+        {
+            const std::string referencePath = std::string( "test_reference" ) + fileTypes[ k ];
+            const std::string resumedPath = std::string( "test_resumed" ) + fileTypes[ k ];
+            REQUIRE( readCheckpointTestFile( resumedPath )
+                     == readCheckpointTestFile( referencePath ) );
+            std::remove( referencePath.c_str( ) );
+            std::remove( resumedPath.c_str( ) );
+        }
+        std::remove( checkpointPath.c_str( ) );
+    }
+}
+
+TEST_CASE( "Test resuming simulation with mismatched settings", "[checkpoint]" )
+{
+    const UserInput input = createTestInput( onOff, 0.5, 100.0 );
+    Simulator simulator( input, false );
+    simulator.execute( );
+    const SimulatorCheckpoint checkpoint = simulator.createCheckpoint( );
+
+    SECTION( "Test different thrust mode" )
+    {
+        Simulator otherSimulator( createTestInput( throttle, 0.5, 100.0 ), false );
+        REQUIRE_THROWS_AS( otherSimulator.resume( checkpoint ), std::runtime_error );
+    }
+
+    SECTION( "Test different thrust maximum" )
+    {
+        Simulator otherSimulator( createTestInput( onOff, 0.25, 100.0 ), false );
+        REQUIRE_THROWS_AS( otherSimulator.resume( checkpoint ), std::runtime_error );
+    }
+
+    SECTION( "Test different chaser wet mass" )
+    {
+        Simulator otherSimulator(
+            createTestInput( onOff, 0.5, 100.0, 1.0, testChaserInitialState, 50.0 ), false );
+        REQUIRE_THROWS_AS( otherSimulator.resume( checkpoint ), std::runtime_error );
+    }
+
+    SECTION( "Test different propagator" )
+    {
+        Simulator otherSimulator(
+            createTestInput( onOff,
+                             0.5,
+                             100.0,
+                             1.0,
+                             testChaserInitialState,
+                             100.0,
+                             1.0,
+                             PropagatorSettings( yamanakaAnkersenPropagator ) ),
+            false );
+        REQUIRE_THROWS_AS( otherSimulator.resume( checkpoint ), std::runtime_error );
+    }
+}
+
+} // namespace tests
+} // namespace rvdsim
@@ -0,0 +1,335 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <astro/astro.hpp>
+
+#include "rvdsim/clohessyWiltshire.hpp"
+#include "rvdsim/timeGrid.hpp"
+#include "rvdsim/typedefs.hpp"
+
+namespace rvdsim
+{
+namespace tests
+{
+
+//! Mean motion of target in low Earth orbit [rad/s].
+const Real testMeanMotion = std::sqrt( 3.986004418e14 / ( 6778.0e3 * 6778.0e3 * 6778.0e3 ) );
+
+//! Create batch of distinct initial states.
+StateBatch createTestStateBatch( const std::size_t numberOfStates )
+{
+    StateBatch states( numberOfStates );
+    for ( std::size_t i = 0; i < numberOfStates; ++i )
+    {
+        const Real offset = static_cast< Real >( i );
+        const Vector6 state = { { -100.0 + 3.0 * offset,
+                                  -1000.0 + 50.0 * offset,
+                                  10.0 - offset,
+                                  0.01 * offset,
+                                  0.1 - 0.005 * offset,
+                                  -0.002 * offset } };
+        states.setVector( i, state );
+    }
+    return states;
+}
+
+//! Create batch of distinct constant accelerations.
+AccelerationBatch createTestAccelerationBatch( const std::size_t numberOfStates )
+{
+    AccelerationBatch accelerations( numberOfStates );
+    for ( std::size_t i = 0; i < numberOfStates; ++i )
+    {
+        const Real offset = static_cast< Real >( i );
+        const Vector3 acceleration = { { 1.0e-3 * offset, -2.0e-3 + 1.0e-4 * offset, 5.0e-4 } };
+        accelerations.setVector( i, acceleration );
+    }
+    return accelerations;
+}
+
+TEST_CASE( "Test Clohessy-Wiltshire state transition", "[clohessy-wiltshire]" )
+{
+    const Vector6 initialState = { { -100.0, -1000.0, 10.0, 0.0, 0.1, -0.01 } };
+    const Vector3 acceleration = { { 1.0e-3, -2.0e-3, 5.0e-4 } };
+
+    SECTION( "Test single state against closed-form solution" )
+    {
+        const Real propagationTimes[ ] = { 0.1, 1.0, 60.0, 2000.0 };
+        for ( std::size_t j = 0; j < 4; ++j )
+        {
+            const ClohessyWiltshireStateTransition transition
+                = computeClohessyWiltshireStateTransition( testMeanMotion, propagationTimes[ j ] );
+
+            Vector6 finalState;
+            propagateClohessyWiltshire( transition, initialState, acceleration, finalState );
+
+            const Vector6 expectedFinalState
+                = astro::propagateClohessyWiltshireSolution(
+                    initialState, propagationTimes[ j ], testMeanMotion, acceleration );
+
+            for ( int i = 0; i < 6; ++i )
+            {
+                REQUIRE( finalState[ i ]
+                         == Approx( expectedFinalState[ i ] )
+                            .epsilon( 1.0e-12 ).margin( 1.0e-12 ) );
+            }
+        }
+    }
+
+    SECTION( "Test in-place propagation" )
+    {
+        const ClohessyWiltshireStateTransition transition
+            = computeClohessyWiltshireStateTransition( testMeanMotion, 1.0 );
+
+        Vector6 expectedFinalState;
+        propagateClohessyWiltshire( transition, initialState, acceleration, expectedFinalState );
+
+        Vector6 state = initialState;
+        propagateClohessyWiltshire( transition, state, acceleration, state );
+
+        for ( int i = 0; i < 6; ++i )
+        {
+            REQUIRE( state[ i ] == expectedFinalState[ i ] );
+        }
+    }
+
+    SECTION( "Test zero propagation time" )
+    {
+        const ClohessyWiltshireStateTransition transition
+            = computeClohessyWiltshireStateTransition( testMeanMotion, 0.0 );
+
+        Vector6 finalState;
+        propagateClohessyWiltshire( transition, initialState, acceleration, finalState );
+
+        for ( int i = 0; i < 6; ++i )
+        {
+            REQUIRE( finalState[ i ] == Approx( initialState[ i ] ) );
+        }
+    }
+}
+
+TEST_CASE( "Test cached Clohessy-Wiltshire state transition", "[clohessy-wiltshire]" )
+{
+    const ClohessyWiltshireStateTransition expectedTransition
+        = computeClohessyWiltshireStateTransition( testMeanMotion, 0.1 );
+
+    // Request the same transition repeatedly, interleaved with enough other transitions to
+    // overflow the cache, such that cached, recomputed and replaced entries are all exercised.
+    for ( int k = 0; k < 3; ++k )
+    {
+        for ( int j = 1; j < 40; ++j )
+        {
+            getClohessyWiltshireStateTransition( testMeanMotion, 0.1 * j + 0.05 );
+        }
+
+        const ClohessyWiltshireStateTransition transition
+            = getClohessyWiltshireStateTransition( testMeanMotion, 0.1 );
+        const ClohessyWiltshireStateTransition cachedTransition
+            = getClohessyWiltshireStateTransition( testMeanMotion, 0.1 );
+
+        for ( int i = 0; i < 6; ++i )
+        {
+            for ( int j = 0; j < 6; ++j )
+            {
+                REQUIRE( transition.stateTransitionMatrix[ i ][ j ]
+                         == expectedTransition.stateTransitionMatrix[ i ][ j ] );
+                REQUIRE( cachedTransition.stateTransitionMatrix[ i ][ j ]
+                         == expectedTransition.stateTransitionMatrix[ i ][ j ] );
+            }
+
+            for ( int j = 0; j < 3; ++j )
+            {
+                REQUIRE( transition.inputMatrix[ i ][ j ]
+                         == expectedTransition.inputMatrix[ i ][ j ] );
+                REQUIRE( cachedTransition.inputMatrix[ i ][ j ]
+                         == expectedTransition.inputMatrix[ i ][ j ] );
+            }
+        }
+    }
+}
+
+TEST_CASE( "Test Clohessy-Wiltshire state transition over Time-To-Go", "[clohessy-wiltshire]" )
+{
+    // Time grid of 40000 thruster pulses, of which the last pulse is shorter.
+    const TimeGrid timeGrid( 0.0, 19999.75, 0.5 );
+    const Real tolerance = 1.0e-12;
+
+    ClohessyWiltshireTimeToGoTransition timeToGoTransition( testMeanMotion, timeGrid, tolerance );
+    REQUIRE( timeToGoTransition.getSynchronisationInterval( ) > 1 );
+    REQUIRE( timeToGoTransition.getSynchronisationInterval( ) < timeGrid.getNumberOfSteps( ) );
+
+    SECTION( "Test accuracy with respect to direct computation" )
+    {
+        const Real n = testMeanMotion;
+        for ( std::size_t k = 0; k < timeGrid.getNumberOfSteps( ); ++k )
+        {
+            const Real timeToGo = timeGrid.getTimeToGo( k );
+            const ClohessyWiltshireStateTransition& transition = timeToGoTransition.update( k );
+            const ClohessyWiltshireStateTransition expectedTransition
+                = computeClohessyWiltshireStateTransition( n, timeToGo );
+
+            // The trigonometric terms are within the tolerance of their direct computation.
+            const Matrix66& phi = transition.stateTransitionMatrix;
+            REQUIRE( std::fabs( phi[ 3 ][ 3 ] - std::cos( n * timeToGo ) ) <= tolerance );
+            REQUIRE( std::fabs( 0.5 * phi[ 3 ][ 4 ] - std::sin( n * timeToGo ) ) <= tolerance );
+            REQUIRE( std::fabs( phi[ 4 ][ 0 ] / ( -6.0 * n )
+                                - 2.0 * std::sin( 0.5 * n * timeToGo )
+                                  * std::sin( 0.5 * n * timeToGo ) ) <= tolerance );
+
+            for ( int i = 0; i < 6; ++i )
+            {
+                for ( int j = 0; j < 6; ++j )
+                {
+                    REQUIRE( phi[ i ][ j ]
+                             == Approx( expectedTransition.stateTransitionMatrix[ i ][ j ] )
+                                .epsilon( 1.0e-12 ).margin( 6.0 * tolerance / n ) );
+                }
+
+                for ( int j = 0; j < 3; ++j )
+                {
+                    REQUIRE( transition.inputMatrix[ i ][ j ]
+                             == Approx( expectedTransition.inputMatrix[ i ][ j ] )
+                                .epsilon( 1.0e-12 ).margin( 16.0 * tolerance / ( n * n ) ) );
+                }
+            }
+        }
+    }
+
+    SECTION( "Test independence of order of updates" )
+    {
+        // The transition at a pulse does not depend on the pulses requested before, e.g., when
+        // coast arcs are skipped or a simulation is resumed.
+        std::vector< ClohessyWiltshireStateTransition > expectedTransitions;
+        for ( std::size_t k = 0; k < 5000; ++k )
+        {
+            expectedTransitions.push_back( timeToGoTransition.update( k ) );
+        }
+
+        ClohessyWiltshireTimeToGoTransition otherTransition( testMeanMotion, timeGrid, tolerance );
+        const std::size_t stepIndices[ ] = { 4999, 17, 18, 2500, 1, 4321, 4320, 0, 4999 };
+        for ( std::size_t l = 0; l < 9; ++l )
+        {
+            const ClohessyWiltshireStateTransition& transition
+                = otherTransition.update( stepIndices[ l ] );
+            const ClohessyWiltshireStateTransition& expectedTransition
+                = expectedTransitions[ stepIndices[ l ] ];
+            for ( int i = 0; i < 6; ++i )
+            {
+                REQUIRE( transition.stateTransitionMatrix[ i ]
+                         == expectedTransition.stateTransitionMatrix[ i ] );
+                REQUIRE( transition.inputMatrix[ i ] == expectedTransition.inputMatrix[ i ] );
+            }
+        }
+    }
+
+    SECTION( "Test direct computation for each pulse" )
+    {
+        ClohessyWiltshireTimeToGoTransition directTransition( testMeanMotion, timeGrid, 0.0 );
+        REQUIRE( directTransition.getSynchronisationInterval( ) == 1 );
+
+        const std::size_t k = timeGrid.getNumberOfSteps( ) - 1;
+        const ClohessyWiltshireStateTransition expectedTransition
+            = computeClohessyWiltshireStateTransition( testMeanMotion, timeGrid.getTimeToGo( k ) );
+        const Matrix66& phi = directTransition.update( k ).stateTransitionMatrix;
+        for ( int i = 0; i < 6; ++i )
+        {
+            for ( int j = 0; j < 6; ++j )
+            {
+                REQUIRE( phi[ i ][ j ]
+                         == Approx( expectedTransition.stateTransitionMatrix[ i ][ j ] )
+                            .epsilon( 1.0e-14 ).margin( 1.0e-14 ) );
+            }
+        }
+    }
+}
+
+TEST_CASE( "Test batch Clohessy-Wiltshire propagation", "[clohessy-wiltshire]" )
+{
+    // Odd batch size, such that the remainder that does not fill a SIMD register is also tested.
+    const std::size_t numberOfStates = 13;
+    const Real propagationTime = 10.0;
+
+    const StateBatch initialStates = createTestStateBatch( numberOfStates );
+    const AccelerationBatch accelerations = createTestAccelerationBatch( numberOfStates );
+    const ClohessyWiltshireStateTransition transition
+        = computeClohessyWiltshireStateTransition( testMeanMotion, propagationTime );
+
+    const std::string instructionSet = getBatchInstructionSet( );
+    REQUIRE( ( instructionSet == "avx512" || instructionSet == "avx2"
+               || instructionSet == "scalar" ) );
+
+    SECTION( "Test batch against closed-form solution" )
+    {
+        StateBatch finalStates;
+        propagateClohessyWiltshireBatch( transition, initialStates, accelerations, finalStates );
+
+        StateBatch scalarFinalStates;
+        propagateClohessyWiltshireBatchScalar(
+            transition, initialStates, accelerations, scalarFinalStates );
+
+        REQUIRE( finalStates.size( ) == numberOfStates );
+        REQUIRE( scalarFinalStates.size( ) == numberOfStates );
+
+        for ( std::size_t j = 0; j < numberOfStates; ++j )
+        {
+            Vector6 initialState;
+            Vector3 acceleration;
+            initialStates.getVector( j, initialState );
+            accelerations.getVector( j, acceleration );
+
+            const Vector6 expectedFinalState
+                = astro::propagateClohessyWiltshireSolution(
+                    initialState, propagationTime, testMeanMotion, acceleration );
+
+            for ( std::size_t i = 0; i < 6; ++i )
+            {
+                REQUIRE( finalStates( j, i )
+                         == Approx( expectedFinalState[ i ] )
+                            .epsilon( 1.0e-12 ).margin( 1.0e-12 ) );
+                REQUIRE( finalStates( j, i )
+                         == Approx( scalarFinalStates( j, i ) ).epsilon( 1.0e-14 ) );
+            }
+        }
+    }
+
+    SECTION( "Test in-place batch propagation" )
+    {
+        StateBatch expectedFinalStates;
+        propagateClohessyWiltshireBatchScalar(
+            transition, initialStates, accelerations, expectedFinalStates );
+
+        StateBatch states = initialStates;
+        propagateClohessyWiltshireBatch( transition, states, accelerations, states );
+
+        for ( std::size_t j = 0; j < numberOfStates; ++j )
+        {
+            for ( std::size_t i = 0; i < 6; ++i )
+            {
+                REQUIRE( states( j, i )
+                         == Approx( expectedFinalStates( j, i ) ).epsilon( 1.0e-14 ) );
+            }
+        }
+    }
+
+    SECTION( "Test empty batch" )
+    {
+        const StateBatch emptyStates;
+        const AccelerationBatch emptyAccelerations;
+        StateBatch finalStates( 3 );
+        propagateClohessyWiltshireBatch( transition, emptyStates, emptyAccelerations, finalStates );
+
+        REQUIRE( finalStates.size( ) == 0 );
+    }
+}
+
+} // namespace tests
+} // namespace rvdsim
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <rapidjson/document.h>
+
+#include "rvdsim/configLoader.hpp"
+
+namespace rvdsim
+{
+namespace tests
+{
+
+//! Write text to file.
+void writeConfigFile( const std::string& filePath, const std::string& text )
+{
+    std::ofstream file( filePath.c_str( ) );
+    file << text;
+}
+
+TEST_CASE( "Test reading file contents", "[config_loader]" )
+{
+    const std::string filePath = "test_config_loader.txt";
+    writeConfigFile( filePath, "abc\ndef" );
+
+    const std::vector< char > contents = readFileContents( filePath );
+    REQUIRE( contents.size( ) == 8 );
+    REQUIRE( std::string( &contents[ 0 ] ) == "abc\ndef" );
+
+    std::remove( filePath.c_str( ) );
+}
+
+TEST_CASE( "Test loading JSON file", "[config_loader]" )
+{
+    const std::string filePath = "test_config_loader.json";
+
+    // Comments may be indented or follow values, and trailing commas are allowed.
+    writeConfigFile( filePath,
+                     "// Header comment.\n"
+                     "{\n"
+                     "    // Set propagation parameters.\n"
+                     "    \"propagation_settings\" : [0.0, 100.0,], // Trailing comment.\n"
+                     "    /* Multi-line\n"
+                     "       comment. */\n"
+                     "    \"output_directory\" : \"/path/to//output\",\n"
+                     "}\n" );
+
+    const ConfigCollection configs = loadConfigs( filePath );
+    REQUIRE( configs.size( ) == 1 );
+    REQUIRE( configs.getName( 0 ) == filePath );
+
+    const rapidjson::Document& config = configs.getDocument( 0 );
+    REQUIRE( config[ "propagation_settings" ].Size( ) == 2 );
+    REQUIRE( config[ "propagation_settings" ][ 1 ].GetDouble( ) == Approx( 100.0 ) );
+    REQUIRE( std::string( config[ "output_directory" ].GetString( ) ) == "/path/to//output" );
+
+    std::remove( filePath.c_str( ) );
+}
+
+TEST_CASE( "Test loading JSON-lines file", "[config_loader]" )
+{
+    const std::string filePath = "test_config_loader.jsonl";
+    writeConfigFile( filePath,
+                     "{ \"scenario\" : 1, \"name\" : \"first\" }\n"
+                     "\n"
+                     "// Skipped scenario.\n"
+                     "  { \"scenario\" : 2, \"name\" : \"second\" }\r\n"
+                     "{ \"scenario\" : 3, \"name\" : \"third\" }" );
+
+    const ConfigCollection configs = loadConfigs( filePath );
+    REQUIRE( configs.size( ) == 3 );
+    REQUIRE( configs.getName( 1 ) == filePath + ":4" );
+
+    const char* expectedNames[ ] = { "first", "second", "third" };
+    for ( int i = 0; i < 3; ++i )
+    {
+        REQUIRE( configs.getDocument( i )[ "scenario" ].GetInt( ) == i + 1 );
+        REQUIRE( std::string( configs.getDocument( i )[ "name" ].GetString( ) )
+                 == expectedNames[ i ] );
+    }
+
+    std::remove( filePath.c_str( ) );
+}
+
+TEST_CASE( "Test invalid JSON-lines input", "[config_loader]" )
+{
+    ConfigCollection configs;
+    REQUIRE( configs.addJsonLine( "{ \"scenario\" : 1 }", "manifest.jsonl:1" ) );
+    REQUIRE_THROWS_AS( configs.addJsonLine( "{ \"scenario\" : }", "manifest.jsonl:2" ),
+                       std::runtime_error );
+    REQUIRE_THROWS_AS( readFileContents( "non_existent_config.json" ), std::runtime_error );
+}
+
+} // namespace tests
+} // namespace rvdsim
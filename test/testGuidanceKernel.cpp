@@ -0,0 +1,277 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <astro/astro.hpp>
+#include <control/control.hpp>
+#include <sml/sml.hpp>
+
+#include "rvdsim/clohessyWiltshire.hpp"
+#include "rvdsim/guidanceKernel.hpp"
+#include "rvdsim/thrustPolicy.hpp"
+#include "rvdsim/typedefs.hpp"
+
+namespace rvdsim
+{
+namespace tests
+{
+
+//! Mean motion of target in 400 km circular orbit used for guidance kernel tests [rad/s].
+const Real guidanceKernelMeanMotion = 1.1313e-3;
+
+//! Chaser states used for guidance kernel tests [m; m/s].
+const Vector6 guidanceKernelStates[ 4 ]
+    = { { { -100.0, -1000.0, 10.0, 0.0, 0.1, 0.0 } },
+        { { 250.0, 3000.0, -40.0, 0.2, -0.4, 0.05 } },
+        { { -5.0, -20.0, 1.0, 0.01, 0.02, -0.001 } },
+        { { 0.5, 2.0, 0.0, -0.001, 0.0, 0.0 } } };
+
+//! Compute thrust acceleration by composing astro, control and sml calls.
+/*!
+ * Reference implementation of the guidance kernel, as previously used by the simulator.
+ */
+template< typename ThrustPolicy >
+Real computeReferenceThrustAcceleration( const Vector6& state,
+                                         const Real timeToGo,
+                                         const Real thrustAccelerationMaximum,
+                                         Vector3& thrustAcceleration,
+                                         bool& isSaturated )
+{
+    const Vector3 zeroAcceleration = { { 0.0, 0.0, 0.0 } };
+    const Vector6 zeroThrustEndState = astro::propagateClohessyWiltshireSolution(
+        state, timeToGo, guidanceKernelMeanMotion, zeroAcceleration );
+
+    Vector3 zeroEffortMiss;
+    Vector3 zeroEffortVelocity;
+    for ( int i = 0; i < 3; ++i )
+    {
+        zeroEffortMiss[ i ] = -zeroThrustEndState[ i ];
+        zeroEffortVelocity[ i ] = -zeroThrustEndState[ i + 3 ];
+    }
+
+    thrustAcceleration
+        = control::computeOptimalGuidanceLaw( zeroEffortMiss, zeroEffortVelocity, timeToGo );
+    isSaturated = applyThrustPolicy< ThrustPolicy >( thrustAccelerationMaximum,
+                                                     thrustAcceleration );
+    return sml::norm< Real >( thrustAcceleration );
+}
+
+//! Check guidance kernel against composition of astro, control and sml calls.
+template< typename ThrustPolicy >
+void checkGuidanceKernel( const Real thrustAccelerationMaximum )
+{
+    const Real timesToGo[ 4 ] = { 5000.0, 1000.0, 10.0, 0.5 };
+    for ( std::size_t j = 0; j < 4; ++j )
+    {
+        const ClohessyWiltshireStateTransition timeToGoTransition
+            = computeClohessyWiltshireStateTransition( guidanceKernelMeanMotion, timesToGo[ j ] );
+
+        for ( std::size_t k = 0; k < 4; ++k )
+        {
+            const Vector6& state = guidanceKernelStates[ k ];
+
+            Vector3 expectedThrustAcceleration;
+            bool isExpectedSaturated = false;
+            const Real expectedNorm = computeReferenceThrustAcceleration< ThrustPolicy >(
+                state, timesToGo[ j ], thrustAccelerationMaximum,
+                expectedThrustAcceleration, isExpectedSaturated );
+
+            Vector3 zeroEffortMiss;
+            Vector3 zeroEffortVelocity;
+            Vector3 thrustAcceleration;
+            bool isSaturated = false;
+            const Real norm = evaluateGuidanceKernel< ThrustPolicy >( timeToGoTransition,
+                                                                      timesToGo[ j ],
+                                                                      state,
+                                                                      thrustAccelerationMaximum,
+                                                                      zeroEffortMiss,
+                                                                      zeroEffortVelocity,
+                                                                      thrustAcceleration,
+                                                                      isSaturated );
+
+            REQUIRE( isSaturated == isExpectedSaturated );
+            REQUIRE( norm == Approx( expectedNorm ).epsilon( 1.0e-12 ).margin( 1.0e-18 ) );
+            for ( int i = 0; i < 3; ++i )
+            {
+                REQUIRE( thrustAcceleration[ i ]
+                         == Approx( expectedThrustAcceleration[ i ] )
+                            .epsilon( 1.0e-12 ).margin( 1.0e-18 ) );
+            }
+
+            // The ZEM and ZEV are the negative of the ballistic end state.
+            const Vector3 zeroAcceleration = { { 0.0, 0.0, 0.0 } };
+            const Vector6 zeroThrustEndState = astro::propagateClohessyWiltshireSolution(
+                state, timesToGo[ j ], guidanceKernelMeanMotion, zeroAcceleration );
+            for ( int i = 0; i < 3; ++i )
+            {
+                REQUIRE( zeroEffortMiss[ i ]
+                         == Approx( -zeroThrustEndState[ i ] ).epsilon( 1.0e-12 ) );
+                REQUIRE( zeroEffortVelocity[ i ]
+                         == Approx( -zeroThrustEndState[ i + 3 ] ).epsilon( 1.0e-12 ) );
+            }
+        }
+    }
+}
+
+TEST_CASE( "Test guidance kernel", "[guidance_kernel]" )
+{
+    SECTION( "Test unconstrained thruster" )
+    {
+        checkGuidanceKernel< UnconstrainedThrustPolicy >( 0.0 );
+    }
+
+    SECTION( "Test throttled thruster" )
+    {
+        checkGuidanceKernel< ThrottleThrustPolicy >( 1.0e-3 );
+        checkGuidanceKernel< ThrottleThrustPolicy >( 1.0e-5 );
+    }
+
+    SECTION( "Test on-off thruster" )
+    {
+        checkGuidanceKernel< OnOffThrustPolicy >( 1.0e-3 );
+        checkGuidanceKernel< OnOffThrustPolicy >( 1.0e-5 );
+    }
+
+    SECTION( "Test ballistic end state given" )
+    {
+        // Both overloads yield identical results for the same ballistic end state.
+        const Real timeToGo = 1000.0;
+        const ClohessyWiltshireStateTransition timeToGoTransition
+            = computeClohessyWiltshireStateTransition( guidanceKernelMeanMotion, timeToGo );
+        const Vector3 zeroAcceleration = { { 0.0, 0.0, 0.0 } };
+        Vector6 zeroThrustEndState;
+        propagateClohessyWiltshire( timeToGoTransition,
+                                    guidanceKernelStates[ 1 ],
+                                    zeroAcceleration,
+                                    zeroThrustEndState );
+
+        Vector3 zeroEffortMiss;
+        Vector3 zeroEffortVelocity;
+        Vector3 thrustAcceleration;
+        bool isSaturated = false;
+        const Real norm = evaluateGuidanceKernel< ThrottleThrustPolicy >( zeroThrustEndState,
+                                                                          timeToGo,
+                                                                          1.0e-3,
+                                                                          zeroEffortMiss,
+                                                                          zeroEffortVelocity,
+                                                                          thrustAcceleration,
+                                                                          isSaturated );
+
+        Vector3 expectedThrustAcceleration;
+        bool isExpectedSaturated = false;
+        const Real expectedNorm = evaluateGuidanceKernel< ThrottleThrustPolicy >(
+            timeToGoTransition, timeToGo, guidanceKernelStates[ 1 ], 1.0e-3,
+            zeroEffortMiss, zeroEffortVelocity, expectedThrustAcceleration, isExpectedSaturated );
+
+        REQUIRE( norm == expectedNorm );
+        REQUIRE( thrustAcceleration == expectedThrustAcceleration );
+        REQUIRE( isSaturated == isExpectedSaturated );
+    }
+}
+
+TEST_CASE( "Test batched guidance kernel", "[guidance_kernel]" )
+{
+    // Batch of chasers with mixed thrust policies, including runs of the same policy and a number
+    // of chasers that does not fill complete SIMD registers.
+    const std::size_t numberOfChasers = 23;
+    const ThrustPolicyType policies[ 4 ] = { throttleThrustPolicy,
+                                             onOffThrustPolicy,
+                                             unconstrainedThrustPolicy,
+                                             noThrustPolicy };
+
+    StateBatch states( numberOfChasers );
+    std::vector< ThrustPolicyType > thrustPolicies( numberOfChasers );
+    std::vector< Real > thrustAccelerationMaxima( numberOfChasers );
+    for ( std::size_t i = 0; i < numberOfChasers; ++i )
+    {
+        Vector6 state = guidanceKernelStates[ i % 4 ];
+        state[ 0 ] += static_cast< Real >( i );
+        states.setVector( i, state );
+        thrustPolicies[ i ] = policies[ ( i / 3 ) % 4 ];
+        thrustAccelerationMaxima[ i ] = i % 2 == 0 ? 1.0e-3 : 2.0e-5;
+    }
+
+    const Real timeToGo = 750.0;
+    const ClohessyWiltshireStateTransition timeToGoTransition
+        = computeClohessyWiltshireStateTransition( guidanceKernelMeanMotion, timeToGo );
+
+    AccelerationBatch thrustAccelerations;
+    std::vector< Real > thrustAccelerationNorms;
+    std::vector< unsigned char > isSaturated;
+    evaluateGuidanceKernelBatch( timeToGoTransition,
+                                 timeToGo,
+                                 states,
+                                 thrustPolicies,
+                                 thrustAccelerationMaxima,
+                                 thrustAccelerations,
+                                 thrustAccelerationNorms,
+                                 isSaturated );
+
+    REQUIRE( thrustAccelerations.size( ) == numberOfChasers );
+    REQUIRE( thrustAccelerationNorms.size( ) == numberOfChasers );
+    REQUIRE( isSaturated.size( ) == numberOfChasers );
+
+    // The batched kernel yields results equal to the single-chaser kernel up to rounding, since
+    // the batched kernel may use SIMD instructions.
+    bool isAnySaturated = false;
+    for ( std::size_t i = 0; i < numberOfChasers; ++i )
+    {
+        Vector6 state;
+        states.getVector( i, state );
+
+        Vector3 zeroEffortMiss;
+        Vector3 zeroEffortVelocity;
+        Vector3 expectedThrustAcceleration = { { 0.0, 0.0, 0.0 } };
+        bool isExpectedSaturated = false;
+        Real expectedNorm = 0.0;
+        switch ( thrustPolicies[ i ] )
+        {
+            case noThrustPolicy:
+                break;
+
+            case unconstrainedThrustPolicy:
+                expectedNorm = evaluateGuidanceKernel< UnconstrainedThrustPolicy >(
+                    timeToGoTransition, timeToGo, state, thrustAccelerationMaxima[ i ],
+                    zeroEffortMiss, zeroEffortVelocity, expectedThrustAcceleration,
+                    isExpectedSaturated );
+                break;
+
+            case throttleThrustPolicy:
+                expectedNorm = evaluateGuidanceKernel< ThrottleThrustPolicy >(
+                    timeToGoTransition, timeToGo, state, thrustAccelerationMaxima[ i ],
+                    zeroEffortMiss, zeroEffortVelocity, expectedThrustAcceleration,
+                    isExpectedSaturated );
+                break;
+
+            case onOffThrustPolicy:
+                expectedNorm = evaluateGuidanceKernel< OnOffThrustPolicy >(
+                    timeToGoTransition, timeToGo, state, thrustAccelerationMaxima[ i ],
+                    zeroEffortMiss, zeroEffortVelocity, expectedThrustAcceleration,
+                    isExpectedSaturated );
+                break;
+        }
+
+        REQUIRE( thrustAccelerationNorms[ i ]
+                 == Approx( expectedNorm ).epsilon( 1.0e-14 ).margin( 1.0e-20 ) );
+        REQUIRE( ( isSaturated[ i ] != 0 ) == isExpectedSaturated );
+        for ( std::size_t j = 0; j < 3; ++j )
+        {
+            REQUIRE( thrustAccelerations( i, j )
+                     == Approx( expectedThrustAcceleration[ j ] )
+                        .epsilon( 1.0e-14 ).margin( 1.0e-20 ) );
+        }
+        isAnySaturated = isAnySaturated || isExpectedSaturated;
+    }
+    REQUIRE( isAnySaturated );
+}
+
+} // namespace tests
+} // namespace rvdsim
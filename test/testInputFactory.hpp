@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef RVDSIM_TEST_INPUT_FACTORY_HPP
+#define RVDSIM_TEST_INPUT_FACTORY_HPP
+
+#include "rvdsim/typedefs.hpp"
+#include "rvdsim/userInput.hpp"
+
+namespace rvdsim
+{
+namespace tests
+{
+
+//! Nominal initial state of chaser used in tests [m; m/s].
+const Vector6 testChaserInitialState = { { -100.0, -1000.0, 10.0, 0.0, 0.1, 0.0 } };
+
+//! Create user input for tests.
+/*!
+ * Creates user input for a close-range approach of a chaser to a target in a circular orbit at an
+ * altitude of 400 km, starting at t = 0 s. The output directory and filenames are dummies, since
+ * the simulator does not write output files itself.
+ *
+ * @param[in] thrustMode               Thrust mode (default: throttle)
+ * @param[in] thrustMaximum            Maximum thrust [N] (default: 0.5)
+ * @param[in] endTime                  Simulation end time [s] (default: 1000.0)
+ * @param[in] thrustFrequency          Thruster frequency [Hz] (default: 1.0)
+ * @param[in] chaserInitialState       Initial state of chaser [m; m/s]
+ *                                     (default: testChaserInitialState)
+ * @param[in] chaserWetMass            Wet mass of chaser [kg] (default: 100.0)
+ * @param[in] arrivalDistanceTolerance Arrival distance tolerance [m] (default: 1.0)
+ * @param[in] propagatorSettings       Propagator settings (default: Clohessy-Wiltshire)
+ * @param[in] chaserSpecificImpulse    Specific impulse of chaser [s]; 0 for constant mass
+ *                                     (default: 0.0)
+ * @param[in] outputFormat             Format of output files (default: csvOutput)
+ * @param[in] outputSampling           Output sampling settings (default: every step)
+ * @return                             User input
+ */
+inline UserInput createTestInput(
+    const ThrustMode thrustMode = throttle,
+    const Real thrustMaximum = 0.5,
+    const Real endTime = 1000.0,
+    const Real thrustFrequency = 1.0,
+    const Vector6& chaserInitialState = testChaserInitialState,
+    const Real chaserWetMass = 100.0,
+    const Real arrivalDistanceTolerance = 1.0,
+    const PropagatorSettings& propagatorSettings = PropagatorSettings( ),
+    const Real chaserSpecificImpulse = 0.0,
+    const OutputFormat outputFormat = csvOutput,
+    const OutputSamplingSettings& outputSampling = OutputSamplingSettings( ) )
+{
+    return UserInput( 0.0,
+                      endTime,
+                      3.986004418e14,
+                      6778.0e3,
+                      chaserInitialState,
+                      thrustMode,
+                      thrustMaximum,
+                      thrustFrequency,
+                      chaserWetMass,
+                      arrivalDistanceTolerance,
+                      "/path/to/output/directory",
+                      "chaser_state_history.csv",
+                      "chaser_thrust_history.csv",
+                      outputFormat,
+                      "",
+                      outputSampling,
+                      "",
+                      AdaptiveSchedulingSettings( ),
+                      propagatorSettings,
+                      CheckpointSettings( ),
+                      chaserSpecificImpulse );
+}
+
+} // namespace tests
+} // namespace rvdsim
+
+#endif // RVDSIM_TEST_INPUT_FACTORY_HPP
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <catch.hpp>
+
+#include "rvdsim/instrumentation.hpp"
+#include "rvdsim/simulator.hpp"
+#include "rvdsim/typedefs.hpp"
+#include "rvdsim/userInput.hpp"
+
+#include "testInputFactory.hpp"
+
+namespace rvdsim
+{
+namespace tests
+{
+
+TEST_CASE( "Test instrumentation metrics", "[instrumentation]" )
+{
+    resetInstrumentation( );
+
+    SECTION( "Test phase times and counters" )
+    {
+        addInstrumentationPhaseTime( guidancePhase, 100 );
+        addInstrumentationPhaseTime( guidancePhase, 50 );
+        incrementInstrumentationCounter( bytesWrittenCounter, 1024 );
+        {
+            const ScopedTimer timer( outputPhase );
+        }
+
+        const InstrumentationSnapshot snapshot = getInstrumentationSnapshot( );
+        REQUIRE( snapshot.phaseTimes[ guidancePhase ] == 150 );
+        REQUIRE( snapshot.phaseCalls[ guidancePhase ] == 2 );
+        REQUIRE( snapshot.phaseCalls[ outputPhase ] == 1 );
+        REQUIRE( snapshot.phaseCalls[ propagationPhase ] == 0 );
+        REQUIRE( snapshot.counters[ bytesWrittenCounter ] == 1024 );
+        REQUIRE( snapshot.counters[ guidanceCallCounter ] == 0 );
+
+        resetInstrumentation( );
+        REQUIRE( getInstrumentationSnapshot( ).phaseCalls[ guidancePhase ] == 0 );
+        REQUIRE( getInstrumentationSnapshot( ).counters[ bytesWrittenCounter ] == 0 );
+    }
+
+    SECTION( "Test metrics accumulated over threads" )
+    {
+        // Metrics of threads that have exited are retained.
+        std::thread firstThread(
+            [ ]( ) { incrementInstrumentationCounter( guidanceCallCounter, 3 ); } );
+        std::thread secondThread(
+            [ ]( ) { incrementInstrumentationCounter( guidanceCallCounter, 4 ); } );
+        firstThread.join( );
+        secondThread.join( );
+        incrementInstrumentationCounter( guidanceCallCounter, 5 );
+
+        REQUIRE( getInstrumentationSnapshot( ).counters[ guidanceCallCounter ] == 12 );
+    }
+
+    SECTION( "Test report and metrics file" )
+    {
+        incrementInstrumentationCounter( throttleSaturationCounter, 7 );
+
+        std::ostringstream report;
+        writeInstrumentationReport( report );
+        REQUIRE( report.str( ).find( "throttle_saturations" ) != std::string::npos );
+        REQUIRE( report.str( ).find( "json_parse" ) != std::string::npos );
+
+        const std::string filePath = "test_instrumentation_metrics.json";
+        writeInstrumentationMetrics( filePath );
+        std::ifstream metricsFile( filePath.c_str( ) );
+        const std::string metrics( ( std::istreambuf_iterator< char >( metricsFile ) ),
+                                   std::istreambuf_iterator< char >( ) );
+        metricsFile.close( );
+        std::remove( filePath.c_str( ) );
+
+        REQUIRE( metrics.find( "\"throttle_saturations\": 7" ) != std::string::npos );
+        REQUIRE( metrics.find( "\"guidance\": { \"calls\": 0, \"time_ns\": 0 }" )
+                 != std::string::npos );
+    }
+
+    resetInstrumentation( );
+}
+
+TEST_CASE( "Test simulator instrumentation", "[instrumentation]" )
+{
+    const UserInput input = createTestInput( throttle, 0.05, 100.0 );
+
+    resetInstrumentation( );
+    Simulator simulator( input, false );
+    simulator.execute( );
+    const InstrumentationSnapshot snapshot = getInstrumentationSnapshot( );
+    resetInstrumentation( );
+
+    if ( isInstrumentationEnabled( ) )
+    {
+        // Each step evaluates guidance and propagates the state over the thruster pulse.
+        REQUIRE( snapshot.phaseCalls[ simulationPhase ] == 1 );
+        REQUIRE( snapshot.counters[ guidanceCallCounter ] == 100 );
+        REQUIRE( snapshot.phaseCalls[ propagationPhase ] == 100 );
+        REQUIRE( snapshot.counters[ propagationCounter ] == 100 );
+        REQUIRE( snapshot.counters[ throttleSaturationCounter ] > 0 );
+    }
+    else
+    {
+        // Instrumentation is compiled out, so that no metrics are recorded.
+        REQUIRE( snapshot.phaseCalls[ simulationPhase ] == 0 );
+        REQUIRE( snapshot.counters[ guidanceCallCounter ] == 0 );
+        REQUIRE( snapshot.counters[ propagationCounter ] == 0 );
+    }
+}
+
+} // namespace tests
+} // namespace rvdsim
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <catch.hpp>
+
+#include "rvdsim/monteCarlo.hpp"
+#include "rvdsim/simulator.hpp"
+#include "rvdsim/typedefs.hpp"
+#include "rvdsim/userInput.hpp"
+
+#include "testInputFactory.hpp"
+
+namespace rvdsim
+{
+namespace tests
+{
+
+//! Create dispersion settings for Monte Carlo tests.
+DispersionSettings createDispersionSettings( const std::size_t numberOfThreads )
+{
+    StateDispersion chaserInitialStateDispersion;
+    chaserInitialStateDispersion[ 0 ] = Dispersion( normalDispersion, 0.0, 10.0 );
+    chaserInitialStateDispersion[ 1 ] = Dispersion( uniformDispersion, -50.0, 50.0 );
+
+    return DispersionSettings( 64,
+                               12345,
+                               numberOfThreads,
+                               chaserInitialStateDispersion,
+                               Dispersion( uniformDispersion, -5.0, 5.0 ),
+                               Dispersion( normalDispersion, 0.0, 0.01 ),
+                               Dispersion( ),
+                               "monte_carlo_summary.csv" );
+}
+
+TEST_CASE( "Test dispersed input", "[monte_carlo]" )
+{
+    const UserInput nominalInput = createTestInput( throttle, 0.5, 500.0 );
+    const DispersionSettings settings = createDispersionSettings( 1 );
+
+    const UserInput firstInput = computeDispersedInput( nominalInput, settings, 3 );
+    const UserInput secondInput = computeDispersedInput( nominalInput, settings, 3 );
+    const UserInput otherInput = computeDispersedInput( nominalInput, settings, 4 );
+
+    // Dispersed input only depends on seed and sample index.
+    for ( int i = 0; i < 6; ++i )
+    {
+        REQUIRE( firstInput.chaserInitialState[ i ] == secondInput.chaserInitialState[ i ] );
+    }
+    REQUIRE( firstInput.chaserWetMass == secondInput.chaserWetMass );
+    REQUIRE( firstInput.chaserInitialState[ 0 ] != otherInput.chaserInitialState[ 0 ] );
+
+    // Parameters that are not dispersed keep their nominal values.
+    REQUIRE( firstInput.chaserInitialState[ 2 ] == nominalInput.chaserInitialState[ 2 ] );
+    REQUIRE( firstInput.targetSemiMajorAxis     == nominalInput.targetSemiMajorAxis );
+    REQUIRE( firstInput.thrustFrequency         == nominalInput.thrustFrequency );
+
+    // Uniform offsets are within bounds.
+    REQUIRE( std::fabs( firstInput.chaserInitialState[ 1 ]
+                        - nominalInput.chaserInitialState[ 1 ] ) <= 50.0 );
+    REQUIRE( std::fabs( firstInput.chaserWetMass - nominalInput.chaserWetMass ) <= 5.0 );
+}
+
+TEST_CASE( "Test truncated dispersion", "[monte_carlo]" )
+{
+    const UserInput nominalInput = createTestInput( throttle, 0.5, 500.0 );
+    const DispersionSettings settings( 256,
+                                       12345,
+                                       1,
+                                       StateDispersion( ),
+                                       Dispersion( normalDispersion, 0.0, 100.0 ),
+                                       Dispersion( normalDispersion, 0.0, 0.5 ),
+                                       Dispersion( normalDispersion, 0.0, 6778.0e3 ),
+                                       "monte_carlo_summary.csv" );
+
+    // Offsets that yield invalid values are redrawn, such that a constrained thruster remains
+    // constrained and the chaser wet mass and target semi-major axis remain positive.
+    std::size_t numberOfRedrawnSamples = 0;
+    for ( std::size_t i = 0; i < settings.numberOfSamples; ++i )
+    {
+        bool isRedrawn = false;
+        const UserInput input = computeDispersedInput( nominalInput, settings, i, isRedrawn );
+        REQUIRE( input.chaserWetMass > 0.0 );
+        REQUIRE( input.thrustMaximum > 0.0 );
+        REQUIRE( input.targetSemiMajorAxis > 0.0 );
+        numberOfRedrawnSamples += isRedrawn ? 1 : 0;
+
+        // Both overloads yield the same dispersed input.
+        const UserInput repeatedInput = computeDispersedInput( nominalInput, settings, i );
+        REQUIRE( repeatedInput.chaserWetMass == input.chaserWetMass );
+    }
+
+    REQUIRE( numberOfRedrawnSamples > 0 );
+    REQUIRE( numberOfRedrawnSamples < settings.numberOfSamples );
+
+    // Summaries of executed samples report if any offset was redrawn.
+    const std::vector< SimulationSummary > summaries
+        = executeMonteCarloSamples( nominalInput, settings, 0, 16 );
+    std::size_t numberOfRedrawnSummaries = 0;
+    for ( std::size_t i = 0; i < summaries.size( ); ++i )
+    {
+        bool isRedrawn = false;
+        computeDispersedInput( nominalInput, settings, i, isRedrawn );
+        REQUIRE( summaries[ i ].isRedrawn == isRedrawn );
+        numberOfRedrawnSummaries += isRedrawn ? 1 : 0;
+    }
+    REQUIRE( numberOfRedrawnSummaries > 0 );
+}
+
+TEST_CASE( "Test invalid dispersion", "[monte_carlo]" )
+{
+    // The lower bound of the wet mass dispersion yields a negative wet mass, which is reported on
+    // the calling thread before any sample is executed.
+    const UserInput nominalInput = createTestInput( throttle, 0.5, 500.0 );
+    const DispersionSettings settings( 16,
+                                       12345,
+                                       2,
+                                       StateDispersion( ),
+                                       Dispersion( uniformDispersion, -200.0, 5.0 ),
+                                       Dispersion( ),
+                                       Dispersion( ),
+                                       "monte_carlo_summary.csv" );
+    REQUIRE_THROWS_AS( computeDispersedInput( nominalInput, settings, 0 ), std::invalid_argument );
+    REQUIRE_THROWS_AS( executeMonteCarloSamples( nominalInput, settings, 0, 16 ),
+                       std::invalid_argument );
+}
+
+TEST_CASE( "Test Monte Carlo reproducibility", "[monte_carlo]" )
+{
+    const UserInput nominalInput = createTestInput( throttle, 0.5, 500.0 );
+
+    const std::vector< SimulationSummary > serialSummaries
+        = executeMonteCarloAnalysis( nominalInput, createDispersionSettings( 1 ) );
+    const std::vector< SimulationSummary > parallelSummaries
+        = executeMonteCarloAnalysis( nominalInput, createDispersionSettings( 4 ) );
+
+    REQUIRE( serialSummaries.size( ) == 64 );
+    REQUIRE( parallelSummaries.size( ) == 64 );
+
+    // Results are identical, independent of the number of threads.
+    for ( std::size_t i = 0; i < serialSummaries.size( ); ++i )
+    {
+        REQUIRE( serialSummaries[ i ].finalDistanceToTarget
+                 == parallelSummaries[ i ].finalDistanceToTarget );
+        REQUIRE( serialSummaries[ i ].totalDeltaV   == parallelSummaries[ i ].totalDeltaV );
+        REQUIRE( serialSummaries[ i ].isThrottleMax == parallelSummaries[ i ].isThrottleMax );
+    }
+
+    // A range of samples executed separately yields the same summaries.
+    const std::vector< SimulationSummary > rangeSummaries
+        = executeMonteCarloSamples( nominalInput, createDispersionSettings( 2 ), 13, 9 );
+    REQUIRE( rangeSummaries.size( ) == 9 );
+    for ( std::size_t i = 0; i < rangeSummaries.size( ); ++i )
+    {
+        REQUIRE( rangeSummaries[ i ].finalDistanceToTarget
+                 == serialSummaries[ 13 + i ].finalDistanceToTarget );
+        REQUIRE( rangeSummaries[ i ].totalDeltaV == serialSummaries[ 13 + i ].totalDeltaV );
+    }
+
+    // Each summary matches a simulation executed directly with the dispersed input.
+    const UserInput sampleInput
+        = computeDispersedInput( nominalInput, createDispersionSettings( 1 ), 17 );
+    Simulator simulator( sampleInput );
+    simulator.execute( );
+    REQUIRE( simulator.getFinalDistanceToTarget( )
+             == serialSummaries[ 17 ].finalDistanceToTarget );
+    REQUIRE( simulator.getTotalDeltaV( ) == serialSummaries[ 17 ].totalDeltaV );
+}
+
+} // namespace tests
+} // namespace rvdsim
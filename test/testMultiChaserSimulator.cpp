@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <rapidjson/document.h>
+
+#include "rvdsim/multiChaserSimulator.hpp"
+#include "rvdsim/outputSink.hpp"
+#include "rvdsim/simulator.hpp"
+#include "rvdsim/typedefs.hpp"
+#include "rvdsim/userInput.hpp"
+
+#include "testInputFactory.hpp"
+
+namespace rvdsim
+{
+namespace tests
+{
+
+//! Output sink that counts rows written per chaser.
+class ChaserRowCountingSink : public OutputSink
+{
+public:
+
+    ChaserRowCountingSink( const std::vector< std::string >& someColumnNames,
+                           const std::size_t numberOfChasers )
+        : OutputSink( someColumnNames ),
+          rowsPerChaser( numberOfChasers, 0 )
+    { }
+
+    void writeRow( const Real* row )
+    {
+        ++rowsPerChaser[ static_cast< std::size_t >( row[ 1 ] ) ];
+        ++numberOfRows;
+    }
+
+    void close( ) { }
+
+    std::vector< std::size_t > rowsPerChaser;
+};
+
+TEST_CASE( "Test multi-chaser input", "[multi_chaser_simulator]" )
+{
+    const UserInput nominalInput = createTestInput( throttle, 0.5, 500.0, 2.0 );
+
+    rapidjson::Document config;
+    config.Parse( "{ \"multi_chaser\" : { \"chasers\" : [ "
+                  "{ \"initial_state\" : [1.0, 2.0, 3.0, 4.0, 5.0, 6.0] }, "
+                  "{ \"thrust_settings\" : [\"on_off\", 0.2], \"wet_mass\" : 50.0 } ], "
+                  "\"summary_filename\" : \"summary.csv\" } }" );
+    REQUIRE( hasMultiChaserInput( config ) );
+
+    const MultiChaserSettings settings = checkMultiChaserInput( config, nominalInput );
+    REQUIRE( settings.chasers.size( ) == 2 );
+    REQUIRE( settings.summaryFilename == "summary.csv" );
+
+    // Settings that are not given are set to nominal values.
+    REQUIRE( settings.chasers[ 0 ].initialState[ 5 ] == Approx( 6.0 ) );
+    REQUIRE( settings.chasers[ 0 ].thrustMode == throttle );
+    REQUIRE( settings.chasers[ 0 ].thrustMaximum == Approx( 0.5 ) );
+    REQUIRE( settings.chasers[ 0 ].wetMass == Approx( 100.0 ) );
+    REQUIRE( settings.chasers[ 1 ].initialState[ 1 ] == Approx( -1000.0 ) );
+    REQUIRE( settings.chasers[ 1 ].thrustMode == onOff );
+    REQUIRE( settings.chasers[ 1 ].thrustMaximum == Approx( 0.2 ) );
+    REQUIRE( settings.chasers[ 1 ].wetMass == Approx( 50.0 ) );
+}
+
+//! Create user input with given adaptive scheduling and checkpoint settings.
+UserInput createUnsupportedMultiChaserInput( const AdaptiveSchedulingSettings& adaptiveScheduling,
+                                             const CheckpointSettings& checkpoint )
+{
+    const UserInput input = createTestInput( throttle, 0.5, 500.0, 2.0 );
+    return UserInput( input.startTime,
+                      input.endTime,
+                      input.earthGravitationalParameter,
+                      input.targetSemiMajorAxis,
+                      input.chaserInitialState,
+                      input.thrustMode,
+                      input.thrustMaximum,
+                      input.thrustFrequency,
+                      input.chaserWetMass,
+                      input.arrivalDistanceTolerance,
+                      input.outputDirectory,
+                      input.chaserStateHistoryFilename,
+                      input.chaserThrustHistoryFilename,
+                      input.outputFormat,
+                      input.chaserTrajectoryFilename,
+                      input.outputSampling,
+                      input.metricsFilename,
+                      adaptiveScheduling,
+                      input.propagatorSettings,
+                      checkpoint,
+                      input.chaserSpecificImpulse );
+}
+
+TEST_CASE( "Test multi-chaser unsupported settings", "[multi_chaser_simulator]" )
+{
+    rapidjson::Document config;
+    config.Parse( "{ \"multi_chaser\" : { \"chasers\" : [ { } ], "
+                  "\"summary_filename\" : \"summary.csv\" } }" );
+    const std::vector< ChaserSettings > chasers( 1, ChaserSettings( testChaserInitialState,
+                                                                    throttle,
+                                                                    0.5,
+                                                                    100.0 ) );
+
+    // Settings that multi-chaser simulations do not support are rejected instead of ignored.
+    SECTION( "Test output sampling events" )
+    {
+        const UserInput input
+            = createTestInput( throttle,
+                               0.5,
+                               500.0,
+                               2.0,
+                               testChaserInitialState,
+                               100.0,
+                               1.0,
+                               PropagatorSettings( ),
+                               0.0,
+                               csvOutput,
+                               OutputSamplingSettings( everyStep, 1, 0.0, true ) );
+        REQUIRE_THROWS_AS( checkMultiChaserInput( config, input ), std::invalid_argument );
+        REQUIRE_THROWS_AS( MultiChaserSimulator( input, chasers ), std::invalid_argument );
+    }
+
+    SECTION( "Test adaptive scheduling" )
+    {
+        const UserInput input = createUnsupportedMultiChaserInput(
+            AdaptiveSchedulingSettings( true ), CheckpointSettings( ) );
+        REQUIRE_THROWS_AS( checkMultiChaserInput( config, input ), std::invalid_argument );
+        REQUIRE_THROWS_AS( MultiChaserSimulator( input, chasers ), std::invalid_argument );
+    }
+
+    SECTION( "Test checkpointing" )
+    {
+        const UserInput input = createUnsupportedMultiChaserInput(
+            AdaptiveSchedulingSettings( ), CheckpointSettings( "checkpoint.bin" ) );
+        REQUIRE_THROWS_AS( checkMultiChaserInput( config, input ), std::invalid_argument );
+        REQUIRE_THROWS_AS( MultiChaserSimulator( input, chasers ), std::invalid_argument );
+    }
+
+    SECTION( "Test propagator" )
+    {
+        const UserInput input
+            = createTestInput( throttle,
+                               0.5,
+                               500.0,
+                               2.0,
+                               testChaserInitialState,
+                               100.0,
+                               1.0,
+                               PropagatorSettings( yamanakaAnkersenPropagator ) );
+        REQUIRE_THROWS_AS( checkMultiChaserInput( config, input ), std::invalid_argument );
+        REQUIRE_THROWS_AS( MultiChaserSimulator( input, chasers ), std::invalid_argument );
+    }
+}
+
+TEST_CASE( "Test multi-chaser simulator", "[multi_chaser_simulator]" )
+{
+    const Vector6 firstState = { { -100.0, -1000.0, 10.0, 0.0, 0.1, 0.0 } };
+    const Vector6 secondState = { { 50.0, -500.0, -20.0, 0.01, 0.0, 0.02 } };
+    const Vector6 thirdState = { { 200.0, 800.0, 0.0, -0.1, 0.05, 0.0 } };
+
+    // Chasers with different thrust modes, thruster capabilities and masses.
+    std::vector< ChaserSettings > chasers;
+    chasers.push_back( ChaserSettings( firstState, throttle, 0.05, 100.0 ) );
+    chasers.push_back( ChaserSettings( secondState, onOff, 0.5, 80.0 ) );
+    chasers.push_back( ChaserSettings( thirdState, throttle, 0.0, 120.0 ) );
+    chasers.push_back( ChaserSettings( firstState, off, 0.5, 100.0 ) );
+    chasers.push_back( ChaserSettings( thirdState, throttle, 5.0, 150.0 ) );
+
+    // Masses of all chasers are depleted, with the specific impulse shared by all chasers.
+    const UserInput sharedInput = createTestInput( throttle,
+                                                   0.5,
+                                                   500.0,
+                                                   2.0,
+                                                   firstState,
+                                                   100.0,
+                                                   1.0,
+                                                   PropagatorSettings( ),
+                                                   220.0,
+                                                   csvOutput,
+                                                   OutputSamplingSettings( everyNthStep, 100 ) );
+    MultiChaserSimulator multiChaserSimulator( sharedInput, chasers );
+    REQUIRE( multiChaserSimulator.getNumberOfChasers( ) == 5 );
+
+    const std::size_t numberOfChasers = chasers.size( );
+    const char* stateColumnNames[ ] = { "t", "chaser", "x", "y", "z", "xdot", "ydot", "zdot" };
+    ChaserRowCountingSink stateSink(
+        std::vector< std::string >( stateColumnNames, stateColumnNames + 8 ), numberOfChasers );
+    const char* thrustColumnNames[ ] = { "t", "chaser", "Tx", "Ty", "Tz" };
+    ChaserRowCountingSink thrustSink(
+        std::vector< std::string >( thrustColumnNames, thrustColumnNames + 5 ), numberOfChasers );
+    multiChaserSimulator.setOutputSinks( &stateSink, &thrustSink );
+
+    multiChaserSimulator.execute( );
+    const std::vector< SimulationSummary > summaries = multiChaserSimulator.getSummaries( );
+    REQUIRE( summaries.size( ) == numberOfChasers );
+
+    // Each chaser should match the single-chaser simulator with the same settings.
+    for ( std::size_t i = 0; i < numberOfChasers; ++i )
+    {
+        const UserInput input = createTestInput( chasers[ i ].thrustMode,
+                                                 chasers[ i ].thrustMaximum,
+                                                 500.0,
+                                                 2.0,
+                                                 chasers[ i ].initialState,
+                                                 chasers[ i ].wetMass,
+                                                 1.0,
+                                                 PropagatorSettings( ),
+                                                 sharedInput.chaserSpecificImpulse,
+                                                 csvOutput,
+                                                 sharedInput.outputSampling );
+        Simulator simulator( input, false );
+        simulator.execute( );
+
+        Vector6 finalState;
+        multiChaserSimulator.getChaserFinalStates( ).getVector( i, finalState );
+        for ( int j = 0; j < 6; ++j )
+        {
+            REQUIRE( finalState[ j ]
+                     == Approx( simulator.getChaserFinalState( )[ j ] ).epsilon( 1.0e-6 )
+                                                                       .margin( 1.0e-9 ) );
+        }
+
+        REQUIRE( summaries[ i ].finalDistanceToTarget
+                 == Approx( simulator.getFinalDistanceToTarget( ) ).epsilon( 1.0e-6 )
+                                                                  .margin( 1.0e-9 ) );
+        REQUIRE( summaries[ i ].isTargetReached == simulator.isTargetReached( ) );
+        REQUIRE( summaries[ i ].totalDeltaV
+                 == Approx( simulator.getTotalDeltaV( ) ).epsilon( 1.0e-6 ) );
+        REQUIRE( summaries[ i ].propellantMass
+                 == Approx( simulator.getPropellantMass( ) ).epsilon( 1.0e-6 ) );
+        REQUIRE( summaries[ i ].isThrottleMax == simulator.isThrottleMaximumReached( ) );
+        REQUIRE( summaries[ i ].throttleSaturationTime
+                 == Approx( simulator.getSummary( ).throttleSaturationTime ) );
+    }
+
+    // Weak thruster is saturated, whereas unconstrained thruster and thruster that is off are not.
+    REQUIRE( summaries[ 0 ].isThrottleMax );
+    REQUIRE( !summaries[ 2 ].isThrottleMax );
+    REQUIRE( summaries[ 3 ].totalDeltaV == 0.0 );
+    REQUIRE( summaries[ 3 ].propellantMass == 0.0 );
+    REQUIRE( summaries[ 0 ].propellantMass > 0.0 );
+
+    // Sampled epochs (every 100th of 1000 steps) are streamed for each chaser, together with the
+    // final epoch for the states.
+    for ( std::size_t i = 0; i < numberOfChasers; ++i )
+    {
+        REQUIRE( stateSink.rowsPerChaser[ i ] == 11 );
+        REQUIRE( thrustSink.rowsPerChaser[ i ] == 10 );
+    }
+}
+
+} // namespace tests
+} // namespace rvdsim
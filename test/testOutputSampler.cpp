@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cstddef>
+#include <vector>
+
+#include <catch.hpp>
+
+#include "rvdsim/outputSampler.hpp"
+#include "rvdsim/typedefs.hpp"
+
+namespace rvdsim
+{
+namespace tests
+{
+
+//! Get indices of sampled steps for sampler without events, at given step size.
+std::vector< std::size_t > getSampledSteps( OutputSampler& sampler,
+                                            const std::size_t numberOfSteps,
+                                            const Real stepSize )
+{
+    std::vector< std::size_t > sampledSteps;
+    for ( std::size_t i = 0; i < numberOfSteps; ++i )
+    {
+        if ( sampler.isSampled( i, 10.0 + i * stepSize, false, false, false ) )
+        {
+            sampledSteps.push_back( i );
+        }
+    }
+    return sampledSteps;
+}
+
+TEST_CASE( "Test output sampling modes", "[output_sampler]" )
+{
+    SECTION( "Test every step" )
+    {
+        OutputSampler sampler( OutputSamplingSettings( ), 10.0 );
+        REQUIRE( getSampledSteps( sampler, 10, 0.1 ).size( ) == 10 );
+    }
+
+    SECTION( "Test every N-th step" )
+    {
+        OutputSampler sampler( OutputSamplingSettings( everyNthStep, 4 ), 10.0 );
+        const std::vector< std::size_t > sampledSteps = getSampledSteps( sampler, 10, 0.1 );
+        REQUIRE( sampledSteps.size( ) == 3 );
+        REQUIRE( sampledSteps[ 0 ] == 0 );
+        REQUIRE( sampledSteps[ 1 ] == 4 );
+        REQUIRE( sampledSteps[ 2 ] == 8 );
+    }
+
+    SECTION( "Test fixed interval" )
+    {
+        // Output interval coincides with epochs, which are subject to round-off.
+        OutputSampler sampler( OutputSamplingSettings( fixedInterval, 1, 0.3 ), 10.0 );
+        const std::vector< std::size_t > sampledSteps = getSampledSteps( sampler, 10, 0.1 );
+        REQUIRE( sampledSteps.size( ) == 4 );
+        REQUIRE( sampledSteps[ 0 ] == 0 );
+        REQUIRE( sampledSteps[ 1 ] == 3 );
+        REQUIRE( sampledSteps[ 2 ] == 6 );
+        REQUIRE( sampledSteps[ 3 ] == 9 );
+
+        // Output interval that does not coincide with epochs.
+        OutputSampler otherSampler( OutputSamplingSettings( fixedInterval, 1, 0.25 ), 10.0 );
+        const std::vector< std::size_t > otherSampledSteps
+            = getSampledSteps( otherSampler, 10, 0.1 );
+        REQUIRE( otherSampledSteps.size( ) == 4 );
+        REQUIRE( otherSampledSteps[ 1 ] == 3 );
+        REQUIRE( otherSampledSteps[ 2 ] == 5 );
+        REQUIRE( otherSampledSteps[ 3 ] == 8 );
+    }
+
+    SECTION( "Test reset" )
+    {
+        OutputSampler sampler( OutputSamplingSettings( everyNthStep, 100 ), 10.0 );
+        REQUIRE( getSampledSteps( sampler, 10, 0.1 ).size( ) == 1 );
+        sampler.reset( );
+        REQUIRE( getSampledSteps( sampler, 10, 0.1 ).size( ) == 1 );
+    }
+}
+
+TEST_CASE( "Test output sampling events", "[output_sampler]" )
+{
+    // Sample only first step, unless events are triggered.
+    const bool thrustOn[ ]          = { false, true,  true,  false, false, false };
+    const bool throttleSaturated[ ] = { false, false, true,  true,  false, false };
+    const bool withinTolerance[ ]   = { false, false, false, false, false, true  };
+
+    SECTION( "Test thrust switch events" )
+    {
+        OutputSampler sampler( OutputSamplingSettings( everyNthStep, 100, 0.0, true ), 0.0 );
+        const bool expected[ ] = { true, true, false, true, false, false };
+        for ( std::size_t i = 0; i < 6; ++i )
+        {
+            REQUIRE( sampler.isSampled( i, 1.0 * i, thrustOn[ i ], throttleSaturated[ i ],
+                                        withinTolerance[ i ] ) == expected[ i ] );
+        }
+    }
+
+    SECTION( "Test throttle saturation events" )
+    {
+        OutputSampler sampler(
+            OutputSamplingSettings( everyNthStep, 100, 0.0, false, true ), 0.0 );
+        const bool expected[ ] = { true, false, true, false, true, false };
+        for ( std::size_t i = 0; i < 6; ++i )
+        {
+            REQUIRE( sampler.isSampled( i, 1.0 * i, thrustOn[ i ], throttleSaturated[ i ],
+                                        withinTolerance[ i ] ) == expected[ i ] );
+        }
+    }
+
+    SECTION( "Test arrival events" )
+    {
+        OutputSampler sampler(
+            OutputSamplingSettings( everyNthStep, 100, 0.0, false, false, true ), 0.0 );
+        const bool expected[ ] = { true, false, false, false, false, true };
+        for ( std::size_t i = 0; i < 6; ++i )
+        {
+            REQUIRE( sampler.isSampled( i, 1.0 * i, thrustOn[ i ], throttleSaturated[ i ],
+                                        withinTolerance[ i ] ) == expected[ i ] );
+        }
+    }
+}
+
+} // namespace tests
+} // namespace rvdsim
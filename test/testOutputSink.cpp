@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <catch.hpp>
+
+#include "rvdsim/outputSink.hpp"
+#include "rvdsim/typedefs.hpp"
+
+namespace rvdsim
+{
+namespace tests
+{
+
+//! Read contents of file.
+std::string readFile( const std::string& filePath )
+{
+    std::ifstream file( filePath.c_str( ), std::ios::binary );
+    return std::string( std::istreambuf_iterator< char >( file ),
+                        std::istreambuf_iterator< char >( ) );
+}
+
+//! Decode little-endian unsigned integer from bytes.
+std::uint64_t decodeLittleEndian( const std::string& bytes,
+                                  const std::size_t offset,
+                                  const std::size_t numberOfBytes )
+{
+    std::uint64_t value = 0;
+    for ( std::size_t i = 0; i < numberOfBytes; ++i )
+    {
+        value |= static_cast< std::uint64_t >( static_cast< unsigned char >( bytes[ offset + i ] ) )
+                 << ( 8 * i );
+    }
+    return value;
+}
+
+//! Create column names for test output.
+std::vector< std::string > createTestColumnNames( )
+{
+    std::vector< std::string > columnNames;
+    columnNames.push_back( "t" );
+    columnNames.push_back( "x" );
+    columnNames.push_back( "xdot" );
+    return columnNames;
+}
+
+TEST_CASE( "Test CSV output sink", "[output_sink]" )
+{
+    const std::string filePath = "test_output_sink.csv";
+
+    {
+        // Use small buffer, such that the buffer is flushed several times.
+        CsvOutputSink sink( filePath, createTestColumnNames( ), 6, 16 );
+        for ( int i = 0; i < 3; ++i )
+        {
+            const Real row[ 3 ] = { 1.0 * i, -100.5 + i, 0.25 };
+            sink.writeRow( row );
+        }
+        REQUIRE( sink.getNumberOfRows( ) == 3 );
+        REQUIRE( sink.getColumnNames( ).size( ) == 3 );
+    }
+
+    REQUIRE( readFile( filePath )
+             == "t,x,xdot\n0,-100.5,0.25\n1,-99.5,0.25\n2,-98.5,0.25\n" );
+
+    std::remove( filePath.c_str( ) );
+}
+
+TEST_CASE( "Test binary output sink", "[output_sink]" )
+{
+    const std::string filePath = "test_output_sink.bin";
+    const std::size_t numberOfRows = 1000;
+
+    {
+        std::unique_ptr< OutputSink > sink
+            = createOutputSink( binaryOutput, filePath, createTestColumnNames( ) );
+        for ( std::size_t i = 0; i < numberOfRows; ++i )
+        {
+            const Real row[ 3 ] = { 0.1 * i, -100.0 + i, 1.0 / ( i + 1.0 ) };
+            sink->writeRow( row );
+        }
+        sink->close( );
+
+        // Closing again should have no effect.
+        sink->close( );
+    }
+
+    const std::string contents = readFile( filePath );
+
+    // Check header.
+    REQUIRE( contents.compare( 0, 8, "RVDSIMB1" ) == 0 );
+    REQUIRE( decodeLittleEndian( contents, 8, 4 ) == binaryOutputVersion );
+    REQUIRE( decodeLittleEndian( contents, 12, 4 ) == 3 );
+    REQUIRE( decodeLittleEndian( contents, 16, 8 ) == numberOfRows );
+    const std::size_t dataOffset
+        = static_cast< std::size_t >( decodeLittleEndian( contents, 24, 8 ) );
+    REQUIRE( dataOffset % binaryOutputAlignment == 0 );
+    REQUIRE( std::string( contents.c_str( ) + 32 ) == "t" );
+    REQUIRE( std::string( contents.c_str( ) + 34 ) == "x" );
+    REQUIRE( std::string( contents.c_str( ) + 36 ) == "xdot" );
+
+    // Check rows.
+    REQUIRE( contents.size( ) == dataOffset + numberOfRows * 3 * 8 );
+    for ( std::size_t i = 0; i < numberOfRows; ++i )
+    {
+        const Real expectedRow[ 3 ] = { 0.1 * i, -100.0 + i, 1.0 / ( i + 1.0 ) };
+        for ( std::size_t j = 0; j < 3; ++j )
+        {
+            const std::uint64_t bits
+                = decodeLittleEndian( contents, dataOffset + ( i * 3 + j ) * 8, 8 );
+            double value = 0.0;
+            std::memcpy( &value, &bits, sizeof( value ) );
+            REQUIRE( value == expectedRow[ j ] );
+        }
+    }
+
+    std::remove( filePath.c_str( ) );
+}
+
+} // namespace tests
+} // namespace rvdsim
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cstddef>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <rapidjson/document.h>
+
+#include "rvdsim/parameterSweep.hpp"
+#include "rvdsim/simulator.hpp"
+#include "rvdsim/typedefs.hpp"
+#include "rvdsim/userInput.hpp"
+
+#include "testInputFactory.hpp"
+
+namespace rvdsim
+{
+namespace tests
+{
+
+//! Create sweep settings for parameter sweep tests.
+SweepSettings createSweepSettings( const TerminationSettings& terminationSettings )
+{
+    std::vector< Real > thrustMaximumValues;
+    thrustMaximumValues.push_back( 0.05 );
+    thrustMaximumValues.push_back( 0.5 );
+    thrustMaximumValues.push_back( 5.0 );
+
+    std::vector< Real > thrustFrequencyValues;
+    thrustFrequencyValues.push_back( 1.0 );
+    thrustFrequencyValues.push_back( 2.0 );
+
+    return SweepSettings( thrustMaximumValues,
+                          thrustFrequencyValues,
+                          3,
+                          terminationSettings,
+                          "sweep_results.csv" );
+}
+
+TEST_CASE( "Test sweep input", "[parameter_sweep]" )
+{
+    const UserInput nominalInput = createTestInput( throttle, 0.5, 500.0 );
+
+    rapidjson::Document config;
+    config.Parse( "{ \"sweep\" : { \"thrust_maximum\" : [0.1, 0.2], "
+                  "\"thrust_frequency\" : { \"from\" : 1.0, \"to\" : 2.0, \"points\" : 3 }, "
+                  "\"terminate_on_arrival\" : true, \"maximum_distance\" : 5000.0, "
+                  "\"results_filename\" : \"sweep.csv\" } }" );
+    REQUIRE( hasSweepInput( config ) );
+
+    const SweepSettings settings = checkSweepInput( config, nominalInput );
+    REQUIRE( settings.getNumberOfGridPoints( ) == 6 );
+    REQUIRE( settings.thrustMaximumValues[ 1 ] == Approx( 0.2 ) );
+    REQUIRE( settings.thrustFrequencyValues[ 1 ] == Approx( 1.5 ) );
+    REQUIRE( settings.thrustFrequencyValues[ 2 ] == Approx( 2.0 ) );
+    REQUIRE( settings.numberOfThreads == 0 );
+    REQUIRE( settings.terminationSettings.isArrivalTerminationEnabled );
+    REQUIRE( settings.terminationSettings.maximumDistance == Approx( 5000.0 ) );
+
+    // Grid points are ordered with thrust frequency varying fastest.
+    const UserInput gridPointInput = computeGridPointInput( nominalInput, settings, 4 );
+    REQUIRE( gridPointInput.thrustMaximum == Approx( 0.2 ) );
+    REQUIRE( gridPointInput.thrustFrequency == Approx( 1.5 ) );
+
+    // Parameters that are not swept are set to their nominal values.
+    rapidjson::Document otherConfig;
+    otherConfig.Parse( "{ \"sweep\" : { \"thrust_maximum\" : [0.1, 0.2, 0.3], "
+                       "\"results_filename\" : \"sweep.csv\" } }" );
+    const SweepSettings otherSettings = checkSweepInput( otherConfig, nominalInput );
+    REQUIRE( otherSettings.getNumberOfGridPoints( ) == 3 );
+    REQUIRE( otherSettings.thrustFrequencyValues[ 0 ] == nominalInput.thrustFrequency );
+    REQUIRE( !otherSettings.terminationSettings.isArrivalTerminationEnabled );
+}
+
+TEST_CASE( "Test parameter sweep", "[parameter_sweep]" )
+{
+    const UserInput nominalInput = createTestInput( throttle, 0.5, 500.0 );
+    const SweepSettings settings = createSweepSettings( TerminationSettings( ) );
+
+    const std::vector< SweepResult > results = executeParameterSweep( nominalInput, settings );
+    REQUIRE( results.size( ) == 6 );
+
+    // Each grid point should match an individual simulation with the same thruster settings.
+    for ( std::size_t i = 0; i < results.size( ); ++i )
+    {
+        const UserInput input = computeGridPointInput( nominalInput, settings, i );
+        Simulator simulator( input, false );
+        simulator.execute( );
+
+        REQUIRE( results[ i ].gridPointIndex == i );
+        REQUIRE( results[ i ].thrustMaximum == input.thrustMaximum );
+        REQUIRE( results[ i ].thrustFrequency == input.thrustFrequency );
+        REQUIRE( results[ i ].summary.finalDistanceToTarget
+                 == simulator.getFinalDistanceToTarget( ) );
+        REQUIRE( results[ i ].summary.totalDeltaV == simulator.getTotalDeltaV( ) );
+        REQUIRE( !results[ i ].summary.isTerminatedEarly );
+    }
+
+    // Weakest thruster should be saturated for longer than strongest thruster.
+    REQUIRE( results[ 0 ].summary.throttleSaturationTime > 0.0 );
+    REQUIRE( results[ 0 ].summary.throttleSaturationTime
+             > results[ 4 ].summary.throttleSaturationTime );
+}
+
+TEST_CASE( "Test parameter sweep with early termination", "[parameter_sweep]" )
+{
+    SECTION( "Test termination on arrival" )
+    {
+        const UserInput nominalInput
+            = createTestInput( throttle, 0.5, 500.0, 1.0, testChaserInitialState, 100.0, 50.0 );
+        const SweepSettings settings = createSweepSettings( TerminationSettings( true ) );
+
+        // Only the strongest thruster reaches the target before the end time.
+        const std::vector< SweepResult > results = executeParameterSweep( nominalInput, settings );
+        for ( std::size_t i = 0; i < 4; ++i )
+        {
+            REQUIRE( !results[ i ].summary.isTargetReached );
+            REQUIRE( !results[ i ].summary.isTerminatedEarly );
+        }
+        for ( std::size_t i = 4; i < results.size( ); ++i )
+        {
+            REQUIRE( results[ i ].summary.isTargetReached );
+            REQUIRE( results[ i ].summary.isTerminatedEarly );
+            REQUIRE( results[ i ].summary.terminationTime < nominalInput.endTime );
+            REQUIRE( results[ i ].summary.finalDistanceToTarget <= 50.0 );
+        }
+    }
+
+    SECTION( "Test termination beyond maximum distance" )
+    {
+        const UserInput nominalInput = createTestInput( throttle, 0.5, 500.0 );
+        const SweepSettings settings = createSweepSettings( TerminationSettings( false, 500.0 ) );
+
+        const std::vector< SweepResult > results = executeParameterSweep( nominalInput, settings );
+        for ( std::size_t i = 0; i < results.size( ); ++i )
+        {
+            REQUIRE( !results[ i ].summary.isTargetReached );
+            REQUIRE( results[ i ].summary.isTerminatedEarly );
+            REQUIRE( results[ i ].summary.terminationTime
+                     == Approx( 1.0 / results[ i ].thrustFrequency ) );
+        }
+    }
+}
+
+} // namespace tests
+} // namespace rvdsim
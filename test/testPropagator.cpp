@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cmath>
+#include <memory>
+
+#include <catch.hpp>
+
+#include <astro/astro.hpp>
+
+#include "rvdsim/propagator.hpp"
+#include "rvdsim/simulator.hpp"
+#include "rvdsim/typedefs.hpp"
+#include "rvdsim/userInput.hpp"
+
+#include "testInputFactory.hpp"
+
+namespace rvdsim
+{
+namespace tests
+{
+
+//! Earth gravitational parameter used by propagator tests [m^3 s^-2].
+const Real propagatorTestGravitationalParameter = 3.986004418e14;
+
+//! Target semi-major axis used by propagator tests [m].
+const Real propagatorTestSemiMajorAxis = 6778.0e3;
+
+//! Propagate state over given number of thruster pulses.
+Vector6 propagatePulses( Propagator& propagator,
+                         const Vector6& initialState,
+                         const Vector3& thrustAcceleration,
+                         const int numberOfPulses )
+{
+    propagator.reset( );
+    Vector6 state = initialState;
+    for ( int i = 0; i < numberOfPulses; ++i )
+    {
+        propagator.propagate( 1.0, state, thrustAcceleration, state );
+    }
+    return state;
+}
+
+TEST_CASE( "Test Clohessy-Wiltshire propagator", "[propagator]" )
+{
+    const Real meanMotion
+        = std::sqrt( propagatorTestGravitationalParameter
+                     / ( propagatorTestSemiMajorAxis * propagatorTestSemiMajorAxis
+                         * propagatorTestSemiMajorAxis ) );
+    ClohessyWiltshirePropagator propagator( meanMotion, 1.0 );
+
+    const Vector6 initialState = { { -100.0, -1000.0, 10.0, 0.0, 0.1, -0.01 } };
+    const Vector3 acceleration = { { 1.0e-3, -2.0e-3, 5.0e-4 } };
+    const Real propagationTimes[ ] = { 1.0, 250.0 };
+    for ( int j = 0; j < 2; ++j )
+    {
+        Vector6 finalState;
+        propagator.propagate( propagationTimes[ j ], initialState, acceleration, finalState );
+
+        const Vector6 expectedFinalState = astro::propagateClohessyWiltshireSolution(
+            initialState, propagationTimes[ j ], meanMotion, acceleration );
+        for ( int i = 0; i < 6; ++i )
+        {
+            REQUIRE( finalState[ i ]
+                     == Approx( expectedFinalState[ i ] ).epsilon( 1.0e-12 ).margin( 1.0e-12 ) );
+        }
+    }
+}
+
+TEST_CASE( "Test Yamanaka-Ankersen propagator", "[propagator]" )
+{
+    const Vector6 initialState = { { -100.0, -1000.0, 10.0, 0.05, 0.1, -0.01 } };
+    const Vector3 acceleration = { { 1.0e-3, -2.0e-3, 5.0e-4 } };
+
+    SECTION( "Test reduction to Clohessy-Wiltshire solution for circular orbit" )
+    {
+        const UserInput circularInput = createTestInput(
+            throttle, 0.5, 1000.0, 1.0, testChaserInitialState, 100.0, 1.0,
+            PropagatorSettings( yamanakaAnkersenPropagator ) );
+        const std::unique_ptr< Propagator > yamanakaAnkersen = createPropagator( circularInput );
+        const std::unique_ptr< Propagator > clohessyWiltshire
+            = createPropagator( createTestInput( ) );
+
+        Vector6 predictedState;
+        Vector6 expectedPredictedState;
+        yamanakaAnkersen->predictBallisticState( 2000.0, initialState, predictedState );
+        clohessyWiltshire->predictBallisticState( 2000.0, initialState, expectedPredictedState );
+        for ( int i = 0; i < 6; ++i )
+        {
+            REQUIRE( predictedState[ i ]
+                     == Approx( expectedPredictedState[ i ] ).epsilon( 1.0e-9 ).margin( 1.0e-9 ) );
+        }
+
+        // The thrust acceleration is applied as two half impulses, which differs from continuous
+        // thrust by a term of third order in the pulse length.
+        const Vector6 finalState
+            = propagatePulses( *yamanakaAnkersen, initialState, acceleration, 300 );
+        const Vector6 expectedFinalState
+            = propagatePulses( *clohessyWiltshire, initialState, acceleration, 300 );
+        for ( int i = 0; i < 3; ++i )
+        {
+            REQUIRE( std::fabs( finalState[ i ] - expectedFinalState[ i ] ) < 1.0e-3 );
+            REQUIRE( std::fabs( finalState[ i + 3 ] - expectedFinalState[ i + 3 ] ) < 1.0e-5 );
+        }
+    }
+
+    SECTION( "Test consistency of prediction and propagation along eccentric orbit" )
+    {
+        YamanakaAnkersenPropagator propagator( propagatorTestGravitationalParameter,
+                                               propagatorTestSemiMajorAxis,
+                                               0.1,
+                                               1.0 );
+
+        // Ballistic propagation over consecutive arcs matches the prediction over the full arc.
+        Vector6 predictedState;
+        propagator.predictBallisticState( 1500.0, initialState, predictedState );
+
+        const Vector3 zeroAcceleration = { { 0.0, 0.0, 0.0 } };
+        Vector6 state = initialState;
+        propagator.propagate( 500.0, state, zeroAcceleration, state );
+        propagator.propagate( 1000.0, state, zeroAcceleration, state );
+        for ( int i = 0; i < 6; ++i )
+        {
+            REQUIRE( state[ i ]
+                     == Approx( predictedState[ i ] ).epsilon( 1.0e-9 ).margin( 1.0e-9 ) );
+        }
+
+        // True anomaly advances with the orbital period.
+        const Real orbitalPeriod
+            = 2.0 * std::acos( -1.0 )
+              * std::sqrt( propagatorTestSemiMajorAxis * propagatorTestSemiMajorAxis
+                           * propagatorTestSemiMajorAxis / propagatorTestGravitationalParameter );
+        REQUIRE( propagator.computeTrueAnomaly( 0.0 ) == Approx( 1.0 ) );
+        REQUIRE( propagator.computeTrueAnomaly( orbitalPeriod ) == Approx( 1.0 ) );
+    }
+}
+
+TEST_CASE( "Test J2-perturbed nonlinear propagator", "[propagator]" )
+{
+    const Vector6 initialState = { { -100.0, -1000.0, 10.0, 0.05, 0.1, -0.01 } };
+    const Vector3 acceleration = { { 1.0e-3, -2.0e-3, 5.0e-4 } };
+
+    SECTION( "Test agreement with Yamanaka-Ankersen model without J2" )
+    {
+        // For small separations, the nonlinear model without J2 approaches the linearised model;
+        // the difference is dominated by the second-order terms of the relative gravity.
+        const PropagatorSettings settings( j2NonlinearPropagator, 0.1, 0.5, 1.0,
+                                           dormandPrince45Integrator, 10.0, 1.0e-12, 0.0 );
+        J2NonlinearPropagator nonlinearPropagator(
+            propagatorTestGravitationalParameter, propagatorTestSemiMajorAxis, settings );
+        YamanakaAnkersenPropagator linearPropagator(
+            propagatorTestGravitationalParameter, propagatorTestSemiMajorAxis, 0.1, 1.0 );
+
+        const Vector6 finalState
+            = propagatePulses( nonlinearPropagator, initialState, acceleration, 300 );
+        const Vector6 expectedFinalState
+            = propagatePulses( linearPropagator, initialState, acceleration, 300 );
+        for ( int i = 0; i < 3; ++i )
+        {
+            REQUIRE( std::fabs( finalState[ i ] - expectedFinalState[ i ] ) < 0.05 );
+            REQUIRE( std::fabs( finalState[ i + 3 ] - expectedFinalState[ i + 3 ] ) < 5.0e-4 );
+        }
+    }
+
+    SECTION( "Test agreement of integrators with J2" )
+    {
+        J2NonlinearPropagator rungeKutta4Propagator(
+            propagatorTestGravitationalParameter,
+            propagatorTestSemiMajorAxis,
+            PropagatorSettings( j2NonlinearPropagator, 0.01, 0.9, 0.0,
+                                rungeKutta4Integrator, 0.25 ) );
+        J2NonlinearPropagator dormandPrincePropagator(
+            propagatorTestGravitationalParameter,
+            propagatorTestSemiMajorAxis,
+            PropagatorSettings( j2NonlinearPropagator, 0.01, 0.9, 0.0,
+                                dormandPrince45Integrator, 10.0, 1.0e-13 ) );
+
+        const Vector6 rungeKutta4State
+            = propagatePulses( rungeKutta4Propagator, initialState, acceleration, 300 );
+        const Vector6 dormandPrinceState
+            = propagatePulses( dormandPrincePropagator, initialState, acceleration, 300 );
+        REQUIRE( rungeKutta4Propagator.getNumberOfIntegrationSteps( ) == 1200 );
+        REQUIRE( dormandPrincePropagator.getNumberOfIntegrationSteps( ) >= 300 );
+        for ( int i = 0; i < 3; ++i )
+        {
+            REQUIRE( std::fabs( rungeKutta4State[ i ] - dormandPrinceState[ i ] ) < 1.0e-5 );
+            REQUIRE( std::fabs( rungeKutta4State[ i + 3 ] - dormandPrinceState[ i + 3 ] )
+                     < 1.0e-8 );
+        }
+
+        // Propagating again after a reset reproduces the result.
+        const Vector6 repeatedState
+            = propagatePulses( dormandPrincePropagator, initialState, acceleration, 300 );
+        for ( int i = 0; i < 6; ++i )
+        {
+            REQUIRE( repeatedState[ i ] == dormandPrinceState[ i ] );
+        }
+    }
+}
+
+TEST_CASE( "Test simulator with selectable propagator", "[propagator]" )
+{
+    const PropagatorSettings propagatorSettings[ ]
+        = { PropagatorSettings( yamanakaAnkersenPropagator, 0.05, 0.0, 2.0 ),
+            PropagatorSettings( j2NonlinearPropagator, 0.05, 0.9, 2.0 ),
+            PropagatorSettings( j2NonlinearPropagator, 0.05, 0.9, 2.0, rungeKutta4Integrator ) };
+
+    for ( int j = 0; j < 3; ++j )
+    {
+        Simulator simulator( createTestInput( throttle,
+                                              0.5,
+                                              1000.0,
+                                              1.0,
+                                              testChaserInitialState,
+                                              100.0,
+                                              1.0,
+                                              propagatorSettings[ j ] ),
+                             false );
+        REQUIRE( !simulator.isUnconstrainedFastPathUsed( ) );
+        simulator.execute( );
+
+        // The guidance law steers the chaser to the target, also under perturbed dynamics.
+        REQUIRE( simulator.isTargetReached( ) );
+    }
+
+    // Fast paths that rely on the Clohessy-Wiltshire model are not used for other propagators.
+    Simulator unconstrainedSimulator(
+        createTestInput( throttle, 0.0, 1000.0, 1.0, testChaserInitialState, 100.0, 1.0,
+                         PropagatorSettings( yamanakaAnkersenPropagator ) ),
+        false );
+    REQUIRE( !unconstrainedSimulator.isUnconstrainedFastPathUsed( ) );
+    Simulator clohessyWiltshireSimulator( createTestInput( throttle, 0.0 ), false );
+    REQUIRE( clohessyWiltshireSimulator.isUnconstrainedFastPathUsed( ) );
+}
+
+} // namespace tests
+} // namespace rvdsim
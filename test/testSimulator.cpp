@@ -0,0 +1,447 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <astro/astro.hpp>
+
+#include "rvdsim/outputSink.hpp"
+#include "rvdsim/simulator.hpp"
+#include "rvdsim/typedefs.hpp"
+#include "rvdsim/userInput.hpp"
+
+#include "testInputFactory.hpp"
+
+namespace rvdsim
+{
+namespace tests
+{
+
+TEST_CASE( "Test simulator constants", "[simulator]" )
+{
+    const UserInput input = createTestInput( throttle, 2.0 );
+    const Simulator simulator( input );
+
+    REQUIRE( simulator.getThrustAccelerationMaximum( ) == Approx( 0.02 ) );
+    REQUIRE( simulator.getThrustPulseTime( )           == Approx( 1.0 ) );
+    REQUIRE( simulator.getTargetMeanMotion( )
+             == Approx( std::sqrt( 3.986004418e14 / ( 6778.0e3 * 6778.0e3 * 6778.0e3 ) ) ) );
+}
+
+TEST_CASE( "Test simulator with thruster switched off", "[simulator]" )
+{
+    const UserInput input = createTestInput( off, 0.0 );
+    Simulator simulator( input );
+    simulator.execute( );
+
+    REQUIRE( simulator.getChaserStateHistory( ).size( )  == 1001 );
+    REQUIRE( simulator.getChaserThrustHistory( ).size( ) == 1000 );
+    REQUIRE( !simulator.isThrottleMaximumReached( ) );
+
+    // Free motion over the complete simulation should match a single propagation step.
+    const Vector3 zeroThrustAcceleration = { { 0.0, 0.0, 0.0 } };
+    const Vector6 expectedFinalState
+        = astro::propagateClohessyWiltshireSolution( input.chaserInitialState,
+                                                     input.endTime - input.startTime,
+                                                     simulator.getTargetMeanMotion( ),
+                                                     zeroThrustAcceleration );
+
+    for ( int i = 0; i < 6; ++i )
+    {
+        REQUIRE( simulator.getChaserFinalState( )[ i ]
+                 == Approx( expectedFinalState[ i ] ).epsilon( 1.0e-8 ) );
+    }
+}
+
+TEST_CASE( "Test simulator with unconstrained thrust", "[simulator]" )
+{
+    const UserInput input = createTestInput( throttle, 0.0 );
+    Simulator simulator( input );
+    simulator.execute( );
+
+    REQUIRE( simulator.isTargetReached( ) );
+    REQUIRE( !simulator.isThrottleMaximumReached( ) );
+}
+
+TEST_CASE( "Test simulator with on-off thrust", "[simulator]" )
+{
+    const UserInput input = createTestInput( onOff, 2.0 );
+    Simulator simulator( input );
+    simulator.execute( );
+
+    // Thrust magnitude is either zero or maximum.
+    const ThrustHistory& thrustHistory = simulator.getChaserThrustHistory( );
+    for ( std::size_t i = 0; i < thrustHistory.size( ); ++i )
+    {
+        const Real thrustNorm = std::sqrt( thrustHistory( i, 0 ) * thrustHistory( i, 0 )
+                                           + thrustHistory( i, 1 ) * thrustHistory( i, 1 )
+                                           + thrustHistory( i, 2 ) * thrustHistory( i, 2 ) );
+        const bool isZeroOrMaximum = thrustNorm == 0.0 || std::fabs( thrustNorm - 2.0 ) < 1.0e-10;
+        REQUIRE( isZeroOrMaximum );
+    }
+}
+
+TEST_CASE( "Test simulator with adaptive scheduling", "[simulator]" )
+{
+    // Far-range approach with on-off thruster, which coasts for most of the simulation.
+    const Vector6 chaserInitialState = { { -500.0, -10000.0, 50.0, 0.0, 0.5, 0.0 } };
+    const UserInput fixedRateInput( 0.0,
+                                    5000.0,
+                                    3.986004418e14,
+                                    6778.0e3,
+                                    chaserInitialState,
+                                    onOff,
+                                    2.0,
+                                    1.0,
+                                    100.0,
+                                    1.0,
+                                    "/path/to/output/directory",
+                                    "chaser_state_history.csv",
+                                    "chaser_thrust_history.csv" );
+    const UserInput adaptiveInput( 0.0,
+                                   5000.0,
+                                   3.986004418e14,
+                                   6778.0e3,
+                                   chaserInitialState,
+                                   onOff,
+                                   2.0,
+                                   1.0,
+                                   100.0,
+                                   1.0,
+                                   "/path/to/output/directory",
+                                   "chaser_state_history.csv",
+                                   "chaser_thrust_history.csv",
+                                   csvOutput,
+                                   "",
+                                   OutputSamplingSettings( ),
+                                   "",
+                                   AdaptiveSchedulingSettings( true, 0.01 ) );
+
+    Simulator fixedRateSimulator( fixedRateInput );
+    Simulator adaptiveSimulator( adaptiveInput );
+    fixedRateSimulator.execute( );
+    adaptiveSimulator.execute( );
+
+    // Coast arcs are skipped, whilst the outcome is unchanged.
+    const std::size_t fixedRateSteps = fixedRateSimulator.getChaserThrustHistory( ).size( );
+    const std::size_t adaptiveSteps = adaptiveSimulator.getChaserThrustHistory( ).size( );
+    REQUIRE( fixedRateSteps == 5000 );
+    REQUIRE( 5 * adaptiveSteps < fixedRateSteps );
+    REQUIRE( adaptiveSimulator.getChaserStateHistory( ).getEpoch( adaptiveSteps ) == 5000.0 );
+
+    for ( int i = 0; i < 6; ++i )
+    {
+        REQUIRE( adaptiveSimulator.getChaserFinalState( )[ i ]
+                 == Approx( fixedRateSimulator.getChaserFinalState( )[ i ] ).epsilon( 1.0e-6 )
+                                                                            .margin( 1.0e-6 ) );
+    }
+    REQUIRE( adaptiveSimulator.getTotalDeltaV( )
+             == Approx( fixedRateSimulator.getTotalDeltaV( ) ).epsilon( 1.0e-9 ) );
+    REQUIRE( adaptiveSimulator.isTargetReached( ) == fixedRateSimulator.isTargetReached( ) );
+}
+
+TEST_CASE( "Test simulator time base", "[simulator]" )
+{
+    // Thruster frequency of 3 Hz, for which the pulse length is not exactly representable, such
+    // that accumulating the pulse length yields an additional pulse at the end of the simulation.
+    const Vector6 chaserInitialState = { { -500.0, -10000.0, 50.0, 0.0, 0.5, 0.0 } };
+    const UserInput input( 0.0,
+                           5000.0,
+                           3.986004418e14,
+                           6778.0e3,
+                           chaserInitialState,
+                           onOff,
+                           2.0,
+                           3.0,
+                           100.0,
+                           1.0,
+                           "/path/to/output/directory",
+                           "chaser_state_history.csv",
+                           "chaser_thrust_history.csv",
+                           csvOutput,
+                           "",
+                           OutputSamplingSettings( ),
+                           "",
+                           AdaptiveSchedulingSettings( true, 0.01 ) );
+    const Real thrustPulseTime = 1.0 / 3.0;
+
+    SECTION( "Test number of thruster pulses" )
+    {
+        const UserInput fixedRateInput( input.startTime,
+                                        input.endTime,
+                                        input.earthGravitationalParameter,
+                                        input.targetSemiMajorAxis,
+                                        input.chaserInitialState,
+                                        input.thrustMode,
+                                        input.thrustMaximum,
+                                        input.thrustFrequency,
+                                        input.chaserWetMass,
+                                        input.arrivalDistanceTolerance,
+                                        input.outputDirectory,
+                                        input.chaserStateHistoryFilename,
+                                        input.chaserThrustHistoryFilename );
+        Simulator simulator( fixedRateInput );
+        REQUIRE( simulator.getNumberOfThrustPulses( ) == 15000 );
+
+        simulator.execute( );
+
+        const StateHistory& stateHistory = simulator.getChaserStateHistory( );
+        REQUIRE( stateHistory.size( ) == 15001 );
+        REQUIRE( simulator.getChaserThrustHistory( ).size( ) == 15000 );
+        for ( std::size_t k = 0; k < stateHistory.size( ); ++k )
+        {
+            REQUIRE( stateHistory.getEpoch( k ) == static_cast< Real >( k ) * thrustPulseTime );
+        }
+        REQUIRE( simulator.getSummary( ).terminationTime == 15000.0 * thrustPulseTime );
+    }
+
+    SECTION( "Test epochs with skipped coast arcs" )
+    {
+        Simulator simulator( input );
+        simulator.execute( );
+
+        // Epochs after coast arcs coincide with epochs of pulses that are not skipped.
+        const StateHistory& stateHistory = simulator.getChaserStateHistory( );
+        REQUIRE( stateHistory.size( ) < 15001 );
+        for ( std::size_t k = 0; k < stateHistory.size( ); ++k )
+        {
+            const Real stepIndex = std::floor( stateHistory.getEpoch( k ) / thrustPulseTime + 0.5 );
+            REQUIRE( stateHistory.getEpoch( k ) == stepIndex * thrustPulseTime );
+        }
+        REQUIRE( stateHistory.getEpoch( stateHistory.size( ) - 1 ) == 15000.0 * thrustPulseTime );
+    }
+}
+
+TEST_CASE( "Test simulator with mass depletion", "[simulator]" )
+{
+    const Vector6 chaserInitialState = { { -100.0, -1000.0, 10.0, 0.0, 0.1, 0.0 } };
+    const Real chaserWetMass = 100.0;
+    const Real thrustMaximum = 0.05;
+    const Real specificImpulse = 220.0;
+    const UserInput input( 0.0,
+                           1000.0,
+                           3.986004418e14,
+                           6778.0e3,
+                           chaserInitialState,
+                           throttle,
+                           thrustMaximum,
+                           1.0,
+                           chaserWetMass,
+                           1.0,
+                           "/path/to/output/directory",
+                           "chaser_state_history.csv",
+                           "chaser_thrust_history.csv",
+                           csvOutput,
+                           "",
+                           OutputSamplingSettings( ),
+                           "",
+                           AdaptiveSchedulingSettings( ),
+                           PropagatorSettings( ),
+                           CheckpointSettings( ),
+                           specificImpulse );
+
+    SECTION( "Test constant chaser mass" )
+    {
+        Simulator simulator( createTestInput( throttle, thrustMaximum ) );
+        simulator.execute( );
+
+        REQUIRE( simulator.getTotalDeltaV( ) > 0.0 );
+        REQUIRE( simulator.getPropellantMass( ) == 0.0 );
+        REQUIRE( simulator.getChaserFinalMass( ) == chaserWetMass );
+        REQUIRE( simulator.getSummary( ).propellantMass == 0.0 );
+    }
+
+    SECTION( "Test depleted chaser mass" )
+    {
+        Simulator simulator( input );
+        simulator.execute( );
+
+        // Propellant mass and delta-V accumulated over all thruster pulses satisfy the rocket
+        // equation.
+        const Real exhaustVelocity = specificImpulse * standardGravity;
+        REQUIRE( simulator.isThrottleMaximumReached( ) );
+        REQUIRE( simulator.getPropellantMass( ) > 0.0 );
+        REQUIRE( simulator.getChaserFinalMass( )
+                 == Approx( chaserWetMass - simulator.getPropellantMass( ) ).epsilon( 1.0e-12 ) );
+        REQUIRE( simulator.getTotalDeltaV( )
+                 == Approx( exhaustVelocity * std::log( chaserWetMass
+                                                        / simulator.getChaserFinalMass( ) ) )
+                        .epsilon( 1.0e-9 ) );
+        REQUIRE( simulator.getSummary( ).propellantMass == simulator.getPropellantMass( ) );
+
+        // Thrust is computed from the current chaser mass, such that the thrust maximum is never
+        // exceeded, while the thrust at saturation decreases as propellant is consumed.
+        const ThrustHistory& thrustHistory = simulator.getChaserThrustHistory( );
+        Real firstThrustNorm = 0.0;
+        for ( std::size_t i = 0; i < thrustHistory.size( ); ++i )
+        {
+            const Real thrustNorm = std::sqrt( thrustHistory( i, 0 ) * thrustHistory( i, 0 )
+                                               + thrustHistory( i, 1 ) * thrustHistory( i, 1 )
+                                               + thrustHistory( i, 2 ) * thrustHistory( i, 2 ) );
+            REQUIRE( thrustNorm < thrustMaximum * ( 1.0 + 1.0e-12 ) );
+            if ( i == 0 )
+            {
+                firstThrustNorm = thrustNorm;
+            }
+        }
+        REQUIRE( firstThrustNorm == Approx( thrustMaximum ) );
+
+        // Repeated execution restores the chaser wet mass.
+        const Real propellantMass = simulator.getPropellantMass( );
+        simulator.execute( );
+        REQUIRE( simulator.getPropellantMass( ) == propellantMass );
+    }
+}
+
+TEST_CASE( "Test repeated simulator execution", "[simulator]" )
+{
+    const UserInput input = createTestInput( throttle, 0.05 );
+    Simulator simulator( input );
+
+    simulator.execute( );
+    const Vector6 firstFinalState = simulator.getChaserFinalState( );
+    REQUIRE( simulator.isThrottleMaximumReached( ) );
+
+    // Execution from a different initial state resets the histories.
+    const Vector6 otherInitialState = { { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 } };
+    simulator.execute( otherInitialState );
+    REQUIRE( simulator.getChaserStateHistory( ).size( ) == 1001 );
+    REQUIRE( simulator.getFinalDistanceToTarget( ) == 0.0 );
+
+    simulator.execute( );
+    for ( int i = 0; i < 6; ++i )
+    {
+        REQUIRE( simulator.getChaserFinalState( )[ i ] == firstFinalState[ i ] );
+    }
+}
+
+//! Output sink that records rows in memory.
+class RecordingOutputSink : public OutputSink
+{
+public:
+
+    explicit RecordingOutputSink( const std::size_t numberOfColumns )
+        : OutputSink( std::vector< std::string >( numberOfColumns ) ),
+          rows( )
+    { }
+
+    void writeRow( const Real* row )
+    {
+        rows.push_back( std::vector< Real >( row, row + columnNames.size( ) ) );
+        ++numberOfRows;
+    }
+
+    void close( ) { }
+
+    std::vector< std::vector< Real > > rows;
+};
+
+TEST_CASE( "Test simulator with output sinks", "[simulator]" )
+{
+    const UserInput input = createTestInput( throttle, 0.05 );
+    Simulator simulator( input );
+    RecordingOutputSink stateSink( 7 );
+    RecordingOutputSink thrustSink( 4 );
+    simulator.setOutputSinks( &stateSink, &thrustSink );
+    simulator.execute( );
+
+    // Streamed rows should match stored histories.
+    const StateHistory& stateHistory = simulator.getChaserStateHistory( );
+    REQUIRE( stateSink.getNumberOfRows( ) == stateHistory.size( ) );
+    for ( std::size_t i = 0; i < stateHistory.size( ); ++i )
+    {
+        REQUIRE( stateSink.rows[ i ][ 0 ] == stateHistory.getEpoch( i ) );
+        for ( std::size_t j = 0; j < 6; ++j )
+        {
+            REQUIRE( stateSink.rows[ i ][ j + 1 ] == stateHistory( i, j ) );
+        }
+    }
+
+    const ThrustHistory& thrustHistory = simulator.getChaserThrustHistory( );
+    REQUIRE( thrustSink.getNumberOfRows( ) == thrustHistory.size( ) );
+    for ( std::size_t i = 0; i < thrustHistory.size( ); ++i )
+    {
+        REQUIRE( thrustSink.rows[ i ][ 0 ] == thrustHistory.getEpoch( i ) );
+        for ( std::size_t j = 0; j < 3; ++j )
+        {
+            REQUIRE( thrustSink.rows[ i ][ j + 1 ] == thrustHistory( i, j ) );
+        }
+    }
+
+    // Trajectory rows should combine state and thrust at each epoch.
+    Simulator trajectorySimulator( input );
+    RecordingOutputSink trajectorySink( 10 );
+    trajectorySimulator.setOutputSinks( 0, 0, &trajectorySink );
+    trajectorySimulator.execute( );
+    REQUIRE( trajectorySink.getNumberOfRows( ) == stateHistory.size( ) );
+    for ( std::size_t i = 0; i < thrustHistory.size( ); ++i )
+    {
+        REQUIRE( trajectorySink.rows[ i ][ 0 ] == stateHistory.getEpoch( i ) );
+        for ( std::size_t j = 0; j < 6; ++j )
+        {
+            REQUIRE( trajectorySink.rows[ i ][ j + 1 ] == stateHistory( i, j ) );
+        }
+        for ( std::size_t j = 0; j < 3; ++j )
+        {
+            REQUIRE( trajectorySink.rows[ i ][ j + 7 ] == thrustHistory( i, j ) );
+        }
+    }
+    REQUIRE( std::isnan( trajectorySink.rows.back( )[ 7 ] ) );
+
+    // Streaming should also work if histories are not stored.
+    Simulator streamingSimulator( input, false );
+    RecordingOutputSink streamedStateSink( 7 );
+    streamingSimulator.setOutputSinks( &streamedStateSink );
+    streamingSimulator.execute( );
+    REQUIRE( streamingSimulator.getChaserStateHistory( ).size( ) == 0 );
+    REQUIRE( streamedStateSink.getNumberOfRows( ) == stateHistory.size( ) );
+}
+
+TEST_CASE( "Test simulator with output sampling", "[simulator]" )
+{
+    const Vector6 chaserInitialState = { { -100.0, -1000.0, 10.0, 0.0, 0.1, 0.0 } };
+    const UserInput input( 0.0, 1000.0, 3.986004418e14, 6778.0e3, chaserInitialState, onOff, 2.0,
+                           1.0, 100.0, 1.0, "/path/to/output/directory",
+                           "chaser_state_history.csv", "chaser_thrust_history.csv", csvOutput, "",
+                           OutputSamplingSettings( everyNthStep, 100, 0.0, true ) );
+    Simulator simulator( input );
+    RecordingOutputSink stateSink( 7 );
+    RecordingOutputSink thrustSink( 4 );
+    simulator.setOutputSinks( &stateSink, &thrustSink );
+    simulator.execute( );
+
+    // Every 100th step, the final epoch and the thrust on/off transitions should be written.
+    const ThrustHistory& thrustHistory = simulator.getChaserThrustHistory( );
+    std::size_t numberOfExpectedThrustRows = 0;
+    bool wasThrustOn = false;
+    for ( std::size_t i = 0; i < thrustHistory.size( ); ++i )
+    {
+        const bool isThrustOn = thrustHistory( i, 0 ) != 0.0 || thrustHistory( i, 1 ) != 0.0
+                                || thrustHistory( i, 2 ) != 0.0;
+        if ( i % 100 == 0 || isThrustOn != wasThrustOn )
+        {
+            REQUIRE( thrustSink.rows[ numberOfExpectedThrustRows ][ 0 ]
+                     == thrustHistory.getEpoch( i ) );
+            ++numberOfExpectedThrustRows;
+        }
+        wasThrustOn = isThrustOn;
+    }
+
+    REQUIRE( numberOfExpectedThrustRows > 10 );
+    REQUIRE( thrustSink.getNumberOfRows( ) == numberOfExpectedThrustRows );
+    REQUIRE( stateSink.getNumberOfRows( ) == numberOfExpectedThrustRows + 1 );
+    REQUIRE( stateSink.rows.back( )[ 0 ]
+             == simulator.getChaserStateHistory( ).getEpoch(
+                    simulator.getChaserStateHistory( ).size( ) - 1 ) );
+}
+
+} // namespace tests
+} // namespace rvdsim
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+#include <catch.hpp>
+
+#include "rvdsim/threadPool.hpp"
+
+namespace rvdsim
+{
+namespace tests
+{
+
+TEST_CASE( "Test thread pool construction", "[thread_pool]" )
+{
+    const ThreadPool threadPool( 3 );
+    REQUIRE( threadPool.getNumberOfThreads( ) == 3 );
+
+    const ThreadPool defaultThreadPool;
+    REQUIRE( defaultThreadPool.getNumberOfThreads( ) >= 1 );
+}
+
+TEST_CASE( "Test thread pool task execution", "[thread_pool]" )
+{
+    ThreadPool threadPool( 4 );
+    std::atomic< int > counter( 0 );
+
+    for ( int i = 0; i < 1000; ++i )
+    {
+        threadPool.submit( [ &counter ]( ) { ++counter; } );
+    }
+    threadPool.wait( );
+    REQUIRE( counter == 1000 );
+
+    // Thread pool can be reused after waiting.
+    threadPool.submit( [ &counter ]( ) { counter += 10; } );
+    threadPool.wait( );
+    REQUIRE( counter == 1010 );
+}
+
+TEST_CASE( "Test parallel loop", "[thread_pool]" )
+{
+    ThreadPool threadPool( 4 );
+
+    // Every index is visited exactly once, also if the number of iterations is not a multiple of
+    // the chunk size.
+    std::vector< int > visits( 1001, 0 );
+    executeParallelLoop( threadPool, visits.size( ), 7,
+                         [ &visits ]( const std::size_t i ) { visits[ i ] += 1; } );
+    for ( std::size_t i = 0; i < visits.size( ); ++i )
+    {
+        REQUIRE( visits[ i ] == 1 );
+    }
+
+    // Empty loop returns immediately.
+    executeParallelLoop( threadPool, 0, 7, [ ]( const std::size_t ) { } );
+}
+
+} // namespace tests
+} // namespace rvdsim
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cmath>
+
+#include <catch.hpp>
+
+#include "rvdsim/thrustPolicy.hpp"
+#include "rvdsim/typedefs.hpp"
+#include "rvdsim/userInput.hpp"
+
+namespace rvdsim
+{
+namespace tests
+{
+
+TEST_CASE( "Test thrust policy selection", "[thrust_policy]" )
+{
+    REQUIRE( selectThrustPolicy( off, 0.0 ) == noThrustPolicy );
+    REQUIRE( selectThrustPolicy( off, 1.0e-3 ) == noThrustPolicy );
+    REQUIRE( selectThrustPolicy( throttle, 0.0 ) == unconstrainedThrustPolicy );
+    REQUIRE( selectThrustPolicy( onOff, 0.0 ) == unconstrainedThrustPolicy );
+    REQUIRE( selectThrustPolicy( throttle, 1.0e-3 ) == throttleThrustPolicy );
+    REQUIRE( selectThrustPolicy( onOff, 1.0e-3 ) == onOffThrustPolicy );
+}
+
+TEST_CASE( "Test thrust policies", "[thrust_policy]" )
+{
+    const Real thrustAccelerationMaximum = 1.0e-3;
+
+    // Commanded thrust accelerations below the switching threshold, between the switching
+    // threshold and the maximum, and above the maximum, with magnitudes 3e-4, 8e-4 and 2e-3.
+    const Vector3 commandedThrustAccelerations[ 3 ]
+        = { { { 0.0, 3.0e-4, 0.0 } },
+            { { 0.0, 4.8e-4, 6.4e-4 } },
+            { { 1.2e-3, 0.0, -1.6e-3 } } };
+
+    SECTION( "Test no-thrust and unconstrained policies" )
+    {
+        bool isSaturated = true;
+        REQUIRE( NoThrustPolicy::computeScaleFactor( 2.0e-3, thrustAccelerationMaximum,
+                                                     isSaturated ) == 0.0 );
+        REQUIRE( !isSaturated );
+
+        for ( int j = 0; j < 3; ++j )
+        {
+            Vector3 thrustAcceleration = commandedThrustAccelerations[ j ];
+            REQUIRE( !applyThrustPolicy< UnconstrainedThrustPolicy >( thrustAccelerationMaximum,
+                                                                      thrustAcceleration ) );
+            REQUIRE( thrustAcceleration == commandedThrustAccelerations[ j ] );
+        }
+    }
+
+    SECTION( "Test throttle policy" )
+    {
+        const Real commandedMagnitudes[ 3 ] = { 3.0e-4, 8.0e-4, 2.0e-3 };
+        const Real expectedMagnitudes[ 3 ] = { 3.0e-4, 8.0e-4, 1.0e-3 };
+        for ( int j = 0; j < 3; ++j )
+        {
+            Vector3 thrustAcceleration = commandedThrustAccelerations[ j ];
+            const bool isSaturated = applyThrustPolicy< ThrottleThrustPolicy >(
+                thrustAccelerationMaximum, thrustAcceleration );
+            REQUIRE( isSaturated == ( j == 2 ) );
+
+            // The thrust acceleration is scaled, such that its direction is preserved.
+            for ( int i = 0; i < 3; ++i )
+            {
+                REQUIRE( thrustAcceleration[ i ]
+                         == Approx( commandedThrustAccelerations[ j ][ i ]
+                                    * expectedMagnitudes[ j ] / commandedMagnitudes[ j ] )
+                            .margin( 1.0e-15 ) );
+            }
+        }
+    }
+
+    SECTION( "Test on-off policy" )
+    {
+        REQUIRE( OnOffThrustPolicy::computeSwitchingThreshold( thrustAccelerationMaximum )
+                 == Approx( 5.0e-4 ) );
+
+        const Real expectedMagnitudes[ 3 ] = { 0.0, 1.0e-3, 1.0e-3 };
+        for ( int j = 0; j < 3; ++j )
+        {
+            Vector3 thrustAcceleration = commandedThrustAccelerations[ j ];
+            REQUIRE( !applyThrustPolicy< OnOffThrustPolicy >( thrustAccelerationMaximum,
+                                                              thrustAcceleration ) );
+            REQUIRE( std::sqrt( thrustAcceleration[ 0 ] * thrustAcceleration[ 0 ]
+                                + thrustAcceleration[ 1 ] * thrustAcceleration[ 1 ]
+                                + thrustAcceleration[ 2 ] * thrustAcceleration[ 2 ] )
+                     == Approx( expectedMagnitudes[ j ] ).margin( 1.0e-15 ) );
+        }
+    }
+}
+
+} // namespace tests
+} // namespace rvdsim
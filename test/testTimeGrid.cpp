@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cstddef>
+
+#include <catch.hpp>
+
+#include "rvdsim/timeGrid.hpp"
+#include "rvdsim/typedefs.hpp"
+
+namespace rvdsim
+{
+namespace tests
+{
+
+TEST_CASE( "Test number of thruster pulses", "[time_grid]" )
+{
+    SECTION( "Test duration that is an integer multiple of pulse length" )
+    {
+        REQUIRE( computeNumberOfThrustPulses( 1000.0, 1.0 ) == 1000 );
+        REQUIRE( computeNumberOfThrustPulses( 100.0, 1.0 / 3.0 ) == 300 );
+        REQUIRE( computeNumberOfThrustPulses( 1000.0, 1.0 / 0.3 ) == 300 );
+        REQUIRE( computeNumberOfThrustPulses( 100.0, 1.0 / 10.0 ) == 1000 );
+
+        // Rounding remainder of 1000 s / ( 1 / 1.3 Hz ) = 1300.0000000000002 is discarded.
+        REQUIRE( computeNumberOfThrustPulses( 1000.0, 1.0 / 1.3 ) == 1300 );
+        REQUIRE( computeNumberOfThrustPulses( 5400.0, 1.0 / 1.3 ) == 7020 );
+    }
+
+    SECTION( "Test duration that is not an integer multiple of pulse length" )
+    {
+        REQUIRE( computeNumberOfThrustPulses( 1000.5, 1.0 ) == 1001 );
+        REQUIRE( computeNumberOfThrustPulses( 0.25, 1.0 ) == 1 );
+        REQUIRE( computeNumberOfThrustPulses( 10.0, 3.0 ) == 4 );
+    }
+
+    SECTION( "Test empty simulation" )
+    {
+        REQUIRE( computeNumberOfThrustPulses( 0.0, 1.0 ) == 0 );
+        REQUIRE( computeNumberOfThrustPulses( -10.0, 1.0 ) == 0 );
+    }
+}
+
+TEST_CASE( "Test time grid", "[time_grid]" )
+{
+    const Real thrustPulseTime = 1.0 / 3.0;
+    const TimeGrid timeGrid( 100.0, 1100.0, thrustPulseTime );
+
+    REQUIRE( timeGrid.getNumberOfSteps( ) == 3000 );
+    REQUIRE( timeGrid.getThrustPulseTime( ) == thrustPulseTime );
+    REQUIRE( timeGrid.getEpoch( 0 ) == 100.0 );
+    REQUIRE( timeGrid.getTimeToGo( 0 ) == 1000.0 );
+
+    // Epoch and Time-To-Go are derived from step index, such that they do not depend on the path
+    // taken to reach a step.
+    for ( std::size_t k = 0; k <= timeGrid.getNumberOfSteps( ); ++k )
+    {
+        REQUIRE( timeGrid.getEpoch( k ) == 100.0 + static_cast< Real >( k ) * thrustPulseTime );
+        REQUIRE( timeGrid.getTimeToGo( k )
+                 == 1000.0 - static_cast< Real >( k ) * thrustPulseTime );
+    }
+
+    REQUIRE( timeGrid.getTimeToGo( timeGrid.getNumberOfSteps( ) - 1 ) > 0.0 );
+    REQUIRE( timeGrid.getEpoch( timeGrid.getNumberOfSteps( ) ) == Approx( 1100.0 ) );
+    REQUIRE( timeGrid.getTimeToGo( timeGrid.getNumberOfSteps( ) )
+             == Approx( 0.0 ).margin( 1.0e-10 ) );
+
+    SECTION( "Test last pulse shorter than pulse length" )
+    {
+        const TimeGrid otherTimeGrid( 0.0, 10.5, 1.0 );
+        REQUIRE( otherTimeGrid.getNumberOfSteps( ) == 11 );
+        REQUIRE( otherTimeGrid.getTimeToGo( 10 ) == 0.5 );
+        REQUIRE( otherTimeGrid.getEpoch( 11 ) == 11.0 );
+    }
+}
+
+} // namespace tests
+} // namespace rvdsim
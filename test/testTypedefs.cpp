@@ -4,9 +4,8 @@
  * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
  */
 
-#include <map>
+#include <array>
 #include <typeinfo>
-#include <vector>
 
 #include <catch.hpp>
 
@@ -19,11 +18,64 @@ namespace tests
 
 TEST_CASE( "Test typedefs", "[typedef]" )
 {
-    REQUIRE( typeid( Real )             == typeid( double ) );
-    REQUIRE( typeid( Vector3 )          == typeid( std::vector< Real > ) );
-    REQUIRE( typeid( Vector6 )          == typeid( std::vector< Real > ) );
-    REQUIRE( typeid( StateHistory )     == typeid( std::map< Real, Vector6 > ) );
-    REQUIRE( typeid( ThrustHistory )    == typeid( std::map< Real, Vector3 > ) );
+    REQUIRE( typeid( Real )              == typeid( double ) );
+    REQUIRE( typeid( Vector3 )           == typeid( std::array< Real, 3 > ) );
+    REQUIRE( typeid( Vector6 )           == typeid( std::array< Real, 6 > ) );
+    REQUIRE( typeid( StateHistory )      == typeid( History< Real, 6 > ) );
+    REQUIRE( typeid( ThrustHistory )     == typeid( History< Real, 3 > ) );
+    REQUIRE( typeid( Matrix66 )          == typeid( std::array< std::array< Real, 6 >, 6 > ) );
+    REQUIRE( typeid( Matrix63 )          == typeid( std::array< std::array< Real, 3 >, 6 > ) );
+    REQUIRE( typeid( Matrix36 )          == typeid( std::array< std::array< Real, 6 >, 3 > ) );
+    REQUIRE( typeid( StateBatch )        == typeid( VectorBatch< Real, 6 > ) );
+    REQUIRE( typeid( AccelerationBatch ) == typeid( VectorBatch< Real, 3 > ) );
+}
+
+TEST_CASE( "Test history container", "[typedef]" )
+{
+    StateHistory stateHistory;
+    stateHistory.reserve( 2 );
+    REQUIRE( stateHistory.empty( ) );
+
+    Vector6 state = { { 1.0, 2.0, 3.0, 4.0, 5.0, 6.0 } };
+    stateHistory.push_back( 0.5, state );
+    state[ 0 ] = -1.0;
+    stateHistory.push_back( 1.5, state );
+
+    REQUIRE( stateHistory.size( )                   == 2 );
+    REQUIRE( stateHistory.getEpoch( 0 )             == 0.5 );
+    REQUIRE( stateHistory.getEpoch( 1 )             == 1.5 );
+    REQUIRE( stateHistory( 0, 0 )                   == 1.0 );
+    REQUIRE( stateHistory( 1, 0 )                   == -1.0 );
+    REQUIRE( stateHistory( 1, 5 )                   == 6.0 );
+    REQUIRE( stateHistory.getColumn( 2 ).size( )    == 2 );
+    REQUIRE( stateHistory.getEpochs( ).capacity( )  >= 2 );
+
+    // Clearing the history retains reserved storage.
+    const Real* epochs = stateHistory.getEpochs( ).data( );
+    stateHistory.clear( );
+    REQUIRE( stateHistory.empty( ) );
+    stateHistory.push_back( 2.5, state );
+    REQUIRE( stateHistory.getEpochs( ).data( )      == epochs );
+}
+
+TEST_CASE( "Test vector batch container", "[typedef]" )
+{
+    StateBatch stateBatch( 3 );
+    REQUIRE( stateBatch.size( ) == 3 );
+    REQUIRE( stateBatch( 2, 5 ) == 0.0 );
+
+    const Vector6 state = { { 1.0, 2.0, 3.0, 4.0, 5.0, 6.0 } };
+    stateBatch.setVector( 1, state );
+    REQUIRE( stateBatch( 1, 0 )                 == 1.0 );
+    REQUIRE( stateBatch( 1, 5 )                 == 6.0 );
+    REQUIRE( stateBatch.getColumn( 3 )[ 1 ]     == 4.0 );
+
+    Vector6 result;
+    stateBatch.getVector( 1, result );
+    REQUIRE( result == state );
+
+    stateBatch( 0, 2 ) = -3.0;
+    REQUIRE( stateBatch.getColumn( 2 )[ 0 ]     == -3.0 );
 }
 
 } // namespace tests
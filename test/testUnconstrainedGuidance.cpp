@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cstddef>
+
+#include <catch.hpp>
+
+#include "rvdsim/clohessyWiltshire.hpp"
+#include "rvdsim/guidanceKernel.hpp"
+#include "rvdsim/simulator.hpp"
+#include "rvdsim/thrustPolicy.hpp"
+#include "rvdsim/typedefs.hpp"
+#include "rvdsim/unconstrainedGuidance.hpp"
+#include "rvdsim/userInput.hpp"
+
+#include "testInputFactory.hpp"
+
+namespace rvdsim
+{
+namespace tests
+{
+
+TEST_CASE( "Test unconstrained guidance gains", "[unconstrained_guidance]" )
+{
+    const Real meanMotion = 1.1e-3;
+    const Real timeToGo = 0.5;
+    const ClohessyWiltshireStateTransition transition
+        = computeClohessyWiltshireStateTransition( meanMotion, timeToGo );
+    Matrix36 feedbackGain;
+    computeUnconstrainedFeedbackGain( transition, timeToGo, feedbackGain );
+
+    // Near the end of the simulation, the gains tend to those of the double integrator:
+    // a = -6 / tgo^2 ( r + tgo v ) + 2 / tgo v.
+    REQUIRE( feedbackGain[ 0 ][ 0 ] == Approx( -24.0 ).epsilon( 1.0e-3 ) );
+    REQUIRE( feedbackGain[ 0 ][ 3 ] == Approx( -8.0 ).epsilon( 1.0e-3 ) );
+    REQUIRE( feedbackGain[ 2 ][ 2 ] == Approx( -24.0 ).epsilon( 1.0e-3 ) );
+    REQUIRE( feedbackGain[ 1 ][ 0 ] == Approx( 0.0 ).margin( 1.0e-2 ) );
+
+    // The feedback law commands the same thrust acceleration as the guidance kernel.
+    const Vector6 state = { { -100.0, -1000.0, 10.0, 0.0, 0.1, 0.0 } };
+    const Real longTimeToGo = 600.0;
+    const ClohessyWiltshireStateTransition longTransition
+        = computeClohessyWiltshireStateTransition( meanMotion, longTimeToGo );
+    computeUnconstrainedFeedbackGain( longTransition, longTimeToGo, feedbackGain );
+    Vector3 thrustAcceleration;
+    computeUnconstrainedThrustAcceleration( feedbackGain, state, thrustAcceleration );
+
+    Vector3 zeroEffortMiss;
+    Vector3 zeroEffortVelocity;
+    Vector3 kernelThrustAcceleration;
+    bool isSaturated = false;
+    evaluateGuidanceKernel< UnconstrainedThrustPolicy >( longTransition,
+                                                         longTimeToGo,
+                                                         state,
+                                                         0.0,
+                                                         zeroEffortMiss,
+                                                         zeroEffortVelocity,
+                                                         kernelThrustAcceleration,
+                                                         isSaturated );
+    for ( int i = 0; i < 3; ++i )
+    {
+        REQUIRE( thrustAcceleration[ i ]
+                 == Approx( kernelThrustAcceleration[ i ] ).epsilon( 1.0e-9 ).margin( 1.0e-15 ) );
+    }
+}
+
+TEST_CASE( "Test unconstrained guidance closed-loop transition", "[unconstrained_guidance]" )
+{
+    const Real meanMotion = 1.1e-3;
+    const Real timeToGo = 600.0;
+    Matrix36 feedbackGain;
+    computeUnconstrainedFeedbackGain(
+        computeClohessyWiltshireStateTransition( meanMotion, timeToGo ), timeToGo, feedbackGain );
+    const ClohessyWiltshireStateTransition pulseTransition
+        = computeClohessyWiltshireStateTransition( meanMotion, 1.0 );
+    ClosedLoopTransition closedLoopTransition;
+    computeClosedLoopTransition( pulseTransition, feedbackGain, closedLoopTransition );
+
+    // The closed-loop transition yields the same state as propagating under the commanded thrust
+    // acceleration, also if the final state is stored in the initial state.
+    const Vector6 state = { { -100.0, -1000.0, 10.0, 0.0, 0.1, 0.0 } };
+    Vector3 thrustAcceleration;
+    computeUnconstrainedThrustAcceleration( feedbackGain, state, thrustAcceleration );
+    Vector6 expectedState;
+    propagateClohessyWiltshire( pulseTransition, state, thrustAcceleration, expectedState );
+
+    Vector6 finalState = state;
+    propagateClosedLoop( closedLoopTransition, finalState, finalState );
+    for ( int i = 0; i < 6; ++i )
+    {
+        REQUIRE( finalState[ i ]
+                 == Approx( expectedState[ i ] ).epsilon( 1.0e-12 ).margin( 1.0e-12 ) );
+    }
+}
+
+TEST_CASE( "Test unconstrained guidance fast path", "[unconstrained_guidance]" )
+{
+    // A thruster that is never saturated follows the stepped guidance loop, whereas an
+    // unconstrained thruster applies the precomputed closed-loop transitions.
+    Simulator steppedSimulator( createTestInput( throttle, 1.0e12 ) );
+    Simulator fastSimulator( createTestInput( throttle, 0.0 ) );
+    REQUIRE( !steppedSimulator.isUnconstrainedFastPathUsed( ) );
+    REQUIRE( fastSimulator.isUnconstrainedFastPathUsed( ) );
+
+    // The closed-loop transitions are not stored for simulations with too many thruster pulses.
+    const Simulator longSimulator( createTestInput( throttle, 0.0, 1000.0, 100.0 ), false );
+    REQUIRE( !longSimulator.isUnconstrainedFastPathUsed( ) );
+
+    steppedSimulator.execute( );
+    fastSimulator.execute( );
+    REQUIRE( !steppedSimulator.isThrottleMaximumReached( ) );
+
+    const StateHistory& steppedStates = steppedSimulator.getChaserStateHistory( );
+    const StateHistory& fastStates = fastSimulator.getChaserStateHistory( );
+    REQUIRE( fastStates.size( ) == steppedStates.size( ) );
+    for ( std::size_t i = 0; i < steppedStates.size( ); ++i )
+    {
+        REQUIRE( fastStates.getEpoch( i ) == steppedStates.getEpoch( i ) );
+        for ( std::size_t j = 0; j < 6; ++j )
+        {
+            REQUIRE( fastStates( i, j )
+                     == Approx( steppedStates( i, j ) ).epsilon( 1.0e-6 ).margin( 1.0e-8 ) );
+        }
+    }
+
+    const ThrustHistory& steppedThrusts = steppedSimulator.getChaserThrustHistory( );
+    const ThrustHistory& fastThrusts = fastSimulator.getChaserThrustHistory( );
+    REQUIRE( fastThrusts.size( ) == steppedThrusts.size( ) );
+    for ( std::size_t i = 0; i < steppedThrusts.size( ); ++i )
+    {
+        for ( std::size_t j = 0; j < 3; ++j )
+        {
+            REQUIRE( fastThrusts( i, j )
+                     == Approx( steppedThrusts( i, j ) ).epsilon( 1.0e-6 ).margin( 1.0e-8 ) );
+        }
+    }
+
+    REQUIRE( fastSimulator.getTotalDeltaV( )
+             == Approx( steppedSimulator.getTotalDeltaV( ) ).epsilon( 1.0e-6 ) );
+    REQUIRE( fastSimulator.isTargetReached( ) == steppedSimulator.isTargetReached( ) );
+
+    // Repeated execution from a different initial state yields the same result.
+    const Vector6 otherInitialState = { { 50.0, -500.0, -20.0, 0.01, 0.0, 0.02 } };
+    steppedSimulator.execute( otherInitialState );
+    fastSimulator.execute( otherInitialState );
+    for ( int i = 0; i < 6; ++i )
+    {
+        REQUIRE( fastSimulator.getChaserFinalState( )[ i ]
+                 == Approx( steppedSimulator.getChaserFinalState( )[ i ] ).epsilon( 1.0e-6 )
+                                                                           .margin( 1.0e-8 ) );
+    }
+}
+
+} // namespace tests
+} // namespace rvdsim
@@ -4,22 +4,20 @@
  * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
  */
 
+#include <stdexcept>
+
 #include <catch.hpp>
-#include <vector>
 
+#include "rvdsim/typedefs.hpp"
 #include "rvdsim/userInput.hpp"
 
+#include "testInputFactory.hpp"
+
 namespace rvdsim
 {
 namespace tests
 {
 
-//! Define type for real, floating-point numbers.
-typedef double Real;
-
-//! Define container for vector of length 6.
-typedef std::vector< Real > Vector6;
-
 TEST_CASE( "Test thrust modes", "[input]" )
 {
     // Enum type assigns integers to each thrust mode.
@@ -31,7 +29,7 @@ TEST_CASE( "Test thrust modes", "[input]" )
 TEST_CASE( "Test user input struct", "[input]" )
 {
     // Create dummy initial state.
-    Vector6 dummyInitialState( 6 );
+    Vector6 dummyInitialState;
     dummyInitialState[ 0 ] = 0.15;
     dummyInitialState[ 1 ] = -1.16;
     dummyInitialState[ 2 ] = 5.19;
@@ -68,11 +66,152 @@ TEST_CASE( "Test user input struct", "[input]" )
     REQUIRE( dummyUserInput.thrustMaximum                   == 1.522 );
     REQUIRE( dummyUserInput.thrustFrequency                 == 62.3 );
     REQUIRE( dummyUserInput.chaserWetMass                   == 1250.91 );
+    REQUIRE( dummyUserInput.chaserSpecificImpulse           == 0.0 );
     REQUIRE( dummyUserInput.arrivalDistanceTolerance        == 1.0e-7 );
     REQUIRE( dummyUserInput.outputDirectory                 == "/path/to/output/directory" );
     REQUIRE( dummyUserInput.chaserStateHistoryFilename      == "/path/to/chaser/state/history" );
     REQUIRE( dummyUserInput.chaserThrustHistoryFilename     == "/path/to/chaser/thrust/history" );
 }
 
+TEST_CASE( "Test output sampling input", "[input]" )
+{
+    SECTION( "Test default output sampling" )
+    {
+        rapidjson::Document config;
+        config.Parse( "{ \"output_directory\" : \"\" }" );
+        const OutputSamplingSettings settings = checkOutputSamplingInput( config );
+        REQUIRE( settings.samplingMode == everyStep );
+        REQUIRE( !settings.isThrustSwitchEventEnabled );
+        REQUIRE( !settings.isThrottleSaturationEventEnabled );
+        REQUIRE( !settings.isArrivalEventEnabled );
+    }
+
+    SECTION( "Test every N-th step with events" )
+    {
+        rapidjson::Document config;
+        config.Parse( "{ \"output_sampling\" : { \"mode\" : \"every_nth_step\", "
+                      "\"step_interval\" : 10, \"events\" : [\"thrust_switch\", \"arrival\"] } }" );
+        const OutputSamplingSettings settings = checkOutputSamplingInput( config );
+        REQUIRE( settings.samplingMode == everyNthStep );
+        REQUIRE( settings.stepInterval == 10 );
+        REQUIRE( settings.isThrustSwitchEventEnabled );
+        REQUIRE( !settings.isThrottleSaturationEventEnabled );
+        REQUIRE( settings.isArrivalEventEnabled );
+    }
+
+    SECTION( "Test fixed interval" )
+    {
+        rapidjson::Document config;
+        config.Parse( "{ \"output_sampling\" : { \"mode\" : \"interval\", "
+                      "\"time_interval\" : 2.5 } }" );
+        const OutputSamplingSettings settings = checkOutputSamplingInput( config );
+        REQUIRE( settings.samplingMode == fixedInterval );
+        REQUIRE( settings.timeInterval == Approx( 2.5 ) );
+    }
+}
+
+TEST_CASE( "Test adaptive scheduling input", "[input]" )
+{
+    SECTION( "Test default adaptive scheduling" )
+    {
+        rapidjson::Document config;
+        config.Parse( "{ \"output_directory\" : \"\" }" );
+        const AdaptiveSchedulingSettings settings = checkAdaptiveSchedulingInput( config );
+        REQUIRE( !settings.isEnabled );
+    }
+
+    SECTION( "Test adaptive scheduling with tolerance" )
+    {
+        rapidjson::Document config;
+        config.Parse( "{ \"adaptive_scheduling\" : { \"tolerance\" : 0.05 } }" );
+        const AdaptiveSchedulingSettings settings = checkAdaptiveSchedulingInput( config );
+        REQUIRE( settings.isEnabled );
+        REQUIRE( settings.tolerance == Approx( 0.05 ) );
+    }
+}
+
+TEST_CASE( "Test propagator input", "[input]" )
+{
+    SECTION( "Test default propagator" )
+    {
+        rapidjson::Document config;
+        config.Parse( "{ \"output_directory\" : \"\" }" );
+        const PropagatorSettings settings = checkPropagatorInput( config );
+        REQUIRE( settings.propagatorType == clohessyWiltshirePropagator );
+        REQUIRE( settings.targetEccentricity == 0.0 );
+        REQUIRE( settings.transitionTolerance == 1.0e-12 );
+    }
+
+    SECTION( "Test Clohessy-Wiltshire propagator with transition tolerance" )
+    {
+        rapidjson::Document config;
+        config.Parse( "{ \"propagator\" : { \"model\" : \"clohessy_wiltshire\", "
+                      "\"transition_tolerance\" : 0.0 } }" );
+        const PropagatorSettings settings = checkPropagatorInput( config );
+        REQUIRE( settings.propagatorType == clohessyWiltshirePropagator );
+        REQUIRE( settings.transitionTolerance == 0.0 );
+    }
+
+    SECTION( "Test J2-perturbed nonlinear propagator" )
+    {
+        rapidjson::Document config;
+        config.Parse( "{ \"propagator\" : { \"model\" : \"j2_nonlinear\", "
+                      "\"target_eccentricity\" : 0.01, \"target_true_anomaly\" : 0.5, "
+                      "\"target_inclination\" : 0.9, \"integrator\" : \"rk4\", "
+                      "\"step_size\" : 0.5 } }" );
+        const PropagatorSettings settings = checkPropagatorInput( config );
+        REQUIRE( settings.propagatorType == j2NonlinearPropagator );
+        REQUIRE( settings.targetEccentricity == Approx( 0.01 ) );
+        REQUIRE( settings.targetInitialTrueAnomaly == Approx( 0.5 ) );
+        REQUIRE( settings.targetInclination == Approx( 0.9 ) );
+        REQUIRE( settings.integratorType == rungeKutta4Integrator );
+        REQUIRE( settings.stepSize == Approx( 0.5 ) );
+        REQUIRE( settings.tolerance == Approx( PropagatorSettings( ).tolerance ) );
+    }
+}
+
+TEST_CASE( "Test checkpoint input", "[input]" )
+{
+    SECTION( "Test default checkpointing" )
+    {
+        rapidjson::Document config;
+        config.Parse( "{ \"output_directory\" : \"\" }" );
+        const CheckpointSettings settings = checkCheckpointInput( config );
+        REQUIRE( settings.filename.empty( ) );
+    }
+
+    SECTION( "Test checkpointing with step interval" )
+    {
+        rapidjson::Document config;
+        config.Parse( "{ \"checkpoint\" : { \"filename\" : \"checkpoint.bin\", "
+                      "\"step_interval\" : 5000 } }" );
+        const CheckpointSettings settings = checkCheckpointInput( config );
+        REQUIRE( settings.filename == "checkpoint.bin" );
+        REQUIRE( settings.stepInterval == 5000 );
+    }
+}
+
+TEST_CASE( "Test user input rules", "[input]" )
+{
+    REQUIRE_NOTHROW( checkUserInput( createTestInput( ) ) );
+    REQUIRE_NOTHROW( checkUserInput( createTestInput( onOff, 0.0 ) ) );
+
+    REQUIRE_THROWS_AS( checkUserInput( createTestInput( throttle, -1.0 ) ),
+                       std::invalid_argument );
+    REQUIRE_THROWS_AS( checkUserInput( createTestInput( throttle, 0.5, -1.0 ) ),
+                       std::invalid_argument );
+    REQUIRE_THROWS_AS( checkUserInput( createTestInput( throttle, 0.5, 1000.0, 0.0 ) ),
+                       std::invalid_argument );
+    REQUIRE_THROWS_AS( checkUserInput( createTestInput( throttle, 0.5, 1000.0, 1.0,
+                                                        testChaserInitialState, 0.0 ) ),
+                       std::invalid_argument );
+    REQUIRE_THROWS_AS(
+        checkUserInput( createTestInput( throttle, 0.5, 1000.0, 1.0, testChaserInitialState,
+                                         100.0, 1.0,
+                                         PropagatorSettings( yamanakaAnkersenPropagator,
+                                                             1.0, 0.0, 0.0 ) ) ),
+        std::invalid_argument );
+}
+
 } // namespace tests
 } // namespace rvdsim
@@ -0,0 +1,252 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <rapidjson/document.h>
+
+#include "rvdsim/configLoader.hpp"
+#include "rvdsim/monteCarlo.hpp"
+#include "rvdsim/simulator.hpp"
+#include "rvdsim/typedefs.hpp"
+#include "rvdsim/userInput.hpp"
+#include "rvdsim/workQueue.hpp"
+
+namespace rvdsim
+{
+namespace tests
+{
+
+//! Campaign of Monte Carlo analysis used for work queue tests.
+const char workQueueCampaign[ ]
+    = "{\n"
+      "    \"propagation_settings\"           : [0.0, 500.0],\n"
+      "    \"earth_gravitational_parameter\"  : 3.986004418e14,\n"
+      "    \"target_semi_major_axis\"         : 6778.0e3,\n"
+      "    \"chaser_initial_state\"           : [-100.0, -1000.0, 10.0, 0.0, 0.1, 0.0],\n"
+      "    \"chaser_thrust_settings\"         : [\"throttle\", 0.5, 1.0],\n"
+      "    \"chaser_wet_mass\"                : 100.0,\n"
+      "    \"arrival_distance_tolerance\"     : 1.0,\n"
+      "    \"output_directory\"               : \"\",\n"
+      "    \"chaser_state_history_filename\"  : \"\",\n"
+      "    \"chaser_thrust_history_filename\" : \"\",\n"
+      "    \"dispersion\" : {\n"
+      "        \"samples\"                    : 37,\n"
+      "        \"seed\"                       : 12345,\n"
+      "        \"threads\"                    : 2,\n"
+      "        \"chaser_initial_state\"       : [[\"normal\", 0.0, 10.0],\n"
+      "                                        [\"uniform\", -50.0, 50.0],\n"
+      "                                        [\"normal\", 0.0, 0.0],\n"
+      "                                        [\"normal\", 0.0, 0.0],\n"
+      "                                        [\"normal\", 0.0, 0.0],\n"
+      "                                        [\"normal\", 0.0, 0.0]],\n"
+      "        \"chaser_wet_mass\"            : [\"uniform\", -5.0, 5.0],\n"
+      "        \"summary_filename\"           : \"monte_carlo_summary.csv\"\n"
+      "    },\n"
+      "    \"work_queue\" : {\n"
+      "        \"samples_per_task\"           : 8,\n"
+      "        \"poll_interval\"              : 0.005,\n"
+      "        \"straggler_factor\"           : 2.0,\n"
+      "        \"straggler_timeout\"          : 0.05\n"
+      "    }\n"
+      "}\n";
+
+//! Remove queue directory written by work queue tests, including its subdirectories.
+void removeQueueDirectory( const std::string& queueDirectory )
+{
+    const char* subdirectoryNames[ ] = { "tasks", "claimed", "results" };
+    for ( std::size_t i = 0; i < 3; ++i )
+    {
+        const std::string subdirectory = queueDirectory + "/" + subdirectoryNames[ i ];
+        const std::vector< std::string > entryNames = listDirectoryEntries( subdirectory );
+        for ( std::size_t j = 0; j < entryNames.size( ); ++j )
+        {
+            if ( entryNames[ j ] != "." && entryNames[ j ] != ".." )
+            {
+                std::remove( ( subdirectory + "/" + entryNames[ j ] ).c_str( ) );
+            }
+        }
+        std::remove( subdirectory.c_str( ) );
+    }
+    std::remove( ( queueDirectory + "/campaign.json" ).c_str( ) );
+    std::remove( ( queueDirectory + "/done" ).c_str( ) );
+    std::remove( queueDirectory.c_str( ) );
+}
+
+//! Check that summaries are identical.
+void checkIdenticalSummaries( const std::vector< SimulationSummary >& summaries,
+                              const std::vector< SimulationSummary >& expectedSummaries )
+{
+    REQUIRE( summaries.size( ) == expectedSummaries.size( ) );
+    for ( std::size_t i = 0; i < summaries.size( ); ++i )
+    {
+        REQUIRE( summaries[ i ].finalDistanceToTarget
+                 == expectedSummaries[ i ].finalDistanceToTarget );
+        REQUIRE( summaries[ i ].isTargetReached   == expectedSummaries[ i ].isTargetReached );
+        REQUIRE( summaries[ i ].totalDeltaV       == expectedSummaries[ i ].totalDeltaV );
+        REQUIRE( summaries[ i ].propellantMass    == expectedSummaries[ i ].propellantMass );
+        REQUIRE( summaries[ i ].isThrottleMax     == expectedSummaries[ i ].isThrottleMax );
+        REQUIRE( summaries[ i ].throttleSaturationTime
+                 == expectedSummaries[ i ].throttleSaturationTime );
+        REQUIRE( summaries[ i ].terminationTime   == expectedSummaries[ i ].terminationTime );
+        REQUIRE( summaries[ i ].isTerminatedEarly == expectedSummaries[ i ].isTerminatedEarly );
+        REQUIRE( summaries[ i ].isRedrawn         == expectedSummaries[ i ].isRedrawn );
+    }
+}
+
+TEST_CASE( "Test work queue settings", "[work_queue]" )
+{
+    std::ostringstream outputStream;
+
+    SECTION( "Test default settings" )
+    {
+        rapidjson::Document config;
+        config.Parse( "{ \"output_directory\" : \"\" }" );
+        const WorkQueueSettings settings = checkWorkQueueInput( config, outputStream );
+        REQUIRE( settings.numberOfSamplesPerTask == WorkQueueSettings( ).numberOfSamplesPerTask );
+        REQUIRE( settings.pollInterval == WorkQueueSettings( ).pollInterval );
+        REQUIRE( settings.stragglerFactor == WorkQueueSettings( ).stragglerFactor );
+        REQUIRE( settings.stragglerTimeout == WorkQueueSettings( ).stragglerTimeout );
+    }
+
+    SECTION( "Test user-defined settings" )
+    {
+        rapidjson::Document config;
+        config.Parse( "{ \"work_queue\" : { \"samples_per_task\" : 16, \"poll_interval\" : 2.0, "
+                      "\"straggler_factor\" : 1.5, \"straggler_timeout\" : 60.0 } }" );
+        const WorkQueueSettings settings = checkWorkQueueInput( config, outputStream );
+        REQUIRE( settings.numberOfSamplesPerTask == 16 );
+        REQUIRE( settings.pollInterval == 2.0 );
+        REQUIRE( settings.stragglerFactor == 1.5 );
+        REQUIRE( settings.stragglerTimeout == 60.0 );
+    }
+}
+
+TEST_CASE( "Test work queue result file", "[work_queue]" )
+{
+    const std::string filePath = "test_work_queue.result";
+
+    WorkQueueResult result;
+    result.firstSampleIndex = 1234567890123ULL;
+    result.executionTime = 0.625;
+    for ( std::size_t i = 0; i < 3; ++i )
+    {
+        SimulationSummary summary;
+        summary.finalDistanceToTarget = 0.1 * static_cast< Real >( i );
+        summary.isTargetReached = i != 1;
+        summary.totalDeltaV = 1.0 / 3.0 + static_cast< Real >( i );
+        summary.propellantMass = 0.125;
+        summary.isThrottleMax = i == 1;
+        summary.throttleSaturationTime = 12.5;
+        summary.terminationTime = 500.0;
+        summary.isTerminatedEarly = i == 2;
+        summary.isRedrawn = i == 0;
+        result.summaries.push_back( summary );
+    }
+
+    writeWorkQueueResult( filePath, result );
+    const WorkQueueResult readResult = readWorkQueueResult( filePath );
+    std::remove( filePath.c_str( ) );
+
+    // Each summary is stored in a compact record of five doubles and a byte of flags.
+    REQUIRE( readResult.firstSampleIndex == result.firstSampleIndex );
+    REQUIRE( readResult.executionTime == result.executionTime );
+    checkIdenticalSummaries( readResult.summaries, result.summaries );
+}
+
+TEST_CASE( "Test distributed Monte Carlo analysis", "[work_queue]" )
+{
+    const std::string queueDirectory = "test_work_queue";
+    const std::string campaignFilePath = "test_work_queue_campaign.json";
+    {
+        std::ofstream campaignFile( campaignFilePath.c_str( ) );
+        campaignFile << workQueueCampaign;
+    }
+
+    const ConfigCollection configs = loadConfigs( campaignFilePath );
+    const rapidjson::Document& config = configs.getDocument( 0 );
+    std::ostringstream inputStream;
+    const UserInput nominalInput = checkInput( config, inputStream );
+    const DispersionSettings dispersionSettings
+        = checkDispersionInput( config, nominalInput, inputStream );
+    const WorkQueueSettings settings = checkWorkQueueInput( config, inputStream );
+
+    const std::vector< SimulationSummary > expectedSummaries
+        = executeMonteCarloAnalysis( nominalInput, dispersionSettings );
+
+    // Execute coordinator and workers concurrently. A task is claimed by a worker that fails
+    // before the other workers start, such that the task must be re-dispatched.
+    std::ostringstream coordinatorStream;
+    std::vector< SimulationSummary > summaries;
+    std::thread coordinator( [ &queueDirectory, &campaignFilePath, &dispersionSettings,
+                               &settings, &coordinatorStream, &summaries ]( )
+    {
+        summaries = executeWorkQueueCoordinator( queueDirectory,
+                                                 campaignFilePath,
+                                                 dispersionSettings,
+                                                 settings,
+                                                 coordinatorStream );
+    } );
+
+    const std::string failedTaskName = "8_8_0.task";
+    while ( std::rename( ( queueDirectory + "/tasks/" + failedTaskName ).c_str( ),
+                         ( queueDirectory + "/claimed/" + failedTaskName + ".failed" ).c_str( ) )
+            != 0 )
+    {
+        std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+    }
+
+    std::ostringstream firstWorkerStream;
+    std::ostringstream secondWorkerStream;
+    std::size_t numberOfFirstWorkerTasks = 0;
+    std::size_t numberOfSecondWorkerTasks = 0;
+    std::thread firstWorker( [ &queueDirectory, &firstWorkerStream, &numberOfFirstWorkerTasks ]( )
+    {
+        numberOfFirstWorkerTasks = executeWorkQueueWorker( queueDirectory, firstWorkerStream );
+    } );
+    std::thread secondWorker(
+        [ &queueDirectory, &secondWorkerStream, &numberOfSecondWorkerTasks ]( )
+    {
+        numberOfSecondWorkerTasks = executeWorkQueueWorker( queueDirectory, secondWorkerStream );
+    } );
+
+    coordinator.join( );
+    firstWorker.join( );
+    secondWorker.join( );
+
+    // Merged summaries are identical to those of a Monte Carlo analysis in a single process.
+    checkIdenticalSummaries( summaries, expectedSummaries );
+    REQUIRE( numberOfFirstWorkerTasks + numberOfSecondWorkerTasks >= 5 );
+    REQUIRE( coordinatorStream.str( ).find(
+                 "Re-dispatched straggling task of samples      8-15" ) != std::string::npos );
+
+    // A coordinator restarted on the same queue directory reuses the results present.
+    std::ostringstream restartedCoordinatorStream;
+    const std::vector< SimulationSummary > restartedSummaries
+        = executeWorkQueueCoordinator( queueDirectory,
+                                       campaignFilePath,
+                                       dispersionSettings,
+                                       settings,
+                                       restartedCoordinatorStream );
+    checkIdenticalSummaries( restartedSummaries, expectedSummaries );
+    REQUIRE( restartedCoordinatorStream.str( ).find(
+                 "Tasks dispatched                              0/5" ) != std::string::npos );
+
+    removeQueueDirectory( queueDirectory );
+    std::remove( campaignFilePath.c_str( ) );
+}
+
+} // namespace tests
+} // namespace rvdsim